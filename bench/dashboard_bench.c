@@ -0,0 +1,638 @@
+/*
+ * dashboard-bench: headless micro-benchmarks for the dashboard pipeline.
+ *
+ *   dashboard-bench [--suite NAME] [--iterations N] [--output FILE] LAYOUT
+ *
+ * Suites:
+ *   load   JSON load time and retained heap of the parsed config
+ *   build  dashboard_build_widgets() time        (needs a display)
+ *   css    style collection + style_manager_apply (needs a display)
+ *   draw   steady-state draw time of every shape type into an
+ *          offscreen Cairo image surface; types the layout doesn't use
+ *          are drawn with default props (a route of a few hundred
+ *          points for Polyline and Polygon)
+ *   alloc  layout pass time of DashboardCanvas vs GtkFixed with
+ *          --children synthetic children (needs a display)
+ *   chart  Chart series with --points samples: min/max replot, one new
+ *          column, and a naive cairo_line_to-per-sample plot
+ *   polyline  Polyline of --points points: transform kernel, simplified
+ *          path at a new size, cached redraw, and a naive
+ *          cairo_line_to-per-point stroke
+ *   all    everything above (default)
+ *
+ * Suites that need a display are reported as skipped when GTK cannot be
+ * initialised, so the tool also runs on machines without any display;
+ * wrap it in xvfb-run to cover them too. Results are written as JSON.
+ */
+#include <gtk/gtk.h>
+#include <string.h>
+#include "app.h"
+#include "json_parser.h"
+#include "shape_renderer.h"
+#include "style_manager.h"
+#include "profiler.h"
+#include "dashboard_canvas.h"
+#include "chart_widget.h"
+#include "poly_path.h"
+#include <math.h>
+
+#define DRAW_SURFACE_SIZE 256
+#define DRAW_WARMUP 16
+#define DRAW_FALLBACK_POINTS 300
+#define ALLOC_CHILD_SIZE 24
+#define CHART_WIDTH 1000
+#define CHART_HEIGHT 200
+#define CHART_NAIVE_ITERATIONS 3
+#define POLY_VIEW_SIZE 10000.0    /* Point coordinates: a 10 km site in metres */
+#define POLY_SIZE 800
+#define POLY_TOLERANCE 0.5
+
+static char *opt_suite = NULL;
+static int opt_iterations = 20;
+static char *opt_output = NULL;
+static int opt_children = 10000;
+static int opt_points = 1000000;
+
+static GOptionEntry entries[] = {
+    { "suite", 's', 0, G_OPTION_ARG_STRING, &opt_suite, "Suite to run (load, build, css, draw, alloc, chart, polyline, all)", "NAME" },
+    { "iterations", 'i', 0, G_OPTION_ARG_INT, &opt_iterations, "Iterations per benchmark", "N" },
+    { "output", 'o', 0, G_OPTION_ARG_FILENAME, &opt_output, "Also write results to FILE", "FILE" },
+    { "children", 'c', 0, G_OPTION_ARG_INT, &opt_children, "Children for the alloc suite", "N" },
+    { "points", 'p', 0, G_OPTION_ARG_INT, &opt_points, "Samples for the chart suite, points for the polyline suite", "N" },
+    G_OPTION_ENTRY_NULL
+};
+
+/* ── Results ─────────────────────────────────────────────── */
+
+static JsonArray *results = NULL;
+
+static int compare_double(const void *a, const void *b) {
+    double x = *(const double *)a;
+    double y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+/* Adds a timing result; samples are in microseconds and get sorted */
+static JsonObject* add_result(const char *suite, const char *name, GArray *samples) {
+    JsonObject *obj = json_object_new();
+    json_object_set_string_member(obj, "suite", suite);
+    json_object_set_string_member(obj, "name", name);
+    json_object_set_string_member(obj, "unit", "us");
+    json_object_set_int_member(obj, "iterations", samples->len);
+
+    if (samples->len > 0) {
+        double *v = (double *)samples->data;
+        qsort(v, samples->len, sizeof(double), compare_double);
+
+        double sum = 0;
+        for (guint i = 0; i < samples->len; i++) sum += v[i];
+
+        json_object_set_double_member(obj, "min", v[0]);
+        json_object_set_double_member(obj, "median", v[samples->len / 2]);
+        json_object_set_double_member(obj, "mean", sum / samples->len);
+        json_object_set_double_member(obj, "p95", v[MIN(samples->len - 1, samples->len * 95 / 100)]);
+        json_object_set_double_member(obj, "max", v[samples->len - 1]);
+    }
+
+    json_array_add_object_element(results, obj);
+    return obj;
+}
+
+static void add_skipped(const char *suite, const char *reason) {
+    JsonObject *obj = json_object_new();
+    json_object_set_string_member(obj, "suite", suite);
+    json_object_set_string_member(obj, "skipped", reason);
+    json_array_add_object_element(results, obj);
+}
+
+static double elapsed_us(gint64 start) {
+    return (double)(g_get_monotonic_time() - start);
+}
+
+/* ── Suites ──────────────────────────────────────────────── */
+
+static void bench_load(const char *layout_file) {
+    GArray *samples = g_array_new(FALSE, FALSE, sizeof(double));
+    gint64 heap_bytes = 0;
+
+    for (int i = 0; i < opt_iterations; i++) {
+        GError *error = NULL;
+        gint64 heap_before = profiler_heap_in_use();
+        gint64 start = g_get_monotonic_time();
+        LayoutConfig *config = layout_config_load_from_file(layout_file, &error);
+        double t = elapsed_us(start);
+
+        if (!config) {
+            g_printerr("dashboard-bench: %s\n", error ? error->message : "load failed");
+            g_clear_error(&error);
+            break;
+        }
+        heap_bytes = profiler_heap_in_use() - heap_before;
+        g_array_append_val(samples, t);
+        layout_config_free(config);
+    }
+
+    JsonObject *obj = add_result("load", "json_load", samples);
+    json_object_set_int_member(obj, "retained_heap_bytes", heap_bytes);
+    g_array_free(samples, TRUE);
+}
+
+/* Collects CSS the same way the app does for a window */
+static void collect_styles(const LayoutConfig *config, StyleManager *style_mgr) {
+    if (config->window.background_color) {
+        style_manager_add_window_style(style_mgr, config->window.background_color);
+    }
+    dashboard_collect_styles(config->widgets, style_mgr);
+}
+
+static void bench_build(const LayoutConfig *config) {
+    GArray *samples = g_array_new(FALSE, FALSE, sizeof(double));
+
+    for (int i = 0; i < opt_iterations; i++) {
+        gint64 start = g_get_monotonic_time();
+        GtkWidget *container = dashboard_build_widgets(config->widgets, NULL);
+        double t = elapsed_us(start);
+        g_array_append_val(samples, t);
+
+        g_object_ref_sink(container);
+        g_object_unref(container);
+    }
+
+    JsonObject *obj = add_result("build", "dashboard_build", samples);
+    json_object_set_int_member(obj, "widgets", g_list_length(config->widgets));
+    g_array_free(samples, TRUE);
+}
+
+static void bench_css(const LayoutConfig *config) {
+    GArray *collect_samples = g_array_new(FALSE, FALSE, sizeof(double));
+    GArray *apply_samples = g_array_new(FALSE, FALSE, sizeof(double));
+    gsize css_bytes = 0;
+
+    /* Styles are resolved against real widgets, so build them once */
+    GtkWidget *container = g_object_ref_sink(dashboard_build_widgets(config->widgets, NULL));
+
+    for (int i = 0; i < opt_iterations; i++) {
+        StyleManager *style_mgr = style_manager_new();
+
+        gint64 start = g_get_monotonic_time();
+        collect_styles(config, style_mgr);
+        double t = elapsed_us(start);
+        g_array_append_val(collect_samples, t);
+        css_bytes = style_mgr->css_buffer->len;
+
+        /* Apply, then force style resolution through a measure pass */
+        start = g_get_monotonic_time();
+        style_manager_apply(style_mgr);
+        int min, nat;
+        gtk_widget_measure(container, GTK_ORIENTATION_HORIZONTAL, -1, &min, &nat, NULL, NULL);
+        t = elapsed_us(start);
+        g_array_append_val(apply_samples, t);
+
+        style_manager_unapply(style_mgr);
+        style_manager_free(style_mgr);
+    }
+
+    add_result("css", "css_collect", collect_samples);
+    JsonObject *obj = add_result("css", "css_apply", apply_samples);
+    json_object_set_int_member(obj, "css_bytes", css_bytes);
+
+    g_object_unref(container);
+    g_array_free(collect_samples, TRUE);
+    g_array_free(apply_samples, TRUE);
+}
+
+/* First config of the given type in the layout, so props match real data */
+static const WidgetConfig* find_config_of_type(const LayoutConfig *config, const char *type) {
+    for (GList *l = config->widgets; l != NULL; l = l->next) {
+        WidgetConfig *wconfig = (WidgetConfig *)l->data;
+        if (wconfig->type && strcmp(wconfig->type, type) == 0) return wconfig;
+    }
+    return NULL;
+}
+
+/* Deterministic pipe route: a wandering spiral with survey noise */
+static void poly_route(float *points, gsize n) {
+    for (gsize i = 0; i < n; i++) {
+        double t = (double)i / n;
+        double angle = t * 12.0 * G_PI;
+        double radius = POLY_VIEW_SIZE * (0.1 + 0.35 * t);
+        double noise = (double)((i * 2654435761u) % 1000) / 1000.0 - 0.5;
+        points[2 * i] = (float)(POLY_VIEW_SIZE / 2 + radius * cos(angle) + noise);
+        points[2 * i + 1] = (float)(POLY_VIEW_SIZE / 2 + radius * sin(angle) + noise);
+    }
+}
+
+/* Props for a shape type the layout doesn't use, so it draws something */
+static JsonObject* fallback_props(const char *type) {
+    JsonObject *props = json_object_new();
+    json_object_set_string_member(props, "fill_color", "#5E81AC");
+    json_object_set_string_member(props, "stroke_color", "#ECEFF4");
+
+    if (strcmp(type, "Polyline") == 0 || strcmp(type, "Polygon") == 0) {
+        float points[DRAW_FALLBACK_POINTS * 2];
+        poly_route(points, DRAW_FALLBACK_POINTS);
+
+        JsonArray *array = json_array_sized_new(DRAW_FALLBACK_POINTS * 2);
+        for (int i = 0; i < DRAW_FALLBACK_POINTS * 2; i++) {
+            json_array_add_double_element(array, points[i]);
+        }
+        json_object_set_array_member(props, "points", array);
+
+        JsonArray *viewbox = json_array_sized_new(4);
+        json_array_add_double_element(viewbox, 0.0);
+        json_array_add_double_element(viewbox, 0.0);
+        json_array_add_double_element(viewbox, POLY_VIEW_SIZE);
+        json_array_add_double_element(viewbox, POLY_VIEW_SIZE);
+        json_object_set_array_member(props, "viewbox", viewbox);
+    }
+    return props;
+}
+
+static void bench_draw(const LayoutConfig *config) {
+    cairo_surface_t *surface = cairo_image_surface_create(CAIRO_FORMAT_ARGB32,
+                                                          DRAW_SURFACE_SIZE, DRAW_SURFACE_SIZE);
+    cairo_t *cr = cairo_create(surface);
+
+    for (const char * const *type = shape_renderer_type_names(); *type; type++) {
+        WidgetConfig fallback = { .id = (char *)*type, .type = (char *)*type,
+                                  .width = DRAW_SURFACE_SIZE, .height = DRAW_SURFACE_SIZE };
+        const WidgetConfig *wconfig = config ? find_config_of_type(config, *type) : NULL;
+        if (!wconfig) {
+            fallback.props = fallback_props(*type);
+            wconfig = &fallback;
+        }
+
+        GArray *samples = g_array_new(FALSE, FALSE, sizeof(double));
+        for (int i = 0; i < DRAW_WARMUP + opt_iterations; i++) {
+            cairo_save(cr);
+            cairo_set_operator(cr, CAIRO_OPERATOR_CLEAR);
+            cairo_paint(cr);
+            cairo_restore(cr);
+            cairo_surface_flush(surface);
+
+            gint64 start = g_get_monotonic_time();
+            shape_renderer_draw(wconfig, cr, DRAW_SURFACE_SIZE, DRAW_SURFACE_SIZE);
+            cairo_surface_flush(surface);
+            double t = elapsed_us(start);
+
+            if (i >= DRAW_WARMUP) g_array_append_val(samples, t);
+        }
+
+        char *name = g_strdup_printf("draw_%s", *type);
+        JsonObject *obj = add_result("draw", name, samples);
+        json_object_set_int_member(obj, "surface_size", DRAW_SURFACE_SIZE);
+        json_object_set_boolean_member(obj, "default_props", wconfig == &fallback);
+        g_free(name);
+        g_array_free(samples, TRUE);
+        if (fallback.props) json_object_unref(fallback.props);
+    }
+
+    cairo_destroy(cr);
+    cairo_surface_destroy(surface);
+}
+
+/* Child i of the alloc suite sits on a grid that wraps like layout-gen's */
+static void alloc_child_position(int i, int *x, int *y) {
+    int columns = 1920 / ALLOC_CHILD_SIZE;
+    *x = (i % columns) * ALLOC_CHILD_SIZE;
+    *y = (i / columns) * ALLOC_CHILD_SIZE % 1080;
+}
+
+static GtkWidget* alloc_container_new(gboolean canvas) {
+    GtkWidget *container = g_object_ref_sink(canvas ? dashboard_canvas_new() : gtk_fixed_new());
+
+    for (int i = 0; i < opt_children; i++) {
+        GtkWidget *child = gtk_drawing_area_new();
+        gtk_widget_set_size_request(child, ALLOC_CHILD_SIZE, ALLOC_CHILD_SIZE);
+
+        int x, y;
+        alloc_child_position(i, &x, &y);
+        if (canvas) {
+            dashboard_canvas_put(DASHBOARD_CANVAS(container), child, x, y,
+                                 ALLOC_CHILD_SIZE, ALLOC_CHILD_SIZE);
+        } else {
+            gtk_fixed_put(GTK_FIXED(container), child, x, y);
+        }
+    }
+    return container;
+}
+
+/* One layout pass the way GTK runs it: measure, then allocate */
+static double layout_pass(GtkWidget *container, int width, int height) {
+    int min, nat;
+    gint64 start = g_get_monotonic_time();
+    gtk_widget_measure(container, GTK_ORIENTATION_HORIZONTAL, -1, &min, &nat, NULL, NULL);
+    gtk_widget_measure(container, GTK_ORIENTATION_VERTICAL, width, &min, &nat, NULL, NULL);
+    gtk_widget_allocate(container, width, height, -1, NULL);
+    return elapsed_us(start);
+}
+
+static void bench_alloc_container(gboolean canvas) {
+    const char *kind = canvas ? "canvas" : "gtkfixed";
+    GtkWidget *container = alloc_container_new(canvas);
+    GArray *initial = g_array_new(FALSE, FALSE, sizeof(double));
+    GArray *resize = g_array_new(FALSE, FALSE, sizeof(double));
+    GArray *move = g_array_new(FALSE, FALSE, sizeof(double));
+
+    double t = layout_pass(container, 1920, 1080);
+    g_array_append_val(initial, t);
+
+    for (int i = 0; i < opt_iterations; i++) {
+        /* Window resize: the container's own size changes */
+        t = layout_pass(container, 1920 + (i % 2 ? 0 : 1), 1080);
+        g_array_append_val(resize, t);
+
+        /* One child moves, e.g. an animated or re-laid-out widget */
+        GtkWidget *child = gtk_widget_get_first_child(container);
+        int x = (i % 2) * ALLOC_CHILD_SIZE;
+        if (canvas) {
+            dashboard_canvas_move(DASHBOARD_CANVAS(container), child, x, 0,
+                                  ALLOC_CHILD_SIZE, ALLOC_CHILD_SIZE);
+        } else {
+            gtk_fixed_move(GTK_FIXED(container), child, x, 0);
+        }
+        t = layout_pass(container, 1920, 1080);
+        g_array_append_val(move, t);
+    }
+
+    const char *names[] = { "initial", "resize", "move_one" };
+    GArray *samples[] = { initial, resize, move };
+    for (guint i = 0; i < G_N_ELEMENTS(names); i++) {
+        char *name = g_strdup_printf("alloc_%s_%s", names[i], kind);
+        JsonObject *obj = add_result("alloc", name, samples[i]);
+        json_object_set_int_member(obj, "children", opt_children);
+        g_free(name);
+        g_array_free(samples[i], TRUE);
+    }
+
+    g_object_unref(container);
+}
+
+static void bench_alloc(void) {
+    bench_alloc_container(FALSE);
+    bench_alloc_container(TRUE);
+}
+
+/* Deterministic noisy sine, sample i of the stream */
+static void chart_signal(float *values, gsize n, guint64 first) {
+    for (gsize i = 0; i < n; i++) {
+        guint64 k = first + i;
+        values[i] = 50.0f * sinf(k * 0.0005f) + (float)((k * 2654435761u) % 1000) / 100.0f;
+    }
+}
+
+static void add_chart_result(const char *name, GArray *samples) {
+    JsonObject *obj = add_result("chart", name, samples);
+    json_object_set_int_member(obj, "points", opt_points);
+    json_object_set_int_member(obj, "width", CHART_WIDTH);
+    g_array_free(samples, TRUE);
+}
+
+static void bench_chart(void) {
+    gsize n = (gsize)MAX(opt_points, CHART_WIDTH);
+    float *values = g_new(float, n);
+    chart_signal(values, n, 0);
+    GdkRGBA color = { 0.53f, 0.75f, 0.82f, 1.0f };
+
+    /* Fill the ring buffer */
+    GArray *append = g_array_new(FALSE, FALSE, sizeof(double));
+    ChartSeries *series = chart_series_new((guint)n);
+    gint64 start = g_get_monotonic_time();
+    chart_series_append(series, values, n);
+    double t = elapsed_us(start);
+    g_array_append_val(append, t);
+    add_chart_result("chart_append", append);
+
+    /* Full replot: every sample decimated to the width (resize, new range) */
+    GArray *replot = g_array_new(FALSE, FALSE, sizeof(double));
+    for (int i = 0; i < opt_iterations; i++) {
+        double max = i % 2 ? 100.0 : 101.0;
+        start = g_get_monotonic_time();
+        chart_series_render(series, CHART_WIDTH, CHART_HEIGHT, -100.0, max, &color);
+        t = elapsed_us(start);
+        g_array_append_val(replot, t);
+    }
+    add_chart_result("chart_replot", replot);
+
+    /* Steady state: enough new samples for one column, then render */
+    gsize per_column = n / CHART_WIDTH;
+    float *chunk = g_new(float, per_column);
+    GArray *column = g_array_new(FALSE, FALSE, sizeof(double));
+    for (int i = 0; i < opt_iterations; i++) {
+        chart_signal(chunk, per_column, chart_series_get_total(series));
+        start = g_get_monotonic_time();
+        chart_series_append(series, chunk, per_column);
+        chart_series_render(series, CHART_WIDTH, CHART_HEIGHT, -100.0, 101.0, &color);
+        t = elapsed_us(start);
+        g_array_append_val(column, t);
+    }
+    add_chart_result("chart_new_column", column);
+
+    /* Baseline: one cairo_line_to per sample over the same surface size */
+    cairo_surface_t *surface = cairo_image_surface_create(CAIRO_FORMAT_ARGB32,
+                                                          CHART_WIDTH, CHART_HEIGHT);
+    cairo_t *cr = cairo_create(surface);
+    GArray *naive = g_array_new(FALSE, FALSE, sizeof(double));
+    for (int i = 0; i < MIN(opt_iterations, CHART_NAIVE_ITERATIONS); i++) {
+        start = g_get_monotonic_time();
+        gdk_cairo_set_source_rgba(cr, &color);
+        cairo_set_line_width(cr, 1.0);
+        for (gsize k = 0; k < n; k++) {
+            double x = (double)k * CHART_WIDTH / n;
+            double y = (101.0 - values[k]) / 201.0 * (CHART_HEIGHT - 1);
+            if (k == 0) cairo_move_to(cr, x, y); else cairo_line_to(cr, x, y);
+        }
+        cairo_stroke(cr);
+        cairo_surface_flush(surface);
+        t = elapsed_us(start);
+        g_array_append_val(naive, t);
+    }
+    add_chart_result("chart_naive_lineto", naive);
+
+    cairo_destroy(cr);
+    cairo_surface_destroy(surface);
+    chart_series_free(series);
+    g_free(chunk);
+    g_free(values);
+}
+
+static void add_poly_result(const char *name, GArray *samples, gsize drawn) {
+    JsonObject *obj = add_result("polyline", name, samples);
+    json_object_set_int_member(obj, "points", opt_points);
+    json_object_set_int_member(obj, "points_drawn", drawn);
+    json_object_set_int_member(obj, "size", POLY_SIZE);
+    g_array_free(samples, TRUE);
+}
+
+static void stroke_and_flush(cairo_t *cr, cairo_surface_t *surface) {
+    cairo_set_source_rgb(cr, 0.53, 0.75, 0.82);
+    cairo_set_line_width(cr, 2.0);
+    cairo_stroke(cr);
+    cairo_surface_flush(surface);
+}
+
+static void bench_polyline(void) {
+    gsize n = (gsize)MAX(opt_points, 2);
+    float *points = g_new(float, n * 2);
+    float *mapped = g_new(float, n * 2);
+    poly_route(points, n);
+    float scale = (float)(POLY_SIZE / POLY_VIEW_SIZE);
+
+    /* Mapping kernel alone */
+    GArray *transform = g_array_new(FALSE, FALSE, sizeof(double));
+    for (int i = 0; i < opt_iterations; i++) {
+        gint64 start = g_get_monotonic_time();
+        poly_path_transform(points, mapped, n, scale, scale, 0.0f, 0.0f);
+        double t = elapsed_us(start);
+        g_array_append_val(transform, t);
+    }
+    add_poly_result("polyline_transform", transform, n);
+
+    cairo_surface_t *surface = cairo_image_surface_create(CAIRO_FORMAT_ARGB32,
+                                                          POLY_SIZE, POLY_SIZE);
+    cairo_t *cr = cairo_create(surface);
+    PolyPath *path = poly_path_new(points, n);
+    poly_path_set_view_box(path, 0, 0, POLY_VIEW_SIZE, POLY_VIEW_SIZE);
+    gsize drawn = 0;
+
+    /* New size every time: map, simplify and stroke */
+    GArray *resized = g_array_new(FALSE, FALSE, sizeof(double));
+    for (int i = 0; i < opt_iterations; i++) {
+        double size = POLY_SIZE - (i % 2);
+        gint64 start = g_get_monotonic_time();
+        poly_path_append(path, cr, size, size, POLY_TOLERANCE, FALSE);
+        stroke_and_flush(cr, surface);
+        double t = elapsed_us(start);
+        g_array_append_val(resized, t);
+    }
+    poly_path_get_points(path, POLY_SIZE, POLY_SIZE, 1.0, POLY_TOLERANCE, &drawn);
+    add_poly_result("polyline_resized", resized, drawn);
+
+    /* Steady redraw from the cached simplified points */
+    GArray *cached = g_array_new(FALSE, FALSE, sizeof(double));
+    for (int i = 0; i < opt_iterations; i++) {
+        gint64 start = g_get_monotonic_time();
+        poly_path_append(path, cr, POLY_SIZE, POLY_SIZE, POLY_TOLERANCE, FALSE);
+        stroke_and_flush(cr, surface);
+        double t = elapsed_us(start);
+        g_array_append_val(cached, t);
+    }
+    add_poly_result("polyline_cached", cached, drawn);
+
+    /* Baseline: one cairo_line_to per point, mapped in double */
+    GArray *naive = g_array_new(FALSE, FALSE, sizeof(double));
+    for (int i = 0; i < opt_iterations; i++) {
+        gint64 start = g_get_monotonic_time();
+        for (gsize k = 0; k < n; k++) {
+            double x = points[2 * k] * (POLY_SIZE / POLY_VIEW_SIZE);
+            double y = points[2 * k + 1] * (POLY_SIZE / POLY_VIEW_SIZE);
+            if (k == 0) cairo_move_to(cr, x, y); else cairo_line_to(cr, x, y);
+        }
+        stroke_and_flush(cr, surface);
+        double t = elapsed_us(start);
+        g_array_append_val(naive, t);
+    }
+    add_poly_result("polyline_naive_lineto", naive, n);
+
+    poly_path_free(path);
+    cairo_destroy(cr);
+    cairo_surface_destroy(surface);
+    g_free(mapped);
+    g_free(points);
+}
+
+/* ── Main ────────────────────────────────────────────────── */
+
+static gboolean suite_selected(const char *name) {
+    return !opt_suite || strcmp(opt_suite, "all") == 0 || strcmp(opt_suite, name) == 0;
+}
+
+static void write_report(const char *layout_file, const LayoutConfig *config) {
+    JsonObject *root_obj = json_object_new();
+    GDateTime *now = g_date_time_new_now_utc();
+    char *timestamp = g_date_time_format_iso8601(now);
+
+    json_object_set_string_member(root_obj, "timestamp", timestamp);
+    json_object_set_string_member(root_obj, "layout", layout_file);
+    json_object_set_int_member(root_obj, "elements", config ? g_list_length(config->widgets) : 0);
+    json_object_set_array_member(root_obj, "results", json_array_ref(results));
+
+    JsonNode *root = json_node_new(JSON_NODE_OBJECT);
+    json_node_take_object(root, root_obj);
+
+    JsonGenerator *gen = json_generator_new();
+    json_generator_set_pretty(gen, TRUE);
+    json_generator_set_root(gen, root);
+
+    char *data = json_generator_to_data(gen, NULL);
+    g_print("%s\n", data);
+    g_free(data);
+
+    if (opt_output) {
+        GError *error = NULL;
+        if (!json_generator_to_file(gen, opt_output, &error)) {
+            g_printerr("dashboard-bench: %s\n", error->message);
+            g_clear_error(&error);
+        }
+    }
+
+    g_object_unref(gen);
+    json_node_unref(root);
+    g_free(timestamp);
+    g_date_time_unref(now);
+}
+
+int main(int argc, char **argv) {
+    GError *error = NULL;
+    GOptionContext *context = g_option_context_new("LAYOUT - benchmark the dashboard pipeline");
+    g_option_context_add_main_entries(context, entries, NULL);
+    if (!g_option_context_parse(context, &argc, &argv, &error)) {
+        g_printerr("dashboard-bench: %s\n", error->message);
+        g_clear_error(&error);
+        g_option_context_free(context);
+        return 1;
+    }
+    g_option_context_free(context);
+
+    if (argc < 2) {
+        g_printerr("Usage: %s [OPTIONS] LAYOUT\n", argv[0]);
+        return 1;
+    }
+    const char *layout_file = argv[1];
+
+    LayoutConfig *config = layout_config_load_from_file(layout_file, &error);
+    if (!config) {
+        g_printerr("dashboard-bench: %s\n", error ? error->message : "load failed");
+        g_clear_error(&error);
+        return 1;
+    }
+
+    results = json_array_new();
+    gboolean have_display = gtk_init_check();
+
+    if (suite_selected("load")) bench_load(layout_file);
+
+    if (suite_selected("build")) {
+        if (have_display) bench_build(config); else add_skipped("build", "no display");
+    }
+    if (suite_selected("css")) {
+        if (have_display) bench_css(config); else add_skipped("css", "no display");
+    }
+
+    if (suite_selected("draw")) bench_draw(config);
+
+    if (suite_selected("alloc")) {
+        if (have_display) bench_alloc(); else add_skipped("alloc", "no display");
+    }
+
+    if (suite_selected("chart")) bench_chart();
+    if (suite_selected("polyline")) bench_polyline();
+
+    write_report(layout_file, config);
+
+    json_array_unref(results);
+    layout_config_free(config);
+    g_free(opt_suite);
+    g_free(opt_output);
+    return 0;
+}
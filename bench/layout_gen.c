@@ -0,0 +1,328 @@
+/*
+ * layout-gen: writes synthetic layout.json files for benchmarks.
+ *
+ *   layout-gen --widgets N --shapes M [--styles K] [--seed S] -o FILE
+ *
+ * N widgets cycle through every widget type, M shapes are emitted for
+ * every shape type, and K controls how many distinct style/props
+ * variations are used (1 = every element of a type looks the same).
+ * The types are those the widget factory and shape renderer register,
+ * so new types are covered as soon as they exist.
+ */
+#include <glib.h>
+#include <json-glib/json-glib.h>
+#include <math.h>
+#include "widget_factory.h"
+#include "shape_renderer.h"
+
+#define WINDOW_WIDTH 1920
+#define WINDOW_HEIGHT 1080
+
+/* Samples of Chart/Sparkline "data" and points of Polyline/Polygon */
+#define GEN_SAMPLES 256
+#define GEN_POINTS 300
+
+static const char *palette[] = {
+    "#2E3440", "#3B4252", "#434C5E", "#4C566A", "#D8DEE9", "#E5E9F0",
+    "#ECEFF4", "#8FBCBB", "#88C0D0", "#81A1C1", "#5E81AC", "#BF616A",
+    "#D08770", "#EBCB8B", "#A3BE8C", "#B48EAD"
+};
+
+static int opt_widgets = 100;
+static int opt_shapes = 10;
+static int opt_styles = 8;
+static int opt_seed = 1;
+static char *opt_output = NULL;
+
+static GOptionEntry entries[] = {
+    { "widgets", 'n', 0, G_OPTION_ARG_INT, &opt_widgets, "Number of widgets", "N" },
+    { "shapes", 'm', 0, G_OPTION_ARG_INT, &opt_shapes, "Number of shapes per shape type", "M" },
+    { "styles", 's', 0, G_OPTION_ARG_INT, &opt_styles, "Distinct style variations", "K" },
+    { "seed", 0, 0, G_OPTION_ARG_INT, &opt_seed, "Random seed", "S" },
+    { "output", 'o', 0, G_OPTION_ARG_FILENAME, &opt_output, "Output file (default: stdout)", "FILE" },
+    G_OPTION_ENTRY_NULL
+};
+
+/* Each style variation maps to a stable color */
+static const char* pick_color(int variation) {
+    return palette[(variation * 7) % G_N_ELEMENTS(palette)];
+}
+
+/* Lay elements out on a grid that wraps over the window area */
+static void add_geometry(JsonBuilder *b, int index, int width, int height) {
+    int columns = MAX(1, WINDOW_WIDTH / width);
+    int rows = MAX(1, WINDOW_HEIGHT / height);
+    int slot = index % MAX(1, columns * rows);
+    int layer = index / MAX(1, columns * rows);
+
+    json_builder_set_member_name(b, "geometry");
+    json_builder_begin_object(b);
+    json_builder_set_member_name(b, "x");
+    json_builder_add_int_value(b, (slot % columns) * width + (layer * 3) % width);
+    json_builder_set_member_name(b, "y");
+    json_builder_add_int_value(b, (slot / columns) * height + (layer * 3) % height);
+    json_builder_set_member_name(b, "width");
+    json_builder_add_int_value(b, width);
+    json_builder_set_member_name(b, "height");
+    json_builder_add_int_value(b, height);
+    json_builder_end_object(b);
+}
+
+static void add_widget_props(JsonBuilder *b, const char *type, int index, int variation) {
+    json_builder_set_member_name(b, "props");
+    json_builder_begin_object(b);
+
+    if (g_str_equal(type, "Button") || g_str_equal(type, "Label") ||
+        g_str_equal(type, "Checkbox") || g_str_equal(type, "Switch")) {
+        char *label = g_strdup_printf("%s %d", type, index);
+        json_builder_set_member_name(b, "label");
+        json_builder_add_string_value(b, label);
+        g_free(label);
+    }
+    if (g_str_equal(type, "Label")) {
+        json_builder_set_member_name(b, "font_size");
+        json_builder_add_int_value(b, 12 + variation % 6 * 2);
+    } else if (g_str_equal(type, "Entry")) {
+        json_builder_set_member_name(b, "placeholder");
+        json_builder_add_string_value(b, "Enter text...");
+    } else if (g_str_equal(type, "Checkbox")) {
+        json_builder_set_member_name(b, "checked");
+        json_builder_add_boolean_value(b, index % 2);
+    } else if (g_str_equal(type, "Switch")) {
+        json_builder_set_member_name(b, "active");
+        json_builder_add_boolean_value(b, index % 2);
+    } else if (g_str_equal(type, "Combo")) {
+        json_builder_set_member_name(b, "items");
+        json_builder_add_string_value(b, "Alpha,Bravo,Charlie,Delta");
+        json_builder_set_member_name(b, "active_index");
+        json_builder_add_int_value(b, variation % 4);
+    } else if (g_str_equal(type, "Slider") || g_str_equal(type, "Spin")) {
+        json_builder_set_member_name(b, "min");
+        json_builder_add_int_value(b, 0);
+        json_builder_set_member_name(b, "max");
+        json_builder_add_int_value(b, 100);
+        json_builder_set_member_name(b, "step");
+        json_builder_add_int_value(b, 1);
+        json_builder_set_member_name(b, "value");
+        json_builder_add_int_value(b, (index * 13) % 100);
+    } else if (g_str_equal(type, "Image")) {
+        json_builder_set_member_name(b, "file_path");
+        json_builder_add_string_value(b, "");
+        json_builder_set_member_name(b, "alt_text");
+        json_builder_add_string_value(b, "Image");
+    } else if (g_str_equal(type, "Progress")) {
+        json_builder_set_member_name(b, "value");
+        json_builder_add_double_value(b, (index % 10) / 10.0);
+        json_builder_set_member_name(b, "show_text");
+        json_builder_add_boolean_value(b, variation % 2);
+    } else if (g_str_equal(type, "Separator")) {
+        json_builder_set_member_name(b, "orientation");
+        json_builder_add_string_value(b, index % 2 ? "vertical" : "horizontal");
+    } else if (g_str_equal(type, "Chart") || g_str_equal(type, "Sparkline")) {
+        json_builder_set_member_name(b, "color");
+        json_builder_add_string_value(b, pick_color(variation + 8));
+        json_builder_set_member_name(b, "min");
+        json_builder_add_int_value(b, 0);
+        json_builder_set_member_name(b, "max");
+        json_builder_add_int_value(b, 100);
+        json_builder_set_member_name(b, "data");
+        json_builder_begin_array(b);
+        for (int i = 0; i < GEN_SAMPLES; i++) {
+            json_builder_add_double_value(b, 50 + 40 * sin((i + index * 7) * 0.1));
+        }
+        json_builder_end_array(b);
+    } else if (g_str_equal(type, "Gauge")) {
+        json_builder_set_member_name(b, "min");
+        json_builder_add_int_value(b, 0);
+        json_builder_set_member_name(b, "max");
+        json_builder_add_int_value(b, 100);
+        json_builder_set_member_name(b, "value");
+        json_builder_add_int_value(b, (index * 17) % 100);
+        json_builder_set_member_name(b, "units");
+        json_builder_add_string_value(b, "%");
+        json_builder_set_member_name(b, "bands");
+        json_builder_begin_array(b);
+        json_builder_begin_object(b);
+        json_builder_set_member_name(b, "from");
+        json_builder_add_int_value(b, 70 + variation % 10);
+        json_builder_set_member_name(b, "to");
+        json_builder_add_int_value(b, 100);
+        json_builder_set_member_name(b, "color");
+        json_builder_add_string_value(b, "#BF616A");
+        json_builder_end_object(b);
+        json_builder_end_array(b);
+    } else if (g_str_equal(type, "LogView")) {
+        /* No source: the panel is built and drawn empty */
+        json_builder_set_member_name(b, "max_lines");
+        json_builder_add_int_value(b, 1000);
+        json_builder_set_member_name(b, "color");
+        json_builder_add_string_value(b, pick_color(variation + 6));
+    }
+
+    json_builder_end_object(b);
+}
+
+static void add_shape_props(JsonBuilder *b, const char *type, int variation) {
+    static const char *line_dirs[] = { "horizontal", "vertical", "diagonal-se", "diagonal-ne" };
+    static const char *dirs[] = { "up", "down", "left", "right" };
+
+    json_builder_set_member_name(b, "props");
+    json_builder_begin_object(b);
+
+    gboolean filled = !g_str_equal(type, "Line") && !g_str_equal(type, "Arrow") &&
+                      !g_str_equal(type, "Polyline");
+    if (filled) {
+        json_builder_set_member_name(b, "fill_color");
+        json_builder_add_string_value(b, variation % 3 == 0 ? "transparent" : pick_color(variation));
+    }
+    json_builder_set_member_name(b, "stroke_color");
+    json_builder_add_string_value(b, pick_color(variation + 3));
+    json_builder_set_member_name(b, "stroke_width");
+    json_builder_add_int_value(b, 1 + variation % 4);
+
+    if (g_str_equal(type, "Line")) {
+        json_builder_set_member_name(b, "direction");
+        json_builder_add_string_value(b, line_dirs[variation % 4]);
+    } else if (g_str_equal(type, "Triangle") || g_str_equal(type, "Arrow")) {
+        json_builder_set_member_name(b, "direction");
+        json_builder_add_string_value(b, dirs[variation % 4]);
+    } else if (g_str_equal(type, "Rect")) {
+        json_builder_set_member_name(b, "border_radius");
+        json_builder_add_int_value(b, (variation % 3) * 6);
+    } else if (g_str_equal(type, "Star")) {
+        json_builder_set_member_name(b, "points");
+        json_builder_add_int_value(b, 5 + variation % 4);
+    } else if (g_str_equal(type, "Polyline") || g_str_equal(type, "Polygon")) {
+        /* A wave across the 96x96 shape, or a wobbly ring: enough points
+         * on shared pixels and near-straight runs to exercise simplification */
+        gboolean ring = g_str_equal(type, "Polygon");
+        json_builder_set_member_name(b, "points");
+        json_builder_begin_array(b);
+        for (int i = 0; i < GEN_POINTS; i++) {
+            double t = (double)i / GEN_POINTS;
+            double wobble = sin(t * 2 * G_PI * (3 + variation % 5));
+            if (ring) {
+                double radius = 40 + 6 * wobble;
+                json_builder_add_double_value(b, 48 + radius * cos(t * 2 * G_PI));
+                json_builder_add_double_value(b, 48 + radius * sin(t * 2 * G_PI));
+            } else {
+                json_builder_add_double_value(b, t * 96);
+                json_builder_add_double_value(b, 48 + 40 * wobble);
+            }
+        }
+        json_builder_end_array(b);
+    }
+
+    json_builder_end_object(b);
+}
+
+static void add_style(JsonBuilder *b, int variation, gboolean shape) {
+    json_builder_set_member_name(b, "style");
+    json_builder_begin_object(b);
+    json_builder_set_member_name(b, "background_color");
+    json_builder_add_string_value(b, shape ? "transparent" : pick_color(variation + 5));
+    json_builder_set_member_name(b, "color");
+    json_builder_add_string_value(b, shape ? "transparent" : pick_color(variation + 11));
+    json_builder_end_object(b);
+}
+
+static void add_element(JsonBuilder *b, GRand *rand, const char *type, int index,
+                        int global_index, gboolean shape) {
+    int variation = g_rand_int_range(rand, 0, MAX(1, opt_styles));
+    char *id = g_strdup_printf("%s_%d", type, index);
+
+    json_builder_begin_object(b);
+    json_builder_set_member_name(b, "id");
+    json_builder_add_string_value(b, id);
+    json_builder_set_member_name(b, "type");
+    json_builder_add_string_value(b, type);
+    add_geometry(b, global_index, shape ? 96 : 160, shape ? 96 : 40);
+    add_style(b, variation, shape);
+    if (shape) {
+        add_shape_props(b, type, variation);
+    } else {
+        add_widget_props(b, type, index, variation);
+    }
+    json_builder_set_member_name(b, "events");
+    json_builder_begin_object(b);
+    json_builder_end_object(b);
+    json_builder_end_object(b);
+
+    g_free(id);
+}
+
+int main(int argc, char **argv) {
+    GError *error = NULL;
+    GOptionContext *context = g_option_context_new("- generate synthetic dashboard layouts");
+    g_option_context_add_main_entries(context, entries, NULL);
+    if (!g_option_context_parse(context, &argc, &argv, &error)) {
+        g_printerr("layout-gen: %s\n", error->message);
+        g_clear_error(&error);
+        g_option_context_free(context);
+        return 1;
+    }
+    g_option_context_free(context);
+
+    GRand *rand = g_rand_new_with_seed((guint32)opt_seed);
+
+    JsonBuilder *b = json_builder_new();
+    json_builder_begin_object(b);
+
+    json_builder_set_member_name(b, "window");
+    json_builder_begin_object(b);
+    json_builder_set_member_name(b, "title");
+    json_builder_add_string_value(b, "Synthetic Layout");
+    json_builder_set_member_name(b, "width");
+    json_builder_add_int_value(b, WINDOW_WIDTH);
+    json_builder_set_member_name(b, "height");
+    json_builder_add_int_value(b, WINDOW_HEIGHT);
+    json_builder_set_member_name(b, "background_color");
+    json_builder_add_string_value(b, "#2E3440");
+    json_builder_end_object(b);
+
+    json_builder_set_member_name(b, "widgets");
+    json_builder_begin_array(b);
+
+    /* Shapes first so they sit behind the widgets, as in designed layouts */
+    int global_index = 0;
+    const char * const *shape_types = shape_renderer_type_names();
+    for (guint t = 0; shape_types[t]; t++) {
+        for (int i = 0; i < opt_shapes; i++) {
+            add_element(b, rand, shape_types[t], i + 1, global_index++, TRUE);
+        }
+    }
+    const char * const *widget_types = widget_factory_type_names();
+    int n_widget_types = (int)g_strv_length((char **)widget_types);
+    for (int i = 0; i < opt_widgets; i++) {
+        const char *type = widget_types[i % n_widget_types];
+        add_element(b, rand, type, i / n_widget_types + 1, global_index++, FALSE);
+    }
+
+    json_builder_end_array(b);
+    json_builder_end_object(b);
+
+    JsonGenerator *gen = json_generator_new();
+    json_generator_set_pretty(gen, TRUE);
+    JsonNode *root = json_builder_get_root(b);
+    json_generator_set_root(gen, root);
+
+    int status = 0;
+    if (opt_output) {
+        if (!json_generator_to_file(gen, opt_output, &error)) {
+            g_printerr("layout-gen: %s\n", error->message);
+            g_clear_error(&error);
+            status = 1;
+        }
+    } else {
+        char *data = json_generator_to_data(gen, NULL);
+        g_print("%s\n", data);
+        g_free(data);
+    }
+
+    json_node_unref(root);
+    g_object_unref(gen);
+    g_object_unref(b);
+    g_rand_free(rand);
+    g_free(opt_output);
+    return status;
+}
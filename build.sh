@@ -8,15 +8,22 @@ SRCDIR="src"
 BUILDDIR="builddir"
 TARGET="gtk-dashboard"
 
-CFLAGS="-Wall -std=c11 $(pkg-config --cflags gtk4 json-glib-1.0)"
-LDFLAGS="$(pkg-config --libs gtk4 json-glib-1.0)"
+CFLAGS="-Wall -std=c11 $(pkg-config --cflags gtk4 json-glib-1.0 gio-unix-2.0)"
+LDFLAGS="$(pkg-config --libs gtk4 json-glib-1.0 gio-unix-2.0)"
+
+# Optional: sysprof marks for --profile
+if pkg-config --exists sysprof-capture-4; then
+    CFLAGS="$CFLAGS -DHAVE_SYSPROF $(pkg-config --cflags sysprof-capture-4)"
+    LDFLAGS="$LDFLAGS $(pkg-config --libs sysprof-capture-4)"
+fi
 
 mkdir -p "$BUILDDIR"
 
 echo "Compiling..."
-for src in main.c app.c json_parser.c widget_factory.c style_manager.c shape_renderer.c; do
+for src in main.c app.c json_parser.c widget_factory.c style_manager.c shape_renderer.c profiler.c frame_hud.c frame_stats.c scene_manager.c resource_cache.c scale_bin.c dashboard_canvas.c mem_report.c splash_cache.c animator.c data_feed.c chart_widget.c gauge_widget.c log_view.c tracer.c dep_graph.c layout_solver.c power_policy.c expression.c binding_graph.c widget_bindings.c workload.c poly_path.c metrics.c layout_check.c; do
     echo "  $src"
     gcc $CFLAGS -c "$SRCDIR/$src" -o "$BUILDDIR/${src%.c}.o"
+    if [ "$src" != main.c ]; then CORE_OBJS="$CORE_OBJS $BUILDDIR/${src%.c}.o"; fi
 done
 
 echo "Linking..."
@@ -27,6 +34,35 @@ gcc -o "$BUILDDIR/$TARGET" \
     "$BUILDDIR/widget_factory.o" \
     "$BUILDDIR/style_manager.o" \
     "$BUILDDIR/shape_renderer.o" \
+    "$BUILDDIR/profiler.o" \
+    "$BUILDDIR/frame_hud.o" \
+    "$BUILDDIR/frame_stats.o" \
+    "$BUILDDIR/scene_manager.o" \
+    "$BUILDDIR/resource_cache.o" \
+    "$BUILDDIR/scale_bin.o" \
+    "$BUILDDIR/dashboard_canvas.o" \
+    "$BUILDDIR/mem_report.o" \
+    "$BUILDDIR/splash_cache.o" \
+    "$BUILDDIR/animator.o" \
+    "$BUILDDIR/data_feed.o" \
+    "$BUILDDIR/chart_widget.o" \
+    "$BUILDDIR/gauge_widget.o" \
+    "$BUILDDIR/log_view.o" \
+    "$BUILDDIR/tracer.o" \
+    "$BUILDDIR/dep_graph.o" \
+    "$BUILDDIR/layout_solver.o" \
+    "$BUILDDIR/power_policy.o" \
+    "$BUILDDIR/expression.o" \
+    "$BUILDDIR/binding_graph.o" \
+    "$BUILDDIR/widget_bindings.o" \
+    "$BUILDDIR/workload.o" \
+    "$BUILDDIR/poly_path.o" \
+    "$BUILDDIR/metrics.o" \
     $LDFLAGS -lm
 
-echo "Build complete: $BUILDDIR/$TARGET"
+# Headless layout validator: the same objects with its own main
+echo "  check_main.c"
+gcc $CFLAGS -c "$SRCDIR/check_main.c" -o "$BUILDDIR/check_main.o"
+gcc -o "$BUILDDIR/$TARGET-check" "$BUILDDIR/check_main.o" $CORE_OBJS $LDFLAGS -lm
+
+echo "Build complete: $BUILDDIR/$TARGET, $BUILDDIR/$TARGET-check"
@@ -0,0 +1,379 @@
+#include "animator.h"
+#include "dashboard_canvas.h"
+#include "gauge_widget.h"
+#include "power_policy.h"
+#include <string.h>
+#include <math.h>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+typedef enum {
+    ANIMATED_OPACITY,
+    ANIMATED_ROTATION,
+    ANIMATED_SCALE,
+    ANIMATED_VALUE
+} AnimatedProperty;
+
+typedef double (*EasingFunc)(double t);
+
+typedef struct {
+    GtkWidget *target;
+    AnimatedProperty property;
+    double from;
+    double to;
+    gint64 start_us;         /* On the animator's timeline */
+    gint64 duration_us;
+    int repeat;              /* -1 = forever */
+    gboolean alternate;
+    EasingFunc ease;
+    double applied;          /* Last value pushed to the target */
+    gboolean has_applied;
+} Animation;
+
+/* Rotation and scale are set on the canvas together */
+typedef struct {
+    double rotation;
+    double scale;
+} TargetTransform;
+
+struct _Animator {
+    GtkWidget *canvas;
+    GPtrArray *animations;   /* Animation*, running */
+    gint64 timeline_us;      /* Time spent unpaused */
+    gint64 last_frame_us;    /* 0 = timeline resumes on the next tick */
+    guint tick_id;           /* Every frame, or */
+    guint timer_id;          /* every timer_interval_us under a power limit */
+    gint64 timer_interval_us;
+    guint power_watch;
+    GdkSurface *surface;     /* Watched for minimization while mapped */
+    gulong state_handler;
+};
+
+static GQuark animator_quark;
+static GQuark transform_quark;
+
+/* ── Easing ──────────────────────────────────────────────── */
+
+static double ease_linear(double t) {
+    return t;
+}
+
+static double ease_in(double t) {
+    return t * t * t;
+}
+
+static double ease_out(double t) {
+    double u = 1.0 - t;
+    return 1.0 - u * u * u;
+}
+
+static double ease_in_out(double t) {
+    return t < 0.5 ? 4.0 * t * t * t : 1.0 - pow(-2.0 * t + 2.0, 3.0) / 2.0;
+}
+
+static double ease_sine(double t) {
+    return 0.5 - cos(t * M_PI) / 2.0;
+}
+
+/* Holds from for the first half and to for the second: blinking */
+static double ease_step(double t) {
+    return t < 0.5 ? 0.0 : 1.0;
+}
+
+static const struct {
+    const char *name;
+    EasingFunc func;
+} easings[] = {
+    { "linear",      ease_linear },
+    { "ease-in",     ease_in },
+    { "ease-out",    ease_out },
+    { "ease-in-out", ease_in_out },
+    { "sine",        ease_sine },
+    { "step",        ease_step },
+};
+
+static EasingFunc lookup_easing(const char *name) {
+    if (!name) return ease_linear;
+    for (guint i = 0; i < G_N_ELEMENTS(easings); i++) {
+        if (strcmp(name, easings[i].name) == 0) return easings[i].func;
+    }
+    g_warning("Unknown easing '%s', using linear", name);
+    return ease_linear;
+}
+
+static const struct {
+    const char *name;
+    AnimatedProperty property;
+} properties[] = {
+    { "opacity",  ANIMATED_OPACITY },
+    { "rotation", ANIMATED_ROTATION },
+    { "scale",    ANIMATED_SCALE },
+    { "value",    ANIMATED_VALUE },
+};
+
+static gboolean lookup_property(const char *name, AnimatedProperty *property) {
+    if (!name) return FALSE;
+    for (guint i = 0; i < G_N_ELEMENTS(properties); i++) {
+        if (strcmp(name, properties[i].name) == 0) {
+            *property = properties[i].property;
+            return TRUE;
+        }
+    }
+    return FALSE;
+}
+
+/* ── Applying values ─────────────────────────────────────── */
+
+static TargetTransform* target_transform(GtkWidget *target) {
+    TargetTransform *transform = g_object_get_qdata(G_OBJECT(target), transform_quark);
+    if (!transform) {
+        transform = g_new(TargetTransform, 1);
+        transform->rotation = 0.0;
+        transform->scale = 1.0;
+        g_object_set_qdata_full(G_OBJECT(target), transform_quark, transform, g_free);
+    }
+    return transform;
+}
+
+static void apply_value(Animator *animator, Animation *anim, double value) {
+    /* Unchanged values (e.g. a blink between toggles) invalidate nothing */
+    if (anim->has_applied && anim->applied == value) return;
+    anim->applied = value;
+    anim->has_applied = TRUE;
+
+    DashboardCanvas *canvas = DASHBOARD_CANVAS(animator->canvas);
+    TargetTransform *transform;
+
+    switch (anim->property) {
+    case ANIMATED_OPACITY:
+        dashboard_canvas_set_opacity(canvas, anim->target, CLAMP(value, 0.0, 1.0));
+        break;
+    case ANIMATED_ROTATION:
+        transform = target_transform(anim->target);
+        transform->rotation = fmod(value, 360.0);
+        dashboard_canvas_set_transform(canvas, anim->target, transform->rotation, transform->scale);
+        break;
+    case ANIMATED_SCALE:
+        transform = target_transform(anim->target);
+        transform->scale = value;
+        dashboard_canvas_set_transform(canvas, anim->target, transform->rotation, transform->scale);
+        break;
+    case ANIMATED_VALUE:
+        if (GAUGE_IS_WIDGET(anim->target)) {
+            gauge_widget_set_value(GAUGE_WIDGET(anim->target), value);
+        } else if (GTK_IS_PROGRESS_BAR(anim->target)) {
+            gtk_progress_bar_set_fraction(GTK_PROGRESS_BAR(anim->target), CLAMP(value, 0.0, 1.0));
+        } else if (GTK_IS_SPIN_BUTTON(anim->target)) {
+            gtk_spin_button_set_value(GTK_SPIN_BUTTON(anim->target), value);
+        } else if (GTK_IS_RANGE(anim->target)) {
+            gtk_range_set_value(GTK_RANGE(anim->target), value);
+        }
+        break;
+    }
+}
+
+/* Evaluate at the current timeline position. Returns FALSE once finished. */
+static gboolean step_animation(Animator *animator, Animation *anim) {
+    gint64 t = animator->timeline_us - anim->start_us;
+    if (t < 0) return TRUE;
+
+    gint64 cycle = t / anim->duration_us;
+    double progress = (double)(t % anim->duration_us) / anim->duration_us;
+    gboolean finished = anim->repeat >= 0 && cycle >= anim->repeat;
+
+    if (finished) {
+        /* Rest on the end value of the last cycle */
+        cycle = anim->repeat - 1;
+        progress = 1.0;
+    }
+    if (anim->alternate && cycle % 2 == 1) progress = 1.0 - progress;
+
+    apply_value(animator, anim, anim->from + (anim->to - anim->from) * anim->ease(progress));
+    return !finished;
+}
+
+/* ── Timeline ────────────────────────────────────────────── */
+
+/* FALSE once no animation is left */
+static gboolean advance(Animator *animator, gint64 now) {
+    if (animator->last_frame_us != 0) {
+        animator->timeline_us += now - animator->last_frame_us;
+    }
+    animator->last_frame_us = now;
+
+    for (guint i = 0; i < animator->animations->len; ) {
+        Animation *anim = g_ptr_array_index(animator->animations, i);
+        if (step_animation(animator, anim)) {
+            i++;
+        } else {
+            g_ptr_array_remove_index_fast(animator->animations, i);
+        }
+    }
+
+    return animator->animations->len > 0;
+}
+
+static gboolean on_tick(GtkWidget *widget, GdkFrameClock *frame_clock, gpointer user_data) {
+    Animator *animator = (Animator *)user_data;
+
+    if (!advance(animator, gdk_frame_clock_get_frame_time(frame_clock))) {
+        animator->tick_id = 0;
+        return G_SOURCE_REMOVE;
+    }
+    return G_SOURCE_CONTINUE;
+}
+
+static gboolean on_timer(gpointer user_data) {
+    Animator *animator = (Animator *)user_data;
+
+    if (!advance(animator, g_get_monotonic_time())) {
+        animator->timer_id = 0;
+        return G_SOURCE_REMOVE;
+    }
+    return G_SOURCE_CONTINUE;
+}
+
+static gboolean is_minimized(Animator *animator) {
+    return animator->surface && GDK_IS_TOPLEVEL(animator->surface) &&
+           (gdk_toplevel_get_state(GDK_TOPLEVEL(animator->surface)) & GDK_TOPLEVEL_STATE_MINIMIZED);
+}
+
+static void stop_running(Animator *animator) {
+    if (animator->tick_id) {
+        gtk_widget_remove_tick_callback(animator->canvas, animator->tick_id);
+        animator->tick_id = 0;
+    }
+    if (animator->timer_id) {
+        g_source_remove(animator->timer_id);
+        animator->timer_id = 0;
+    }
+}
+
+/* Tick only while there is something to animate on screen: every frame,
+ * or on a timer at the power policy's rate */
+static void update_running(Animator *animator) {
+    gboolean run = animator->animations->len > 0 && gtk_widget_get_mapped(animator->canvas) &&
+                   !is_minimized(animator) && power_policy_get_state() != POWER_STATE_PAUSED;
+    gint64 interval = run ? power_policy_get_frame_interval() : 0;
+
+    gboolean current = interval > 0 ? animator->timer_id && animator->timer_interval_us == interval
+                                    : animator->tick_id != 0;
+    if (run && current) return;
+
+    stop_running(animator);
+    if (!run) return;
+
+    animator->last_frame_us = 0;
+    if (interval > 0) {
+        animator->timer_interval_us = interval;
+        animator->timer_id = g_timeout_add((guint)(interval / 1000), on_timer, animator);
+    } else {
+        animator->tick_id = gtk_widget_add_tick_callback(animator->canvas, on_tick, animator, NULL);
+    }
+}
+
+static void on_surface_state(GObject *surface, GParamSpec *pspec, gpointer user_data) {
+    update_running((Animator *)user_data);
+}
+
+static void on_power_changed(gpointer user_data) {
+    update_running((Animator *)user_data);
+}
+
+static void on_map(GtkWidget *widget, gpointer user_data) {
+    Animator *animator = (Animator *)user_data;
+
+    GtkNative *native = gtk_widget_get_native(widget);
+    animator->surface = native ? g_object_ref(gtk_native_get_surface(native)) : NULL;
+    if (animator->surface) {
+        animator->state_handler = g_signal_connect(animator->surface, "notify::state",
+                                                   G_CALLBACK(on_surface_state), animator);
+    }
+    update_running(animator);
+}
+
+static void unwatch_surface(Animator *animator) {
+    if (!animator->surface) return;
+    g_signal_handler_disconnect(animator->surface, animator->state_handler);
+    g_clear_object(&animator->surface);
+    animator->state_handler = 0;
+}
+
+static void on_unmap(GtkWidget *widget, gpointer user_data) {
+    Animator *animator = (Animator *)user_data;
+    unwatch_surface(animator);
+    update_running(animator);
+}
+
+/* ── Public API ──────────────────────────────────────────── */
+
+static void animator_free(gpointer data) {
+    Animator *animator = (Animator *)data;
+
+    /* The canvas is being finalized: its tick callbacks and handlers are gone */
+    unwatch_surface(animator);
+    if (animator->timer_id) g_source_remove(animator->timer_id);
+    power_policy_unwatch(animator->power_watch);
+    g_ptr_array_free(animator->animations, TRUE);
+    g_free(animator);
+}
+
+Animator* animator_get(GtkWidget *canvas) {
+    g_return_val_if_fail(DASHBOARD_IS_CANVAS(canvas), NULL);
+
+    if (!animator_quark) {
+        animator_quark = g_quark_from_static_string("dashboard-animator");
+        transform_quark = g_quark_from_static_string("dashboard-animator-transform");
+    }
+
+    Animator *animator = g_object_get_qdata(G_OBJECT(canvas), animator_quark);
+    if (animator) return animator;
+
+    animator = g_new0(Animator, 1);
+    animator->canvas = canvas;
+    animator->animations = g_ptr_array_new_with_free_func(g_free);
+    g_object_set_qdata_full(G_OBJECT(canvas), animator_quark, animator, animator_free);
+
+    g_signal_connect(canvas, "map", G_CALLBACK(on_map), animator);
+    g_signal_connect(canvas, "unmap", G_CALLBACK(on_unmap), animator);
+    animator->power_watch = power_policy_watch(on_power_changed, animator);
+    return animator;
+}
+
+void animator_add(Animator *animator, GtkWidget *child, const WidgetConfig *config) {
+    for (GList *l = config->animations; l != NULL; l = l->next) {
+        AnimationConfig *aconfig = (AnimationConfig *)l->data;
+
+        AnimatedProperty property;
+        if (!lookup_property(aconfig->property, &property)) {
+            g_warning("Widget '%s': unknown animated property '%s'",
+                      config->id ? config->id : "(no id)",
+                      aconfig->property ? aconfig->property : "(null)");
+            continue;
+        }
+        if (aconfig->repeat == 0) continue;
+
+        Animation *anim = g_new0(Animation, 1);
+        anim->target = child;
+        anim->property = property;
+        anim->from = aconfig->from;
+        anim->to = aconfig->to;
+        anim->start_us = animator->timeline_us + (gint64)MAX(aconfig->delay_ms, 0) * 1000;
+        anim->duration_us = (gint64)MAX(aconfig->duration_ms, 1) * 1000;
+        anim->repeat = aconfig->repeat;
+        anim->alternate = aconfig->alternate;
+        anim->ease = lookup_easing(aconfig->easing);
+        g_ptr_array_add(animator->animations, anim);
+
+        /* Show the start value from the first frame, even while delayed */
+        apply_value(animator, anim, anim->from);
+    }
+
+    update_running(animator);
+}
+
+guint animator_get_active(Animator *animator) {
+    return animator ? animator->animations->len : 0;
+}
@@ -0,0 +1,33 @@
+#ifndef ANIMATOR_H
+#define ANIMATOR_H
+
+#include <gtk/gtk.h>
+#include "json_parser.h"
+
+/*
+ * Declarative animations of dashboard elements.
+ *
+ * One animator per DashboardCanvas drives every animation of its children
+ * from a single frame-clock tick callback, evaluating each animation on a
+ * shared timeline through an easing table. Only elements whose animated
+ * value actually changed are invalidated: rotation and scale go through
+ * the canvas as render-node transforms, opacity through the canvas as
+ * well, and "value" through the widget (Progress, Slider, Spin, Gauge). The
+ * timeline is paused while the canvas is unmapped, its window is
+ * minimized or the power policy pauses everything, and resumes where it
+ * stopped. Under a power policy frame limit it advances on a timer at
+ * that rate instead of every frame.
+ */
+
+typedef struct _Animator Animator;
+
+/* Owned by canvas (a DashboardCanvas): freed with it */
+Animator* animator_get(GtkWidget *canvas);
+
+/* Start the animations of config on child, a child of the animator's canvas */
+void animator_add(Animator *animator, GtkWidget *child, const WidgetConfig *config);
+
+/* Animations still running */
+guint animator_get_active(Animator *animator);
+
+#endif /* ANIMATOR_H */
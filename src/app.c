@@ -2,8 +2,29 @@
 #include "widget_factory.h"
 #include "shape_renderer.h"
 #include "style_manager.h"
+#include "profiler.h"
+#include "frame_hud.h"
+#include "scene_manager.h"
+#include "resource_cache.h"
+#include "scale_bin.h"
+#include "dashboard_canvas.h"
+#include "mem_report.h"
+#include "splash_cache.h"
+#include "animator.h"
+#include "data_feed.h"
+#include "tracer.h"
+#include "layout_solver.h"
+#include "power_policy.h"
+#include "widget_bindings.h"
+#include "workload.h"
+#include "metrics.h"
 #include <string.h>
 
+/* Cross-fade from the splash image to the live dashboard */
+#define SPLASH_FADE_US (300 * 1000)
+/* Delay before the live dashboard is stored as the next splash */
+#define SPLASH_SAVE_DELAY_S 2
+
 /*
  * Known Limitations (WSL2/WSLg):
  *
@@ -17,12 +38,12 @@
  */
 
 /* Forward declarations */
-static void show_properties_dialog(DashboardApp *app);
-static void toggle_fullscreen(DashboardApp *app);
+static void show_properties_dialog(DashboardWindow *win);
+static void toggle_fullscreen(DashboardWindow *win);
 
 /* Dialog data structure */
 typedef struct {
-    DashboardApp *app;
+    DashboardWindow *win;
     GtkWidget *dialog;
     GtkWidget *radio_fullscreen;
 } DialogData;
@@ -33,18 +54,38 @@ static void on_ok_clicked(GtkButton *button, gpointer user_data) {
 
     gboolean want_fullscreen = gtk_check_button_get_active(
         GTK_CHECK_BUTTON(data->radio_fullscreen));
-    if (want_fullscreen && !data->app->is_fullscreen) {
-        gtk_window_fullscreen(GTK_WINDOW(data->app->main_window));
-        data->app->is_fullscreen = TRUE;
-    } else if (!want_fullscreen && data->app->is_fullscreen) {
-        gtk_window_unfullscreen(GTK_WINDOW(data->app->main_window));
-        data->app->is_fullscreen = FALSE;
+    if (want_fullscreen != data->win->is_fullscreen) {
+        toggle_fullscreen(data->win);
     }
 
     gtk_window_destroy(GTK_WINDOW(data->dialog));
     g_free(data);
 }
 
+/* Show the memory report in its own window */
+static void on_mem_report_clicked(GtkButton *button, gpointer user_data) {
+    DialogData *data = (DialogData *)user_data;
+
+    char *report = mem_report_build(data->win->app);
+
+    GtkWidget *window = gtk_window_new();
+    gtk_window_set_title(GTK_WINDOW(window), "Memory Report");
+    gtk_window_set_transient_for(GTK_WINDOW(window), GTK_WINDOW(data->win->window));
+    gtk_window_set_default_size(GTK_WINDOW(window), 520, 640);
+
+    GtkWidget *text_view = gtk_text_view_new();
+    gtk_text_view_set_editable(GTK_TEXT_VIEW(text_view), FALSE);
+    gtk_text_view_set_monospace(GTK_TEXT_VIEW(text_view), TRUE);
+    gtk_text_buffer_set_text(gtk_text_view_get_buffer(GTK_TEXT_VIEW(text_view)), report, -1);
+
+    GtkWidget *scrolled = gtk_scrolled_window_new();
+    gtk_scrolled_window_set_child(GTK_SCROLLED_WINDOW(scrolled), text_view);
+    gtk_window_set_child(GTK_WINDOW(window), scrolled);
+
+    gtk_window_present(GTK_WINDOW(window));
+    g_free(report);
+}
+
 /* Cancel button clicked handler */
 static void on_cancel_clicked(GtkButton *button, gpointer user_data) {
     DialogData *data = (DialogData *)user_data;
@@ -53,10 +94,10 @@ static void on_cancel_clicked(GtkButton *button, gpointer user_data) {
 }
 
 /* Properties dialog display */
-static void show_properties_dialog(DashboardApp *app) {
+static void show_properties_dialog(DashboardWindow *win) {
     GtkWidget *dialog = gtk_window_new();
     gtk_window_set_title(GTK_WINDOW(dialog), "Properties");
-    gtk_window_set_transient_for(GTK_WINDOW(dialog), GTK_WINDOW(app->main_window));
+    gtk_window_set_transient_for(GTK_WINDOW(dialog), GTK_WINDOW(win->window));
     gtk_window_set_modal(GTK_WINDOW(dialog), TRUE);
     gtk_window_set_resizable(GTK_WINDOW(dialog), FALSE);
 
@@ -72,7 +113,7 @@ static void show_properties_dialog(DashboardApp *app) {
                                GTK_CHECK_BUTTON(radio_window));
 
     gtk_check_button_set_active(
-        GTK_CHECK_BUTTON(app->is_fullscreen ? radio_fullscreen : radio_window), TRUE);
+        GTK_CHECK_BUTTON(win->is_fullscreen ? radio_fullscreen : radio_window), TRUE);
 
     gtk_box_append(GTK_BOX(main_box), radio_window);
     gtk_box_append(GTK_BOX(main_box), radio_fullscreen);
@@ -81,10 +122,12 @@ static void show_properties_dialog(DashboardApp *app) {
     gtk_widget_set_halign(button_box, GTK_ALIGN_END);
     gtk_widget_set_margin_top(button_box, 10);
 
+    GtkWidget *mem_button = gtk_button_new_with_label("Memory Report...");
     GtkWidget *cancel_button = gtk_button_new_with_label("Cancel");
     GtkWidget *ok_button = gtk_button_new_with_label("OK");
     gtk_widget_add_css_class(ok_button, "suggested-action");
 
+    gtk_box_append(GTK_BOX(button_box), mem_button);
     gtk_box_append(GTK_BOX(button_box), cancel_button);
     gtk_box_append(GTK_BOX(button_box), ok_button);
     gtk_box_append(GTK_BOX(main_box), button_box);
@@ -92,78 +135,193 @@ static void show_properties_dialog(DashboardApp *app) {
     gtk_window_set_child(GTK_WINDOW(dialog), main_box);
 
     DialogData *data = g_new(DialogData, 1);
-    data->app = app;
+    data->win = win;
     data->dialog = dialog;
     data->radio_fullscreen = radio_fullscreen;
 
     g_signal_connect(ok_button, "clicked", G_CALLBACK(on_ok_clicked), data);
+    g_signal_connect(mem_button, "clicked", G_CALLBACK(on_mem_report_clicked), data);
     g_signal_connect(cancel_button, "clicked", G_CALLBACK(on_cancel_clicked), data);
 
     gtk_window_present(GTK_WINDOW(dialog));
 }
 
+/* Monitor by index on the default display, or NULL */
+static GdkMonitor* get_monitor(int index) {
+    if (index < 0) return NULL;
+
+    GListModel *monitors = gdk_display_get_monitors(gdk_display_get_default());
+    GdkMonitor *monitor = g_list_model_get_item(monitors, index);
+    if (monitor) g_object_unref(monitor);  /* The list keeps it alive */
+    return monitor;
+}
+
 /* Toggle fullscreen mode */
-static void toggle_fullscreen(DashboardApp *app) {
-    if (app->is_fullscreen) {
-        gtk_window_unfullscreen(GTK_WINDOW(app->main_window));
-        app->is_fullscreen = FALSE;
+static void toggle_fullscreen(DashboardWindow *win) {
+    if (win->is_fullscreen) {
+        gtk_window_unfullscreen(GTK_WINDOW(win->window));
+        win->is_fullscreen = FALSE;
     } else {
-        gtk_window_fullscreen(GTK_WINDOW(app->main_window));
-        app->is_fullscreen = TRUE;
+        GdkMonitor *monitor = get_monitor(win->monitor);
+        if (monitor) {
+            gtk_window_fullscreen_on_monitor(GTK_WINDOW(win->window), monitor);
+        } else {
+            gtk_window_fullscreen(GTK_WINDOW(win->window));
+        }
+        win->is_fullscreen = TRUE;
     }
 }
 
 /* Key event handler */
-static gboolean on_key_pressed(GtkEventControllerKey *controller,
-                               guint keyval,
-                               guint keycode,
-                               GdkModifierType state_flags,
-                               gpointer data) {
-    DashboardApp *app = (DashboardApp *)data;
+static gboolean handle_key(DashboardWindow *win, guint keyval, GdkModifierType state_flags) {
 
     if (keyval == GDK_KEY_F12) {
         if (state_flags & GDK_CONTROL_MASK) {
-            toggle_fullscreen(app);
+            toggle_fullscreen(win);
+        } else if (state_flags & GDK_SHIFT_MASK) {
+            frame_hud_toggle(win->hud);
         } else {
-            show_properties_dialog(app);
+            show_properties_dialog(win);
         }
         return TRUE;
     }
+
+    /* Scene switching */
+    if (win->scenes && keyval == GDK_KEY_Page_Down) {
+        scene_manager_next(win->scenes);
+        return TRUE;
+    }
+    if (win->scenes && keyval == GDK_KEY_Page_Up) {
+        scene_manager_previous(win->scenes);
+        return TRUE;
+    }
     return FALSE;
 }
 
+static gboolean on_key_pressed(GtkEventControllerKey *controller,
+                               guint keyval,
+                               guint keycode,
+                               GdkModifierType state_flags,
+                               gpointer data) {
+    DashboardWindow *win = (DashboardWindow *)data;
+    tracer_begin("key_pressed", NULL);
+    gboolean handled = handle_key(win, keyval, state_flags);
+    if (handled) workload_record_key(win->window, keyval, state_flags);
+    tracer_end("key_pressed");
+    return handled;
+}
+
+/* Replayed keys take the same path as typed ones */
+static void on_replay_key(GtkWidget *window, guint keyval, GdkModifierType state,
+                          gpointer user_data) {
+    DashboardApp *app = (DashboardApp *)user_data;
+    for (guint i = 0; i < app->windows->len; i++) {
+        DashboardWindow *win = g_ptr_array_index(app->windows, i);
+        if (win->window == window) handle_key(win, keyval, state);
+    }
+}
+
 /* Callback for delayed fullscreen */
 static gboolean apply_fullscreen(gpointer user_data) {
-    DashboardApp *app = (DashboardApp *)user_data;
-    gtk_window_fullscreen(GTK_WINDOW(app->main_window));
-    gtk_widget_grab_focus(app->main_window);
+    DashboardWindow *win = (DashboardWindow *)user_data;
+    win->fullscreen_source = 0;
+    win->is_fullscreen = FALSE;
+    toggle_fullscreen(win);
+    gtk_widget_grab_focus(win->window);
     return G_SOURCE_REMOVE;
 }
 
-/* Build dashboard from layout config */
-static void build_dashboard(DashboardApp *app) {
-    if (!app->layout) return;
+static gboolean widget_in_region(const WidgetConfig *wconfig, const GdkRectangle *region) {
+    GdkRectangle bounds = { wconfig->x, wconfig->y, wconfig->width, wconfig->height };
+    return gdk_rectangle_intersect(&bounds, region, NULL);
+}
+
+static void on_layout_moved(gpointer item, int x, int y, int width, int height,
+                            gpointer user_data) {
+    DashboardCanvas *canvas = DASHBOARD_CANVAS(user_data);
+    GtkWidget *widget = GTK_WIDGET(item);
+    WidgetConfig *wconfig = g_object_get_data(G_OBJECT(widget), "widget-config");
+
+    /* Everything sized from the config at load time follows: the size
+     * request (which would keep a shrunk widget at its old size), a shape's
+     * path and shadow, and the opaque area used for culling */
+    WidgetConfig sized = *wconfig;
+    sized.width = width;
+    sized.height = height;
+    GdkRectangle opaque;
+    gboolean has_opaque;
+    if (is_shape_type(wconfig->type)) {
+        shape_renderer_set_size(widget, width, height);
+        has_opaque = shape_renderer_get_opaque_rect(&sized, &opaque);
+    } else {
+        gtk_widget_set_size_request(widget, width, height);
+        has_opaque = widget_factory_get_opaque_rect(&sized, &opaque);
+    }
+    dashboard_canvas_set_opaque(canvas, widget, has_opaque ? &opaque : NULL);
+    dashboard_canvas_move(canvas, widget, x, y, width, height);
+}
+
+static void on_canvas_resize(DashboardCanvas *canvas, int width, int height, gpointer user_data) {
+    layout_solver_set_window_size((LayoutSolver *)user_data, width, height);
+}
 
-    StyleManager *style_mgr = style_manager_new();
+/* Solver for widgets with relative or bound geometry, NULL if there are none */
+static LayoutSolver* create_layout_solver(GList *widgets) {
+    for (GList *l = widgets; l != NULL; l = l->next) {
+        WidgetConfig *wconfig = (WidgetConfig *)l->data;
+        if (!wconfig->constraints && !layout_solver_has_geometry_bindings(wconfig)) continue;
 
-    /* Apply window background if specified */
-    if (app->layout->window.background_color) {
-        style_manager_add_window_style(style_mgr, app->layout->window.background_color);
+        GError *error = NULL;
+        LayoutSolver *solver = layout_solver_new(widgets, &error);
+        if (!solver) {
+            g_warning("Relative geometry disabled: %s", error->message);
+            g_error_free(error);
+        }
+        return solver;
     }
+    return NULL;
+}
+
+/* Create the absolute-positioned container with every widget and shape of
+ * a WidgetConfig list that lies inside region (NULL = all of them). */
+GtkWidget* dashboard_build_widgets(GList *widgets, const GdkRectangle *region) {
+    tracer_begin("build_widgets", NULL);
 
-    /* Create GtkFixed container for absolute positioning */
-    app->fixed_container = gtk_fixed_new();
-    gtk_window_set_child(GTK_WINDOW(app->main_window), app->fixed_container);
+    /* Absolute positioning straight from the configured geometry */
+    GtkWidget *canvas = dashboard_canvas_new();
+    int offset_x = region ? region->x : 0;
+    int offset_y = region ? region->y : 0;
+
+    /* Relative geometry follows the canvas size, except in a region of a
+     * larger layout, which keeps the geometry solved for its design size */
+    LayoutSolver *solver = region ? NULL : create_layout_solver(widgets);
+    WidgetBindings *bindings = widget_bindings_new(widgets);
 
     /* Create widgets from config */
-    for (GList *l = app->layout->widgets; l != NULL; l = l->next) {
+    for (GList *l = widgets; l != NULL; l = l->next) {
         WidgetConfig *wconfig = (WidgetConfig *)l->data;
+        if (region && !widget_in_region(wconfig, region)) continue;
+
+        gint64 widget_start = g_get_monotonic_time();
+        GdkRectangle opaque;
 
         if (is_shape_type(wconfig->type)) {
             /* Shape types: render with Cairo drawing area */
             GtkWidget *shape = shape_renderer_create(wconfig);
             if (shape) {
-                gtk_fixed_put(GTK_FIXED(app->fixed_container), shape, wconfig->x, wconfig->y);
+                g_object_set_data(G_OBJECT(shape), "widget-config", wconfig);
+                dashboard_canvas_put(DASHBOARD_CANVAS(canvas), shape, wconfig->x - offset_x,
+                                     wconfig->y - offset_y, wconfig->width, wconfig->height);
+                if (shape_renderer_get_opaque_rect(wconfig, &opaque)) {
+                    dashboard_canvas_set_opaque(DASHBOARD_CANVAS(canvas), shape, &opaque);
+                }
+                if (shape_renderer_has_shadow(wconfig)) {
+                    dashboard_canvas_set_shadow(DASHBOARD_CANVAS(canvas), shape,
+                                                shape_renderer_get_shadow);
+                }
+                if (solver) layout_solver_bind(solver, wconfig, shape);
+                if (bindings) widget_bindings_add(bindings, wconfig, shape);
+                if (wconfig->animations) animator_add(animator_get(canvas), shape, wconfig);
             } else {
                 g_warning("Failed to create shape '%s' (type: %s)",
                           wconfig->id ? wconfig->id : "(no id)",
@@ -174,12 +332,16 @@ static void build_dashboard(DashboardApp *app) {
             GError *error = NULL;
             GtkWidget *widget = widget_factory_create(wconfig, &error);
             if (widget) {
-                gtk_fixed_put(GTK_FIXED(app->fixed_container), widget, wconfig->x, wconfig->y);
-
-                /* Add widget-specific CSS (not for shapes) */
-                if (wconfig->style && wconfig->id) {
-                    style_manager_add_widget_style(style_mgr, wconfig->id, wconfig->style);
+                g_object_set_data(G_OBJECT(widget), "widget-config", wconfig);
+                dashboard_canvas_put(DASHBOARD_CANVAS(canvas), widget, wconfig->x - offset_x,
+                                     wconfig->y - offset_y, wconfig->width, wconfig->height);
+                if (widget_factory_get_opaque_rect(wconfig, &opaque)) {
+                    dashboard_canvas_set_opaque(DASHBOARD_CANVAS(canvas), widget, &opaque);
                 }
+                if (solver) layout_solver_bind(solver, wconfig, widget);
+                if (bindings) widget_bindings_add(bindings, wconfig, widget);
+                workload_add_widget(wconfig, widget);
+                if (wconfig->animations) animator_add(animator_get(canvas), widget, wconfig);
             } else {
                 g_warning("Failed to create widget '%s': %s",
                           wconfig->id ? wconfig->id : "(no id)",
@@ -187,59 +349,459 @@ static void build_dashboard(DashboardApp *app) {
                 g_clear_error(&error);
             }
         }
+
+        profiler_record_widget(wconfig->type, wconfig->id, widget_start, g_get_monotonic_time());
     }
 
-    /* Apply all CSS */
-    style_manager_apply(style_mgr);
-    style_manager_free(style_mgr);
+    if (solver) {
+        layout_solver_set_moved_func(solver, on_layout_moved, canvas);
+        dashboard_canvas_set_resize_func(DASHBOARD_CANVAS(canvas), on_canvas_resize, solver,
+                                         (GDestroyNotify)layout_solver_free);
+    }
+    if (bindings) {
+        widget_bindings_set_solver(bindings, solver);
+        widget_bindings_attach(bindings, canvas);
+    }
+
+    tracer_end("build_widgets");
+    return canvas;
 }
 
-/* Activate callback */
-static void on_activate(GtkApplication *gtk_app, gpointer user_data) {
+/* Add the CSS of every widget (not shapes) of a WidgetConfig list */
+void dashboard_collect_styles(GList *widgets, StyleManager *style_mgr) {
+    /* Shared styles become one class rule instead of a rule per widget */
+    GHashTable *classes = g_hash_table_new(g_str_hash, g_str_equal);
+
+    for (GList *l = widgets; l != NULL; l = l->next) {
+        WidgetConfig *wconfig = (WidgetConfig *)l->data;
+        if (is_shape_type(wconfig->type) || !wconfig->style) continue;
+
+        if (wconfig->style_class) {
+            if (g_hash_table_add(classes, wconfig->style_class)) {
+                style_manager_add_class_style(style_mgr, wconfig->style_class, wconfig->style);
+            }
+        } else if (wconfig->id) {
+            style_manager_add_widget_style(style_mgr, wconfig->id, wconfig->style);
+        }
+    }
+    g_hash_table_destroy(classes);
+}
+
+/* Build a window's dashboard from its layout config */
+static void build_dashboard(DashboardWindow *win, const GdkRectangle *region) {
+    if (!win->layout) return;
+    tracer_begin("build_dashboard", NULL);
+
+    /* Windows showing the same layout share one style provider */
+    gboolean created;
+    StyleManager *style_mgr = resource_cache_acquire_styles(win->layout, &created);
+
+    if (win->layout->scenes) {
+        /* Multi-scene layout: one stack page per scene */
+        win->scenes = scene_manager_new(win->layout);
+        win->container = scene_manager_get_widget(win->scenes);
+    } else {
+        win->container = dashboard_build_widgets(win->layout->widgets, region);
+    }
+
+    /* Scale-to-fit: the layout keeps its design size behind one transform */
+    if (win->layout->window.scale_to_fit) {
+        int design_width = region ? region->width : win->layout->window.width;
+        int design_height = region ? region->height : win->layout->window.height;
+        win->container = scale_bin_new(win->container, design_width, design_height);
+    }
+    gtk_widget_set_name(win->container, style_mgr->scope);
+    gtk_overlay_set_child(GTK_OVERLAY(win->overlay), win->container);
+
+    if (created) {
+        /* Apply window background if specified */
+        if (win->layout->window.background_color) {
+            style_manager_add_window_style(style_mgr, win->layout->window.background_color);
+        }
+        dashboard_collect_styles(win->layout->widgets, style_mgr);
+
+        /* Apply all CSS */
+        profiler_phase_begin("style_apply");
+        style_manager_apply(style_mgr);
+        profiler_phase_end("style_apply");
+    }
+    tracer_end("build_dashboard");
+}
+
+/* First frame presented: close the startup profile */
+static void on_first_frame(GdkFrameClock *frame_clock, gpointer user_data) {
     DashboardApp *app = (DashboardApp *)user_data;
 
-    /* Create main window */
-    app->main_window = gtk_application_window_new(gtk_app);
+    g_signal_handler_disconnect(frame_clock, app->first_frame_handler);
+    app->first_frame_handler = 0;
+
+    profiler_phase_end("first_frame");
+    profiler_report();
+
+    if (app->mem_report) {
+        char *report = mem_report_build(app);
+        g_print("%s\n", report);
+        g_free(report);
+    }
+}
+
+/* Store the live dashboard as the splash for the next launch */
+static gboolean save_splash(gpointer user_data) {
+    DashboardWindow *win = (DashboardWindow *)user_data;
+    win->splash_save_source = 0;
+    splash_cache_save(win->container, win->splash_path);
+    return G_SOURCE_REMOVE;
+}
+
+/* Give fullscreen and the first data updates time to settle */
+static void schedule_splash_save(DashboardWindow *win) {
+    if (!win->splash_path || !win->container) return;
+    win->splash_save_source = g_timeout_add_seconds(SPLASH_SAVE_DELAY_S, save_splash, win);
+}
+
+/* Drives a window that started from a splash image: build the widgets
+ * behind it once it is on screen, then fade it out */
+static gboolean on_splash_tick(GtkWidget *widget, GdkFrameClock *frame_clock, gpointer user_data) {
+    DashboardWindow *win = (DashboardWindow *)user_data;
+
+    /* Let the splash reach the screen first */
+    if (win->splash_frames++ == 0) return G_SOURCE_CONTINUE;
+
+    if (!win->container) {
+        profiler_phase_begin("build_behind_splash");
+        build_dashboard(win, win->has_region ? &win->region : NULL);
+        profiler_phase_end("build_behind_splash");
+        return G_SOURCE_CONTINUE;
+    }
+
+    gint64 now = gdk_frame_clock_get_frame_time(frame_clock);
+    if (win->fade_start == 0) win->fade_start = now;
+
+    double progress = (double)(now - win->fade_start) / SPLASH_FADE_US;
+    if (progress < 1.0) {
+        gtk_widget_set_opacity(win->splash, 1.0 - progress);
+        return G_SOURCE_CONTINUE;
+    }
+
+    gtk_overlay_remove_overlay(GTK_OVERLAY(win->overlay), win->splash);
+    win->splash = NULL;
+    win->splash_tick = 0;
+    schedule_splash_save(win);
+    return G_SOURCE_REMOVE;
+}
+
+static void dashboard_window_free(gpointer data) {
+    DashboardWindow *win = (DashboardWindow *)data;
+
+    if (win->fullscreen_source) g_source_remove(win->fullscreen_source);
+    if (win->splash_save_source) g_source_remove(win->splash_save_source);
+    if (win->splash_tick) gtk_widget_remove_tick_callback(win->window, win->splash_tick);
+    g_free(win->splash_path);
+    scene_manager_free(win->scenes);
+    if (win->layout) resource_cache_release_styles(win->layout);
+    g_free(win);
+}
+
+static void on_window_destroy(GtkWidget *widget, gpointer user_data) {
+    DashboardWindow *win = (DashboardWindow *)user_data;
+    g_ptr_array_remove(win->app->windows, win);
+}
+
+/* Create, build and present one window. output may be NULL for the
+ * default single window showing the app's layout. */
+static DashboardWindow* open_window(DashboardApp *app, const OutputConfig *output, int index) {
+    DashboardWindow *win = g_new0(DashboardWindow, 1);
+    win->app = app;
+    win->layout = app->layout;
+    win->monitor = output ? output->monitor : -1;
+
+    if (output && output->file) {
+        GError *error = NULL;
+        win->layout = resource_cache_load_layout(output->file, &error);
+        if (!win->layout) {
+            g_warning("Failed to load window layout '%s': %s", output->file, error->message);
+            g_clear_error(&error);
+        }
+    }
+
+    win->has_region = output && output->has_region;
+    if (win->has_region) {
+        win->region = (GdkRectangle){ output->region_x, output->region_y,
+                                      output->region_width, output->region_height };
+    }
+    gboolean fullscreen = !output || output->fullscreen;
+
+    /* Create the window */
+    win->window = gtk_application_window_new(app->app);
 
     /* Set window title from config or default */
     const char *title = "Dashboard Control Panel";
-    if (app->layout && app->layout->window.title) {
-        title = app->layout->window.title;
+    if (output && output->title) {
+        title = output->title;
+    } else if (win->layout && win->layout->window.title) {
+        title = win->layout->window.title;
     }
-    gtk_window_set_title(GTK_WINDOW(app->main_window), title);
+    gtk_window_set_title(GTK_WINDOW(win->window), title);
 
-    /* Set window size from config or default */
+    /* Set window size from region, config or default */
     int win_width = 1024, win_height = 768;
-    if (app->layout) {
-        if (app->layout->window.width > 0) win_width = app->layout->window.width;
-        if (app->layout->window.height > 0) win_height = app->layout->window.height;
+    if (win->has_region) {
+        win_width = win->region.width;
+        win_height = win->region.height;
+    } else if (win->layout) {
+        if (win->layout->window.width > 0) win_width = win->layout->window.width;
+        if (win->layout->window.height > 0) win_height = win->layout->window.height;
+    }
+    gtk_window_set_default_size(GTK_WINDOW(win->window), win_width, win_height);
+
+    /* Overlay: dashboard below, then the splash image, frame-timing HUD on top */
+    win->overlay = gtk_overlay_new();
+    gtk_window_set_child(GTK_WINDOW(win->window), win->overlay);
+
+    /* Last frame of this layout at this size, if there is one */
+    int splash_width = win_width, splash_height = win_height;
+    if (fullscreen) {
+        GdkMonitor *monitor = get_monitor(win->monitor >= 0 ? win->monitor : 0);
+        if (monitor) {
+            GdkRectangle geometry;
+            gdk_monitor_get_geometry(monitor, &geometry);
+            splash_width = geometry.width;
+            splash_height = geometry.height;
+        }
+    }
+    win->splash_path = splash_cache_path(app->layout_file, output ? output->file : NULL,
+                                         index, splash_width, splash_height);
+    /* --mem-report measures the built dashboard at the first frame */
+    GdkTexture *splash = app->mem_report ? NULL : splash_cache_load(win->splash_path);
+    if (splash) {
+        win->splash = gtk_picture_new_for_paintable(GDK_PAINTABLE(splash));
+        gtk_picture_set_content_fit(GTK_PICTURE(win->splash), GTK_CONTENT_FIT_FILL);
+        gtk_widget_set_can_target(win->splash, FALSE);
+        gtk_overlay_add_overlay(GTK_OVERLAY(win->overlay), win->splash);
+        g_object_unref(splash);
     }
-    gtk_window_set_default_size(GTK_WINDOW(app->main_window), win_width, win_height);
 
-    /* Build the dashboard UI */
-    build_dashboard(app);
+    win->hud = frame_hud_new(win->window);
+    gtk_overlay_add_overlay(GTK_OVERLAY(win->overlay), frame_hud_get_widget(win->hud));
+
+    /* Build the dashboard UI now, or behind the splash once it is shown */
+    if (win->splash) {
+        win->splash_tick = gtk_widget_add_tick_callback(win->window, on_splash_tick, win, NULL);
+    } else {
+        build_dashboard(win, win->has_region ? &win->region : NULL);
+        schedule_splash_save(win);
+    }
 
     /* Setup key event controller */
     GtkEventController *key_controller = gtk_event_controller_key_new();
-    g_signal_connect(key_controller, "key-pressed", G_CALLBACK(on_key_pressed), app);
-    gtk_widget_add_controller(app->main_window, key_controller);
+    g_signal_connect(key_controller, "key-pressed", G_CALLBACK(on_key_pressed), win);
+    gtk_widget_add_controller(win->window, key_controller);
+
+    g_ptr_array_add(app->windows, win);
+    g_signal_connect(win->window, "destroy", G_CALLBACK(on_window_destroy), win);
+    power_policy_add_window(win->window);
+    workload_add_window(win->window);
+    metrics_add_window(win->window);
 
-    /* Show window */
-    gtk_window_present(GTK_WINDOW(app->main_window));
+    gtk_window_present(GTK_WINDOW(win->window));
 
     /* Apply fullscreen with delay */
-    app->is_fullscreen = TRUE;
-    g_idle_add(apply_fullscreen, app);
+    if (fullscreen) {
+        win->fullscreen_source = g_idle_add(apply_fullscreen, win);
+    }
+
+    return win;
+}
+
+/* Open the windows of the current layout: one per output, or a single one */
+static void open_windows(DashboardApp *app) {
+    if (app->layout && app->layout->outputs) {
+        int index = 0;
+        for (GList *l = app->layout->outputs; l != NULL; l = l->next, index++) {
+            open_window(app, (OutputConfig *)l->data, index);
+        }
+    } else {
+        open_window(app, NULL, 0);
+    }
+}
+
+/* Activate callback */
+static void on_activate(GtkApplication *gtk_app, gpointer user_data) {
+    DashboardApp *app = (DashboardApp *)user_data;
+
+    /* Activation of a running instance just raises the existing windows */
+    if (app->windows->len > 0) {
+        for (guint i = 0; i < app->windows->len; i++) {
+            DashboardWindow *win = g_ptr_array_index(app->windows, i);
+            gtk_window_present(GTK_WINDOW(win->window));
+        }
+        return;
+    }
+
+    /* Build the dashboard UI */
+    metrics_start();
+    profiler_phase_begin("build_dashboard");
+    open_windows(app);
+    profiler_phase_end("build_dashboard");
+
+    power_policy_configure(app->layout ? &app->layout->power : NULL);
+    if (app->layout) data_feed_start(app->layout->feeds);
+    workload_start();
+
+    /* Show windows */
+    profiler_phase_begin("first_frame");
+
+    DashboardWindow *first = g_ptr_array_index(app->windows, 0);
+    GdkFrameClock *frame_clock = gtk_widget_get_frame_clock(first->window);
+    if (frame_clock) {
+        app->first_frame_handler = g_signal_connect(frame_clock, "after-paint",
+                                                    G_CALLBACK(on_first_frame), app);
+    }
+}
+
+/* Replace the running dashboard with another layout. GTK, the theme,
+ * fonts and the resource cache stay warm; the new windows open before
+ * the old ones close so the screen never goes blank. */
+static void swap_layout(DashboardApp *app, LayoutConfig *layout, const char *layout_file) {
+    GPtrArray *old_windows = g_ptr_array_copy(app->windows, NULL, NULL);
+    LayoutConfig *old_layout = app->layout;
+
+    app->layout = layout;
+    g_free(app->layout_file);
+    app->layout_file = g_strdup(layout_file);
+    /* Window and scene files may have changed on disk since they were cached */
+    resource_cache_retire_layouts();
+    open_windows(app);
+    power_policy_configure(&layout->power);
+    data_feed_start(layout->feeds);
+
+    /* Destroying a window frees its DashboardWindow */
+    for (guint i = 0; i < old_windows->len; i++) {
+        DashboardWindow *win = g_ptr_array_index(old_windows, i);
+        gtk_window_destroy(GTK_WINDOW(win->window));
+    }
+    g_ptr_array_free(old_windows, TRUE);
+
+    /* Nothing shows the previous layout's files any more */
+    resource_cache_free_retired_layouts();
+    layout_config_free(old_layout);
+}
+
+/* Runs in the primary instance, for its own launch and for every later
+ * `gtk-dashboard LAYOUT...` call, which hands its arguments over D-Bus */
+static int on_command_line(GApplication *gapp, GApplicationCommandLine *cmdline, gpointer user_data) {
+    DashboardApp *app = (DashboardApp *)user_data;
+    gboolean first_launch = app->windows->len == 0;
+    int argc;
+    char **argv = g_application_command_line_get_arguments(cmdline, &argc);
+    GVariantDict *options = g_application_command_line_get_options_dict(cmdline);
+    GPtrArray *layout_files = g_ptr_array_new_with_free_func(g_free);
+    const char **args = NULL;
+    int status = 0;
+
+    if (first_launch) profiler_phase_end("gtk_startup");
+
+    /* Options were parsed by the launching process (instance-wide ones only
+     * in the primary, see on_handle_local_options()); layout files are
+     * relative to its working directory */
+    if (g_variant_dict_lookup(options, G_OPTION_REMAINING, "^a&ay", &args)) {
+        for (int i = 0; args[i]; i++) {
+            GFile *file = g_application_command_line_create_file_for_arg(cmdline, args[i]);
+            g_ptr_array_add(layout_files, g_file_get_path(file));
+            g_object_unref(file);
+        }
+        g_free(args);
+    }
+    g_ptr_array_add(layout_files, NULL);
+    const char *layout_file = g_ptr_array_index(layout_files, 0);
+
+    /* Load layout if specified */
+    LayoutConfig *layout = NULL;
+    if (layout_file) {
+        GError *error = NULL;
+        if (first_launch) profiler_phase_begin("layout_load");
+        layout = layout_config_load_from_files((const char * const *)layout_files->pdata, &error);
+        if (first_launch) profiler_phase_end("layout_load");
+        if (!layout) {
+            g_application_command_line_printerr(cmdline, "Error loading layout file '%s': %s\n",
+                layout_file, error ? error->message : "unknown error");
+            g_clear_error(&error);
+            status = 1;
+            goto out;
+        }
+        g_application_command_line_print(cmdline, "Loaded layout from: %s\n", layout_file);
+    } else if (first_launch) {
+        g_application_command_line_print(cmdline,
+            "No layout file specified. Starting with empty dashboard.\n"
+            "Usage: %s <layout.json>\n", argv[0]);
+    }
+
+    if (first_launch) {
+        app->layout = layout;
+        app->layout_file = g_strdup(layout_file);
+        g_application_activate(gapp);
+    } else if (layout) {
+        swap_layout(app, layout, layout_file);
+    } else {
+        g_application_activate(gapp);
+    }
+
+out:
+    g_ptr_array_free(layout_files, TRUE);
+    g_strfreev(argv);
+    return status;
+}
+
+/* app.scene, app.next-scene, app.previous-scene: also reachable over
+ * D-Bus, e.g. `gapplication action com.example.gtkdashboard scene "'pumps'"`.
+ * They act on every window that shows a multi-scene layout. */
+static void on_scene_action(GSimpleAction *action, GVariant *parameter, gpointer user_data) {
+    DashboardApp *app = (DashboardApp *)user_data;
+    for (guint i = 0; i < app->windows->len; i++) {
+        DashboardWindow *win = g_ptr_array_index(app->windows, i);
+        if (win->scenes) scene_manager_show(win->scenes, g_variant_get_string(parameter, NULL));
+    }
+}
+
+static void on_next_scene_action(GSimpleAction *action, GVariant *parameter, gpointer user_data) {
+    DashboardApp *app = (DashboardApp *)user_data;
+    for (guint i = 0; i < app->windows->len; i++) {
+        DashboardWindow *win = g_ptr_array_index(app->windows, i);
+        scene_manager_next(win->scenes);
+    }
+}
+
+static void on_previous_scene_action(GSimpleAction *action, GVariant *parameter, gpointer user_data) {
+    DashboardApp *app = (DashboardApp *)user_data;
+    for (guint i = 0; i < app->windows->len; i++) {
+        DashboardWindow *win = g_ptr_array_index(app->windows, i);
+        scene_manager_previous(win->scenes);
+    }
+}
+
+static void add_scene_actions(DashboardApp *app) {
+    static const GActionEntry actions[] = {
+        { "scene", on_scene_action, "s", NULL, NULL, { 0 } },
+        { "next-scene", on_next_scene_action, NULL, NULL, NULL, { 0 } },
+        { "previous-scene", on_previous_scene_action, NULL, NULL, NULL, { 0 } },
+    };
+    g_action_map_add_action_entries(G_ACTION_MAP(app->app), actions,
+                                    G_N_ELEMENTS(actions), app);
 }
 
 DashboardApp* dashboard_app_new(void) {
     DashboardApp *app = g_new0(DashboardApp, 1);
+    app->windows = g_ptr_array_new_with_free_func(dashboard_window_free);
     return app;
 }
 
 void dashboard_app_free(DashboardApp *app) {
     if (!app) return;
 
+    data_feed_stop();
+    g_ptr_array_free(app->windows, TRUE);
+    resource_cache_clear();
+    shape_renderer_clear_shadows();
     if (app->layout) {
         layout_config_free(app->layout);
     }
@@ -247,51 +809,122 @@ void dashboard_app_free(DashboardApp *app) {
     g_free(app);
 }
 
-static void print_usage(const char *prog_name) {
-    g_print("Usage: %s [OPTIONS] [LAYOUT_FILE]\n\n", prog_name);
-    g_print("Options:\n");
-    g_print("  --help           Show this help message\n\n");
-    g_print("Arguments:\n");
-    g_print("  LAYOUT_FILE      JSON file defining the dashboard layout\n\n");
-    g_print("Keyboard shortcuts:\n");
-    g_print("  F12              Properties dialog\n");
-    g_print("  Ctrl+F12         Toggle fullscreen\n");
-}
+static const GOptionEntry option_entries[] = {
+    { "profile", 0, 0, G_OPTION_ARG_NONE, NULL,
+      "Print a JSON startup profile after the first frame", NULL },
+    { "mem-report", 0, 0, G_OPTION_ARG_NONE, NULL,
+      "Print a JSON per-widget memory report after the first frame", NULL },
+    { "trace", 0, 0, G_OPTION_ARG_FILENAME, NULL,
+      "Write the trace buffers to FILE at exit (SIGUSR1 writes them at any time; "
+      "without --trace to the cache directory)", "FILE" },
+    { "wakeups", 0, 0, G_OPTION_ARG_NONE, NULL,
+      "Print main-loop wakeups per second every 10 seconds", NULL },
+    { "record", 0, 0, G_OPTION_ARG_FILENAME, NULL,
+      "Record feed samples and input to FILE", "FILE" },
+    { "replay", 0, 0, G_OPTION_ARG_FILENAME, NULL,
+      "Replay a recording instead of the layout's feeds, print JSON frame statistics "
+      "and quit at its end", "FILE" },
+    { "replay-speed", 0, 0, G_OPTION_ARG_DOUBLE, NULL,
+      "Replay N times faster (default 1)", "N" },
+    { "metrics", 0, 0, G_OPTION_ARG_FILENAME, NULL,
+      "Serve Prometheus metrics on the Unix socket SOCKET", "SOCKET" },
+    { G_OPTION_REMAINING, 0, 0, G_OPTION_ARG_FILENAME_ARRAY, NULL, NULL, "LAYOUT_FILE..." },
+    G_OPTION_ENTRY_NULL
+};
+
+/* Options that set up the process running the dashboard: a launch that
+ * only forwards its layout files to a running instance cannot apply them */
+static const char *instance_options[] = {
+    "profile", "mem-report", "trace", "wakeups", "record", "replay", "replay-speed", "metrics"
+};
+
+/* Runs in every launching process, before its command line is handled or
+ * forwarded. Registering here tells the primary instance from a launch
+ * that will only forward its layout files. */
+static int on_handle_local_options(GApplication *gapp, GVariantDict *options, gpointer user_data) {
+    DashboardApp *app = (DashboardApp *)user_data;
+    const char *trace_path = NULL;
+    const char *record_path = NULL;
+    const char *replay_path = NULL;
+    const char *metrics_path = NULL;
+    double replay_speed = 1.0;
+    GError *error = NULL;
+
+    g_variant_dict_lookup(options, "trace", "^&ay", &trace_path);
+    g_variant_dict_lookup(options, "record", "^&ay", &record_path);
+    g_variant_dict_lookup(options, "replay", "^&ay", &replay_path);
+    g_variant_dict_lookup(options, "metrics", "^&ay", &metrics_path);
+    g_variant_dict_lookup(options, "replay-speed", "d", &replay_speed);
+
+    if (record_path && replay_path) {
+        g_printerr("--record and --replay cannot be combined\n");
+        return 1;
+    }
 
-int dashboard_app_run(DashboardApp *app, int argc, char **argv) {
-    /* Parse arguments */
-    for (int i = 1; i < argc; i++) {
-        if (strcmp(argv[i], "--help") == 0) {
-            print_usage(argv[0]);
-            return 0;
-        } else if (argv[i][0] != '-') {
-            /* Assume it's the layout file */
-            app->layout_file = g_strdup(argv[i]);
-        }
+    if (!g_application_register(gapp, NULL, &error)) {
+        g_printerr("Error: %s\n", error->message);
+        g_error_free(error);
+        return 1;
     }
 
-    /* Load layout if specified */
-    if (app->layout_file) {
-        GError *error = NULL;
-        app->layout = layout_config_load_from_file(app->layout_file, &error);
-        if (!app->layout) {
-            g_printerr("Error loading layout file '%s': %s\n",
-                       app->layout_file, error ? error->message : "unknown error");
-            g_clear_error(&error);
-            return 1;
+    if (g_application_get_is_remote(gapp)) {
+        for (guint i = 0; i < G_N_ELEMENTS(instance_options); i++) {
+            if (g_variant_dict_contains(options, instance_options[i])) {
+                g_printerr("--%s only applies when starting the dashboard; "
+                           "an instance is already running\n", instance_options[i]);
+                return 1;
+            }
         }
-        g_print("Loaded layout from: %s\n", app->layout_file);
-    } else {
-        g_print("No layout file specified. Starting with empty dashboard.\n");
-        g_print("Usage: %s <layout.json>\n", argv[0]);
+        return -1;
     }
 
-    /* Create GtkApplication */
-    app->app = gtk_application_new("com.example.gtkdashboard", G_APPLICATION_DEFAULT_FLAGS);
+    /* Opening the recording truncates it: never from a forwarding launch */
+    if ((record_path && !workload_record(record_path, &error)) ||
+        (replay_path && !workload_replay(replay_path, replay_speed, &error))) {
+        g_printerr("Error: %s\n", error->message);
+        g_error_free(error);
+        return 1;
+    }
+
+    /* Only the primary handles SIGUSR1 and writes the trace at exit */
+    tracer_init(trace_path);
+    profiler_set_enabled(g_variant_dict_contains(options, "profile"));
+    app->mem_report = g_variant_dict_contains(options, "mem-report");
+    if (g_variant_dict_contains(options, "wakeups")) power_policy_report_wakeups();
+    metrics_init(metrics_path);
+    return -1;
+}
+
+int dashboard_app_run(DashboardApp *app, int argc, char **argv) {
+    /* Phases are timed from here; the report is enabled with the options */
+    profiler_init(FALSE);
+
+    /* Create GtkApplication: a second launch forwards its command line to
+     * the running instance, which swaps to the new layout in-process */
+    app->app = gtk_application_new("com.example.gtkdashboard", G_APPLICATION_HANDLES_COMMAND_LINE);
+    g_application_add_main_option_entries(G_APPLICATION(app->app), option_entries);
+    g_application_set_option_context_summary(G_APPLICATION(app->app),
+        "Several layout files are shown as switchable scenes; a running instance\n"
+        "switches to them in-process.");
+    g_application_set_option_context_description(G_APPLICATION(app->app),
+        "Keyboard shortcuts:\n"
+        "  F12              Properties dialog\n"
+        "  Ctrl+F12         Toggle fullscreen\n"
+        "  Shift+F12        Toggle frame-timing HUD\n"
+        "  PageDown/PageUp  Next/previous scene\n");
+    g_signal_connect(app->app, "handle-local-options", G_CALLBACK(on_handle_local_options), app);
+    g_signal_connect(app->app, "command-line", G_CALLBACK(on_command_line), app);
     g_signal_connect(app->app, "activate", G_CALLBACK(on_activate), app);
+    add_scene_actions(app);
+    power_policy_init(app->app);
+    workload_set_key_func(on_replay_key, app);
 
     /* Run the application */
-    int status = g_application_run(G_APPLICATION(app->app), 0, NULL);
+    profiler_phase_begin("gtk_startup");
+    int status = g_application_run(G_APPLICATION(app->app), argc, argv);
+    workload_shutdown();
+    metrics_shutdown();
+    tracer_shutdown();
 
     g_object_unref(app->app);
     return status;
@@ -3,18 +3,50 @@
 
 #include <gtk/gtk.h>
 #include "json_parser.h"
+#include "frame_hud.h"
+#include "style_manager.h"
+#include "scene_manager.h"
 
+typedef struct _DashboardApp DashboardApp;
+
+/* One toplevel window; every window shares the app's resource cache */
 typedef struct {
-    GtkApplication *app;
-    GtkWidget *main_window;
-    GtkWidget *fixed_container;
+    DashboardApp *app;
+    GtkWidget *window;
+    GtkWidget *overlay;
+    GtkWidget *container;
+    FrameHud *hud;
     gboolean is_fullscreen;
+    LayoutConfig *layout;    /* Borrowed: the app's layout or a cached one */
+    SceneManager *scenes;    /* Multi-scene layouts only */
+    int monitor;             /* -1 = window manager's choice */
+    guint fullscreen_source;
+    GdkRectangle region;     /* Part of the layout shown, if has_region */
+    gboolean has_region;
+    char *splash_path;       /* Warm-start image for this layout and size */
+    GtkWidget *splash;       /* Shown until the live widgets take over */
+    guint splash_tick;
+    guint splash_frames;
+    gint64 fade_start;
+    guint splash_save_source;
+} DashboardWindow;
+
+struct _DashboardApp {
+    GtkApplication *app;
+    GPtrArray *windows;      /* DashboardWindow*, one per output */
     LayoutConfig *layout;
     char *layout_file;
-} DashboardApp;
+    gulong first_frame_handler;
+    gboolean mem_report;     /* --mem-report */
+};
 
 DashboardApp* dashboard_app_new(void);
 void dashboard_app_free(DashboardApp *app);
 int dashboard_app_run(DashboardApp *app, int argc, char **argv);
 
+/* Absolute-positioned container for the widgets inside region (NULL = all),
+ * offset so the region's origin is the container's origin */
+GtkWidget* dashboard_build_widgets(GList *widgets, const GdkRectangle *region);
+void dashboard_collect_styles(GList *widgets, StyleManager *style_mgr);
+
 #endif /* APP_H */
@@ -0,0 +1,303 @@
+#include "binding_graph.h"
+#include "dep_graph.h"
+#include <string.h>
+
+typedef struct _BindingNode BindingNode;
+
+struct _BindingNode {
+    WidgetConfig *config;
+    const char *property;    /* Interned */
+    PropBinding *binding;    /* NULL for a property that is only read */
+    gboolean live;           /* Read through the read func once bound */
+    BindingNode **sources;   /* Node of each reference of the expression */
+    DepNode *dep;
+    ExpressionValue value;   /* Last computed, or the constant / fallback */
+    gboolean has_value;
+    gpointer item;
+};
+
+struct _BindingGraph {
+    DepGraph *graph;         /* Of BindingNode* */
+    GHashTable *by_config;   /* WidgetConfig* -> GPtrArray of its BindingNode* */
+    BindingReadFunc read;
+    BindingWriteFunc write;
+    gpointer user_data;
+};
+
+/* Properties that change at run time, by input, animations or feeds */
+static const struct {
+    const char *type;
+    const char *property;
+} live_properties[] = {
+    { "Slider",   "value" },
+    { "Spin",     "value" },
+    { "Progress", "value" },
+    { "Gauge",    "value" },
+    { "Checkbox", "checked" },
+    { "Switch",   "active" },
+    { "Combo",    "active_index" },
+    { "Combo",    "text" },
+    { "Entry",    "text" },
+};
+
+static void binding_node_free(gpointer data) {
+    BindingNode *node = (BindingNode *)data;
+    g_free(node->sources);
+    expression_value_clear(&node->value);
+    g_free(node);
+}
+
+static const char* node_owner(const BindingNode *node) {
+    return node->config->id ? node->config->id : node->config->type;
+}
+
+gboolean binding_graph_is_live(const char *type, const char *property) {
+    if (!type || !property) return FALSE;
+
+    for (guint i = 0; i < G_N_ELEMENTS(live_properties); i++) {
+        if (strcmp(live_properties[i].type, type) == 0 &&
+            strcmp(live_properties[i].property, property) == 0) {
+            return TRUE;
+        }
+    }
+    return FALSE;
+}
+
+/* ── Graph ───────────────────────────────────────────────── */
+
+static BindingNode* lookup_node(BindingGraph *graph, const WidgetConfig *config,
+                                const char *property) {
+    GPtrArray *nodes = g_hash_table_lookup(graph->by_config, config);
+    const char *interned = g_intern_string(property);
+
+    for (guint i = 0; nodes && i < nodes->len; i++) {
+        BindingNode *node = g_ptr_array_index(nodes, i);
+        if (node->property == interned) return node;
+    }
+    return NULL;
+}
+
+static BindingNode* add_node(BindingGraph *graph, WidgetConfig *config, const char *property) {
+    BindingNode *node = g_new0(BindingNode, 1);
+    node->config = config;
+    node->property = g_intern_string(property);
+
+    GPtrArray *nodes = g_hash_table_lookup(graph->by_config, config);
+    if (!nodes) {
+        nodes = g_ptr_array_new();
+        g_hash_table_insert(graph->by_config, config, nodes);
+    }
+    g_ptr_array_add(nodes, node);
+    node->dep = dep_graph_add_node(graph->graph, node);
+    return node;
+}
+
+/* The static prop value: a constant, or what a live property reads as
+ * while its widget is not shown. FALSE when the widget has no such prop. */
+static gboolean read_static_prop(const WidgetConfig *config, const char *property,
+                                 ExpressionValue *value) {
+    if (!config->props || !json_object_has_member(config->props, property)) return FALSE;
+
+    JsonNode *member = json_object_get_member(config->props, property);
+    if (!JSON_NODE_HOLDS_VALUE(member)) return FALSE;
+
+    GType type = json_node_get_value_type(member);
+    expression_value_clear(value);
+    if (type == G_TYPE_STRING) {
+        value->type = EXPRESSION_STRING;
+        value->string = g_strdup(json_node_get_string(member));
+    } else if (type == G_TYPE_BOOLEAN) {
+        value->number = json_node_get_boolean(member) ? 1.0 : 0.0;
+    } else {
+        value->number = json_node_get_double(member);
+    }
+    return TRUE;
+}
+
+static BindingNode* get_source(BindingGraph *graph, BindingNode *node, guint reference,
+                               GHashTable *configs, GError **error) {
+    const Expression *expr = node->binding->expr;
+    const char *id = expression_get_reference_id(expr, reference);
+    const char *property = expression_get_reference_property(expr, reference);
+
+    WidgetConfig *target = g_hash_table_lookup(configs, id);
+    if (!target) {
+        g_set_error(error, G_IO_ERROR, G_IO_ERROR_INVALID_DATA,
+                    "Prop '%s' of '%s' refers to unknown widget '%s'",
+                    node->property, node_owner(node), id);
+        return NULL;
+    }
+
+    BindingNode *source = lookup_node(graph, target, property);
+    if (source) return source;
+
+    ExpressionValue value = { 0 };
+    gboolean live = binding_graph_is_live(target->type, property);
+    if (!read_static_prop(target, property, &value) && !live) {
+        g_set_error(error, G_IO_ERROR, G_IO_ERROR_INVALID_DATA,
+                    "Prop '%s' of '%s' refers to '%s.%s', which has no such property",
+                    node->property, node_owner(node), id, property);
+        return NULL;
+    }
+
+    source = add_node(graph, target, property);
+    source->live = live;
+    source->value = value;
+    source->has_value = TRUE;
+    return source;
+}
+
+static gboolean sort_nodes(BindingGraph *graph, GError **error) {
+    gpointer cycle = NULL;
+    if (dep_graph_sort(graph->graph, &cycle)) return TRUE;
+
+    BindingNode *node = (BindingNode *)cycle;
+    g_set_error(error, G_IO_ERROR, G_IO_ERROR_INVALID_DATA,
+                "Prop bindings form a cycle through '%s.%s'",
+                node_owner(node), node->property);
+    return FALSE;
+}
+
+/* ── Evaluation ──────────────────────────────────────────── */
+
+typedef struct {
+    BindingGraph *graph;
+    BindingNode *node;
+} Lookup;
+
+/* Bound props read as computed, even where the widget clamped the value */
+static void lookup_reference(guint reference, ExpressionValue *value, gpointer user_data) {
+    Lookup *lookup = (Lookup *)user_data;
+    BindingNode *source = lookup->node->sources[reference];
+
+    if (!source->binding && source->live && source->item && lookup->graph->read) {
+        lookup->graph->read(source->item, source->property, value, lookup->graph->user_data);
+    } else {
+        expression_value_copy(value, &source->value);
+    }
+}
+
+static gboolean evaluate_node(gpointer data, gpointer user_data) {
+    BindingGraph *graph = (BindingGraph *)user_data;
+    BindingNode *node = (BindingNode *)data;
+    if (!node->binding) return FALSE;
+
+    Lookup lookup = { graph, node };
+    ExpressionValue value;
+    expression_evaluate(node->binding->expr, lookup_reference, &lookup, &value);
+
+    if (node->has_value && expression_value_equal(&value, &node->value)) {
+        expression_value_clear(&value);
+        return FALSE;
+    }
+
+    expression_value_clear(&node->value);
+    node->value = value;
+    node->has_value = TRUE;
+    if (node->item && graph->write) {
+        graph->write(node->item, node->config, node->binding, &node->value, graph->user_data);
+    }
+    return TRUE;
+}
+
+/* ── Public API ──────────────────────────────────────────── */
+
+BindingGraph* binding_graph_new(GList *widgets, GError **error) {
+    BindingGraph *graph = g_new0(BindingGraph, 1);
+    graph->graph = dep_graph_new(binding_node_free);
+    graph->by_config = g_hash_table_new_full(g_direct_hash, g_direct_equal, NULL,
+                                             (GDestroyNotify)g_ptr_array_unref);
+
+    GHashTable *configs = widget_configs_by_id(widgets);
+    for (GList *l = widgets; l != NULL; l = l->next) {
+        WidgetConfig *config = (WidgetConfig *)l->data;
+        for (GList *b = config->bindings; b != NULL; b = b->next) {
+            PropBinding *binding = (PropBinding *)b->data;
+            add_node(graph, config, binding->property)->binding = binding;
+        }
+    }
+
+    /* Bound nodes come first; their sources are appended behind them */
+    guint n_bound = dep_graph_get_n_nodes(graph->graph);
+    gboolean ok = TRUE;
+    for (guint i = 0; i < n_bound && ok; i++) {
+        BindingNode *node = dep_graph_get_data(graph->graph, i);
+        guint n_references = expression_get_n_references(node->binding->expr);
+        node->sources = g_new0(BindingNode *, MAX(n_references, 1));
+
+        for (guint r = 0; r < n_references && ok; r++) {
+            node->sources[r] = get_source(graph, node, r, configs, error);
+            ok = node->sources[r] != NULL;
+            if (ok) dep_graph_add_edge(graph->graph, node->sources[r]->dep, node->dep);
+        }
+    }
+    g_hash_table_destroy(configs);
+
+    if (!ok || !sort_nodes(graph, error)) {
+        binding_graph_free(graph);
+        return NULL;
+    }
+
+    guint n_nodes = dep_graph_get_n_nodes(graph->graph);
+    for (guint i = 0; i < n_nodes; i++) {
+        BindingNode *node = dep_graph_get_data(graph->graph, i);
+        if (node->binding) dep_graph_mark(graph->graph, node->dep);
+    }
+    return graph;
+}
+
+void binding_graph_free(BindingGraph *graph) {
+    if (!graph) return;
+
+    dep_graph_free(graph->graph);
+    g_hash_table_destroy(graph->by_config);
+    g_free(graph);
+}
+
+gboolean binding_graph_check(GList *widgets, GError **error) {
+    BindingGraph *graph = binding_graph_new(widgets, error);
+    binding_graph_free(graph);
+    return graph != NULL;
+}
+
+gboolean binding_graph_bind(BindingGraph *graph, const WidgetConfig *config, gpointer item) {
+    g_return_val_if_fail(graph != NULL, FALSE);
+
+    GPtrArray *nodes = g_hash_table_lookup(graph->by_config, config);
+    for (guint i = 0; nodes && i < nodes->len; i++) {
+        ((BindingNode *)g_ptr_array_index(nodes, i))->item = item;
+    }
+    return nodes != NULL;
+}
+
+void binding_graph_set_funcs(BindingGraph *graph, BindingReadFunc read, BindingWriteFunc write,
+                             gpointer user_data) {
+    g_return_if_fail(graph != NULL);
+
+    graph->read = read;
+    graph->write = write;
+    graph->user_data = user_data;
+}
+
+gboolean binding_graph_reads(BindingGraph *graph, const WidgetConfig *config,
+                             const char *property) {
+    g_return_val_if_fail(graph != NULL, FALSE);
+
+    BindingNode *node = lookup_node(graph, config, property);
+    return node && dep_node_has_dependents(node->dep);
+}
+
+gboolean binding_graph_changed(BindingGraph *graph, const WidgetConfig *config,
+                               const char *property) {
+    g_return_val_if_fail(graph != NULL, FALSE);
+
+    /* Readers of a bound prop see the computed value, not the widget's */
+    BindingNode *node = lookup_node(graph, config, property);
+    return node && !node->binding && dep_graph_mark_dependents(graph->graph, node->dep);
+}
+
+void binding_graph_update(BindingGraph *graph) {
+    g_return_if_fail(graph != NULL);
+
+    dep_graph_update(graph->graph, evaluate_node, graph);
+}
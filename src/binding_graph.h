@@ -0,0 +1,54 @@
+#ifndef BINDING_GRAPH_H
+#define BINDING_GRAPH_H
+
+#include "json_parser.h"
+
+/*
+ * Dependency graph of prop bindings (PropBinding).
+ *
+ * Nodes are widget properties: every bound prop and every property an
+ * expression reads. The graph is sorted once, when it is built; a
+ * reference to an unknown widget or property, or a cycle, is an error.
+ * binding_graph_changed() marks the bindings reading a property that
+ * changed; binding_graph_update() then re-evaluates only marked bindings,
+ * in dependency order, and follows on to the readers of those whose value
+ * actually changed. The caller decides when to update (once per frame).
+ *
+ * Properties that change at run time ("live", e.g. a Slider's value) are
+ * read through the read func; any other prop a widget has is a constant.
+ */
+
+typedef struct _BindingGraph BindingGraph;
+
+/* Current value of a live property of item, value is cleared */
+typedef void (*BindingReadFunc)(gpointer item, const char *property, ExpressionValue *value,
+                                gpointer user_data);
+/* A bound prop of item has a new value */
+typedef void (*BindingWriteFunc)(gpointer item, const WidgetConfig *config,
+                                 const PropBinding *binding, const ExpressionValue *value,
+                                 gpointer user_data);
+
+/* Graph of the compiled bindings of a WidgetConfig list; every binding
+ * starts out marked, so the first update evaluates all of them */
+BindingGraph* binding_graph_new(GList *widgets, GError **error);
+void binding_graph_free(BindingGraph *graph);
+/* Build and discard a graph, for the errors */
+gboolean binding_graph_check(GList *widgets, GError **error);
+
+/* TRUE when property of a widget type changes at run time */
+gboolean binding_graph_is_live(const char *type, const char *property);
+
+/* FALSE when no node belongs to the widget */
+gboolean binding_graph_bind(BindingGraph *graph, const WidgetConfig *config, gpointer item);
+void binding_graph_set_funcs(BindingGraph *graph, BindingReadFunc read, BindingWriteFunc write,
+                             gpointer user_data);
+
+/* TRUE when some binding reads this property of the widget */
+gboolean binding_graph_reads(BindingGraph *graph, const WidgetConfig *config,
+                             const char *property);
+/* A live property changed; TRUE when a binding was marked (an update is due) */
+gboolean binding_graph_changed(BindingGraph *graph, const WidgetConfig *config,
+                               const char *property);
+void binding_graph_update(BindingGraph *graph);
+
+#endif /* BINDING_GRAPH_H */
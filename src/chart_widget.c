@@ -0,0 +1,394 @@
+#include "chart_widget.h"
+#include "data_feed.h"
+#include "power_policy.h"
+#include "scale_bin.h"
+#include <string.h>
+#include <math.h>
+
+#define CHART_DEFAULT_CAPACITY 100000
+#define SPARKLINE_DEFAULT_CAPACITY 1000
+#define CHART_MAX_CAPACITY (64u * 1024 * 1024)
+#define CHART_GRID_LINES 4
+/* Autoscaled ranges leave this fraction of the span free above and below */
+#define CHART_AUTOSCALE_MARGIN 0.1
+
+struct _ChartSeries {
+    float *samples;          /* Ring buffer */
+    guint capacity;
+    guint64 total;           /* Samples ever appended */
+
+    /* Column image */
+    cairo_surface_t *image;
+    int width;
+    int height;
+    double min;
+    double max;
+    GdkRGBA color;
+    guint64 samples_per_column;
+    guint64 drawn_columns;   /* Completed columns already in the image */
+    guint64 rendered_total;  /* total at the last render */
+    gboolean valid;
+};
+
+struct _ChartWidget {
+    GtkWidget parent_instance;
+
+    ChartSeries *series;
+    gboolean sparkline;
+    GdkRGBA color;
+    gboolean autoscale;
+    double min;              /* Current value range */
+    double max;
+    gboolean has_range;
+    guint subscription;
+    GdkTexture *texture;     /* Upload of the column image */
+};
+
+G_DEFINE_TYPE(ChartWidget, chart_widget, GTK_TYPE_WIDGET)
+
+/* ── Decimation kernel ───────────────────────────────────── */
+
+void chart_minmax(const float *values, gsize n, float *min, float *max) {
+    /* Independent lanes let the compiler use packed min/max instructions */
+    enum { LANES = 8 };
+    float lo[LANES], hi[LANES];
+    gsize i = 0;
+
+    for (int l = 0; l < LANES; l++) lo[l] = hi[l] = values[0];
+
+    for (; i + LANES <= n; i += LANES) {
+        for (int l = 0; l < LANES; l++) {
+            float v = values[i + l];
+            lo[l] = v < lo[l] ? v : lo[l];
+            hi[l] = v > hi[l] ? v : hi[l];
+        }
+    }
+    for (; i < n; i++) {
+        lo[0] = values[i] < lo[0] ? values[i] : lo[0];
+        hi[0] = values[i] > hi[0] ? values[i] : hi[0];
+    }
+
+    for (int l = 1; l < LANES; l++) {
+        lo[0] = lo[l] < lo[0] ? lo[l] : lo[0];
+        hi[0] = hi[l] > hi[0] ? hi[l] : hi[0];
+    }
+    *min = lo[0];
+    *max = hi[0];
+}
+
+/* ── Series ──────────────────────────────────────────────── */
+
+ChartSeries* chart_series_new(guint capacity) {
+    ChartSeries *series = g_new0(ChartSeries, 1);
+    series->capacity = CLAMP(capacity, 1, CHART_MAX_CAPACITY);
+    series->samples = g_new(float, series->capacity);
+    return series;
+}
+
+void chart_series_free(ChartSeries *series) {
+    if (!series) return;
+
+    if (series->image) cairo_surface_destroy(series->image);
+    g_free(series->samples);
+    g_free(series);
+}
+
+void chart_series_append(ChartSeries *series, const float *values, gsize n) {
+    /* Only the newest capacity samples can survive */
+    if (n > series->capacity) {
+        series->total += n - series->capacity;
+        values += n - series->capacity;
+        n = series->capacity;
+    }
+
+    /* At most two copies: up to the end of the ring, then from its start */
+    guint head = (guint)(series->total % series->capacity);
+    gsize first = MIN(n, (gsize)(series->capacity - head));
+    memcpy(series->samples + head, values, first * sizeof(float));
+    memcpy(series->samples, values + first, (n - first) * sizeof(float));
+    series->total += n;
+}
+
+guint64 chart_series_get_total(ChartSeries *series) {
+    return series->total;
+}
+
+/* Min/max of absolute sample range [start, end), which must be retained */
+static void range_minmax(ChartSeries *series, guint64 start, guint64 end, float *min, float *max) {
+    guint from = (guint)(start % series->capacity);
+    gsize n = (gsize)(end - start);
+    gsize first = MIN(n, (gsize)(series->capacity - from));
+
+    chart_minmax(series->samples + from, first, min, max);
+    if (first < n) {
+        float lo, hi;
+        chart_minmax(series->samples, n - first, &lo, &hi);
+        *min = MIN(*min, lo);
+        *max = MAX(*max, hi);
+    }
+}
+
+static double value_to_y(ChartSeries *series, double value) {
+    double span = series->max - series->min;
+    double y = (series->max - value) / span * (series->height - 1);
+    return CLAMP(y, 0, series->height - 1);
+}
+
+/* Clear column k's slot in the image and draw its bucket there */
+static void draw_column(ChartSeries *series, cairo_t *cr, guint64 k) {
+    int x = (int)(k % (guint64)series->width);
+
+    cairo_set_operator(cr, CAIRO_OPERATOR_CLEAR);
+    cairo_rectangle(cr, x, 0, 1, series->height);
+    cairo_fill(cr);
+    cairo_set_operator(cr, CAIRO_OPERATOR_OVER);
+
+    guint64 oldest = series->total > series->capacity ? series->total - series->capacity : 0;
+    guint64 start = MAX(k * series->samples_per_column, oldest);
+    guint64 end = MIN((k + 1) * series->samples_per_column, series->total);
+    if (start >= end) return;
+
+    /* Include the previous sample so adjacent columns join up */
+    if (start > oldest) start--;
+
+    float lo, hi;
+    range_minmax(series, start, end, &lo, &hi);
+
+    double top = value_to_y(series, hi);
+    double bottom = value_to_y(series, lo);
+    cairo_rectangle(cr, x, floor(top), 1, MAX(1.0, ceil(bottom) - floor(top) + 1));
+    cairo_fill(cr);
+}
+
+guint chart_series_render(ChartSeries *series, int width, int height,
+                          double min, double max, const GdkRGBA *color) {
+    if (width <= 0 || height <= 0 || max <= min) return 0;
+
+    if (!series->image || width != series->width || height != series->height) {
+        if (series->image) cairo_surface_destroy(series->image);
+        series->image = cairo_image_surface_create(CAIRO_FORMAT_ARGB32, width, height);
+        series->width = width;
+        series->height = height;
+        series->valid = FALSE;
+    }
+
+    /* The whole buffer spans the width */
+    guint64 samples_per_column = MAX(1, series->capacity / (guint)width);
+    if (samples_per_column != series->samples_per_column || min != series->min ||
+        max != series->max || !gdk_rgba_equal(color, &series->color)) {
+        series->samples_per_column = samples_per_column;
+        series->min = min;
+        series->max = max;
+        series->color = *color;
+        series->valid = FALSE;
+    }
+
+    if (series->valid && series->total == series->rendered_total) return 0;
+
+    cairo_t *cr = cairo_create(series->image);
+    guint64 completed = series->total / samples_per_column;
+
+    if (!series->valid) {
+        cairo_set_operator(cr, CAIRO_OPERATOR_CLEAR);
+        cairo_paint(cr);
+        series->drawn_columns = 0;
+        series->valid = TRUE;
+    }
+
+    /* Columns that scrolled out before being drawn are skipped */
+    if (completed - series->drawn_columns > (guint64)width) {
+        series->drawn_columns = completed - width;
+    }
+
+    gdk_cairo_set_source_rgba(cr, color);
+    guint drawn = 0;
+    for (guint64 k = series->drawn_columns; k < completed; k++, drawn++) {
+        draw_column(series, cr, k);
+    }
+    series->drawn_columns = completed;
+
+    /* The column still filling is redrawn until it completes */
+    if (series->total % samples_per_column != 0) {
+        draw_column(series, cr, completed);
+        drawn++;
+    }
+
+    cairo_destroy(cr);
+    cairo_surface_flush(series->image);
+    series->rendered_total = series->total;
+    return drawn;
+}
+
+cairo_surface_t* chart_series_get_image(ChartSeries *series, int *newest_x) {
+    guint64 spc = MAX(series->samples_per_column, 1);
+    guint64 newest = series->total / spc;
+    if (series->total % spc == 0 && newest > 0) newest--;
+    if (newest_x) *newest_x = series->width > 0 ? (int)(newest % (guint64)series->width) : 0;
+    return series->image;
+}
+
+/* ── Widget ──────────────────────────────────────────────── */
+
+/* Widen the autoscaled range when a sample falls outside it */
+static void update_range(ChartWidget *chart, const float *values, gsize n) {
+    if (!chart->autoscale || n == 0) return;
+
+    float lo, hi;
+    chart_minmax(values, n, &lo, &hi);
+    if (chart->has_range && lo >= chart->min && hi <= chart->max) return;
+
+    if (chart->has_range) {
+        lo = MIN(lo, chart->min);
+        hi = MAX(hi, chart->max);
+    }
+    double span = hi > lo ? hi - lo : 1.0;
+    chart->min = lo - span * CHART_AUTOSCALE_MARGIN;
+    chart->max = hi + span * CHART_AUTOSCALE_MARGIN;
+    chart->has_range = TRUE;
+}
+
+void chart_widget_push(ChartWidget *chart, const float *values, gsize n) {
+    g_return_if_fail(CHART_IS_WIDGET(chart));
+
+    update_range(chart, values, n);
+    chart_series_append(chart->series, values, n);
+    power_policy_queue_draw(GTK_WIDGET(chart));
+}
+
+static void on_feed_sample(const char *channel, double value, gpointer user_data) {
+    float sample = (float)value;
+    chart_widget_push(CHART_WIDGET(user_data), &sample, 1);
+}
+
+static void chart_widget_snapshot(GtkWidget *widget, GtkSnapshot *snapshot) {
+    ChartWidget *chart = CHART_WIDGET(widget);
+    int width = gtk_widget_get_width(widget);
+    int height = gtk_widget_get_height(widget);
+    if (width <= 0 || height <= 0) return;
+
+    /* One image column per device pixel, however the layout is scaled */
+    double scale = scale_bin_get_raster_scale(widget);
+    int image_width = (int)ceil(width * scale);
+    int image_height = (int)ceil(height * scale);
+
+    if (!chart->sparkline) {
+        GdkRGBA grid = chart->color;
+        grid.alpha *= 0.15f;
+        for (int i = 1; i < CHART_GRID_LINES; i++) {
+            float y = floorf((float)height * i / CHART_GRID_LINES);
+            gtk_snapshot_append_color(snapshot, &grid, &GRAPHENE_RECT_INIT(0, y, width, 1));
+        }
+    }
+
+    if (!chart->has_range) return;
+
+    guint drawn = chart_series_render(chart->series, image_width, image_height,
+                                      chart->min, chart->max, &chart->color);
+    if (drawn > 0 || !chart->texture) {
+        int newest_x;
+        cairo_surface_t *image = chart_series_get_image(chart->series, &newest_x);
+        int stride = cairo_image_surface_get_stride(image);
+        GBytes *bytes = g_bytes_new(cairo_image_surface_get_data(image),
+                                    (gsize)stride * cairo_image_surface_get_height(image));
+
+        g_clear_object(&chart->texture);
+        chart->texture = gdk_memory_texture_new(cairo_image_surface_get_width(image),
+                                                cairo_image_surface_get_height(image),
+                                                GDK_MEMORY_DEFAULT, bytes, stride);
+        g_bytes_unref(bytes);
+    }
+
+    /* Image columns after the newest one are the oldest: show them first */
+    int newest_x;
+    chart_series_get_image(chart->series, &newest_x);
+    float offset = -(float)(newest_x + 1) * width / image_width;
+
+    gtk_snapshot_push_clip(snapshot, &GRAPHENE_RECT_INIT(0, 0, width, height));
+    gtk_snapshot_append_texture(snapshot, chart->texture,
+                                &GRAPHENE_RECT_INIT(offset, 0, width, height));
+    gtk_snapshot_append_texture(snapshot, chart->texture,
+                                &GRAPHENE_RECT_INIT(offset + width, 0, width, height));
+    gtk_snapshot_pop(snapshot);
+}
+
+static void chart_widget_dispose(GObject *object) {
+    ChartWidget *chart = CHART_WIDGET(object);
+
+    data_feed_unsubscribe(chart->subscription);
+    chart->subscription = 0;
+    g_clear_object(&chart->texture);
+
+    G_OBJECT_CLASS(chart_widget_parent_class)->dispose(object);
+}
+
+static void chart_widget_finalize(GObject *object) {
+    chart_series_free(CHART_WIDGET(object)->series);
+    G_OBJECT_CLASS(chart_widget_parent_class)->finalize(object);
+}
+
+static void chart_widget_class_init(ChartWidgetClass *klass) {
+    GObjectClass *object_class = G_OBJECT_CLASS(klass);
+    GtkWidgetClass *widget_class = GTK_WIDGET_CLASS(klass);
+
+    object_class->dispose = chart_widget_dispose;
+    object_class->finalize = chart_widget_finalize;
+    widget_class->snapshot = chart_widget_snapshot;
+    gtk_widget_class_set_css_name(widget_class, "chart");
+}
+
+static void chart_widget_init(ChartWidget *chart) {
+}
+
+static double get_double_prop(JsonObject *props, const char *key, double default_val) {
+    if (!props || !json_object_has_member(props, key)) return default_val;
+    JsonNode *node = json_object_get_member(props, key);
+    if (!JSON_NODE_HOLDS_VALUE(node)) return default_val;
+    return json_node_get_double(node);
+}
+
+static const char* get_string_prop(JsonObject *props, const char *key, const char *default_val) {
+    if (!props || !json_object_has_member(props, key)) return default_val;
+    JsonNode *node = json_object_get_member(props, key);
+    if (!JSON_NODE_HOLDS_VALUE(node)) return default_val;
+    const char *val = json_node_get_string(node);
+    return val ? val : default_val;
+}
+
+GtkWidget* chart_widget_new(const WidgetConfig *config) {
+    ChartWidget *chart = g_object_new(CHART_TYPE_WIDGET, NULL);
+    JsonObject *props = config->props;
+
+    chart->sparkline = config->type && strcmp(config->type, "Sparkline") == 0;
+    guint default_capacity = chart->sparkline ? SPARKLINE_DEFAULT_CAPACITY : CHART_DEFAULT_CAPACITY;
+    chart->series = chart_series_new((guint)get_double_prop(props, "capacity", default_capacity));
+
+    if (!gdk_rgba_parse(&chart->color, get_string_prop(props, "color", "#88C0D0"))) {
+        gdk_rgba_parse(&chart->color, "#88C0D0");
+    }
+
+    /* Fixed range when both ends are given, autoscale otherwise */
+    chart->autoscale = !(props && json_object_has_member(props, "min") &&
+                         json_object_has_member(props, "max"));
+    if (!chart->autoscale) {
+        chart->min = get_double_prop(props, "min", 0.0);
+        chart->max = get_double_prop(props, "max", 1.0);
+        chart->has_range = chart->max > chart->min;
+    }
+
+    /* Initial samples */
+    if (props && json_object_has_member(props, "data")) {
+        JsonArray *data = json_object_get_array_member(props, "data");
+        guint n = json_array_get_length(data);
+        float *values = g_new(float, MAX(n, 1));
+        for (guint i = 0; i < n; i++) {
+            values[i] = (float)json_array_get_double_element(data, i);
+        }
+        chart_widget_push(chart, values, n);
+        g_free(values);
+    }
+
+    const char *feed = get_string_prop(props, "feed", NULL);
+    if (feed) chart->subscription = data_feed_subscribe(feed, on_feed_sample, chart);
+
+    return GTK_WIDGET(chart);
+}
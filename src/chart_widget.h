@@ -0,0 +1,47 @@
+#ifndef CHART_WIDGET_H
+#define CHART_WIDGET_H
+
+#include <gtk/gtk.h>
+#include "json_parser.h"
+
+/*
+ * High-volume time-series "Chart" and "Sparkline" widgets.
+ *
+ * Samples go into a fixed-capacity ring buffer of floats (ChartSeries).
+ * The plot is a column image with one device pixel per bucket of
+ * capacity / width samples. Each column is drawn as the min/max range of
+ * its bucket, so the drawing cost depends on the width and not on the
+ * sample count. The image is a ring as well: new samples redraw only the
+ * columns they complete plus the one still filling, and the snapshot shows
+ * the ring in two pieces. A full replot (resize, or a change of the value
+ * range) is a single pass of the min/max kernel over the buffer.
+ */
+
+typedef struct _ChartSeries ChartSeries;
+
+ChartSeries* chart_series_new(guint capacity);
+void chart_series_free(ChartSeries *series);
+void chart_series_append(ChartSeries *series, const float *values, gsize n);
+/* Samples ever appended */
+guint64 chart_series_get_total(ChartSeries *series);
+
+/* Bring the column image up to date for a size (device pixels) and value
+ * range, replotting it entirely if either changed. Returns the number of
+ * columns drawn. */
+guint chart_series_render(ChartSeries *series, int width, int height,
+                          double min, double max, const GdkRGBA *color);
+/* Column image (ARGB32) and the x of its newest column */
+cairo_surface_t* chart_series_get_image(ChartSeries *series, int *newest_x);
+
+/* Min/max of n > 0 samples, written to be auto-vectorized */
+void chart_minmax(const float *values, gsize n, float *min, float *max);
+
+#define CHART_TYPE_WIDGET (chart_widget_get_type())
+G_DECLARE_FINAL_TYPE(ChartWidget, chart_widget, CHART, WIDGET, GtkWidget)
+
+/* Chart: props.feed, capacity, min, max, color, data. Sparkline is the
+ * same plot without grid lines. */
+GtkWidget* chart_widget_new(const WidgetConfig *config);
+void chart_widget_push(ChartWidget *chart, const float *values, gsize n);
+
+#endif /* CHART_WIDGET_H */
@@ -0,0 +1,183 @@
+/*
+ * gtk-dashboard-check: validates layout files without a display.
+ *
+ *   gtk-dashboard-check [--jobs N] [--output FILE] [--quiet] PATH...
+ *
+ * Every PATH is a layout file or a directory searched recursively for
+ * *.json files. Files are checked in parallel on N threads (default: one
+ * per processor) and a JSON report is written to FILE or stdout; a
+ * summary goes to stderr. Exits 1 if any file has errors.
+ */
+#include "layout_check.h"
+#include <json-glib/json-glib.h>
+#include <string.h>
+
+static int opt_jobs = 0;
+static char *opt_output = NULL;
+static gboolean opt_quiet = FALSE;
+static char **opt_paths = NULL;
+
+static GOptionEntry entries[] = {
+    { "jobs", 'j', 0, G_OPTION_ARG_INT, &opt_jobs, "Files checked at once (default: processors)", "N" },
+    { "output", 'o', 0, G_OPTION_ARG_FILENAME, &opt_output, "Report file (default: stdout)", "FILE" },
+    { "quiet", 'q', 0, G_OPTION_ARG_NONE, &opt_quiet, "Only report files with findings", NULL },
+    { G_OPTION_REMAINING, 0, 0, G_OPTION_ARG_FILENAME_ARRAY, &opt_paths, NULL, "PATH..." },
+    G_OPTION_ENTRY_NULL
+};
+
+typedef struct {
+    GPtrArray *files;
+    LayoutCheckResult **results;
+} CheckRun;
+
+static void collect_files(const char *path, GPtrArray *files) {
+    if (!g_file_test(path, G_FILE_TEST_IS_DIR)) {
+        g_ptr_array_add(files, g_strdup(path));
+        return;
+    }
+
+    GDir *dir = g_dir_open(path, 0, NULL);
+    if (!dir) return;
+
+    const char *name;
+    while ((name = g_dir_read_name(dir)) != NULL) {
+        char *child = g_build_filename(path, name, NULL);
+        if (g_file_test(child, G_FILE_TEST_IS_DIR)) {
+            collect_files(child, files);
+        } else if (g_str_has_suffix(name, ".json")) {
+            g_ptr_array_add(files, g_strdup(child));
+        }
+        g_free(child);
+    }
+    g_dir_close(dir);
+}
+
+static gint compare_paths(gconstpointer a, gconstpointer b) {
+    return strcmp(*(const char * const *)a, *(const char * const *)b);
+}
+
+/* Pool worker; data is the file index + 1 */
+static void check_one(gpointer data, gpointer user_data) {
+    CheckRun *run = (CheckRun *)user_data;
+    guint index = GPOINTER_TO_UINT(data) - 1;
+    run->results[index] = layout_check_file(g_ptr_array_index(run->files, index));
+}
+
+static JsonObject* result_to_json(const LayoutCheckResult *result) {
+    JsonObject *obj = json_object_new();
+    JsonArray *findings = json_array_new();
+
+    json_object_set_string_member(obj, "file", result->path);
+    json_object_set_int_member(obj, "errors", result->errors);
+    json_object_set_int_member(obj, "warnings", result->warnings);
+    json_object_set_double_member(obj, "duration_ms", result->duration_us / 1000.0);
+
+    for (guint i = 0; i < result->findings->len; i++) {
+        LayoutCheckFinding *finding = g_ptr_array_index(result->findings, i);
+        JsonObject *finding_obj = json_object_new();
+        json_object_set_string_member(finding_obj, "severity",
+            finding->severity == LAYOUT_CHECK_ERROR ? "error" : "warning");
+        json_object_set_string_member(finding_obj, "code", finding->code);
+        if (finding->id) {
+            json_object_set_string_member(finding_obj, "id", finding->id);
+        } else {
+            json_object_set_null_member(finding_obj, "id");
+        }
+        json_object_set_string_member(finding_obj, "message", finding->message);
+        json_array_add_object_element(findings, finding_obj);
+    }
+    json_object_set_array_member(obj, "findings", findings);
+    return obj;
+}
+
+static gboolean write_report(JsonObject *root_obj, GError **error) {
+    JsonNode *root = json_node_new(JSON_NODE_OBJECT);
+    json_node_take_object(root, root_obj);
+
+    JsonGenerator *gen = json_generator_new();
+    json_generator_set_pretty(gen, TRUE);
+    json_generator_set_root(gen, root);
+
+    gboolean ok = TRUE;
+    if (opt_output) {
+        ok = json_generator_to_file(gen, opt_output, error);
+    } else {
+        char *data = json_generator_to_data(gen, NULL);
+        g_print("%s\n", data);
+        g_free(data);
+    }
+
+    g_object_unref(gen);
+    json_node_unref(root);
+    return ok;
+}
+
+int main(int argc, char **argv) {
+    GError *error = NULL;
+    GOptionContext *context = g_option_context_new("- check dashboard layout files");
+    g_option_context_add_main_entries(context, entries, NULL);
+    if (!g_option_context_parse(context, &argc, &argv, &error) || !opt_paths) {
+        g_printerr("gtk-dashboard-check: %s\n", error ? error->message : "no layout files given");
+        g_clear_error(&error);
+        g_option_context_free(context);
+        return 2;
+    }
+    g_option_context_free(context);
+
+    int jobs = opt_jobs > 0 ? opt_jobs : (int)g_get_num_processors();
+
+    CheckRun run;
+    run.files = g_ptr_array_new_with_free_func(g_free);
+    for (char **path = opt_paths; *path; path++) collect_files(*path, run.files);
+    g_ptr_array_sort(run.files, compare_paths);
+    run.results = g_new0(LayoutCheckResult *, run.files->len);
+
+    layout_check_init();
+    gint64 start = g_get_monotonic_time();
+
+    /* Exclusive pool: threads are started up front and reused */
+    GThreadPool *pool = g_thread_pool_new(check_one, &run, jobs, TRUE, NULL);
+    for (guint i = 0; i < run.files->len; i++) {
+        g_thread_pool_push(pool, GUINT_TO_POINTER(i + 1), NULL);
+    }
+    g_thread_pool_free(pool, FALSE, TRUE);
+
+    double duration_ms = (g_get_monotonic_time() - start) / 1000.0;
+
+    guint failed = 0, errors = 0, warnings = 0;
+    JsonArray *results = json_array_new();
+    for (guint i = 0; i < run.files->len; i++) {
+        LayoutCheckResult *result = run.results[i];
+        if (result->errors > 0) failed++;
+        errors += result->errors;
+        warnings += result->warnings;
+        if (!opt_quiet || result->findings->len > 0) {
+            json_array_add_object_element(results, result_to_json(result));
+        }
+        layout_check_result_free(result);
+    }
+
+    JsonObject *root_obj = json_object_new();
+    json_object_set_int_member(root_obj, "files", run.files->len);
+    json_object_set_int_member(root_obj, "failed", failed);
+    json_object_set_int_member(root_obj, "errors", errors);
+    json_object_set_int_member(root_obj, "warnings", warnings);
+    json_object_set_int_member(root_obj, "jobs", jobs);
+    json_object_set_double_member(root_obj, "duration_ms", duration_ms);
+    json_object_set_array_member(root_obj, "results", results);
+
+    int status = errors > 0 ? 1 : 0;
+    if (!write_report(root_obj, &error)) {
+        g_printerr("gtk-dashboard-check: %s\n", error->message);
+        g_clear_error(&error);
+        status = 2;
+    }
+
+    g_printerr("Checked %u files in %.1f ms on %d threads: %u with errors, %u errors, %u warnings\n",
+               run.files->len, duration_ms, jobs, failed, errors, warnings);
+
+    g_free(run.results);
+    g_ptr_array_free(run.files, TRUE);
+    g_strfreev(opt_paths);
+    return status;
+}
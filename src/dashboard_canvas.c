@@ -0,0 +1,517 @@
+#include "dashboard_canvas.h"
+#include "scale_bin.h"
+
+typedef struct {
+    GtkWidget *widget;
+    GdkRectangle rect;       /* As placed; size <= 0 = natural */
+    GdkRectangle allocated;  /* Last allocation given to the child */
+    gboolean dirty;          /* Needs measuring on the next pass */
+    guint index;             /* Position in canvas->children */
+    GdkRectangle opaque;     /* Fully opaque area in child coordinates */
+    gboolean has_opaque;
+    gboolean culled;         /* Covered by an opaque child painted above */
+    double rotation;         /* Degrees about the centre */
+    double scale;
+    gboolean transformed;    /* rotation != 0 or scale != 1 */
+    DashboardShadowFunc shadow;
+} CanvasChild;
+
+struct _DashboardCanvas {
+    GtkWidget parent_instance;
+
+    GPtrArray *children;     /* CanvasChild*, in paint order */
+    GPtrArray *dirty;        /* CanvasChild* to measure on the next pass */
+    GPtrArray *natural;      /* CanvasChild* sized by measuring every pass */
+    int extent_width;        /* Bounding box of every child rect */
+    int extent_height;
+    gboolean extent_valid;
+
+    /* Children following the canvas size */
+    DashboardResizeFunc resize;
+    gpointer resize_data;
+    GDestroyNotify resize_destroy;
+    int width;               /* Size of the last allocation */
+    int height;
+    gboolean allocating;     /* Inside size_allocate: moves need no new pass */
+
+    /* Occlusion culling */
+    GPtrArray *occluders;    /* CanvasChild* with an opaque area, in paint order */
+    GArray *cull_damage;     /* GdkRectangle areas whose culling is stale */
+    guint culled;
+};
+
+static GQuark child_quark;
+static guint culled_total = 0;   /* Over every canvas, for the HUD */
+
+G_DEFINE_TYPE(DashboardCanvas, dashboard_canvas, GTK_TYPE_WIDGET)
+
+static CanvasChild* get_child(GtkWidget *widget) {
+    return g_object_get_qdata(G_OBJECT(widget), child_quark);
+}
+
+static void mark_dirty(DashboardCanvas *canvas, CanvasChild *child) {
+    if (child->dirty) return;
+    child->dirty = TRUE;
+    g_ptr_array_add(canvas->dirty, child);
+}
+
+/* Size a child will be allocated at. Fixed-size children are measured
+ * only to honour their minimum size, and only when (re)placed. */
+static void child_size(CanvasChild *child, int *width, int *height) {
+    GtkRequisition min, nat;
+
+    if (child->rect.width > 0 && child->rect.height > 0) {
+        gtk_widget_get_preferred_size(child->widget, &min, NULL);
+        *width = MAX(child->rect.width, min.width);
+        *height = MAX(child->rect.height, min.height);
+        return;
+    }
+
+    gtk_widget_get_preferred_size(child->widget, &min, &nat);
+    *width = child->rect.width > 0 ? MAX(child->rect.width, min.width) : nat.width;
+    *height = child->rect.height > 0 ? MAX(child->rect.height, min.height) : nat.height;
+}
+
+static void add_cull_damage(DashboardCanvas *canvas, const GdkRectangle *area) {
+    if (area->width > 0 && area->height > 0) {
+        g_array_append_val(canvas->cull_damage, *area);
+    }
+}
+
+/* Rectangle the child gets from now on */
+static void update_allocation(DashboardCanvas *canvas, CanvasChild *child) {
+    int width, height;
+    child_size(child, &width, &height);
+
+    GdkRectangle allocated = { child->rect.x, child->rect.y, width, height };
+    if (!gdk_rectangle_equal(&allocated, &child->allocated)) {
+        /* Both where it was and where it is now may change culling */
+        add_cull_damage(canvas, &child->allocated);
+        add_cull_damage(canvas, &allocated);
+        child->allocated = allocated;
+    }
+}
+
+/* ── Occlusion culling ───────────────────────────────────── */
+
+static gboolean rect_contains(const GdkRectangle *outer, const GdkRectangle *inner) {
+    return inner->x >= outer->x && inner->y >= outer->y &&
+           inner->x + inner->width <= outer->x + outer->width &&
+           inner->y + inner->height <= outer->y + outer->height;
+}
+
+/* Paints exactly its opaque area over whatever is below */
+static gboolean can_occlude(CanvasChild *child) {
+    return gtk_widget_should_layout(child->widget) && !child->transformed &&
+           gtk_widget_get_opacity(child->widget) >= 1.0;
+}
+
+/* Covered by the opaque area of a single visible child painted above it */
+static gboolean is_occluded(DashboardCanvas *canvas, CanvasChild *child) {
+    if (child->allocated.width <= 0 || child->allocated.height <= 0) return FALSE;
+    if (child->transformed || child->shadow) return FALSE;
+
+    for (guint i = canvas->occluders->len; i > 0; i--) {
+        CanvasChild *occluder = g_ptr_array_index(canvas->occluders, i - 1);
+        if (occluder->index <= child->index) break;
+        if (!can_occlude(occluder)) continue;
+
+        /* The area was declared for a size the child may no longer have */
+        GdkRectangle opaque;
+        GdkRectangle bounds = { 0, 0, occluder->allocated.width, occluder->allocated.height };
+        if (!gdk_rectangle_intersect(&occluder->opaque, &bounds, &opaque)) continue;
+        opaque.x += occluder->allocated.x;
+        opaque.y += occluder->allocated.y;
+        if (rect_contains(&opaque, &child->allocated)) return TRUE;
+    }
+    return FALSE;
+}
+
+static gboolean intersects_damage(DashboardCanvas *canvas, const GdkRectangle *rect) {
+    for (guint i = 0; i < canvas->cull_damage->len; i++) {
+        if (gdk_rectangle_intersect(&g_array_index(canvas->cull_damage, GdkRectangle, i),
+                                    rect, NULL)) {
+            return TRUE;
+        }
+    }
+    return FALSE;
+}
+
+static void set_culled(DashboardCanvas *canvas, CanvasChild *child, gboolean culled) {
+    if (child->culled == culled) return;
+
+    child->culled = culled;
+    if (culled) {
+        canvas->culled++;
+        culled_total++;
+    } else {
+        canvas->culled--;
+        culled_total--;
+    }
+}
+
+/* Re-evaluate only the children touching areas that changed */
+static void update_culling(DashboardCanvas *canvas) {
+    if (canvas->cull_damage->len == 0) return;
+
+    for (guint i = 0; i < canvas->children->len; i++) {
+        CanvasChild *child = g_ptr_array_index(canvas->children, i);
+        if (child->culled || intersects_damage(canvas, &child->allocated)) {
+            set_culled(canvas, child, is_occluded(canvas, child));
+        }
+    }
+    g_array_set_size(canvas->cull_damage, 0);
+}
+
+static int compare_paint_order(gconstpointer a, gconstpointer b) {
+    const CanvasChild *x = *(CanvasChild * const *)a;
+    const CanvasChild *y = *(CanvasChild * const *)b;
+    return (x->index > y->index) - (x->index < y->index);
+}
+
+static gboolean is_natural_size(const CanvasChild *child) {
+    return child->rect.width <= 0 || child->rect.height <= 0;
+}
+
+/* Showing or hiding a child changes what it covers, and a child hidden
+ * when it was placed or moved has not been measured */
+static void on_child_visible(GtkWidget *widget, GParamSpec *pspec, gpointer user_data) {
+    DashboardCanvas *canvas = DASHBOARD_CANVAS(user_data);
+    CanvasChild *child = get_child(widget);
+    if (!child) return;
+
+    add_cull_damage(canvas, &child->allocated);
+    mark_dirty(canvas, child);
+    gtk_widget_queue_allocate(GTK_WIDGET(canvas));
+}
+
+/* ── GtkWidget ───────────────────────────────────────────── */
+
+static void update_extent(DashboardCanvas *canvas) {
+    if (canvas->extent_valid) return;
+
+    canvas->extent_width = 0;
+    canvas->extent_height = 0;
+    for (guint i = 0; i < canvas->children->len; i++) {
+        CanvasChild *child = g_ptr_array_index(canvas->children, i);
+        const GdkRectangle *r = child->allocated.width > 0 ? &child->allocated : &child->rect;
+        canvas->extent_width = MAX(canvas->extent_width, r->x + MAX(r->width, 0));
+        canvas->extent_height = MAX(canvas->extent_height, r->y + MAX(r->height, 0));
+    }
+    canvas->extent_valid = TRUE;
+}
+
+static void dashboard_canvas_measure(GtkWidget *widget, GtkOrientation orientation, int for_size,
+                                     int *minimum, int *natural,
+                                     int *minimum_baseline, int *natural_baseline) {
+    DashboardCanvas *canvas = DASHBOARD_CANVAS(widget);
+
+    /* Like GtkFixed, request the bounding box of the children */
+    update_extent(canvas);
+    *minimum = *natural = orientation == GTK_ORIENTATION_HORIZONTAL ? canvas->extent_width
+                                                                    : canvas->extent_height;
+    if (canvas->resize) *minimum = 0;
+}
+
+static void dashboard_canvas_size_allocate(GtkWidget *widget, int width, int height, int baseline) {
+    DashboardCanvas *canvas = DASHBOARD_CANVAS(widget);
+
+    canvas->allocating = TRUE;
+    if (canvas->resize && (width != canvas->width || height != canvas->height)) {
+        canvas->resize(canvas, width, height, canvas->resize_data);
+    }
+    canvas->width = width;
+    canvas->height = height;
+
+    /* Children placed at their natural size follow their content */
+    for (guint i = 0; i < canvas->natural->len; i++) {
+        mark_dirty(canvas, g_ptr_array_index(canvas->natural, i));
+    }
+
+    /* Only children that were placed, moved or sized by content are measured;
+     * the rest keep the rectangle of their last measurement */
+    for (guint i = 0; i < canvas->dirty->len; i++) {
+        CanvasChild *child = g_ptr_array_index(canvas->dirty, i);
+        child->dirty = FALSE;
+        if (gtk_widget_should_layout(child->widget)) {
+            update_allocation(canvas, child);
+        }
+    }
+    g_ptr_array_set_size(canvas->dirty, 0);
+
+    /* Every visible child is allocated on every pass, as GTK expects of a
+     * parent; one whose allocation is unchanged and that queued nothing
+     * itself returns without running its own size_allocate */
+    for (guint i = 0; i < canvas->children->len; i++) {
+        CanvasChild *child = g_ptr_array_index(canvas->children, i);
+        if (gtk_widget_should_layout(child->widget)) {
+            gtk_widget_size_allocate(child->widget, &child->allocated, -1);
+        }
+    }
+    canvas->allocating = FALSE;
+}
+
+static void snapshot_shadow(DashboardCanvas *canvas, CanvasChild *child, GtkSnapshot *snapshot) {
+    graphene_rect_t bounds;
+    GdkTexture *texture = child->shadow(child->widget,
+                                        scale_bin_get_raster_scale(GTK_WIDGET(canvas)), &bounds);
+    if (!texture) return;
+
+    graphene_rect_offset(&bounds, child->allocated.x, child->allocated.y);
+    gtk_snapshot_append_texture(snapshot, texture, &bounds);
+}
+
+static void dashboard_canvas_snapshot(GtkWidget *widget, GtkSnapshot *snapshot) {
+    DashboardCanvas *canvas = DASHBOARD_CANVAS(widget);
+
+    update_culling(canvas);
+
+    for (guint i = 0; i < canvas->children->len; i++) {
+        CanvasChild *child = g_ptr_array_index(canvas->children, i);
+        if (child->culled) continue;
+
+        if (!child->transformed) {
+            if (child->shadow) snapshot_shadow(canvas, child, snapshot);
+            gtk_widget_snapshot_child(widget, child->widget, snapshot);
+            continue;
+        }
+
+        /* Reuses the child's render node: no redraw of its content */
+        graphene_point_t centre = GRAPHENE_POINT_INIT(
+            child->allocated.x + child->allocated.width / 2.0f,
+            child->allocated.y + child->allocated.height / 2.0f);
+        gtk_snapshot_save(snapshot);
+        gtk_snapshot_translate(snapshot, &centre);
+        gtk_snapshot_rotate(snapshot, (float)child->rotation);
+        gtk_snapshot_scale(snapshot, (float)child->scale, (float)child->scale);
+        gtk_snapshot_translate(snapshot, &GRAPHENE_POINT_INIT(-centre.x, -centre.y));
+        if (child->shadow) snapshot_shadow(canvas, child, snapshot);
+        gtk_widget_snapshot_child(widget, child->widget, snapshot);
+        gtk_snapshot_restore(snapshot);
+    }
+}
+
+/* ── GObject ─────────────────────────────────────────────── */
+
+static void dashboard_canvas_dispose(GObject *object) {
+    DashboardCanvas *canvas = DASHBOARD_CANVAS(object);
+
+    dashboard_canvas_set_resize_func(canvas, NULL, NULL, NULL);
+    g_ptr_array_set_size(canvas->dirty, 0);
+    g_ptr_array_set_size(canvas->natural, 0);
+    g_ptr_array_set_size(canvas->occluders, 0);
+    while (canvas->children->len > 0) {
+        CanvasChild *child = g_ptr_array_index(canvas->children, canvas->children->len - 1);
+        dashboard_canvas_remove(canvas, child->widget);
+    }
+
+    G_OBJECT_CLASS(dashboard_canvas_parent_class)->dispose(object);
+}
+
+static void dashboard_canvas_finalize(GObject *object) {
+    DashboardCanvas *canvas = DASHBOARD_CANVAS(object);
+
+    g_ptr_array_free(canvas->children, TRUE);
+    g_ptr_array_free(canvas->dirty, TRUE);
+    g_ptr_array_free(canvas->natural, TRUE);
+    g_ptr_array_free(canvas->occluders, TRUE);
+    g_array_free(canvas->cull_damage, TRUE);
+
+    G_OBJECT_CLASS(dashboard_canvas_parent_class)->finalize(object);
+}
+
+static void dashboard_canvas_class_init(DashboardCanvasClass *klass) {
+    GObjectClass *object_class = G_OBJECT_CLASS(klass);
+    GtkWidgetClass *widget_class = GTK_WIDGET_CLASS(klass);
+
+    object_class->dispose = dashboard_canvas_dispose;
+    object_class->finalize = dashboard_canvas_finalize;
+    widget_class->measure = dashboard_canvas_measure;
+    widget_class->size_allocate = dashboard_canvas_size_allocate;
+    widget_class->snapshot = dashboard_canvas_snapshot;
+
+    child_quark = g_quark_from_static_string("dashboard-canvas-child");
+}
+
+static void dashboard_canvas_init(DashboardCanvas *canvas) {
+    canvas->children = g_ptr_array_new_with_free_func(g_free);
+    canvas->dirty = g_ptr_array_new();
+    canvas->natural = g_ptr_array_new();
+    canvas->occluders = g_ptr_array_new();
+    canvas->cull_damage = g_array_new(FALSE, FALSE, sizeof(GdkRectangle));
+}
+
+/* ── Public API ──────────────────────────────────────────── */
+
+GtkWidget* dashboard_canvas_new(void) {
+    return g_object_new(DASHBOARD_TYPE_CANVAS, NULL);
+}
+
+void dashboard_canvas_put(DashboardCanvas *canvas, GtkWidget *widget,
+                          int x, int y, int width, int height) {
+    g_return_if_fail(DASHBOARD_IS_CANVAS(canvas));
+    g_return_if_fail(gtk_widget_get_parent(widget) == NULL);
+
+    CanvasChild *child = g_new0(CanvasChild, 1);
+    child->widget = widget;
+    child->rect = (GdkRectangle){ x, y, width, height };
+    child->index = canvas->children->len;
+    child->scale = 1.0;
+
+    g_object_set_qdata(G_OBJECT(widget), child_quark, child);
+    g_ptr_array_add(canvas->children, child);
+    if (is_natural_size(child)) g_ptr_array_add(canvas->natural, child);
+
+    /* Appending keeps paint order == insertion order */
+    gtk_widget_insert_before(widget, GTK_WIDGET(canvas), NULL);
+    g_signal_connect(widget, "notify::visible", G_CALLBACK(on_child_visible), canvas);
+
+    mark_dirty(canvas, child);
+    canvas->extent_valid = FALSE;
+    gtk_widget_queue_resize(GTK_WIDGET(canvas));
+}
+
+void dashboard_canvas_move(DashboardCanvas *canvas, GtkWidget *widget,
+                           int x, int y, int width, int height) {
+    g_return_if_fail(DASHBOARD_IS_CANVAS(canvas));
+
+    CanvasChild *child = get_child(widget);
+    g_return_if_fail(child != NULL);
+
+    GdkRectangle rect = { x, y, width, height };
+    if (gdk_rectangle_equal(&rect, &child->rect)) return;
+
+    gboolean was_natural = is_natural_size(child);
+    child->rect = rect;
+    if (was_natural && !is_natural_size(child)) {
+        g_ptr_array_remove_fast(canvas->natural, child);
+    } else if (!was_natural && is_natural_size(child)) {
+        g_ptr_array_add(canvas->natural, child);
+    }
+
+    mark_dirty(canvas, child);
+    canvas->extent_valid = FALSE;
+    if (!canvas->allocating) gtk_widget_queue_allocate(GTK_WIDGET(canvas));
+}
+
+void dashboard_canvas_remove(DashboardCanvas *canvas, GtkWidget *widget) {
+    g_return_if_fail(DASHBOARD_IS_CANVAS(canvas));
+
+    CanvasChild *child = get_child(widget);
+    g_return_if_fail(child != NULL);
+
+    if (child->dirty) g_ptr_array_remove_fast(canvas->dirty, child);
+    if (is_natural_size(child)) g_ptr_array_remove_fast(canvas->natural, child);
+    if (child->has_opaque) g_ptr_array_remove(canvas->occluders, child);
+    set_culled(canvas, child, FALSE);
+    add_cull_damage(canvas, &child->allocated);
+
+    /* Keep indices contiguous for the children painted above */
+    for (guint i = child->index + 1; i < canvas->children->len; i++) {
+        ((CanvasChild *)g_ptr_array_index(canvas->children, i))->index--;
+    }
+
+    g_signal_handlers_disconnect_by_func(widget, on_child_visible, canvas);
+    g_object_set_qdata(G_OBJECT(widget), child_quark, NULL);
+    gtk_widget_unparent(widget);
+    g_ptr_array_remove_index(canvas->children, child->index);  /* Frees child */
+
+    canvas->extent_valid = FALSE;
+    gtk_widget_queue_resize(GTK_WIDGET(canvas));
+}
+
+void dashboard_canvas_set_opaque(DashboardCanvas *canvas, GtkWidget *widget,
+                                 const GdkRectangle *opaque) {
+    g_return_if_fail(DASHBOARD_IS_CANVAS(canvas));
+
+    CanvasChild *child = get_child(widget);
+    g_return_if_fail(child != NULL);
+
+    gboolean has_opaque = opaque && opaque->width > 0 && opaque->height > 0;
+    if (has_opaque == child->has_opaque &&
+        (!has_opaque || gdk_rectangle_equal(opaque, &child->opaque))) {
+        return;
+    }
+
+    if (has_opaque && !child->has_opaque) {
+        g_ptr_array_add(canvas->occluders, child);
+        g_ptr_array_sort(canvas->occluders, compare_paint_order);
+    } else if (!has_opaque && child->has_opaque) {
+        g_ptr_array_remove(canvas->occluders, child);
+    }
+
+    child->has_opaque = has_opaque;
+    if (has_opaque) child->opaque = *opaque;
+
+    add_cull_damage(canvas, &child->allocated);
+    gtk_widget_queue_draw(GTK_WIDGET(canvas));
+}
+
+void dashboard_canvas_set_transform(DashboardCanvas *canvas, GtkWidget *widget,
+                                    double rotation, double scale) {
+    g_return_if_fail(DASHBOARD_IS_CANVAS(canvas));
+
+    CanvasChild *child = get_child(widget);
+    g_return_if_fail(child != NULL);
+
+    if (rotation == child->rotation && scale == child->scale) return;
+
+    gboolean transformed = rotation != 0.0 || scale != 1.0;
+    if (transformed != child->transformed) {
+        add_cull_damage(canvas, &child->allocated);
+    }
+    child->rotation = rotation;
+    child->scale = scale;
+    child->transformed = transformed;
+
+    gtk_widget_queue_draw(GTK_WIDGET(canvas));
+}
+
+void dashboard_canvas_set_opacity(DashboardCanvas *canvas, GtkWidget *widget, double opacity) {
+    g_return_if_fail(DASHBOARD_IS_CANVAS(canvas));
+
+    CanvasChild *child = get_child(widget);
+    g_return_if_fail(child != NULL);
+
+    /* Only crossing full opacity changes what the child hides */
+    if ((gtk_widget_get_opacity(widget) >= 1.0) != (opacity >= 1.0)) {
+        add_cull_damage(canvas, &child->allocated);
+    }
+    gtk_widget_set_opacity(widget, opacity);
+}
+
+void dashboard_canvas_set_resize_func(DashboardCanvas *canvas, DashboardResizeFunc resize,
+                                      gpointer user_data, GDestroyNotify destroy) {
+    g_return_if_fail(DASHBOARD_IS_CANVAS(canvas));
+
+    if (canvas->resize_destroy) canvas->resize_destroy(canvas->resize_data);
+    canvas->resize = resize;
+    canvas->resize_data = user_data;
+    canvas->resize_destroy = destroy;
+
+    /* The next allocation reports its size even if unchanged */
+    canvas->width = canvas->height = -1;
+    gtk_widget_queue_resize(GTK_WIDGET(canvas));
+}
+
+void dashboard_canvas_set_shadow(DashboardCanvas *canvas, GtkWidget *widget,
+                                 DashboardShadowFunc shadow) {
+    g_return_if_fail(DASHBOARD_IS_CANVAS(canvas));
+
+    CanvasChild *child = get_child(widget);
+    g_return_if_fail(child != NULL);
+
+    if (shadow == child->shadow) return;
+    child->shadow = shadow;
+    add_cull_damage(canvas, &child->allocated);
+    gtk_widget_queue_draw(GTK_WIDGET(canvas));
+}
+
+guint dashboard_canvas_get_culled(DashboardCanvas *canvas) {
+    g_return_val_if_fail(DASHBOARD_IS_CANVAS(canvas), 0);
+    return canvas->culled;
+}
+
+guint dashboard_canvas_get_culled_total(void) {
+    return culled_total;
+}
@@ -0,0 +1,79 @@
+#ifndef DASHBOARD_CANVAS_H
+#define DASHBOARD_CANVAS_H
+
+#include <gtk/gtk.h>
+
+/*
+ * Absolute-positioning container for dashboard layouts.
+ *
+ * Replaces GtkFixed: every child has a precomputed rectangle from its
+ * WidgetConfig. Children with a fixed size are measured once, when they
+ * are added or moved; only children placed with a size <= 0 (natural
+ * size) are measured on every pass. Every visible child is still
+ * allocated on every pass, which GTK turns into an early return for a
+ * child whose allocation is unchanged and that queued nothing itself.
+ * Children are drawn in insertion order.
+ *
+ * Children can declare an opaque area. A child whose allocation lies
+ * entirely inside the opaque area of one visible child painted above it
+ * is not snapshotted at all. Culling is re-evaluated only for children
+ * touching an area whose geometry, opacity or visibility changed.
+ *
+ * A child can be rotated and scaled about its centre. The transform is
+ * applied to the child's cached render node when the canvas is
+ * snapshotted, so changing it never redraws the child itself. Transformed
+ * or translucent children neither occlude nor get culled, and input
+ * still goes to their untransformed allocation.
+ *
+ * A child can cast a shadow: a texture painted just below it (and
+ * transformed with it), supplied for the current scale factor by a
+ * callback that is expected to cache it. Children with a shadow are never
+ * culled, since the shadow can reach past their opaque cover.
+ *
+ * A resize callback lets children follow the canvas size: it runs at the
+ * start of an allocation whose size changed and may move children, which
+ * are then allocated in the same pass. Such a canvas requests no minimum
+ * size, since its layout adapts to whatever it gets.
+ */
+
+/* Shadow of child rasterized at scale device pixels per unit, bounds in
+ * child coordinates; borrowed */
+typedef GdkTexture* (*DashboardShadowFunc)(GtkWidget *child, double scale, graphene_rect_t *bounds);
+
+#define DASHBOARD_TYPE_CANVAS (dashboard_canvas_get_type())
+G_DECLARE_FINAL_TYPE(DashboardCanvas, dashboard_canvas, DASHBOARD, CANVAS, GtkWidget)
+
+typedef void (*DashboardResizeFunc)(DashboardCanvas *canvas, int width, int height,
+                                    gpointer user_data);
+
+GtkWidget* dashboard_canvas_new(void);
+
+/* width/height <= 0 use the child's natural size */
+void dashboard_canvas_put(DashboardCanvas *canvas, GtkWidget *child,
+                          int x, int y, int width, int height);
+void dashboard_canvas_move(DashboardCanvas *canvas, GtkWidget *child,
+                           int x, int y, int width, int height);
+void dashboard_canvas_remove(DashboardCanvas *canvas, GtkWidget *child);
+
+/* Area of child (in its own coordinates) that it paints fully opaque,
+ * NULL or empty if none */
+void dashboard_canvas_set_opaque(DashboardCanvas *canvas, GtkWidget *child,
+                                 const GdkRectangle *opaque);
+/* Rotation in degrees clockwise and uniform scale, about the child's centre */
+void dashboard_canvas_set_transform(DashboardCanvas *canvas, GtkWidget *child,
+                                    double rotation, double scale);
+/* Like gtk_widget_set_opacity(), keeping occlusion culling correct */
+void dashboard_canvas_set_opacity(DashboardCanvas *canvas, GtkWidget *child, double opacity);
+/* Called with the new size before children are allocated; user_data is
+ * released with destroy when replaced or when the canvas is disposed */
+void dashboard_canvas_set_resize_func(DashboardCanvas *canvas, DashboardResizeFunc resize,
+                                      gpointer user_data, GDestroyNotify destroy);
+/* NULL removes the shadow */
+void dashboard_canvas_set_shadow(DashboardCanvas *canvas, GtkWidget *child,
+                                 DashboardShadowFunc shadow);
+
+guint dashboard_canvas_get_culled(DashboardCanvas *canvas);
+/* Culled children over every canvas of the process */
+guint dashboard_canvas_get_culled_total(void);
+
+#endif /* DASHBOARD_CANVAS_H */
@@ -0,0 +1,342 @@
+#include "data_feed.h"
+#include "tracer.h"
+#include <gio/gio.h>
+#include <math.h>
+#include <string.h>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+typedef struct {
+    guint id;
+    DataFeedFunc func;
+    gpointer user_data;
+} Subscription;
+
+typedef struct {
+    GPtrArray *subscribers;  /* Subscription* */
+    double last_value;
+    gboolean has_value;
+    guint64 samples;
+    gint64 last_sample_us;
+} Channel;
+
+/* A running source */
+typedef struct {
+    const char *channel;     /* Interned */
+    FeedConfig *config;      /* Borrowed from the layout */
+    guint timer;
+    double phase_ms;         /* "sine": position in the wave */
+    double value;            /* "random": current walk position */
+    GDataInputStream *stream;
+    GCancellable *cancellable;
+    gboolean stalled;        /* File: next read deferred until resumed */
+} Source;
+
+static GHashTable *channels = NULL;   /* channel -> Channel* */
+static GPtrArray *sources = NULL;     /* Source* */
+static guint next_subscription = 1;
+static gboolean paused = FALSE;
+static gboolean sources_enabled = TRUE;
+static DataFeedChangeFunc change_func = NULL;
+static gpointer change_data = NULL;
+static DataFeedFunc tap_func = NULL;
+static gpointer tap_data = NULL;
+static guint64 published = 0;
+
+static void channel_free(gpointer data) {
+    Channel *channel = (Channel *)data;
+    g_ptr_array_unref(channel->subscribers);
+    g_free(channel);
+}
+
+/* ── Subscriptions ───────────────────────────────────────── */
+
+guint data_feed_subscribe(const char *channel, DataFeedFunc func, gpointer user_data) {
+    g_return_val_if_fail(channel != NULL && func != NULL, 0);
+
+    if (!channels) {
+        channels = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, channel_free);
+    }
+
+    Channel *entry = g_hash_table_lookup(channels, channel);
+    if (!entry) {
+        entry = g_new0(Channel, 1);
+        entry->subscribers = g_ptr_array_new_with_free_func(g_free);
+        g_hash_table_insert(channels, g_strdup(channel), entry);
+    }
+
+    Subscription *sub = g_new(Subscription, 1);
+    sub->id = next_subscription++;
+    sub->func = func;
+    sub->user_data = user_data;
+    g_ptr_array_add(entry->subscribers, sub);
+    return sub->id;
+}
+
+void data_feed_unsubscribe(guint id) {
+    if (!channels || id == 0) return;
+
+    GHashTableIter iter;
+    gpointer value;
+    g_hash_table_iter_init(&iter, channels);
+    while (g_hash_table_iter_next(&iter, NULL, &value)) {
+        GPtrArray *subscribers = ((Channel *)value)->subscribers;
+        for (guint i = 0; i < subscribers->len; i++) {
+            Subscription *sub = g_ptr_array_index(subscribers, i);
+            if (sub->id == id) {
+                g_ptr_array_remove_index(subscribers, i);
+                if (subscribers->len == 0) g_hash_table_iter_remove(&iter);
+                return;
+            }
+        }
+    }
+}
+
+void data_feed_publish(const char *channel, double value) {
+    if (tap_func) tap_func(channel, value, tap_data);
+    published++;
+    if (!channels) return;
+
+    Channel *entry = g_hash_table_lookup(channels, channel);
+    if (!entry) return;
+
+    if (change_func && (!entry->has_value || value != entry->last_value)) {
+        change_func(change_data);
+    }
+    entry->last_value = value;
+    entry->has_value = TRUE;
+    entry->samples++;
+    entry->last_sample_us = g_get_monotonic_time();
+
+    for (guint i = 0; i < entry->subscribers->len; i++) {
+        Subscription *sub = g_ptr_array_index(entry->subscribers, i);
+        sub->func(channel, value, sub->user_data);
+    }
+}
+
+/* ── Generators ──────────────────────────────────────────── */
+
+static gboolean on_sine_tick(gpointer user_data) {
+    Source *source = (Source *)user_data;
+    FeedConfig *config = source->config;
+    double mid = (config->min + config->max) / 2.0;
+    double amplitude = (config->max - config->min) / 2.0;
+    double step_ms = (double)config->interval_ms / MAX(config->samples_per_tick, 1);
+
+    tracer_begin("feed_update", source->channel);
+    for (int i = 0; i < MAX(config->samples_per_tick, 1); i++) {
+        source->phase_ms = fmod(source->phase_ms + step_ms, config->period_ms);
+        data_feed_publish(source->channel,
+                          mid + amplitude * sin(2.0 * M_PI * source->phase_ms / config->period_ms));
+    }
+    tracer_end("feed_update");
+    return G_SOURCE_CONTINUE;
+}
+
+/* Bounded random walk */
+static gboolean on_random_tick(gpointer user_data) {
+    Source *source = (Source *)user_data;
+    FeedConfig *config = source->config;
+    double step = (config->max - config->min) * 0.05;
+
+    tracer_begin("feed_update", source->channel);
+    for (int i = 0; i < MAX(config->samples_per_tick, 1); i++) {
+        source->value = CLAMP(source->value + g_random_double_range(-step, step),
+                              config->min, config->max);
+        data_feed_publish(source->channel, source->value);
+    }
+    tracer_end("feed_update");
+    return G_SOURCE_CONTINUE;
+}
+
+/* ── File / FIFO ─────────────────────────────────────────── */
+
+static void read_next_line(Source *source);
+
+static void publish_line(Source *source, char *line) {
+    char *end;
+    double value = g_ascii_strtod(line, &end);
+    if (end != line) {
+        data_feed_publish(source->channel, value);
+        return;
+    }
+
+    /* "channel value" */
+    char **parts = g_strsplit_set(g_strstrip(line), " \t", 2);
+    if (parts[0] && parts[1]) {
+        value = g_ascii_strtod(parts[1], &end);
+        if (end != parts[1]) data_feed_publish(parts[0], value);
+    }
+    g_strfreev(parts);
+}
+
+static void on_line_read(GObject *object, GAsyncResult *result, gpointer user_data) {
+    GError *error = NULL;
+    char *line = g_data_input_stream_read_line_finish(G_DATA_INPUT_STREAM(object), result,
+                                                      NULL, &error);
+
+    /* Source is gone: user_data must not be touched */
+    if (g_error_matches(error, G_IO_ERROR, G_IO_ERROR_CANCELLED)) {
+        g_error_free(error);
+        return;
+    }
+
+    Source *source = (Source *)user_data;
+    if (error) {
+        g_warning("Feed '%s': read failed: %s", source->channel, error->message);
+        g_error_free(error);
+        return;
+    }
+    if (!line) return;  /* End of file */
+
+    tracer_begin("feed_update", source->channel);
+    publish_line(source, line);
+    tracer_end("feed_update");
+    g_free(line);
+
+    if (paused) {
+        source->stalled = TRUE;
+    } else {
+        read_next_line(source);
+    }
+}
+
+static void read_next_line(Source *source) {
+    g_data_input_stream_read_line_async(source->stream, G_PRIORITY_DEFAULT,
+                                        source->cancellable, on_line_read, source);
+}
+
+static void on_file_opened(GObject *object, GAsyncResult *result, gpointer user_data) {
+    GError *error = NULL;
+    GFileInputStream *input = g_file_read_finish(G_FILE(object), result, &error);
+
+    if (g_error_matches(error, G_IO_ERROR, G_IO_ERROR_CANCELLED)) {
+        g_error_free(error);
+        return;
+    }
+
+    Source *source = (Source *)user_data;
+    if (!input) {
+        g_warning("Feed '%s': %s", source->channel, error->message);
+        g_error_free(error);
+        return;
+    }
+
+    source->stream = g_data_input_stream_new(G_INPUT_STREAM(input));
+    g_object_unref(input);
+    if (paused) {
+        source->stalled = TRUE;
+    } else {
+        read_next_line(source);
+    }
+}
+
+/* ── Lifecycle ───────────────────────────────────────────── */
+
+static void start_timer(Source *source) {
+    guint interval = MAX(source->config->interval_ms, 1);
+    source->timer = g_timeout_add(interval, strcmp(source->config->kind, "sine") == 0
+                                            ? on_sine_tick : on_random_tick, source);
+}
+
+static void source_free(gpointer data) {
+    Source *source = (Source *)data;
+
+    if (source->timer) g_source_remove(source->timer);
+    g_cancellable_cancel(source->cancellable);
+    g_object_unref(source->cancellable);
+    g_clear_object(&source->stream);
+    g_free(source);
+}
+
+void data_feed_start(GList *feeds) {
+    data_feed_stop();
+    if (!sources_enabled) return;
+    if (!sources) sources = g_ptr_array_new_with_free_func(source_free);
+
+    for (GList *l = feeds; l != NULL; l = l->next) {
+        FeedConfig *config = (FeedConfig *)l->data;
+        if (!config->id || !config->kind) {
+            g_warning("Ignoring feed without id or kind");
+            continue;
+        }
+
+        Source *source = g_new0(Source, 1);
+        source->channel = g_intern_string(config->id);
+        source->config = config;
+        source->value = (config->min + config->max) / 2.0;
+        source->cancellable = g_cancellable_new();
+
+        if ((strcmp(config->kind, "sine") == 0 && config->period_ms > 0) ||
+            strcmp(config->kind, "random") == 0) {
+            if (!paused) start_timer(source);
+        } else if (strcmp(config->kind, "file") == 0 && config->path) {
+            GFile *file = g_file_new_for_path(config->path);
+            g_file_read_async(file, G_PRIORITY_DEFAULT, source->cancellable, on_file_opened, source);
+            g_object_unref(file);
+        } else {
+            g_warning("Feed '%s': unsupported kind '%s'", config->id, config->kind);
+            source_free(source);
+            continue;
+        }
+        g_ptr_array_add(sources, source);
+    }
+}
+
+void data_feed_stop(void) {
+    if (sources) g_ptr_array_set_size(sources, 0);
+}
+
+void data_feed_set_paused(gboolean pause) {
+    if (pause == paused) return;
+    paused = pause;
+
+    for (guint i = 0; sources && i < sources->len; i++) {
+        Source *source = g_ptr_array_index(sources, i);
+        if (strcmp(source->config->kind, "file") != 0) {
+            if (paused && source->timer) {
+                g_source_remove(source->timer);
+                source->timer = 0;
+            } else if (!paused && !source->timer) {
+                start_timer(source);
+            }
+        } else if (!paused && source->stalled) {
+            source->stalled = FALSE;
+            read_next_line(source);
+        }
+    }
+}
+
+void data_feed_set_sources_enabled(gboolean enabled) {
+    sources_enabled = enabled;
+}
+
+void data_feed_set_change_func(DataFeedChangeFunc func, gpointer user_data) {
+    change_func = func;
+    change_data = user_data;
+}
+
+void data_feed_set_tap(DataFeedFunc func, gpointer user_data) {
+    tap_func = func;
+    tap_data = user_data;
+}
+
+/* ── Statistics ──────────────────────────────────────────── */
+
+guint64 data_feed_get_sample_count(void) {
+    return published;
+}
+
+void data_feed_foreach_channel(DataFeedChannelFunc func, gpointer user_data) {
+    if (!channels) return;
+
+    GHashTableIter iter;
+    gpointer key, value;
+    g_hash_table_iter_init(&iter, channels);
+    while (g_hash_table_iter_next(&iter, &key, &value)) {
+        Channel *channel = (Channel *)value;
+        func((const char *)key, channel->samples, channel->last_sample_us, user_data);
+    }
+}
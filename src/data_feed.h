@@ -0,0 +1,51 @@
+#ifndef DATA_FEED_H
+#define DATA_FEED_H
+
+#include <glib.h>
+#include "json_parser.h"
+
+/*
+ * Named numeric data channels.
+ *
+ * The "feeds" of a layout publish samples to channels; widgets such as
+ * Chart subscribe to a channel by name. Generators ("sine", "random") run
+ * on main-loop timers. "file" feeds read a file or FIFO asynchronously,
+ * one sample per line: "value" goes to the feed's own channel and
+ * "channel value" to the named one. Everything runs on the main thread.
+ *
+ * Sources can be paused: generators stop ticking and file feeds stop
+ * reading (a FIFO writer then blocks) until they are resumed. With
+ * sources disabled, data_feed_start() starts none of them and channels
+ * only get what data_feed_publish() callers send (a replayed workload).
+ */
+
+typedef void (*DataFeedFunc)(const char *channel, double value, gpointer user_data);
+typedef void (*DataFeedChangeFunc)(gpointer user_data);
+typedef void (*DataFeedChannelFunc)(const char *channel, guint64 samples, gint64 last_sample_us,
+                                    gpointer user_data);
+
+guint data_feed_subscribe(const char *channel, DataFeedFunc func, gpointer user_data);
+void data_feed_unsubscribe(guint id);
+
+/* Deliver a sample to every subscriber of channel */
+void data_feed_publish(const char *channel, double value);
+
+/* Start the sources of a list of FeedConfig*, stopping the previous ones */
+void data_feed_start(GList *feeds);
+void data_feed_stop(void);
+void data_feed_set_paused(gboolean paused);
+/* Before data_feed_start(); enabled by default */
+void data_feed_set_sources_enabled(gboolean enabled);
+
+/* Called when a subscribed channel gets a value different from its last one */
+void data_feed_set_change_func(DataFeedChangeFunc func, gpointer user_data);
+/* Called with every published sample, subscribed channel or not */
+void data_feed_set_tap(DataFeedFunc func, gpointer user_data);
+
+/* Samples published since start, subscribed channel or not */
+guint64 data_feed_get_sample_count(void);
+/* Every subscribed channel with the samples it got since its first
+ * subscriber and the monotonic time of the last one (0 = none yet) */
+void data_feed_foreach_channel(DataFeedChannelFunc func, gpointer user_data);
+
+#endif /* DATA_FEED_H */
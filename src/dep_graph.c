@@ -0,0 +1,144 @@
+#include "dep_graph.h"
+
+#define PENDING_BITS (GLIB_SIZEOF_LONG * 8)
+
+struct _DepNode {
+    gpointer data;
+    GPtrArray *dependents;   /* DepNode* reading this one, NULL if none */
+    guint order;             /* Position in dependency order */
+    guint unsorted_sources;  /* Sorting only */
+};
+
+struct _DepGraph {
+    GPtrArray *nodes;        /* DepNode*, sources before dependents once sorted */
+    gulong *pending;         /* Bit per node order: to be updated */
+    gboolean sorted;
+    GDestroyNotify free_data;
+};
+
+DepGraph* dep_graph_new(GDestroyNotify free_data) {
+    DepGraph *graph = g_new0(DepGraph, 1);
+    graph->nodes = g_ptr_array_new();
+    graph->free_data = free_data;
+    return graph;
+}
+
+void dep_graph_free(DepGraph *graph) {
+    if (!graph) return;
+
+    for (guint i = 0; i < graph->nodes->len; i++) {
+        DepNode *node = g_ptr_array_index(graph->nodes, i);
+        if (graph->free_data) graph->free_data(node->data);
+        if (node->dependents) g_ptr_array_free(node->dependents, TRUE);
+        g_free(node);
+    }
+    g_ptr_array_free(graph->nodes, TRUE);
+    g_free(graph->pending);
+    g_free(graph);
+}
+
+DepNode* dep_graph_add_node(DepGraph *graph, gpointer data) {
+    g_return_val_if_fail(graph != NULL && !graph->sorted, NULL);
+
+    DepNode *node = g_new0(DepNode, 1);
+    node->data = data;
+    g_ptr_array_add(graph->nodes, node);
+    return node;
+}
+
+void dep_graph_add_edge(DepGraph *graph, DepNode *source, DepNode *dependent) {
+    g_return_if_fail(graph != NULL && !graph->sorted);
+
+    if (!source->dependents) source->dependents = g_ptr_array_new();
+    if (!g_ptr_array_find(source->dependents, dependent, NULL)) {
+        g_ptr_array_add(source->dependents, dependent);
+    }
+}
+
+gboolean dep_node_has_dependents(const DepNode *node) {
+    return node->dependents != NULL;
+}
+
+/* Kahn's algorithm; every node left over lies on or behind a cycle */
+gboolean dep_graph_sort(DepGraph *graph, gpointer *cycle_data) {
+    g_return_val_if_fail(graph != NULL && !graph->sorted, FALSE);
+
+    GPtrArray *sorted = g_ptr_array_sized_new(graph->nodes->len);
+
+    for (guint i = 0; i < graph->nodes->len; i++) {
+        DepNode *node = g_ptr_array_index(graph->nodes, i);
+        for (guint k = 0; node->dependents && k < node->dependents->len; k++) {
+            ((DepNode *)g_ptr_array_index(node->dependents, k))->unsorted_sources++;
+        }
+    }
+    for (guint i = 0; i < graph->nodes->len; i++) {
+        DepNode *node = g_ptr_array_index(graph->nodes, i);
+        if (node->unsorted_sources == 0) g_ptr_array_add(sorted, node);
+    }
+
+    /* sorted doubles as the queue */
+    for (guint i = 0; i < sorted->len; i++) {
+        DepNode *node = g_ptr_array_index(sorted, i);
+        node->order = i;
+        for (guint k = 0; node->dependents && k < node->dependents->len; k++) {
+            DepNode *dependent = g_ptr_array_index(node->dependents, k);
+            if (--dependent->unsorted_sources == 0) g_ptr_array_add(sorted, dependent);
+        }
+    }
+
+    if (sorted->len < graph->nodes->len) {
+        for (guint i = 0; i < graph->nodes->len; i++) {
+            DepNode *node = g_ptr_array_index(graph->nodes, i);
+            if (node->unsorted_sources > 0) {
+                if (cycle_data) *cycle_data = node->data;
+                break;
+            }
+        }
+        g_ptr_array_free(sorted, TRUE);
+        return FALSE;
+    }
+
+    g_ptr_array_free(graph->nodes, TRUE);
+    graph->nodes = sorted;
+    graph->pending = g_new0(gulong, (sorted->len + PENDING_BITS - 1) / PENDING_BITS);
+    graph->sorted = TRUE;
+    return TRUE;
+}
+
+guint dep_graph_get_n_nodes(const DepGraph *graph) {
+    return graph->nodes->len;
+}
+
+gpointer dep_graph_get_data(const DepGraph *graph, guint index) {
+    g_return_val_if_fail(index < graph->nodes->len, NULL);
+    return ((DepNode *)g_ptr_array_index(graph->nodes, index))->data;
+}
+
+void dep_graph_mark(DepGraph *graph, DepNode *node) {
+    g_return_if_fail(graph->sorted);
+    graph->pending[node->order / PENDING_BITS] |= (gulong)1 << (node->order % PENDING_BITS);
+}
+
+gboolean dep_graph_mark_dependents(DepGraph *graph, DepNode *node) {
+    for (guint i = 0; node->dependents && i < node->dependents->len; i++) {
+        dep_graph_mark(graph, g_ptr_array_index(node->dependents, i));
+    }
+    return node->dependents != NULL;
+}
+
+/* Dependents always sort after their sources, so a single forward scan
+ * picks up everything marked while updating */
+void dep_graph_update(DepGraph *graph, DepGraphUpdateFunc update, gpointer user_data) {
+    g_return_if_fail(graph != NULL && graph->sorted);
+
+    guint n_words = (graph->nodes->len + PENDING_BITS - 1) / PENDING_BITS;
+    for (guint w = 0; w < n_words; w++) {
+        while (graph->pending[w]) {
+            gint bit = g_bit_nth_lsf(graph->pending[w], -1);
+            graph->pending[w] &= ~((gulong)1 << bit);
+
+            DepNode *node = g_ptr_array_index(graph->nodes, w * PENDING_BITS + bit);
+            if (update(node->data, user_data)) dep_graph_mark_dependents(graph, node);
+        }
+    }
+}
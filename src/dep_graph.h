@@ -0,0 +1,46 @@
+#ifndef DEP_GRAPH_H
+#define DEP_GRAPH_H
+
+#include <glib.h>
+
+/*
+ * One-way dependency graph with incremental updates, shared by the
+ * layout solver and the prop binding graph.
+ *
+ * Nodes carry the caller's data. Once all edges are in, the graph is
+ * sorted (a cycle is an error). Afterwards nodes are marked as pending,
+ * and an update visits the pending ones in dependency order; wherever
+ * the update func reports a change, the node's dependents are marked
+ * and visited in the same pass.
+ */
+
+typedef struct _DepGraph DepGraph;
+typedef struct _DepNode DepNode;
+
+/* Bring the data of one node up to date; TRUE when it changed */
+typedef gboolean (*DepGraphUpdateFunc)(gpointer data, gpointer user_data);
+
+/* free_data is called on the data of every node when the graph is freed */
+DepGraph* dep_graph_new(GDestroyNotify free_data);
+void dep_graph_free(DepGraph *graph);
+
+DepNode* dep_graph_add_node(DepGraph *graph, gpointer data);
+/* dependent reads source; a repeated edge is ignored */
+void dep_graph_add_edge(DepGraph *graph, DepNode *source, DepNode *dependent);
+gboolean dep_node_has_dependents(const DepNode *node);
+
+/* Puts the nodes in dependency order. On a cycle returns FALSE and sets
+ * cycle_data to the data of a node on or behind it. */
+gboolean dep_graph_sort(DepGraph *graph, gpointer *cycle_data);
+
+/* Data by position: insertion order, dependency order once sorted */
+guint dep_graph_get_n_nodes(const DepGraph *graph);
+gpointer dep_graph_get_data(const DepGraph *graph, guint index);
+
+/* Sorted graphs only */
+void dep_graph_mark(DepGraph *graph, DepNode *node);
+/* FALSE when the node has no dependents */
+gboolean dep_graph_mark_dependents(DepGraph *graph, DepNode *node);
+void dep_graph_update(DepGraph *graph, DepGraphUpdateFunc update, gpointer user_data);
+
+#endif /* DEP_GRAPH_H */
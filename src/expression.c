@@ -0,0 +1,564 @@
+#include "expression.h"
+#include <gio/gio.h>
+#include <math.h>
+#include <string.h>
+
+typedef enum {
+    OP_NUMBER,
+    OP_STRING,
+    OP_REFERENCE,
+    OP_NEGATE,
+    OP_NOT,
+    OP_ADD,
+    OP_SUBTRACT,
+    OP_MULTIPLY,
+    OP_DIVIDE,
+    OP_MODULO,
+    OP_LESS,
+    OP_LESS_EQUAL,
+    OP_GREATER,
+    OP_GREATER_EQUAL,
+    OP_EQUAL,
+    OP_NOT_EQUAL,
+    OP_AND,
+    OP_OR,
+    OP_SELECT,               /* cond a b -> a or b */
+    OP_CALL
+} Opcode;
+
+typedef struct {
+    Opcode op;
+    guint arg;               /* String, reference or function index */
+    guint argc;              /* OP_CALL: arguments on the stack */
+    double number;           /* OP_NUMBER */
+} Instruction;
+
+struct _Expression {
+    GArray *code;            /* Instruction, postfix */
+    GPtrArray *strings;      /* Text constants */
+    GPtrArray *reference_ids;
+    GPtrArray *reference_properties;
+    guint max_depth;         /* Stack slots evaluation needs */
+};
+
+typedef enum {
+    FUNCTION_ABS,
+    FUNCTION_ROUND,
+    FUNCTION_FLOOR,
+    FUNCTION_CEIL,
+    FUNCTION_SQRT,
+    FUNCTION_MIN,
+    FUNCTION_MAX,
+    FUNCTION_CLAMP
+} Function;
+
+static const struct {
+    const char *name;
+    guint min_args;
+    guint max_args;
+} functions[] = {
+    [FUNCTION_ABS]   = { "abs",   1, 1 },
+    [FUNCTION_ROUND] = { "round", 1, 1 },
+    [FUNCTION_FLOOR] = { "floor", 1, 1 },
+    [FUNCTION_CEIL]  = { "ceil",  1, 1 },
+    [FUNCTION_SQRT]  = { "sqrt",  1, 1 },
+    [FUNCTION_MIN]   = { "min",   2, G_MAXUINT },
+    [FUNCTION_MAX]   = { "max",   2, G_MAXUINT },
+    [FUNCTION_CLAMP] = { "clamp", 3, 3 },
+};
+
+/* ── Values ──────────────────────────────────────────────── */
+
+void expression_value_clear(ExpressionValue *value) {
+    g_free(value->string);
+    value->type = EXPRESSION_NUMBER;
+    value->number = 0.0;
+    value->string = NULL;
+}
+
+static void set_number(ExpressionValue *value, double number) {
+    expression_value_clear(value);
+    value->number = number;
+}
+
+/* Takes ownership of string */
+static void set_string(ExpressionValue *value, char *string) {
+    expression_value_clear(value);
+    value->type = EXPRESSION_STRING;
+    value->string = string;
+}
+
+void expression_value_copy(ExpressionValue *dest, const ExpressionValue *src) {
+    if (src->type == EXPRESSION_STRING) {
+        set_string(dest, g_strdup(src->string));
+    } else {
+        set_number(dest, src->number);
+    }
+}
+
+gboolean expression_value_equal(const ExpressionValue *a, const ExpressionValue *b) {
+    if (a->type != b->type) return FALSE;
+    if (a->type == EXPRESSION_STRING) return g_strcmp0(a->string, b->string) == 0;
+    return a->number == b->number || (isnan(a->number) && isnan(b->number));
+}
+
+gboolean expression_value_is_true(const ExpressionValue *value) {
+    if (value->type == EXPRESSION_STRING) return value->string && value->string[0] != '\0';
+    return value->number != 0.0 && !isnan(value->number);
+}
+
+double expression_value_to_number(const ExpressionValue *value) {
+    if (value->type == EXPRESSION_NUMBER) return value->number;
+    return value->string ? g_ascii_strtod(value->string, NULL) : 0.0;
+}
+
+/* Conversion character of a checked format, 0 for none; FALSE if invalid */
+static gboolean parse_format(const char *format, char *conversion) {
+    *conversion = 0;
+
+    for (const char *p = format; *p; p++) {
+        if (*p != '%') continue;
+        if (*++p == '%') continue;
+        if (*conversion) return FALSE;
+
+        while (*p && strchr("-+ #0", *p)) p++;
+        for (int digits = 0; g_ascii_isdigit(*p); p++) {
+            if (++digits > 2) return FALSE;
+        }
+        if (*p == '.') {
+            p++;
+            for (int digits = 0; g_ascii_isdigit(*p); p++) {
+                if (++digits > 2) return FALSE;
+            }
+        }
+        if (!*p || !strchr("fFeEgGdis", *p)) return FALSE;
+        *conversion = *p;
+    }
+    return TRUE;
+}
+
+gboolean expression_check_format(const char *format, GError **error) {
+    char conversion;
+    if (!format || parse_format(format, &conversion)) return TRUE;
+
+    g_set_error(error, G_IO_ERROR, G_IO_ERROR_INVALID_DATA,
+                "Invalid format '%s': use at most one %%f, %%e, %%g, %%d, %%i or %%s", format);
+    return FALSE;
+}
+
+char* expression_value_to_string(const ExpressionValue *value, const char *format) {
+    char conversion = 0;
+    if (format && !parse_format(format, &conversion)) format = NULL;
+
+    if (!format) {
+        if (value->type == EXPRESSION_STRING) return g_strdup(value->string ? value->string : "");
+        char buffer[G_ASCII_DTOSTR_BUF_SIZE];
+        return g_strdup(g_ascii_formatd(buffer, sizeof(buffer), "%.6g", value->number));
+    }
+
+    switch (conversion) {
+    case 0:
+        /* Only "%%" escapes */
+        return g_strdup_printf(format, 0);
+    case 's': {
+        char *text = expression_value_to_string(value, NULL);
+        char *result = g_strdup_printf(format, text);
+        g_free(text);
+        return result;
+    }
+    case 'd':
+    case 'i': {
+        double number = round(expression_value_to_number(value));
+        int integer = isnan(number) ? 0 : (int)CLAMP(number, G_MININT, G_MAXINT);
+        return g_strdup_printf(format, integer);
+    }
+    default:
+        return g_strdup_printf(format, expression_value_to_number(value));
+    }
+}
+
+/* ── Compiling ───────────────────────────────────────────── */
+
+typedef struct {
+    const char *source;
+    const char *p;
+    Expression *expr;
+    guint depth;
+    GError **error;
+} Compiler;
+
+static gboolean compile_conditional(Compiler *c);
+
+static gboolean fail(Compiler *c, const char *message) {
+    g_set_error(c->error, G_IO_ERROR, G_IO_ERROR_INVALID_DATA,
+                "Expression '%s': %s at offset %d", c->source, message, (int)(c->p - c->source));
+    return FALSE;
+}
+
+/* depth_change: net stack effect of the instruction */
+static void emit(Compiler *c, Opcode op, guint arg, guint argc, double number, int depth_change) {
+    Instruction instruction = { op, arg, argc, number };
+    g_array_append_val(c->expr->code, instruction);
+    c->depth += depth_change;
+    c->expr->max_depth = MAX(c->expr->max_depth, c->depth);
+}
+
+static void skip_space(Compiler *c) {
+    while (g_ascii_isspace(*c->p)) c->p++;
+}
+
+/* Consume token if it comes next */
+static gboolean accept(Compiler *c, const char *token) {
+    skip_space(c);
+    size_t length = strlen(token);
+    if (strncmp(c->p, token, length) != 0) return FALSE;
+    c->p += length;
+    return TRUE;
+}
+
+static gboolean is_name_start(char ch) {
+    return g_ascii_isalpha(ch) || ch == '_';
+}
+
+static char* read_name(Compiler *c) {
+    const char *start = c->p;
+    while (g_ascii_isalnum(*c->p) || *c->p == '_') c->p++;
+    return g_strndup(start, c->p - start);
+}
+
+static guint add_reference(Compiler *c, char *id, char *property) {
+    Expression *expr = c->expr;
+    for (guint i = 0; i < expr->reference_ids->len; i++) {
+        if (strcmp(g_ptr_array_index(expr->reference_ids, i), id) == 0 &&
+            strcmp(g_ptr_array_index(expr->reference_properties, i), property) == 0) {
+            g_free(id);
+            g_free(property);
+            return i;
+        }
+    }
+    g_ptr_array_add(expr->reference_ids, id);
+    g_ptr_array_add(expr->reference_properties, property);
+    return expr->reference_ids->len - 1;
+}
+
+static gboolean compile_string(Compiler *c) {
+    char quote = *c->p++;
+    GString *text = g_string_new(NULL);
+
+    while (*c->p != quote) {
+        if (*c->p == '\0') {
+            g_string_free(text, TRUE);
+            return fail(c, "unterminated text");
+        }
+        if (*c->p == '\\' && c->p[1] != '\0') c->p++;
+        g_string_append_c(text, *c->p++);
+    }
+    c->p++;
+
+    g_ptr_array_add(c->expr->strings, g_string_free(text, FALSE));
+    emit(c, OP_STRING, c->expr->strings->len - 1, 0, 0.0, 1);
+    return TRUE;
+}
+
+static gboolean compile_call(Compiler *c, const char *name) {
+    guint function = G_N_ELEMENTS(functions);
+    for (guint i = 0; i < G_N_ELEMENTS(functions); i++) {
+        if (strcmp(functions[i].name, name) == 0) function = i;
+    }
+    if (function == G_N_ELEMENTS(functions)) return fail(c, "unknown function");
+
+    guint argc = 0;
+    if (!accept(c, ")")) {
+        do {
+            if (!compile_conditional(c)) return FALSE;
+            argc++;
+        } while (accept(c, ","));
+        if (!accept(c, ")")) return fail(c, "expected ')'");
+    }
+    if (argc < functions[function].min_args || argc > functions[function].max_args) {
+        return fail(c, "wrong number of arguments");
+    }
+
+    emit(c, OP_CALL, function, argc, 0.0, 1 - (int)argc);
+    return TRUE;
+}
+
+static gboolean compile_primary(Compiler *c) {
+    skip_space(c);
+
+    if (g_ascii_isdigit(*c->p) || (*c->p == '.' && g_ascii_isdigit(c->p[1]))) {
+        char *end;
+        double number = g_ascii_strtod(c->p, &end);
+        c->p = end;
+        emit(c, OP_NUMBER, 0, 0, number, 1);
+        return TRUE;
+    }
+    if (*c->p == '\'' || *c->p == '"') return compile_string(c);
+
+    if (*c->p == '(') {
+        c->p++;
+        if (!compile_conditional(c)) return FALSE;
+        return accept(c, ")") || fail(c, "expected ')'");
+    }
+
+    if (!is_name_start(*c->p)) {
+        return fail(c, *c->p ? "unexpected character" : "unexpected end");
+    }
+
+    char *name = read_name(c);
+    gboolean ok = TRUE;
+
+    if (*c->p == '.' && is_name_start(c->p[1])) {
+        c->p++;
+        guint reference = add_reference(c, name, read_name(c));
+        emit(c, OP_REFERENCE, reference, 0, 0.0, 1);
+        return TRUE;
+    }
+    if (strcmp(name, "true") == 0 || strcmp(name, "false") == 0) {
+        emit(c, OP_NUMBER, 0, 0, name[0] == 't' ? 1.0 : 0.0, 1);
+    } else if (accept(c, "(")) {
+        ok = compile_call(c, name);
+    } else {
+        ok = fail(c, "expected widget.property");
+    }
+    g_free(name);
+    return ok;
+}
+
+static gboolean compile_unary(Compiler *c) {
+    skip_space(c);
+    if (*c->p == '-' || (*c->p == '!' && c->p[1] != '=')) {
+        Opcode op = *c->p++ == '-' ? OP_NEGATE : OP_NOT;
+        if (!compile_unary(c)) return FALSE;
+        emit(c, op, 0, 0, 0.0, 0);
+        return TRUE;
+    }
+    return compile_primary(c);
+}
+
+/* Binary operators, loosest first; longer tokens before their prefixes */
+static const struct {
+    const char *token;
+    Opcode op;
+    int level;
+} binary_operators[] = {
+    { "||", OP_OR,            0 },
+    { "&&", OP_AND,           1 },
+    { "==", OP_EQUAL,         2 },
+    { "!=", OP_NOT_EQUAL,     2 },
+    { "<=", OP_LESS_EQUAL,    3 },
+    { ">=", OP_GREATER_EQUAL, 3 },
+    { "<",  OP_LESS,          3 },
+    { ">",  OP_GREATER,       3 },
+    { "+",  OP_ADD,           4 },
+    { "-",  OP_SUBTRACT,      4 },
+    { "*",  OP_MULTIPLY,      5 },
+    { "/",  OP_DIVIDE,        5 },
+    { "%",  OP_MODULO,        5 },
+};
+
+#define BINARY_LEVELS 6
+
+static gboolean compile_binary(Compiler *c, int level) {
+    if (level == BINARY_LEVELS) return compile_unary(c);
+    if (!compile_binary(c, level + 1)) return FALSE;
+
+    for (;;) {
+        gboolean found = FALSE;
+        for (guint i = 0; i < G_N_ELEMENTS(binary_operators) && !found; i++) {
+            if (binary_operators[i].level != level) continue;
+            if (!accept(c, binary_operators[i].token)) continue;
+
+            found = TRUE;
+            if (!compile_binary(c, level + 1)) return FALSE;
+            emit(c, binary_operators[i].op, 0, 0, 0.0, -1);
+        }
+        if (!found) return TRUE;
+    }
+}
+
+static gboolean compile_conditional(Compiler *c) {
+    if (!compile_binary(c, 0)) return FALSE;
+    if (!accept(c, "?")) return TRUE;
+
+    if (!compile_conditional(c)) return FALSE;
+    if (!accept(c, ":")) return fail(c, "expected ':'");
+    if (!compile_conditional(c)) return FALSE;
+    emit(c, OP_SELECT, 0, 0, 0.0, -2);
+    return TRUE;
+}
+
+Expression* expression_compile(const char *source, GError **error) {
+    g_return_val_if_fail(source != NULL, NULL);
+
+    Expression *expr = g_new0(Expression, 1);
+    expr->code = g_array_new(FALSE, FALSE, sizeof(Instruction));
+    expr->strings = g_ptr_array_new_with_free_func(g_free);
+    expr->reference_ids = g_ptr_array_new_with_free_func(g_free);
+    expr->reference_properties = g_ptr_array_new_with_free_func(g_free);
+
+    Compiler c = { source, source, expr, 0, error };
+    gboolean ok = compile_conditional(&c);
+    if (ok) {
+        skip_space(&c);
+        if (*c.p) ok = fail(&c, "unexpected character");
+    }
+
+    if (!ok) {
+        expression_free(expr);
+        return NULL;
+    }
+    return expr;
+}
+
+void expression_free(Expression *expr) {
+    if (!expr) return;
+
+    g_array_free(expr->code, TRUE);
+    g_ptr_array_free(expr->strings, TRUE);
+    g_ptr_array_free(expr->reference_ids, TRUE);
+    g_ptr_array_free(expr->reference_properties, TRUE);
+    g_free(expr);
+}
+
+guint expression_get_n_references(const Expression *expr) {
+    return expr->reference_ids->len;
+}
+
+const char* expression_get_reference_id(const Expression *expr, guint reference) {
+    g_return_val_if_fail(reference < expr->reference_ids->len, NULL);
+    return g_ptr_array_index(expr->reference_ids, reference);
+}
+
+const char* expression_get_reference_property(const Expression *expr, guint reference) {
+    g_return_val_if_fail(reference < expr->reference_properties->len, NULL);
+    return g_ptr_array_index(expr->reference_properties, reference);
+}
+
+/* ── Evaluating ──────────────────────────────────────────── */
+
+/* Text compares as text only against text */
+static int compare(const ExpressionValue *a, const ExpressionValue *b) {
+    if (a->type == EXPRESSION_STRING && b->type == EXPRESSION_STRING) {
+        return g_strcmp0(a->string, b->string);
+    }
+    double x = expression_value_to_number(a);
+    double y = expression_value_to_number(b);
+    return x < y ? -1 : x > y ? 1 : 0;
+}
+
+/* a = a op b */
+static void apply_binary(Opcode op, ExpressionValue *a, const ExpressionValue *b) {
+    if (op == OP_ADD && (a->type == EXPRESSION_STRING || b->type == EXPRESSION_STRING)) {
+        char *left = expression_value_to_string(a, NULL);
+        char *right = expression_value_to_string(b, NULL);
+        set_string(a, g_strconcat(left, right, NULL));
+        g_free(left);
+        g_free(right);
+        return;
+    }
+
+    double x = expression_value_to_number(a);
+    double y = expression_value_to_number(b);
+    double result;
+
+    switch (op) {
+    case OP_ADD:           result = x + y; break;
+    case OP_SUBTRACT:      result = x - y; break;
+    case OP_MULTIPLY:      result = x * y; break;
+    case OP_DIVIDE:        result = x / y; break;
+    case OP_MODULO:        result = fmod(x, y); break;
+    case OP_LESS:          result = compare(a, b) < 0; break;
+    case OP_LESS_EQUAL:    result = compare(a, b) <= 0; break;
+    case OP_GREATER:       result = compare(a, b) > 0; break;
+    case OP_GREATER_EQUAL: result = compare(a, b) >= 0; break;
+    case OP_EQUAL:
+        result = a->type == b->type ? expression_value_equal(a, b) : compare(a, b) == 0;
+        break;
+    case OP_NOT_EQUAL:
+        result = a->type == b->type ? !expression_value_equal(a, b) : compare(a, b) != 0;
+        break;
+    case OP_AND:           result = expression_value_is_true(a) && expression_value_is_true(b); break;
+    case OP_OR:            result = expression_value_is_true(a) || expression_value_is_true(b); break;
+    default:               result = 0.0; break;
+    }
+    set_number(a, result);
+}
+
+static double call_function(Function function, const ExpressionValue *args, guint argc) {
+    double x = expression_value_to_number(&args[0]);
+
+    switch (function) {
+    case FUNCTION_ABS:   return fabs(x);
+    case FUNCTION_ROUND: return round(x);
+    case FUNCTION_FLOOR: return floor(x);
+    case FUNCTION_CEIL:  return ceil(x);
+    case FUNCTION_SQRT:  return sqrt(x);
+    case FUNCTION_MIN:
+    case FUNCTION_MAX:
+        for (guint i = 1; i < argc; i++) {
+            double y = expression_value_to_number(&args[i]);
+            x = function == FUNCTION_MIN ? fmin(x, y) : fmax(x, y);
+        }
+        return x;
+    case FUNCTION_CLAMP:
+        return fmin(fmax(x, expression_value_to_number(&args[1])),
+                    expression_value_to_number(&args[2]));
+    }
+    return 0.0;
+}
+
+void expression_evaluate(const Expression *expr, ExpressionLookupFunc lookup,
+                         gpointer user_data, ExpressionValue *result) {
+    ExpressionValue *stack = g_newa(ExpressionValue, expr->max_depth);
+    memset(stack, 0, expr->max_depth * sizeof(ExpressionValue));
+    guint top = 0;
+
+    for (guint i = 0; i < expr->code->len; i++) {
+        const Instruction *in = &g_array_index(expr->code, Instruction, i);
+
+        switch (in->op) {
+        case OP_NUMBER:
+            stack[top++].number = in->number;
+            break;
+        case OP_STRING:
+            set_string(&stack[top++], g_strdup(g_ptr_array_index(expr->strings, in->arg)));
+            break;
+        case OP_REFERENCE:
+            lookup(in->arg, &stack[top++], user_data);
+            break;
+        case OP_NEGATE:
+            set_number(&stack[top - 1], -expression_value_to_number(&stack[top - 1]));
+            break;
+        case OP_NOT:
+            set_number(&stack[top - 1], !expression_value_is_true(&stack[top - 1]));
+            break;
+        case OP_SELECT: {
+            top -= 2;
+            ExpressionValue *cond = &stack[top - 1];
+            ExpressionValue *chosen = expression_value_is_true(cond) ? &stack[top] : &stack[top + 1];
+            expression_value_clear(cond);
+            *cond = *chosen;
+            *chosen = (ExpressionValue){ 0 };
+            expression_value_clear(&stack[top]);
+            expression_value_clear(&stack[top + 1]);
+            break;
+        }
+        case OP_CALL: {
+            top -= in->argc;
+            double value = call_function((Function)in->arg, &stack[top], in->argc);
+            for (guint k = 0; k < in->argc; k++) expression_value_clear(&stack[top + k]);
+            stack[top++].number = value;
+            break;
+        }
+        default:
+            top--;
+            apply_binary(in->op, &stack[top - 1], &stack[top]);
+            expression_value_clear(&stack[top]);
+            break;
+        }
+    }
+
+    /* A compiled expression leaves exactly one value */
+    *result = stack[0];
+}
@@ -0,0 +1,59 @@
+#ifndef EXPRESSION_H
+#define EXPRESSION_H
+
+#include <glib.h>
+
+/*
+ * Small expressions over widget properties, used by prop bindings.
+ *
+ * Syntax: numbers, 'text' or "text", true / false, references written
+ * widget_id.property, the operators + - * / % (+ joins when either side
+ * is text), < <= > >= == != && || ! and cond ? a : b, parentheses, and
+ * the functions abs, round, floor, ceil, sqrt, min, max and clamp.
+ *
+ * An expression is compiled once into postfix code for a small stack
+ * machine. References are numbered at compile time, so evaluating needs
+ * neither parsing nor name lookups.
+ */
+
+typedef enum {
+    EXPRESSION_NUMBER,
+    EXPRESSION_STRING
+} ExpressionType;
+
+/* Zero-initialized = the number 0 */
+typedef struct {
+    ExpressionType type;
+    double number;
+    char *string;            /* Owned, EXPRESSION_STRING only */
+} ExpressionValue;
+
+typedef struct _Expression Expression;
+
+/* Store the current value of reference number reference in value (cleared) */
+typedef void (*ExpressionLookupFunc)(guint reference, ExpressionValue *value,
+                                     gpointer user_data);
+
+Expression* expression_compile(const char *source, GError **error);
+void expression_free(Expression *expr);
+
+/* Distinct widget_id.property references, numbered from 0 */
+guint expression_get_n_references(const Expression *expr);
+const char* expression_get_reference_id(const Expression *expr, guint reference);
+const char* expression_get_reference_property(const Expression *expr, guint reference);
+
+/* result is overwritten; clear it afterwards */
+void expression_evaluate(const Expression *expr, ExpressionLookupFunc lookup,
+                         gpointer user_data, ExpressionValue *result);
+
+void expression_value_clear(ExpressionValue *value);
+void expression_value_copy(ExpressionValue *dest, const ExpressionValue *src);
+gboolean expression_value_equal(const ExpressionValue *a, const ExpressionValue *b);
+gboolean expression_value_is_true(const ExpressionValue *value);
+double expression_value_to_number(const ExpressionValue *value);
+/* format: printf format with at most one %f %e %g %d %i or %s conversion,
+ * NULL = numbers with up to 6 significant digits */
+char* expression_value_to_string(const ExpressionValue *value, const char *format);
+gboolean expression_check_format(const char *format, GError **error);
+
+#endif /* EXPRESSION_H */
@@ -0,0 +1,197 @@
+#include "frame_hud.h"
+#include "dashboard_canvas.h"
+#include "frame_stats.h"
+#include "power_policy.h"
+#include <string.h>
+
+#define HUD_HISTORY 240           /* Frame intervals kept for percentiles */
+#define HUD_TOP_N 5               /* Slowest shape draws listed per frame */
+#define HUD_UPDATE_INTERVAL_US (250 * 1000)
+
+typedef struct {
+    char id[48];
+    gint64 duration_us;
+} ShapeDrawSample;
+
+typedef struct {
+    guint shapes_drawn;
+    guint top_len;
+    ShapeDrawSample top[HUD_TOP_N];
+} FrameDrawStats;
+
+struct _FrameHud {
+    GtkWidget *window;
+    GtkWidget *label;
+    gboolean visible;
+    guint watch_id;          /* Frame statistics, while visible */
+
+    gint64 intervals[HUD_HISTORY];
+    guint n_intervals;
+    guint head;
+    gint64 last_paint_us;
+    gint64 last_update;
+};
+
+/* Draw statistics are global: shapes do not know which HUD they belong to */
+static gboolean collecting = FALSE;
+static FrameDrawStats current_frame;
+static FrameDrawStats last_frame;
+
+static const char *hud_css =
+    ".frame-hud {\n"
+    "  background: rgba(0, 0, 0, 0.75);\n"
+    "  color: #A3BE8C;\n"
+    "  font-family: monospace;\n"
+    "  font-size: 12px;\n"
+    "  padding: 6px 10px;\n"
+    "  margin: 8px;\n"
+    "  border-radius: 4px;\n"
+    "}\n";
+
+gboolean frame_hud_is_collecting(void) {
+    return collecting;
+}
+
+void frame_hud_record_shape_draw(const char *id, gint64 duration_us) {
+    FrameDrawStats *stats = &current_frame;
+    stats->shapes_drawn++;
+
+    /* Insertion into the small sorted top-N list */
+    guint pos = stats->top_len;
+    while (pos > 0 && stats->top[pos - 1].duration_us < duration_us) pos--;
+    if (pos >= HUD_TOP_N) return;
+
+    guint last = MIN(stats->top_len, HUD_TOP_N - 1);
+    memmove(&stats->top[pos + 1], &stats->top[pos], (last - pos) * sizeof(ShapeDrawSample));
+    g_strlcpy(stats->top[pos].id, id ? id : "", sizeof(stats->top[pos].id));
+    stats->top[pos].duration_us = duration_us;
+    if (stats->top_len < HUD_TOP_N) stats->top_len++;
+}
+
+static int compare_int64(const void *a, const void *b) {
+    gint64 x = *(const gint64 *)a;
+    gint64 y = *(const gint64 *)b;
+    return (x > y) - (x < y);
+}
+
+static void update_label(FrameHud *hud, GdkFrameClock *frame_clock) {
+    GString *text = g_string_new("");
+
+    if (hud->n_intervals > 0) {
+        gint64 sorted[HUD_HISTORY];
+        memcpy(sorted, hud->intervals, hud->n_intervals * sizeof(gint64));
+        qsort(sorted, hud->n_intervals, sizeof(gint64), compare_int64);
+
+        guint last = (hud->head + HUD_HISTORY - 1) % HUD_HISTORY;
+        gint64 p50 = sorted[hud->n_intervals / 2];
+        gint64 p99 = sorted[MIN(hud->n_intervals - 1, hud->n_intervals * 99 / 100)];
+
+        g_string_append_printf(text, "frame %6.2f ms  paint %5.2f ms\n",
+                               hud->intervals[last] / 1000.0, hud->last_paint_us / 1000.0);
+        g_string_append_printf(text, "fps   %6.1f\n", gdk_frame_clock_get_fps(frame_clock));
+        g_string_append_printf(text, "p50   %6.2f ms  p99 %6.2f ms\n", p50 / 1000.0, p99 / 1000.0);
+    } else {
+        g_string_append(text, "frame    -\n");
+    }
+
+    g_string_append_printf(text, "culled (occluded) %u\n", dashboard_canvas_get_culled_total());
+    g_string_append_printf(text, "wakeups/s %5.1f  %s\n", power_policy_get_wakeups_per_second(),
+                           power_policy_get_state_name());
+    g_string_append_printf(text, "shapes redrawn %u", last_frame.shapes_drawn);
+    for (guint i = 0; i < last_frame.top_len; i++) {
+        g_string_append_printf(text, "\n  %-24s %6.3f ms",
+                               last_frame.top[i].id, last_frame.top[i].duration_us / 1000.0);
+    }
+
+    gtk_label_set_text(GTK_LABEL(hud->label), text->str);
+    g_string_free(text, TRUE);
+}
+
+static void on_frame(GdkFrameClock *frame_clock, gint64 interval_us, gint64 paint_us,
+                     gpointer user_data) {
+    FrameHud *hud = (FrameHud *)user_data;
+    gint64 now = g_get_monotonic_time();
+
+    if (interval_us > 0) {
+        hud->intervals[hud->head] = interval_us;
+        hud->head = (hud->head + 1) % HUD_HISTORY;
+        if (hud->n_intervals < HUD_HISTORY) hud->n_intervals++;
+    }
+    hud->last_paint_us = paint_us;
+
+    /* Draw callbacks of this frame have all run by now */
+    last_frame = current_frame;
+    memset(&current_frame, 0, sizeof(current_frame));
+
+    if (now - hud->last_update >= HUD_UPDATE_INTERVAL_US) {
+        hud->last_update = now;
+        update_label(hud, frame_clock);
+    }
+}
+
+static void install_css(void) {
+    static gboolean installed = FALSE;
+    if (installed) return;
+
+    GtkCssProvider *provider = gtk_css_provider_new();
+    gtk_css_provider_load_from_string(provider, hud_css);
+    gtk_style_context_add_provider_for_display(
+        gdk_display_get_default(),
+        GTK_STYLE_PROVIDER(provider),
+        GTK_STYLE_PROVIDER_PRIORITY_APPLICATION + 1
+    );
+    g_object_unref(provider);
+    installed = TRUE;
+}
+
+static void frame_hud_free(gpointer data) {
+    FrameHud *hud = (FrameHud *)data;
+    if (hud->watch_id) frame_stats_unwatch(hud->window, hud->watch_id);
+    g_free(hud);
+}
+
+FrameHud* frame_hud_new(GtkWidget *window) {
+    FrameHud *hud = g_new0(FrameHud, 1);
+    hud->window = window;
+
+    install_css();
+
+    hud->label = gtk_label_new("");
+    gtk_widget_add_css_class(hud->label, "frame-hud");
+    gtk_widget_set_halign(hud->label, GTK_ALIGN_END);
+    gtk_widget_set_valign(hud->label, GTK_ALIGN_START);
+    gtk_widget_set_can_target(hud->label, FALSE);
+    gtk_widget_set_visible(hud->label, FALSE);
+
+    g_object_set_data_full(G_OBJECT(hud->label), "frame-hud", hud, frame_hud_free);
+    return hud;
+}
+
+GtkWidget* frame_hud_get_widget(FrameHud *hud) {
+    return hud->label;
+}
+
+void frame_hud_toggle(FrameHud *hud) {
+    GdkFrameClock *frame_clock = gtk_widget_get_frame_clock(hud->window);
+    if (!frame_clock) return;
+
+    hud->visible = !hud->visible;
+    collecting = hud->visible;
+
+    if (hud->visible) {
+        hud->n_intervals = 0;
+        hud->head = 0;
+        hud->last_update = 0;
+        memset(&current_frame, 0, sizeof(current_frame));
+        memset(&last_frame, 0, sizeof(last_frame));
+
+        /* Removed with the HUD if the window goes first */
+        hud->watch_id = frame_stats_watch(hud->window, on_frame, hud);
+        update_label(hud, frame_clock);
+    } else {
+        frame_stats_unwatch(hud->window, hud->watch_id);
+        hud->watch_id = 0;
+    }
+
+    gtk_widget_set_visible(hud->label, hud->visible);
+}
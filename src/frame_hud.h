@@ -0,0 +1,25 @@
+#ifndef FRAME_HUD_H
+#define FRAME_HUD_H
+
+#include <gtk/gtk.h>
+
+/*
+ * Frame-timing HUD overlay (Shift+F12).
+ *
+ * Frame statistics come from the window's GdkFrameClock and are only
+ * collected while the HUD is visible.
+ */
+
+typedef struct _FrameHud FrameHud;
+
+/* The returned widget is owned by the caller's widget tree; the HUD is
+ * freed together with it. */
+FrameHud* frame_hud_new(GtkWidget *window);
+GtkWidget* frame_hud_get_widget(FrameHud *hud);
+void frame_hud_toggle(FrameHud *hud);
+
+/* Hot-path hooks for shape draw callbacks */
+gboolean frame_hud_is_collecting(void);
+void frame_hud_record_shape_draw(const char *id, gint64 duration_us);
+
+#endif /* FRAME_HUD_H */
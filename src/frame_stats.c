@@ -0,0 +1,75 @@
+#include "frame_stats.h"
+
+#define FRAME_IDLE_GAP_US G_USEC_PER_SEC   /* Longer gaps are idle, not slow frames */
+
+typedef struct {
+    guint id;
+    FrameStatsFunc func;
+    gpointer user_data;
+} FrameWatch;
+
+typedef struct {
+    GArray *watches;         /* FrameWatch */
+    gint64 last_frame_time;
+} WindowFrames;
+
+static guint next_watch_id = 1;
+
+static void window_frames_free(gpointer data) {
+    WindowFrames *frames = (WindowFrames *)data;
+    g_array_free(frames->watches, TRUE);
+    g_free(frames);
+}
+
+static void on_after_paint(GdkFrameClock *frame_clock, gpointer user_data) {
+    WindowFrames *frames = g_object_get_data(G_OBJECT(user_data), "frame-stats");
+    if (!frames) return;
+
+    gint64 frame_time = gdk_frame_clock_get_frame_time(frame_clock);
+    gint64 interval = frames->last_frame_time > 0 ? frame_time - frames->last_frame_time : 0;
+    if (interval < 0 || interval >= FRAME_IDLE_GAP_US) interval = 0;
+    frames->last_frame_time = frame_time;
+    gint64 paint = MAX(g_get_monotonic_time() - frame_time, 0);
+
+    /* Backwards, so a watch may remove itself */
+    for (guint i = frames->watches->len; i > 0; i--) {
+        FrameWatch *watch = &g_array_index(frames->watches, FrameWatch, i - 1);
+        watch->func(frame_clock, interval, paint, watch->user_data);
+    }
+}
+
+static void on_window_realize(GtkWidget *window, gpointer user_data) {
+    GdkFrameClock *frame_clock = gtk_widget_get_frame_clock(window);
+    if (frame_clock) {
+        g_signal_connect_object(frame_clock, "after-paint", G_CALLBACK(on_after_paint), window, 0);
+    }
+}
+
+guint frame_stats_watch(GtkWidget *window, FrameStatsFunc func, gpointer user_data) {
+    g_return_val_if_fail(GTK_IS_WIDGET(window) && func != NULL, 0);
+
+    WindowFrames *frames = g_object_get_data(G_OBJECT(window), "frame-stats");
+    if (!frames) {
+        frames = g_new0(WindowFrames, 1);
+        frames->watches = g_array_new(FALSE, FALSE, sizeof(FrameWatch));
+        g_object_set_data_full(G_OBJECT(window), "frame-stats", frames, window_frames_free);
+
+        g_signal_connect(window, "realize", G_CALLBACK(on_window_realize), NULL);
+        if (gtk_widget_get_realized(window)) on_window_realize(window, NULL);
+    }
+
+    FrameWatch watch = { next_watch_id++, func, user_data };
+    g_array_append_val(frames->watches, watch);
+    return watch.id;
+}
+
+void frame_stats_unwatch(GtkWidget *window, guint id) {
+    WindowFrames *frames = g_object_get_data(G_OBJECT(window), "frame-stats");
+
+    for (guint i = 0; frames && i < frames->watches->len; i++) {
+        if (g_array_index(frames->watches, FrameWatch, i).id == id) {
+            g_array_remove_index(frames->watches, i);
+            return;
+        }
+    }
+}
@@ -0,0 +1,26 @@
+#ifndef FRAME_STATS_H
+#define FRAME_STATS_H
+
+#include <gtk/gtk.h>
+
+/*
+ * Frame timing of dashboard windows, for the HUD, workload replay and
+ * the metrics endpoint.
+ *
+ * One after-paint handler per window on its GdkFrameClock measures the
+ * interval since the window's previous frame and the paint time (frame
+ * start to the end of painting), and hands both to every watch of the
+ * window. A gap of a second or more is idle time, not a slow frame: the
+ * first frame after it reports no interval.
+ */
+
+/* interval_us is 0 when there is no previous frame to measure from */
+typedef void (*FrameStatsFunc)(GdkFrameClock *frame_clock, gint64 interval_us, gint64 paint_us,
+                               gpointer user_data);
+
+/* Calls func after every paint of window, from its realization until the
+ * window is finalized or the watch is removed. Returns the watch id. */
+guint frame_stats_watch(GtkWidget *window, FrameStatsFunc func, gpointer user_data);
+void frame_stats_unwatch(GtkWidget *window, guint id);
+
+#endif /* FRAME_STATS_H */
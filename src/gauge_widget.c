@@ -0,0 +1,439 @@
+#include "gauge_widget.h"
+#include "data_feed.h"
+#include "metrics.h"
+#include "power_policy.h"
+#include "scale_bin.h"
+#include <pango/pangocairo.h>
+#include <string.h>
+#include <math.h>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+#define GAUGE_MAX_BANDS 8
+
+typedef struct {
+    double from;
+    double to;
+    GdkRGBA color;
+} GaugeBand;
+
+/* Everything the face and needle images depend on */
+typedef struct {
+    double min;
+    double max;
+    int ticks;               /* Major divisions */
+    int minor_ticks;         /* Minor divisions per major one */
+    double start_angle;      /* Degrees clockwise from 3 o'clock */
+    double sweep;
+    int decimals;
+    GdkRGBA face_color;
+    GdkRGBA tick_color;
+    GdkRGBA needle_color;
+    GaugeBand bands[GAUGE_MAX_BANDS];
+    int n_bands;
+} GaugeStyle;
+
+struct _GaugeWidget {
+    GtkWidget parent_instance;
+
+    GaugeStyle style;
+    char *units;
+    double value;
+    guint subscription;
+
+    /* Shared textures for the current size and scale */
+    GdkTexture *face;
+    GdkTexture *needle;
+    int texture_width;
+    int texture_height;
+    double texture_scale;    /* Raster scale, see scale_bin_get_raster_scale() */
+    PangoLayout *value_layout;
+};
+
+G_DEFINE_TYPE(GaugeWidget, gauge_widget, GTK_TYPE_WIDGET)
+
+enum {
+    PROP_0,
+    PROP_VALUE,
+    N_PROPS
+};
+
+static GParamSpec *properties[N_PROPS];
+
+/* key -> GdkTexture*, shared by gauges that look the same. The table holds
+ * no reference: an entry goes away with the texture when the last gauge
+ * using it is resized or finalized, so only the sizes in use are kept */
+static GHashTable *texture_cache = NULL;
+
+/* ── Geometry ────────────────────────────────────────────── */
+
+static double gauge_radius(int width, int height) {
+    return MAX(1.0, MIN(width, height) / 2.0 - 2.0);
+}
+
+static double value_angle(const GaugeStyle *style, double value) {
+    double span = style->max > style->min ? style->max - style->min : 1.0;
+    double fraction = CLAMP((value - style->min) / span, 0.0, 1.0);
+    return style->start_angle + style->sweep * fraction;
+}
+
+static double to_radians(double degrees) {
+    return degrees * M_PI / 180.0;
+}
+
+/* ── Face and needle rendering (once per look/size/scale) ── */
+
+static void draw_face(const GaugeStyle *style, cairo_t *cr, int width, int height) {
+    double cx = width / 2.0, cy = height / 2.0;
+    double r = gauge_radius(width, height);
+
+    gdk_cairo_set_source_rgba(cr, &style->face_color);
+    cairo_arc(cr, cx, cy, r, 0, 2 * M_PI);
+    cairo_fill(cr);
+
+    /* Colour bands along the rim */
+    double band_width = r * 0.08;
+    cairo_set_line_width(cr, band_width);
+    for (int i = 0; i < style->n_bands; i++) {
+        const GaugeBand *band = &style->bands[i];
+        gdk_cairo_set_source_rgba(cr, &band->color);
+        cairo_new_path(cr);
+        cairo_arc(cr, cx, cy, r * 0.88,
+                  to_radians(value_angle(style, band->from)),
+                  to_radians(value_angle(style, band->to)));
+        cairo_stroke(cr);
+    }
+
+    /* Ticks */
+    gdk_cairo_set_source_rgba(cr, &style->tick_color);
+    int divisions = MAX(style->ticks, 1) * MAX(style->minor_ticks, 1);
+    for (int i = 0; i <= divisions; i++) {
+        gboolean major = i % MAX(style->minor_ticks, 1) == 0;
+        double angle = to_radians(style->start_angle + style->sweep * i / divisions);
+        double inner = r * (major ? 0.72 : 0.78);
+        cairo_set_line_width(cr, major ? MAX(1.5, r * 0.02) : 1.0);
+        cairo_move_to(cr, cx + inner * cos(angle), cy + inner * sin(angle));
+        cairo_line_to(cr, cx + r * 0.84 * cos(angle), cy + r * 0.84 * sin(angle));
+        cairo_stroke(cr);
+    }
+
+    /* Labels at the major ticks */
+    PangoLayout *layout = pango_cairo_create_layout(cr);
+    PangoFontDescription *font = pango_font_description_from_string("Sans");
+    pango_font_description_set_absolute_size(font, MAX(6.0, r * 0.13) * PANGO_SCALE);
+    pango_layout_set_font_description(layout, font);
+
+    for (int i = 0; i <= MAX(style->ticks, 1); i++) {
+        double value = style->min + (style->max - style->min) * i / MAX(style->ticks, 1);
+        double angle = to_radians(style->start_angle + style->sweep * i / MAX(style->ticks, 1));
+        char *text = g_strdup_printf("%.*f", style->decimals, value);
+        int text_w, text_h;
+
+        pango_layout_set_text(layout, text, -1);
+        pango_layout_get_pixel_size(layout, &text_w, &text_h);
+        cairo_move_to(cr, cx + r * 0.58 * cos(angle) - text_w / 2.0,
+                          cy + r * 0.58 * sin(angle) - text_h / 2.0);
+        pango_cairo_show_layout(cr, layout);
+        g_free(text);
+    }
+
+    pango_font_description_free(font);
+    g_object_unref(layout);
+}
+
+/* Pointing at 3 o'clock; the snapshot rotates it */
+static void draw_needle(const GaugeStyle *style, cairo_t *cr, int width, int height) {
+    double cx = width / 2.0, cy = height / 2.0;
+    double r = gauge_radius(width, height);
+    double half = MAX(1.5, r * 0.04);
+
+    gdk_cairo_set_source_rgba(cr, &style->needle_color);
+    cairo_move_to(cr, cx - r * 0.12, cy - half);
+    cairo_line_to(cr, cx + r * 0.8, cy);
+    cairo_line_to(cr, cx - r * 0.12, cy + half);
+    cairo_close_path(cr);
+    cairo_fill(cr);
+
+    cairo_arc(cr, cx, cy, half * 2.0, 0, 2 * M_PI);
+    cairo_fill(cr);
+}
+
+typedef void (*GaugeDrawFunc)(const GaugeStyle *style, cairo_t *cr, int width, int height);
+
+static void append_rgba(GString *key, const GdkRGBA *color) {
+    g_string_append_printf(key, "|%.3f,%.3f,%.3f,%.3f",
+                           color->red, color->green, color->blue, color->alpha);
+}
+
+static char* texture_key(const GaugeStyle *style, const char *layer, int width, int height,
+                         double scale) {
+    GString *key = g_string_new(NULL);
+    g_string_append_printf(key, "%s|%dx%d@%g", layer, width, height, scale);
+
+    if (strcmp(layer, "needle") == 0) {
+        append_rgba(key, &style->needle_color);
+        return g_string_free(key, FALSE);
+    }
+
+    g_string_append_printf(key, "|%g|%g|%d|%d|%g|%g|%d", style->min, style->max, style->ticks,
+                           style->minor_ticks, style->start_angle, style->sweep, style->decimals);
+    append_rgba(key, &style->face_color);
+    append_rgba(key, &style->tick_color);
+    for (int i = 0; i < style->n_bands; i++) {
+        g_string_append_printf(key, "|%g-%g", style->bands[i].from, style->bands[i].to);
+        append_rgba(key, &style->bands[i].color);
+    }
+    return g_string_free(key, FALSE);
+}
+
+static void on_texture_finalized(gpointer key, GObject *where_the_object_was) {
+    g_hash_table_remove(texture_cache, key);
+}
+
+/* New reference to the shared texture of a layer */
+static GdkTexture* get_texture(const GaugeStyle *style, const char *layer, GaugeDrawFunc draw,
+                               int width, int height, double scale) {
+    if (!texture_cache) {
+        texture_cache = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, NULL);
+    }
+
+    char *key = texture_key(style, layer, width, height, scale);
+    GdkTexture *texture = g_hash_table_lookup(texture_cache, key);
+    metrics_cache_lookup(METRICS_CACHE_GAUGE, texture != NULL);
+    if (texture) {
+        g_free(key);
+        return g_object_ref(texture);
+    }
+
+    int pixel_width = (int)ceil(width * scale);
+    int pixel_height = (int)ceil(height * scale);
+    cairo_surface_t *surface = cairo_image_surface_create(CAIRO_FORMAT_ARGB32,
+                                                          pixel_width, pixel_height);
+    cairo_t *cr = cairo_create(surface);
+    cairo_scale(cr, scale, scale);
+    draw(style, cr, width, height);
+    cairo_destroy(cr);
+    cairo_surface_flush(surface);
+
+    int stride = cairo_image_surface_get_stride(surface);
+    GBytes *bytes = g_bytes_new(cairo_image_surface_get_data(surface),
+                                (gsize)stride * pixel_height);
+    texture = gdk_memory_texture_new(pixel_width, pixel_height, GDK_MEMORY_DEFAULT,
+                                     bytes, stride);
+    g_bytes_unref(bytes);
+    cairo_surface_destroy(surface);
+
+    g_hash_table_insert(texture_cache, key, texture);
+    g_object_weak_ref(G_OBJECT(texture), on_texture_finalized, key);
+    return texture;
+}
+
+/* ── Widget ──────────────────────────────────────────────── */
+
+static void update_value_text(GaugeWidget *gauge) {
+    char *text = g_strdup_printf("%.*f%s%s", gauge->style.decimals, gauge->value,
+                                 gauge->units ? " " : "", gauge->units ? gauge->units : "");
+    if (g_strcmp0(pango_layout_get_text(gauge->value_layout), text) != 0) {
+        pango_layout_set_text(gauge->value_layout, text, -1);
+    }
+    g_free(text);
+}
+
+static void gauge_widget_snapshot(GtkWidget *widget, GtkSnapshot *snapshot) {
+    GaugeWidget *gauge = GAUGE_WIDGET(widget);
+    int width = gtk_widget_get_width(widget);
+    int height = gtk_widget_get_height(widget);
+    double scale = scale_bin_get_raster_scale(widget);
+    if (width <= 0 || height <= 0) return;
+
+    if (!gauge->face || width != gauge->texture_width || height != gauge->texture_height ||
+        scale != gauge->texture_scale) {
+        g_clear_object(&gauge->face);
+        g_clear_object(&gauge->needle);
+        gauge->face = get_texture(&gauge->style, "face", draw_face, width, height, scale);
+        gauge->needle = get_texture(&gauge->style, "needle", draw_needle, width, height, scale);
+        gauge->texture_width = width;
+        gauge->texture_height = height;
+        gauge->texture_scale = scale;
+
+        PangoFontDescription *font = pango_font_description_from_string("Sans Bold");
+        pango_font_description_set_absolute_size(font,
+            MAX(6.0, gauge_radius(width, height) * 0.18) * PANGO_SCALE);
+        pango_layout_set_font_description(gauge->value_layout, font);
+        pango_font_description_free(font);
+    }
+
+    graphene_rect_t bounds = GRAPHENE_RECT_INIT(0, 0, width, height);
+    graphene_point_t centre = GRAPHENE_POINT_INIT(width / 2.0f, height / 2.0f);
+
+    gtk_snapshot_append_texture(snapshot, gauge->face, &bounds);
+
+    /* Needle: the shared texture under a rotation, no rasterization */
+    gtk_snapshot_save(snapshot);
+    gtk_snapshot_translate(snapshot, &centre);
+    gtk_snapshot_rotate(snapshot, (float)value_angle(&gauge->style, gauge->value));
+    gtk_snapshot_translate(snapshot, &GRAPHENE_POINT_INIT(-centre.x, -centre.y));
+    gtk_snapshot_append_texture(snapshot, gauge->needle, &bounds);
+    gtk_snapshot_restore(snapshot);
+
+    /* Value text below the hub */
+    int text_w, text_h;
+    pango_layout_get_pixel_size(gauge->value_layout, &text_w, &text_h);
+    gtk_snapshot_save(snapshot);
+    gtk_snapshot_translate(snapshot, &GRAPHENE_POINT_INIT(
+        centre.x - text_w / 2.0f,
+        centre.y + (float)gauge_radius(width, height) * 0.35f));
+    gtk_snapshot_append_layout(snapshot, gauge->value_layout, &gauge->style.tick_color);
+    gtk_snapshot_restore(snapshot);
+}
+
+static void on_feed_sample(const char *channel, double value, gpointer user_data) {
+    gauge_widget_set_value(GAUGE_WIDGET(user_data), value);
+}
+
+static void gauge_widget_dispose(GObject *object) {
+    GaugeWidget *gauge = GAUGE_WIDGET(object);
+
+    data_feed_unsubscribe(gauge->subscription);
+    gauge->subscription = 0;
+    g_clear_object(&gauge->face);
+    g_clear_object(&gauge->needle);
+    g_clear_object(&gauge->value_layout);
+
+    G_OBJECT_CLASS(gauge_widget_parent_class)->dispose(object);
+}
+
+static void gauge_widget_finalize(GObject *object) {
+    g_free(GAUGE_WIDGET(object)->units);
+    G_OBJECT_CLASS(gauge_widget_parent_class)->finalize(object);
+}
+
+static void gauge_widget_get_property(GObject *object, guint prop_id, GValue *value,
+                                      GParamSpec *pspec) {
+    switch (prop_id) {
+    case PROP_VALUE:
+        g_value_set_double(value, GAUGE_WIDGET(object)->value);
+        break;
+    default:
+        G_OBJECT_WARN_INVALID_PROPERTY_ID(object, prop_id, pspec);
+    }
+}
+
+static void gauge_widget_set_property(GObject *object, guint prop_id, const GValue *value,
+                                      GParamSpec *pspec) {
+    switch (prop_id) {
+    case PROP_VALUE:
+        gauge_widget_set_value(GAUGE_WIDGET(object), g_value_get_double(value));
+        break;
+    default:
+        G_OBJECT_WARN_INVALID_PROPERTY_ID(object, prop_id, pspec);
+    }
+}
+
+static void gauge_widget_class_init(GaugeWidgetClass *klass) {
+    GObjectClass *object_class = G_OBJECT_CLASS(klass);
+    GtkWidgetClass *widget_class = GTK_WIDGET_CLASS(klass);
+
+    object_class->dispose = gauge_widget_dispose;
+    object_class->finalize = gauge_widget_finalize;
+    object_class->get_property = gauge_widget_get_property;
+    object_class->set_property = gauge_widget_set_property;
+    widget_class->snapshot = gauge_widget_snapshot;
+    gtk_widget_class_set_css_name(widget_class, "gauge");
+
+    /* Notified on every change, e.g. for prop bindings */
+    properties[PROP_VALUE] = g_param_spec_double("value", NULL, NULL,
+                                                 -G_MAXDOUBLE, G_MAXDOUBLE, 0.0,
+                                                 G_PARAM_READWRITE | G_PARAM_EXPLICIT_NOTIFY |
+                                                 G_PARAM_STATIC_STRINGS);
+    g_object_class_install_properties(object_class, N_PROPS, properties);
+}
+
+static void gauge_widget_init(GaugeWidget *gauge) {
+}
+
+/* ── Public API ──────────────────────────────────────────── */
+
+static double get_double_prop(JsonObject *props, const char *key, double default_val) {
+    if (!props || !json_object_has_member(props, key)) return default_val;
+    JsonNode *node = json_object_get_member(props, key);
+    if (!JSON_NODE_HOLDS_VALUE(node)) return default_val;
+    return json_node_get_double(node);
+}
+
+static const char* get_string_prop(JsonObject *props, const char *key, const char *default_val) {
+    if (!props || !json_object_has_member(props, key)) return default_val;
+    JsonNode *node = json_object_get_member(props, key);
+    if (!JSON_NODE_HOLDS_VALUE(node)) return default_val;
+    const char *val = json_node_get_string(node);
+    return val ? val : default_val;
+}
+
+static void get_color_prop(JsonObject *props, const char *key, const char *default_val,
+                           GdkRGBA *color) {
+    if (!gdk_rgba_parse(color, get_string_prop(props, key, default_val))) {
+        gdk_rgba_parse(color, default_val);
+    }
+}
+
+/* bands: [ { "from", "to", "color" }, ... ] */
+static void parse_bands(GaugeStyle *style, JsonObject *props) {
+    if (!props || !json_object_has_member(props, "bands")) return;
+
+    JsonArray *bands = json_object_get_array_member(props, "bands");
+    guint n = MIN(json_array_get_length(bands), GAUGE_MAX_BANDS);
+    for (guint i = 0; i < n; i++) {
+        JsonObject *band_obj = json_array_get_object_element(bands, i);
+        GaugeBand *band = &style->bands[style->n_bands++];
+        band->from = get_double_prop(band_obj, "from", style->min);
+        band->to = get_double_prop(band_obj, "to", style->max);
+        get_color_prop(band_obj, "color", "#A3BE8C", &band->color);
+    }
+}
+
+GtkWidget* gauge_widget_new(const WidgetConfig *config) {
+    GaugeWidget *gauge = g_object_new(GAUGE_TYPE_WIDGET, NULL);
+    JsonObject *props = config->props;
+    GaugeStyle *style = &gauge->style;
+
+    style->min = get_double_prop(props, "min", 0.0);
+    style->max = get_double_prop(props, "max", 100.0);
+    style->ticks = (int)get_double_prop(props, "ticks", 10);
+    style->minor_ticks = (int)get_double_prop(props, "minor_ticks", 5);
+    style->start_angle = get_double_prop(props, "start_angle", 135.0);
+    style->sweep = get_double_prop(props, "sweep", 270.0);
+    style->decimals = CLAMP((int)get_double_prop(props, "decimals", 0), 0, 6);
+    get_color_prop(props, "face_color", "#3B4252", &style->face_color);
+    get_color_prop(props, "tick_color", "#ECEFF4", &style->tick_color);
+    get_color_prop(props, "needle_color", "#BF616A", &style->needle_color);
+    parse_bands(style, props);
+
+    const char *units = get_string_prop(props, "units", NULL);
+    gauge->units = units && *units ? g_strdup(units) : NULL;
+
+    gauge->value_layout = gtk_widget_create_pango_layout(GTK_WIDGET(gauge), NULL);
+    gauge->value = get_double_prop(props, "value", style->min);
+    update_value_text(gauge);
+
+    const char *feed = get_string_prop(props, "feed", NULL);
+    if (feed) gauge->subscription = data_feed_subscribe(feed, on_feed_sample, gauge);
+
+    return GTK_WIDGET(gauge);
+}
+
+void gauge_widget_set_value(GaugeWidget *gauge, double value) {
+    g_return_if_fail(GAUGE_IS_WIDGET(gauge));
+
+    if (value == gauge->value) return;
+    gauge->value = value;
+    update_value_text(gauge);
+    power_policy_queue_draw(GTK_WIDGET(gauge));
+    g_object_notify_by_pspec(G_OBJECT(gauge), properties[PROP_VALUE]);
+}
+
+double gauge_widget_get_value(GaugeWidget *gauge) {
+    g_return_val_if_fail(GAUGE_IS_WIDGET(gauge), 0.0);
+    return gauge->value;
+}
@@ -0,0 +1,26 @@
+#ifndef GAUGE_WIDGET_H
+#define GAUGE_WIDGET_H
+
+#include <gtk/gtk.h>
+#include "json_parser.h"
+
+/*
+ * "Gauge" widget: a dial with ticks, labels and colour bands.
+ *
+ * The static face and the needle are rendered with Cairo once per
+ * appearance, size and scale factor into textures that every gauge with
+ * the same look shares. A value change only rotates the needle texture
+ * through a transform node and updates the value text, so hundreds of
+ * gauges can update several times a second without any Cairo work.
+ */
+
+#define GAUGE_TYPE_WIDGET (gauge_widget_get_type())
+G_DECLARE_FINAL_TYPE(GaugeWidget, gauge_widget, GAUGE, WIDGET, GtkWidget)
+
+/* props: value, min, max, feed, bands, ticks, minor_ticks, start_angle,
+ * sweep, decimals, units, face_color, tick_color, needle_color */
+GtkWidget* gauge_widget_new(const WidgetConfig *config);
+void gauge_widget_set_value(GaugeWidget *gauge, double value);
+double gauge_widget_get_value(GaugeWidget *gauge);
+
+#endif /* GAUGE_WIDGET_H */
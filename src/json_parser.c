@@ -1,4 +1,7 @@
 #include "json_parser.h"
+#include "layout_solver.h"
+#include "binding_graph.h"
+#include "tracer.h"
 #include <string.h>
 
 static char* get_string_member_or_null(JsonObject *obj, const char *member) {
@@ -20,47 +23,592 @@ static int get_int_member_or_default(JsonObject *obj, const char *member, int de
     return (int)json_node_get_int(node);
 }
 
-static WidgetConfig* parse_widget(JsonObject *widget_obj) {
+static double get_double_member_or_default(JsonObject *obj, const char *member, double default_val) {
+    if (!json_object_has_member(obj, member)) return default_val;
+
+    JsonNode *node = json_object_get_member(obj, member);
+    if (!JSON_NODE_HOLDS_VALUE(node)) return default_val;
+
+    return json_node_get_double(node);
+}
+
+/* Animation: { "property", "from", "to", "duration_ms", "delay_ms", "easing",
+ * "repeat": true | N, "alternate" } */
+static AnimationConfig* parse_animation(JsonObject *anim_obj) {
+    AnimationConfig *anim = g_new0(AnimationConfig, 1);
+
+    anim->property = get_string_member_or_null(anim_obj, "property");
+    anim->from = get_double_member_or_default(anim_obj, "from", 0.0);
+    anim->to = get_double_member_or_default(anim_obj, "to", 1.0);
+    anim->duration_ms = get_int_member_or_default(anim_obj, "duration_ms", 1000);
+    anim->delay_ms = get_int_member_or_default(anim_obj, "delay_ms", 0);
+    anim->easing = get_string_member_or_null(anim_obj, "easing");
+    anim->alternate = json_object_get_boolean_member_with_default(anim_obj, "alternate", FALSE);
+
+    anim->repeat = 1;
+    if (json_object_has_member(anim_obj, "repeat")) {
+        JsonNode *node = json_object_get_member(anim_obj, "repeat");
+        if (JSON_NODE_HOLDS_VALUE(node) && json_node_get_value_type(node) == G_TYPE_BOOLEAN) {
+            anim->repeat = json_node_get_boolean(node) ? -1 : 1;
+        } else {
+            anim->repeat = get_int_member_or_default(anim_obj, "repeat", 1);
+        }
+    }
+
+    return anim;
+}
+
+/* Templates and repeaters */
+#define INDEX_PLACEHOLDER "{i}"
+
+/* Object member of a widget, falling back to its template */
+static JsonObject* get_widget_object(JsonObject *widget_obj, JsonObject *template_obj,
+                                     const char *member) {
+    if (json_object_has_member(widget_obj, member)) {
+        return json_object_get_object_member(widget_obj, member);
+    }
+    if (template_obj && json_object_has_member(template_obj, member)) {
+        return json_object_get_object_member(template_obj, member);
+    }
+    return NULL;
+}
+
+static char* substitute_index(const char *str, int index) {
+    char **parts = g_strsplit(str, INDEX_PLACEHOLDER, -1);
+    char *number = g_strdup_printf("%d", index);
+    char *result = g_strjoinv(number, parts);
+    g_free(number);
+    g_strfreev(parts);
+    return result;
+}
+
+/* Relative geometry */
+static const char * const geometry_edge_names[GEOMETRY_N_EDGES] = {
+    "left", "right", "center_x", "width", "top", "bottom", "center_y", "height"
+};
+
+static gboolean parse_geometry_edge(const char *name, GeometryEdge *edge) {
+    for (int i = 0; i < GEOMETRY_N_EDGES; i++) {
+        if (strcmp(name, geometry_edge_names[i]) == 0) {
+            *edge = (GeometryEdge)i;
+            return TRUE;
+        }
+    }
+    return FALSE;
+}
+
+static JsonNode* get_geometry_member(JsonObject *geom, JsonObject *template_geom,
+                                     const char *member) {
+    if (geom && json_object_has_member(geom, member)) return json_object_get_member(geom, member);
+    if (template_geom && json_object_has_member(template_geom, member)) {
+        return json_object_get_member(template_geom, member);
+    }
+    return NULL;
+}
+
+/* A number, "N%" of the window along the same axis, or an anchor
+ * { "to": id | "window", "edge" (default: the same edge), "multiplier", "offset" } */
+static gboolean parse_geometry_term(JsonNode *node, GeometryEdge edge, int index,
+                                    GeometryTerm *term) {
+    term->multiplier = 1.0;
+
+    if (JSON_NODE_HOLDS_VALUE(node) && json_node_get_value_type(node) != G_TYPE_STRING) {
+        term->offset = json_node_get_double(node);
+        return TRUE;
+    }
+
+    if (JSON_NODE_HOLDS_VALUE(node)) {
+        const char *str = json_node_get_string(node);
+        char *end = NULL;
+        double percent = g_ascii_strtod(str, &end);
+        if (end == str || strcmp(end, "%") != 0) {
+            g_warning("Invalid geometry value '%s' for '%s'", str, geometry_edge_names[edge]);
+            return FALSE;
+        }
+        term->target = g_strdup("window");
+        term->target_edge = edge < GEOMETRY_TOP ? GEOMETRY_WIDTH : GEOMETRY_HEIGHT;
+        term->multiplier = percent / 100.0;
+        return TRUE;
+    }
+
+    if (!JSON_NODE_HOLDS_OBJECT(node)) return FALSE;
+
+    JsonObject *anchor = json_node_get_object(node);
+    char *target = get_string_member_or_null(anchor, "to");
+    if (!target) {
+        g_warning("Geometry anchor for '%s' has no \"to\"", geometry_edge_names[edge]);
+        return FALSE;
+    }
+    term->target = index >= 0 && strstr(target, INDEX_PLACEHOLDER)
+        ? substitute_index(target, index) : g_strdup(target);
+    g_free(target);
+
+    term->target_edge = edge;
+    char *edge_name = get_string_member_or_null(anchor, "edge");
+    if (edge_name && !parse_geometry_edge(edge_name, &term->target_edge)) {
+        g_warning("Unknown geometry edge '%s'", edge_name);
+    }
+    g_free(edge_name);
+
+    term->multiplier = get_double_member_or_default(anchor, "multiplier", 1.0);
+    term->offset = get_double_member_or_default(anchor, "offset", 0.0);
+    return TRUE;
+}
+
+/* Keep two edges per axis: the first two given, completed with the
+ * default position (0) and size */
+static void normalize_geometry_axis(GeometryConstraints *constraints, int axis,
+                                    int default_size, const char *widget_name) {
+    int base = axis * 4;
+    guint set = (constraints->set >> base) & 0xF;
+    int count = 0;
+
+    for (int kind = 0; kind < 4; kind++) {
+        if (!(set & (1u << kind))) continue;
+        if (++count > 2) {
+            g_warning("Geometry of '%s' is over-constrained, ignoring '%s'",
+                      widget_name, geometry_edge_names[base + kind]);
+            g_clear_pointer(&constraints->terms[base + kind].target, g_free);
+            set &= ~(1u << kind);
+        }
+    }
+
+    if (!(set & 8) && count < 2) {
+        constraints->terms[base + 3] = (GeometryTerm){ NULL, 0, 1.0, default_size };
+        set |= 8;
+    }
+    if (set == 8) {
+        constraints->terms[base] = (GeometryTerm){ NULL, 0, 1.0, 0.0 };
+        set |= 1;
+    }
+
+    constraints->set = (constraints->set & ~(0xFu << base)) | (set << base);
+}
+
+static void parse_geometry(WidgetConfig *config, JsonObject *geom, JsonObject *template_geom,
+                           int index, int offset_x, int offset_y) {
+    GeometryConstraints constraints = { 0 };
+    gboolean relative = FALSE;
+
+    for (int edge = 0; edge < GEOMETRY_N_EDGES; edge++) {
+        JsonNode *node = get_geometry_member(geom, template_geom, geometry_edge_names[edge]);
+        if (!node && edge == GEOMETRY_LEFT) node = get_geometry_member(geom, template_geom, "x");
+        if (!node && edge == GEOMETRY_TOP) node = get_geometry_member(geom, template_geom, "y");
+
+        if (node && parse_geometry_term(node, edge, index, &constraints.terms[edge])) {
+            constraints.set |= 1u << edge;
+            relative |= constraints.terms[edge].target != NULL;
+        }
+    }
+
+    const char *name = config->id ? config->id : "(no id)";
+    normalize_geometry_axis(&constraints, 0, 100, name);
+    normalize_geometry_axis(&constraints, 1, 30, name);
+
+    /* Plain x/y/width/height need no solving */
+    guint absolute = (1u << GEOMETRY_LEFT) | (1u << GEOMETRY_WIDTH) |
+                     (1u << GEOMETRY_TOP) | (1u << GEOMETRY_HEIGHT);
+    if (!relative && constraints.set == absolute) {
+        config->x = (int)constraints.terms[GEOMETRY_LEFT].offset + offset_x;
+        config->y = (int)constraints.terms[GEOMETRY_TOP].offset + offset_y;
+        config->width = (int)constraints.terms[GEOMETRY_WIDTH].offset;
+        config->height = (int)constraints.terms[GEOMETRY_HEIGHT].offset;
+        return;
+    }
+
+    /* Repeater offsets shift every position term */
+    for (int edge = 0; edge < GEOMETRY_N_EDGES; edge++) {
+        if (edge % 4 == 3) continue;
+        constraints.terms[edge].offset += edge < GEOMETRY_TOP ? offset_x : offset_y;
+    }
+    config->constraints = g_new(GeometryConstraints, 1);
+    *config->constraints = constraints;
+}
+
+static gboolean geometry_is_relative(const GeometryConstraints *constraints) {
+    for (int edge = 0; edge < GEOMETRY_N_EDGES; edge++) {
+        if ((constraints->set & (1u << edge)) && constraints->terms[edge].target) return TRUE;
+    }
+    return FALSE;
+}
+
+/* Solve relative geometry for the window's size; constraints made only of
+ * constants are dropped once solved */
+static gboolean resolve_geometry(GList *widgets, const WindowConfig *window, GError **error) {
+    gboolean constrained = FALSE;
+    for (GList *l = widgets; l != NULL && !constrained; l = l->next) {
+        constrained = ((WidgetConfig *)l->data)->constraints != NULL;
+    }
+    if (!constrained) return TRUE;
+
+    if (!layout_solver_resolve(widgets, window->width > 0 ? window->width : 1920,
+                               window->height > 0 ? window->height : 1080, error)) {
+        return FALSE;
+    }
+
+    for (GList *l = widgets; l != NULL; l = l->next) {
+        WidgetConfig *config = (WidgetConfig *)l->data;
+        if (config->constraints && !geometry_is_relative(config->constraints)) {
+            g_clear_pointer(&config->constraints, geometry_constraints_free);
+        }
+    }
+    return TRUE;
+}
+
+/* Prop bindings */
+
+/* Props given as { "expr": "...", "format": "..." }, in member order */
+static GList* parse_bindings(JsonObject *props, int index) {
+    if (!props) return NULL;
+
+    GList *bindings = NULL;
+    GList *members = json_object_get_members(props);
+    for (GList *l = members; l != NULL; l = l->next) {
+        JsonNode *node = json_object_get_member(props, (const char *)l->data);
+        if (!JSON_NODE_HOLDS_OBJECT(node)) continue;
+
+        JsonObject *binding_obj = json_node_get_object(node);
+        char *source = get_string_member_or_null(binding_obj, "expr");
+        if (!source) continue;
+
+        PropBinding *binding = g_new0(PropBinding, 1);
+        binding->property = g_strdup((const char *)l->data);
+        binding->source = index >= 0 ? substitute_index(source, index) : g_strdup(source);
+        binding->format = get_string_member_or_null(binding_obj, "format");
+        bindings = g_list_prepend(bindings, binding);
+        g_free(source);
+    }
+    g_list_free(members);
+    return g_list_reverse(bindings);
+}
+
+/* Compile the expressions of a widget list and check what they refer to */
+static gboolean compile_bindings(GList *widgets, GError **error) {
+    gboolean bound = FALSE;
+
+    for (GList *l = widgets; l != NULL; l = l->next) {
+        WidgetConfig *config = (WidgetConfig *)l->data;
+
+        for (GList *b = config->bindings; b != NULL; b = b->next) {
+            PropBinding *binding = (PropBinding *)b->data;
+            bound = TRUE;
+
+            if (!expression_check_format(binding->format, error) ||
+                !(binding->expr = expression_compile(binding->source, error))) {
+                g_prefix_error(error, "Prop '%s' of '%s': ", binding->property,
+                               config->id ? config->id : config->type);
+                return FALSE;
+            }
+        }
+    }
+    return !bound || binding_graph_check(widgets, error);
+}
+
+static gboolean has_index_placeholder(JsonObject *obj) {
+    GList *members = json_object_get_members(obj);
+    gboolean found = FALSE;
+
+    for (GList *l = members; l != NULL && !found; l = l->next) {
+        JsonNode *node = json_object_get_member(obj, (const char *)l->data);
+        if (JSON_NODE_HOLDS_VALUE(node) && json_node_get_value_type(node) == G_TYPE_STRING) {
+            found = strstr(json_node_get_string(node), INDEX_PLACEHOLDER) != NULL;
+        }
+    }
+    g_list_free(members);
+    return found;
+}
+
+/* New reference to obj for one instance: shared unless a string member
+ * contains "{i}", in which case a shallow copy gets the index substituted */
+static JsonObject* instance_object(JsonObject *obj, int index) {
+    if (!obj) return NULL;
+    if (index < 0 || !has_index_placeholder(obj)) return json_object_ref(obj);
+
+    JsonObject *copy = json_object_new();
+    GList *members = json_object_get_members(obj);
+    for (GList *l = members; l != NULL; l = l->next) {
+        const char *key = (const char *)l->data;
+        JsonNode *node = json_object_get_member(obj, key);
+
+        if (JSON_NODE_HOLDS_VALUE(node) && json_node_get_value_type(node) == G_TYPE_STRING) {
+            char *value = substitute_index(json_node_get_string(node), index);
+            json_object_set_string_member(copy, key, value);
+            g_free(value);
+        } else {
+            json_object_set_member(copy, key, json_node_copy(node));
+        }
+    }
+    g_list_free(members);
+    return copy;
+}
+
+/* CSS class name for a shared style: prefix plus [A-Za-z0-9_-] */
+static char* style_class_name(const char *prefix, const char *name) {
+    GString *class_name = g_string_new(prefix);
+    for (const char *p = name; *p; p++) {
+        g_string_append_c(class_name, g_ascii_isalnum(*p) || *p == '-' || *p == '_' ? *p : '_');
+    }
+    return g_string_free(class_name, FALSE);
+}
+
+/* One widget, or one instance of a repeater when index >= 0 (offset by
+ * offset_x/offset_y, "{i}" substituted). Members missing from widget_obj
+ * come from template_obj, whose objects are shared rather than copied. */
+static WidgetConfig* parse_widget(JsonObject *widget_obj, JsonObject *template_obj,
+                                  const char *template_name, int index,
+                                  int offset_x, int offset_y) {
     WidgetConfig *config = g_new0(WidgetConfig, 1);
 
-    config->id = get_string_member_or_null(widget_obj, "id");
-    config->type = get_string_member_or_null(widget_obj, "type");
+    char *id = get_string_member_or_null(widget_obj, "id");
+    if (id && index >= 0) {
+        config->id = strstr(id, INDEX_PLACEHOLDER) ? substitute_index(id, index)
+                                                   : g_strdup_printf("%s_%d", id, index);
+        g_free(id);
+    } else {
+        config->id = id;
+    }
 
-    if (json_object_has_member(widget_obj, "geometry")) {
-        JsonObject *geom = json_object_get_object_member(widget_obj, "geometry");
-        config->x = get_int_member_or_default(geom, "x", 0);
-        config->y = get_int_member_or_default(geom, "y", 0);
-        config->width = get_int_member_or_default(geom, "width", 100);
-        config->height = get_int_member_or_default(geom, "height", 30);
+    config->type = get_string_member_or_null(widget_obj, "type");
+    if (!config->type && template_obj) {
+        config->type = get_string_member_or_null(template_obj, "type");
     }
 
-    if (json_object_has_member(widget_obj, "style")) {
-        config->style = json_object_ref(json_object_get_object_member(widget_obj, "style"));
+    JsonObject *geom = json_object_has_member(widget_obj, "geometry")
+        ? json_object_get_object_member(widget_obj, "geometry") : NULL;
+    JsonObject *template_geom = template_obj && json_object_has_member(template_obj, "geometry")
+        ? json_object_get_object_member(template_obj, "geometry") : NULL;
+    if (geom || template_geom) {
+        parse_geometry(config, geom, template_geom, index, offset_x, offset_y);
+    } else {
+        config->x = offset_x;
+        config->y = offset_y;
     }
 
-    if (json_object_has_member(widget_obj, "props")) {
-        config->props = json_object_ref(json_object_get_object_member(widget_obj, "props"));
+    /* Style is never substituted: every instance shares one object and one CSS rule */
+    JsonObject *style = get_widget_object(widget_obj, template_obj, "style");
+    if (style) {
+        config->style = json_object_ref(style);
+        if (!json_object_has_member(widget_obj, "style")) {
+            config->style_class = style_class_name("tpl-", template_name);
+        } else if (index >= 0 && json_object_has_member(widget_obj, "id")) {
+            config->style_class = style_class_name("rep-",
+                json_object_get_string_member(widget_obj, "id"));
+        }
     }
 
-    if (json_object_has_member(widget_obj, "events")) {
-        config->events = json_object_ref(json_object_get_object_member(widget_obj, "events"));
+    config->props = instance_object(get_widget_object(widget_obj, template_obj, "props"), index);
+    config->events = instance_object(get_widget_object(widget_obj, template_obj, "events"), index);
+    config->bindings = parse_bindings(config->props, index);
+
+    JsonObject *anim_source = json_object_has_member(widget_obj, "animations") ? widget_obj
+        : template_obj && json_object_has_member(template_obj, "animations") ? template_obj : NULL;
+    if (anim_source) {
+        JsonArray *animations = json_object_get_array_member(anim_source, "animations");
+        for (guint i = 0; i < json_array_get_length(animations); i++) {
+            JsonObject *anim_obj = json_array_get_object_element(animations, i);
+            config->animations = g_list_prepend(config->animations, parse_animation(anim_obj));
+        }
+        config->animations = g_list_reverse(config->animations);
     }
 
     return config;
 }
 
+/* Repeat: { "count", "columns" (default: one row), "dx", "dy", "start" (first index, 1) } */
+static GList* prepend_widget_entry(GList *widgets, JsonObject *widget_obj, JsonObject *templates) {
+    JsonObject *template_obj = NULL;
+    const char *template_name = NULL;
+
+    if (json_object_has_member(widget_obj, "template")) {
+        template_name = json_object_get_string_member(widget_obj, "template");
+        if (template_name && templates && json_object_has_member(templates, template_name)) {
+            template_obj = json_object_get_object_member(templates, template_name);
+        } else {
+            g_warning("Unknown template '%s'", template_name ? template_name : "(null)");
+            template_name = NULL;
+        }
+    }
+
+    if (!json_object_has_member(widget_obj, "repeat")) {
+        return g_list_prepend(widgets, parse_widget(widget_obj, template_obj, template_name,
+                                                    -1, 0, 0));
+    }
+
+    JsonObject *repeat = json_object_get_object_member(widget_obj, "repeat");
+    int count = get_int_member_or_default(repeat, "count", 1);
+    int columns = get_int_member_or_default(repeat, "columns", count);
+    int dx = get_int_member_or_default(repeat, "dx", 0);
+    int dy = get_int_member_or_default(repeat, "dy", 0);
+    int start = get_int_member_or_default(repeat, "start", 1);
+    if (columns <= 0) columns = MAX(count, 1);
+
+    for (int k = 0; k < count; k++) {
+        widgets = g_list_prepend(widgets, parse_widget(widget_obj, template_obj, template_name,
+                                                       start + k, (k % columns) * dx,
+                                                       (k / columns) * dy));
+    }
+    return widgets;
+}
+
+/* Parse a widgets array, keeping document (z-)order and expanding repeaters */
+static GList* parse_widgets_array(JsonArray *widgets_array, JsonObject *templates) {
+    GList *widgets = NULL;
+    guint n_widgets = json_array_get_length(widgets_array);
+
+    for (guint i = 0; i < n_widgets; i++) {
+        JsonObject *widget_obj = json_array_get_object_element(widgets_array, i);
+        widgets = prepend_widget_entry(widgets, widget_obj, templates);
+    }
+    return g_list_reverse(widgets);
+}
+
+/* Scene: { "id", "file" } or { "id", "background_color", "widgets" } */
+static SceneConfig* parse_scene(JsonObject *scene_obj, const char *base_dir, guint index,
+                                JsonObject *templates) {
+    SceneConfig *scene = g_new0(SceneConfig, 1);
+
+    scene->id = get_string_member_or_null(scene_obj, "id");
+    if (!scene->id) scene->id = g_strdup_printf("scene_%u", index + 1);
+
+    char *file = get_string_member_or_null(scene_obj, "file");
+    if (file) {
+        scene->file = g_path_is_absolute(file) ? g_strdup(file)
+                                               : g_build_filename(base_dir, file, NULL);
+        g_free(file);
+    }
+
+    scene->background_color = get_string_member_or_null(scene_obj, "background_color");
+
+    if (json_object_has_member(scene_obj, "widgets")) {
+        scene->widgets = parse_widgets_array(json_object_get_array_member(scene_obj, "widgets"),
+                                             templates);
+    }
+
+    return scene;
+}
+
+/* Window: { "monitor", "file", "title", "fullscreen", "region": { x, y, width, height } } */
+static OutputConfig* parse_output(JsonObject *output_obj, const char *base_dir) {
+    OutputConfig *output = g_new0(OutputConfig, 1);
+
+    output->monitor = get_int_member_or_default(output_obj, "monitor", -1);
+    output->title = get_string_member_or_null(output_obj, "title");
+    output->fullscreen = TRUE;
+    if (json_object_has_member(output_obj, "fullscreen")) {
+        output->fullscreen = json_object_get_boolean_member(output_obj, "fullscreen");
+    }
+
+    char *file = get_string_member_or_null(output_obj, "file");
+    if (file) {
+        output->file = g_path_is_absolute(file) ? g_strdup(file)
+                                                : g_build_filename(base_dir, file, NULL);
+        g_free(file);
+    }
+
+    if (json_object_has_member(output_obj, "region")) {
+        JsonObject *region = json_object_get_object_member(output_obj, "region");
+        output->has_region = TRUE;
+        output->region_x = get_int_member_or_default(region, "x", 0);
+        output->region_y = get_int_member_or_default(region, "y", 0);
+        output->region_width = get_int_member_or_default(region, "width", 1920);
+        output->region_height = get_int_member_or_default(region, "height", 1080);
+    }
+
+    return output;
+}
+
+/* Feed: { "id", "kind", "interval_ms", "samples_per_tick", "min", "max", "period_ms", "path" } */
+static FeedConfig* parse_feed(JsonObject *feed_obj, const char *base_dir) {
+    FeedConfig *feed = g_new0(FeedConfig, 1);
+
+    feed->id = get_string_member_or_null(feed_obj, "id");
+    feed->kind = get_string_member_or_null(feed_obj, "kind");
+    feed->interval_ms = get_int_member_or_default(feed_obj, "interval_ms", 100);
+    feed->samples_per_tick = get_int_member_or_default(feed_obj, "samples_per_tick", 1);
+    feed->min = get_double_member_or_default(feed_obj, "min", 0.0);
+    feed->max = get_double_member_or_default(feed_obj, "max", 100.0);
+    feed->period_ms = get_double_member_or_default(feed_obj, "period_ms", 10000.0);
+
+    char *path = get_string_member_or_null(feed_obj, "path");
+    if (path) {
+        feed->path = g_path_is_absolute(path) ? g_strdup(path)
+                                              : g_build_filename(base_dir, path, NULL);
+        g_free(path);
+    }
+
+    return feed;
+}
+
+void geometry_constraints_free(GeometryConstraints *constraints) {
+    if (!constraints) return;
+
+    for (int edge = 0; edge < GEOMETRY_N_EDGES; edge++) {
+        g_free(constraints->terms[edge].target);
+    }
+    g_free(constraints);
+}
+
+void prop_binding_free(PropBinding *binding) {
+    if (!binding) return;
+
+    g_free(binding->property);
+    g_free(binding->source);
+    g_free(binding->format);
+    expression_free(binding->expr);
+    g_free(binding);
+}
+
+void feed_config_free(FeedConfig *config) {
+    if (!config) return;
+
+    g_free(config->id);
+    g_free(config->kind);
+    g_free(config->path);
+    g_free(config);
+}
+
+void output_config_free(OutputConfig *config) {
+    if (!config) return;
+
+    g_free(config->file);
+    g_free(config->title);
+    g_free(config);
+}
+
+void scene_config_free(SceneConfig *config) {
+    if (!config) return;
+
+    g_free(config->id);
+    g_free(config->file);
+    g_free(config->background_color);
+    g_list_free_full(config->widgets, (GDestroyNotify)widget_config_free);
+    g_free(config);
+}
+
+void animation_config_free(AnimationConfig *config) {
+    if (!config) return;
+
+    g_free(config->property);
+    g_free(config->easing);
+    g_free(config);
+}
+
 void widget_config_free(WidgetConfig *config) {
     if (!config) return;
 
     g_free(config->id);
     g_free(config->type);
+    geometry_constraints_free(config->constraints);
     if (config->style) json_object_unref(config->style);
     if (config->props) json_object_unref(config->props);
     if (config->events) json_object_unref(config->events);
+    g_list_free_full(config->animations, (GDestroyNotify)animation_config_free);
+    g_list_free_full(config->bindings, (GDestroyNotify)prop_binding_free);
+    g_free(config->style_class);
     g_free(config);
 }
 
-LayoutConfig* layout_config_load_from_file(const char *filename, GError **error) {
+static LayoutConfig* load_layout_file(const char *filename, GError **error) {
     JsonParser *parser = json_parser_new();
 
     if (!json_parser_load_from_file(parser, filename, error)) {
@@ -86,24 +634,143 @@ LayoutConfig* layout_config_load_from_file(const char *filename, GError **error)
         config->window.width = get_int_member_or_default(window_obj, "width", 1920);
         config->window.height = get_int_member_or_default(window_obj, "height", 1080);
         config->window.background_color = get_string_member_or_null(window_obj, "background_color");
+
+        char *scale_mode = get_string_member_or_null(window_obj, "scale_mode");
+        config->window.scale_to_fit = scale_mode && strcmp(scale_mode, "fit") == 0;
+        g_free(scale_mode);
     }
 
+    /* Templates referenced by widgets of this file (and its inline scenes) */
+    JsonObject *templates = json_object_has_member(root_obj, "templates")
+        ? json_object_get_object_member(root_obj, "templates") : NULL;
+
     /* Parse widgets array */
     if (json_object_has_member(root_obj, "widgets")) {
-        JsonArray *widgets_array = json_object_get_array_member(root_obj, "widgets");
-        guint n_widgets = json_array_get_length(widgets_array);
+        config->widgets = parse_widgets_array(json_object_get_array_member(root_obj, "widgets"),
+                                              templates);
+    }
 
-        for (guint i = 0; i < n_widgets; i++) {
-            JsonObject *widget_obj = json_array_get_object_element(widgets_array, i);
-            WidgetConfig *widget = parse_widget(widget_obj);
-            config->widgets = g_list_append(config->widgets, widget);
+    /* Parse scenes (multi-page layouts) */
+    if (json_object_has_member(root_obj, "scenes")) {
+        JsonArray *scenes_array = json_object_get_array_member(root_obj, "scenes");
+        guint n_scenes = json_array_get_length(scenes_array);
+        char *base_dir = g_path_get_dirname(filename);
+
+        for (guint i = 0; i < n_scenes; i++) {
+            JsonObject *scene_obj = json_array_get_object_element(scenes_array, i);
+            config->scenes = g_list_prepend(config->scenes, parse_scene(scene_obj, base_dir, i, templates));
+        }
+        config->scenes = g_list_reverse(config->scenes);
+        g_free(base_dir);
+    }
+
+    /* Parse windows (multi-monitor layouts) */
+    if (json_object_has_member(root_obj, "windows")) {
+        JsonArray *outputs_array = json_object_get_array_member(root_obj, "windows");
+        guint n_outputs = json_array_get_length(outputs_array);
+        char *base_dir = g_path_get_dirname(filename);
+
+        for (guint i = 0; i < n_outputs; i++) {
+            JsonObject *output_obj = json_array_get_object_element(outputs_array, i);
+            config->outputs = g_list_prepend(config->outputs, parse_output(output_obj, base_dir));
+        }
+        config->outputs = g_list_reverse(config->outputs);
+        g_free(base_dir);
+    }
+
+    /* Parse feeds (data sources for charts) */
+    if (json_object_has_member(root_obj, "feeds")) {
+        JsonArray *feeds_array = json_object_get_array_member(root_obj, "feeds");
+        guint n_feeds = json_array_get_length(feeds_array);
+        char *base_dir = g_path_get_dirname(filename);
+
+        for (guint i = 0; i < n_feeds; i++) {
+            JsonObject *feed_obj = json_array_get_object_element(feeds_array, i);
+            config->feeds = g_list_prepend(config->feeds, parse_feed(feed_obj, base_dir));
         }
+        config->feeds = g_list_reverse(config->feeds);
+        g_free(base_dir);
+    }
+
+    /* Relative geometry of this file's widgets, against its own window */
+    gboolean geometry_ok = resolve_geometry(config->widgets, &config->window, error);
+    for (GList *l = config->scenes; l != NULL && geometry_ok; l = l->next) {
+        geometry_ok = resolve_geometry(((SceneConfig *)l->data)->widgets, &config->window, error);
+    }
+    /* Prop bindings never reach across scenes */
+    gboolean bindings_ok = geometry_ok && compile_bindings(config->widgets, error);
+    for (GList *l = config->scenes; l != NULL && bindings_ok; l = l->next) {
+        bindings_ok = compile_bindings(((SceneConfig *)l->data)->widgets, error);
+    }
+    if (!bindings_ok) {
+        layout_config_free(config);
+        g_object_unref(parser);
+        return NULL;
+    }
+
+    config->power.idle_fps = 1;
+    if (json_object_has_member(root_obj, "power")) {
+        JsonObject *power = json_object_get_object_member(root_obj, "power");
+        config->power.max_fps = MAX(get_int_member_or_default(power, "max_fps", 0), 0);
+        config->power.idle_after_s = MAX(get_int_member_or_default(power, "idle_after_s", 0), 0);
+        config->power.idle_fps = MAX(get_int_member_or_default(power, "idle_fps", 1), 0);
+    }
+
+    if (json_object_has_member(root_obj, "scene_options")) {
+        JsonObject *options = json_object_get_object_member(root_obj, "scene_options");
+        config->scene_interval = get_int_member_or_default(options, "interval", 0);
+        config->scene_budget_mb = get_int_member_or_default(options, "memory_budget_mb", 0);
     }
 
     g_object_unref(parser);
     return config;
 }
 
+LayoutConfig* layout_config_load_from_file(const char *filename, GError **error) {
+    tracer_begin("layout_load", g_intern_string(filename));
+    LayoutConfig *config = load_layout_file(filename, error);
+    tracer_end("layout_load");
+    return config;
+}
+
+/* Scene id for a layout file: its basename without extension */
+static char* scene_id_from_filename(const char *filename) {
+    char *base = g_path_get_basename(filename);
+    char *dot = strrchr(base, '.');
+    if (dot && dot != base) *dot = '\0';
+    return base;
+}
+
+LayoutConfig* layout_config_load_from_files(const char * const *filenames, GError **error) {
+    if (!filenames || !filenames[0]) {
+        g_set_error(error, G_IO_ERROR, G_IO_ERROR_INVALID_ARGUMENT, "No layout files given");
+        return NULL;
+    }
+
+    LayoutConfig *config = layout_config_load_from_file(filenames[0], error);
+    if (!config || !filenames[1]) return config;
+
+    /* The first file becomes an inline scene unless it declares its own */
+    if (!config->scenes) {
+        SceneConfig *first = g_new0(SceneConfig, 1);
+        first->id = scene_id_from_filename(filenames[0]);
+        first->background_color = g_strdup(config->window.background_color);
+        first->widgets = config->widgets;
+        config->widgets = NULL;
+        config->scenes = g_list_append(config->scenes, first);
+    }
+
+    /* The others are parsed in the background by the scene manager */
+    for (int i = 1; filenames[i]; i++) {
+        SceneConfig *scene = g_new0(SceneConfig, 1);
+        scene->id = scene_id_from_filename(filenames[i]);
+        scene->file = g_strdup(filenames[i]);
+        config->scenes = g_list_append(config->scenes, scene);
+    }
+
+    return config;
+}
+
 void layout_config_free(LayoutConfig *config) {
     if (!config) return;
 
@@ -111,5 +778,20 @@ void layout_config_free(LayoutConfig *config) {
     g_free(config->window.background_color);
 
     g_list_free_full(config->widgets, (GDestroyNotify)widget_config_free);
+    g_list_free_full(config->scenes, (GDestroyNotify)scene_config_free);
+    g_list_free_full(config->outputs, (GDestroyNotify)output_config_free);
+    g_list_free_full(config->feeds, (GDestroyNotify)feed_config_free);
     g_free(config);
 }
+
+GHashTable* widget_configs_by_id(GList *widgets) {
+    GHashTable *configs = g_hash_table_new(g_str_hash, g_str_equal);
+
+    for (GList *l = widgets; l != NULL; l = l->next) {
+        WidgetConfig *config = (WidgetConfig *)l->data;
+        if (config->id && !g_hash_table_contains(configs, config->id)) {
+            g_hash_table_insert(configs, config->id, config);
+        }
+    }
+    return configs;
+}
@@ -3,30 +3,164 @@
 
 #include <glib.h>
 #include <json-glib/json-glib.h>
+#include "expression.h"
 
 typedef struct {
     char *title;
     int width;
     int height;
     char *background_color;
+    gboolean scale_to_fit;   /* "scale_mode": "fit" */
 } WindowConfig;
 
+/* One entry of a widget's "animations" */
+typedef struct {
+    char *property;          /* "opacity", "rotation", "scale" or "value" */
+    double from;
+    double to;
+    int duration_ms;
+    int delay_ms;
+    char *easing;            /* NULL = linear */
+    int repeat;              /* Number of cycles, -1 = forever */
+    gboolean alternate;      /* Every other cycle runs backwards */
+} AnimationConfig;
+
+/* Edges a geometry member can constrain or refer to; two per axis are given */
+typedef enum {
+    GEOMETRY_LEFT,
+    GEOMETRY_RIGHT,
+    GEOMETRY_CENTER_X,
+    GEOMETRY_WIDTH,
+    GEOMETRY_TOP,
+    GEOMETRY_BOTTOM,
+    GEOMETRY_CENTER_Y,
+    GEOMETRY_HEIGHT,
+    GEOMETRY_N_EDGES
+} GeometryEdge;
+
+/* edge = multiplier * target.target_edge + offset */
+typedef struct {
+    char *target;            /* Widget id, "window", or NULL for the constant offset */
+    GeometryEdge target_edge;
+    double multiplier;
+    double offset;
+} GeometryTerm;
+
+/* Relative "geometry": percentages, anchors and alignment */
+typedef struct {
+    guint set;               /* Bit per GeometryEdge, exactly two per axis */
+    GeometryTerm terms[GEOMETRY_N_EDGES];
+} GeometryConstraints;
+
+/* A prop given as { "expr", "format" }: computed from other widgets' values */
+typedef struct {
+    char *property;
+    char *source;            /* Expression text, "{i}" substituted */
+    char *format;            /* printf format for text, or NULL */
+    Expression *expr;        /* Compiled when the layout is loaded */
+} PropBinding;
+
 typedef struct {
     char *id;
     char *type;
-    int x, y, width, height;
+    int x, y, width, height;         /* Solved for the window size when constrained */
+    GeometryConstraints *constraints;  /* NULL = absolute geometry */
     JsonObject *style;
     JsonObject *props;
     JsonObject *events;
+    GList *animations;       /* List of AnimationConfig* */
+    GList *bindings;         /* List of PropBinding*, props given as expressions */
+    char *style_class;       /* Set when style is shared (template or repeat): one CSS class rule */
 } WidgetConfig;
 
+/* Value a prop takes, for checking layouts without building them */
+typedef enum {
+    PROP_KIND_STRING,
+    PROP_KIND_STRING_LIST,   /* Comma-separated string or array of strings */
+    PROP_KIND_NUMBER,
+    PROP_KIND_INTEGER,
+    PROP_KIND_BOOLEAN,
+    PROP_KIND_COLOR,         /* CSS colour, as gdk_rgba_parse() reads it */
+    PROP_KIND_HEX_COLOR,     /* Shapes: "#RRGGBB" or "transparent" */
+    PROP_KIND_CHOICE,        /* One of "a|b|c" */
+    PROP_KIND_ARRAY,
+    PROP_KIND_OBJECT,
+    PROP_KIND_POINTS         /* Polyline / Polygon points */
+} PropKind;
+
+/* One prop a widget or shape type reads; lists end with PROP_SPEC_END */
+typedef struct {
+    const char *name;
+    PropKind kind;
+    double min, max;         /* Numbers and integers, inclusive */
+    const char *choices;
+} PropSpec;
+
+#define PROP_SPEC(name, kind) { (name), PROP_KIND_##kind, -G_MAXDOUBLE, G_MAXDOUBLE, NULL }
+#define PROP_SPEC_RANGE(name, kind, min, max) { (name), PROP_KIND_##kind, (min), (max), NULL }
+#define PROP_SPEC_CHOICE(name, choices) { (name), PROP_KIND_CHOICE, 0, 0, (choices) }
+#define PROP_SPEC_END { NULL, 0, 0, 0, NULL }
+
+typedef struct {
+    char *id;
+    char *file;              /* External layout file (resolved path), or NULL */
+    char *background_color;  /* Inline scenes only; file scenes use their window */
+    GList *widgets;          /* Inline scenes: list of WidgetConfig* */
+} SceneConfig;
+
+/* One entry of "windows": a toplevel window showing a layout or a region of it */
+typedef struct {
+    int monitor;             /* Monitor index, -1 = let the window manager decide */
+    char *file;              /* Layout file (resolved path), NULL = this layout */
+    char *title;
+    gboolean fullscreen;
+    gboolean has_region;
+    int region_x, region_y, region_width, region_height;
+} OutputConfig;
+
+/* One entry of "feeds": a source of samples for the channel named id */
+typedef struct {
+    char *id;
+    char *kind;              /* "sine", "random" or "file" */
+    int interval_ms;         /* Generators: time between ticks */
+    int samples_per_tick;    /* Generators: samples published per tick */
+    double min, max;         /* Generators: value range */
+    double period_ms;        /* "sine": length of one wave */
+    char *path;              /* "file": file or FIFO (resolved path) */
+} FeedConfig;
+
+/* "power": limits for panels running unattended */
+typedef struct {
+    int max_fps;             /* Data-driven redraws and animations, 0 = display rate */
+    int idle_after_s;        /* Idle after this long without input or value changes, 0 = never */
+    int idle_fps;            /* Rate while idle */
+} PowerConfig;
+
 typedef struct {
     WindowConfig window;
     GList *widgets;  /* List of WidgetConfig* */
+    GList *scenes;   /* List of SceneConfig*, empty for single-page layouts */
+    int scene_interval;      /* Seconds between automatic scene switches, 0 = off */
+    int scene_budget_mb;     /* Memory budget for built scenes, 0 = unlimited */
+    GList *outputs;  /* List of OutputConfig*, empty = one window for this layout */
+    GList *feeds;    /* List of FeedConfig* */
+    PowerConfig power;
 } LayoutConfig;
 
 LayoutConfig* layout_config_load_from_file(const char *filename, GError **error);
+/* Load several layout files as the scenes of one layout (window from the first) */
+LayoutConfig* layout_config_load_from_files(const char * const *filenames, GError **error);
 void layout_config_free(LayoutConfig *config);
 void widget_config_free(WidgetConfig *config);
+void animation_config_free(AnimationConfig *config);
+void scene_config_free(SceneConfig *config);
+void output_config_free(OutputConfig *config);
+void feed_config_free(FeedConfig *config);
+void geometry_constraints_free(GeometryConstraints *constraints);
+void prop_binding_free(PropBinding *binding);
+
+/* id -> WidgetConfig* of a widget list, for references between widgets;
+ * the first widget wins for a duplicated id. Free with g_hash_table_destroy. */
+GHashTable* widget_configs_by_id(GList *widgets);
 
 #endif /* JSON_PARSER_H */
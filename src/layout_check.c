@@ -0,0 +1,503 @@
+#include "layout_check.h"
+#include "json_parser.h"
+#include "widget_factory.h"
+#include "shape_renderer.h"
+#include "poly_path.h"
+#include <math.h>
+#include <stdarg.h>
+#include <string.h>
+
+/* Overlap warnings reported per widget list before they are only counted */
+#define MAX_OVERLAP_FINDINGS 50
+
+/* Result of the file this thread is loading, for the log writer */
+static GPrivate current_result;
+
+/* ── Findings ────────────────────────────────────────────── */
+
+static void finding_free(gpointer data) {
+    LayoutCheckFinding *finding = (LayoutCheckFinding *)data;
+    g_free(finding->id);
+    g_free(finding->message);
+    g_free(finding);
+}
+
+static void add_finding(LayoutCheckResult *result, LayoutCheckSeverity severity,
+                        const char *code, const char *id, const char *format, ...)
+    G_GNUC_PRINTF(5, 6);
+
+static void add_finding(LayoutCheckResult *result, LayoutCheckSeverity severity,
+                        const char *code, const char *id, const char *format, ...) {
+    LayoutCheckFinding *finding = g_new0(LayoutCheckFinding, 1);
+    va_list args;
+
+    va_start(args, format);
+    finding->message = g_strdup_vprintf(format, args);
+    va_end(args);
+    finding->severity = severity;
+    finding->code = code;
+    finding->id = g_strdup(id);
+
+    g_ptr_array_add(result->findings, finding);
+    if (severity == LAYOUT_CHECK_ERROR) result->errors++; else result->warnings++;
+}
+
+/* Id, or type for widgets without one, for messages */
+static const char* widget_label(const WidgetConfig *config) {
+    return config->id ? config->id : config->type ? config->type : "(untyped)";
+}
+
+/* ── Parser messages ─────────────────────────────────────── */
+
+static GLogWriterOutput log_writer(GLogLevelFlags level, const GLogField *fields,
+                                   gsize n_fields, gpointer user_data) {
+    LayoutCheckResult *result = g_private_get(&current_result);
+
+    if (!result || !(level & (G_LOG_LEVEL_WARNING | G_LOG_LEVEL_CRITICAL))) {
+        return g_log_writer_default(level, fields, n_fields, user_data);
+    }
+
+    for (gsize i = 0; i < n_fields; i++) {
+        if (strcmp(fields[i].key, "MESSAGE") != 0) continue;
+        char *message = fields[i].length < 0 ? g_strdup(fields[i].value)
+                                             : g_strndup(fields[i].value, fields[i].length);
+        add_finding(result, LAYOUT_CHECK_ERROR, "parse", NULL, "%s", message);
+        g_free(message);
+        break;
+    }
+    return G_LOG_WRITER_HANDLED;
+}
+
+void layout_check_init(void) {
+    static gsize initialized = 0;
+
+    if (g_once_init_enter(&initialized)) {
+        g_log_set_writer_func(log_writer, NULL, NULL);
+        g_once_init_leave(&initialized, 1);
+    }
+}
+
+/* ── Values ──────────────────────────────────────────────── */
+
+static gboolean holds_type(JsonNode *node, GType type) {
+    return JSON_NODE_HOLDS_VALUE(node) && json_node_get_value_type(node) == type;
+}
+
+static gboolean holds_number(JsonNode *node) {
+    return holds_type(node, G_TYPE_DOUBLE) || holds_type(node, G_TYPE_INT64);
+}
+
+/* What shape_renderer draws: "#RRGGBB" or "transparent" */
+static gboolean is_hex_color(const char *color) {
+    if (strcmp(color, "transparent") == 0) return TRUE;
+    if (color[0] != '#' || strlen(color) != 7) return FALSE;
+    for (int i = 1; i < 7; i++) {
+        if (!g_ascii_isxdigit(color[i])) return FALSE;
+    }
+    return TRUE;
+}
+
+static gboolean is_color(JsonNode *node, gboolean hex) {
+    if (!holds_type(node, G_TYPE_STRING)) return FALSE;
+
+    const char *color = json_node_get_string(node);
+    GdkRGBA rgba;
+    return hex ? is_hex_color(color) : gdk_rgba_parse(&rgba, color);
+}
+
+static gboolean is_choice(JsonNode *node, const char *choices) {
+    if (!holds_type(node, G_TYPE_STRING)) return FALSE;
+
+    const char *value = json_node_get_string(node);
+    gsize length = strlen(value);
+    for (const char *c = choices; c; c = strchr(c, '|') ? strchr(c, '|') + 1 : NULL) {
+        if (strncmp(c, value, length) == 0 && (c[length] == '|' || c[length] == '\0')) {
+            return TRUE;
+        }
+    }
+    return FALSE;
+}
+
+static gboolean is_string_list(JsonNode *node) {
+    if (holds_type(node, G_TYPE_STRING)) return TRUE;
+    if (!JSON_NODE_HOLDS_ARRAY(node)) return FALSE;
+
+    JsonArray *array = json_node_get_array(node);
+    for (guint i = 0; i < json_array_get_length(array); i++) {
+        if (!holds_type(json_array_get_element(array, i), G_TYPE_STRING)) return FALSE;
+    }
+    return TRUE;
+}
+
+static const char* kind_name(PropKind kind) {
+    switch (kind) {
+    case PROP_KIND_STRING:      return "a string";
+    case PROP_KIND_STRING_LIST: return "a string or an array of strings";
+    case PROP_KIND_NUMBER:      return "a number";
+    case PROP_KIND_INTEGER:     return "an integer";
+    case PROP_KIND_BOOLEAN:     return "true or false";
+    case PROP_KIND_COLOR:       return "a CSS color";
+    case PROP_KIND_HEX_COLOR:   return "\"#RRGGBB\" or \"transparent\"";
+    case PROP_KIND_CHOICE:      return "one of";
+    case PROP_KIND_ARRAY:       return "an array";
+    case PROP_KIND_OBJECT:      return "an object";
+    case PROP_KIND_POINTS:      return "a point array";
+    }
+    return "valid";
+}
+
+/* Members named "color" or "*_color" anywhere below node: gradient stops, gauge bands */
+static void check_nested_colors(LayoutCheckResult *result, const char *id, const char *prop,
+                                JsonNode *node, gboolean hex) {
+    if (JSON_NODE_HOLDS_ARRAY(node)) {
+        JsonArray *array = json_node_get_array(node);
+        for (guint i = 0; i < json_array_get_length(array); i++) {
+            check_nested_colors(result, id, prop, json_array_get_element(array, i), hex);
+        }
+    } else if (JSON_NODE_HOLDS_OBJECT(node)) {
+        JsonObject *object = json_node_get_object(node);
+        GList *members = json_object_get_members(object);
+        for (GList *l = members; l != NULL; l = l->next) {
+            const char *name = (const char *)l->data;
+            JsonNode *member = json_object_get_member(object, name);
+            if (g_str_has_suffix(name, "color") && !is_color(member, hex)) {
+                add_finding(result, LAYOUT_CHECK_ERROR, "color", id,
+                            "\"%s\" in prop '%s' is not %s", name, prop,
+                            kind_name(hex ? PROP_KIND_HEX_COLOR : PROP_KIND_COLOR));
+            } else {
+                check_nested_colors(result, id, prop, member, hex);
+            }
+        }
+        g_list_free(members);
+    }
+}
+
+static void check_range(LayoutCheckResult *result, const char *id, const PropSpec *spec,
+                        double value) {
+    if (value >= spec->min && value <= spec->max) return;
+
+    if (spec->max == G_MAXDOUBLE || spec->max == G_MAXINT) {
+        add_finding(result, LAYOUT_CHECK_ERROR, "prop-range", id,
+                    "Prop '%s' is %g, must be at least %g", spec->name, value, spec->min);
+    } else {
+        add_finding(result, LAYOUT_CHECK_ERROR, "prop-range", id,
+                    "Prop '%s' is %g, must be between %g and %g",
+                    spec->name, value, spec->min, spec->max);
+    }
+}
+
+static void check_value(LayoutCheckResult *result, const char *id, const PropSpec *spec,
+                        JsonNode *node, gboolean shape) {
+    gboolean ok = TRUE;
+
+    switch (spec->kind) {
+    case PROP_KIND_STRING:
+        ok = holds_type(node, G_TYPE_STRING);
+        break;
+    case PROP_KIND_STRING_LIST:
+        ok = is_string_list(node);
+        break;
+    case PROP_KIND_NUMBER:
+        ok = holds_number(node);
+        if (ok) check_range(result, id, spec, json_node_get_double(node));
+        break;
+    case PROP_KIND_INTEGER:
+        ok = holds_type(node, G_TYPE_INT64) ||
+             (holds_type(node, G_TYPE_DOUBLE) &&
+              json_node_get_double(node) == floor(json_node_get_double(node)));
+        if (ok) check_range(result, id, spec, json_node_get_double(node));
+        break;
+    case PROP_KIND_BOOLEAN:
+        ok = holds_type(node, G_TYPE_BOOLEAN);
+        break;
+    case PROP_KIND_COLOR:
+    case PROP_KIND_HEX_COLOR:
+        ok = is_color(node, spec->kind == PROP_KIND_HEX_COLOR);
+        break;
+    case PROP_KIND_CHOICE:
+        if (!is_choice(node, spec->choices)) {
+            char **list = g_strsplit(spec->choices, "|", -1);
+            char *choices = g_strjoinv("\", \"", list);
+            add_finding(result, LAYOUT_CHECK_ERROR, "prop-value", id,
+                        "Prop '%s' must be one of \"%s\"", spec->name, choices);
+            g_free(choices);
+            g_strfreev(list);
+        }
+        return;
+    case PROP_KIND_ARRAY:
+        ok = JSON_NODE_HOLDS_ARRAY(node);
+        if (ok) check_nested_colors(result, id, spec->name, node, shape);
+        break;
+    case PROP_KIND_OBJECT:
+        ok = JSON_NODE_HOLDS_OBJECT(node);
+        if (ok) check_nested_colors(result, id, spec->name, node, shape);
+        break;
+    case PROP_KIND_POINTS: {
+        GError *error = NULL;
+        PolyPath *path = poly_path_new_from_json(node, &error);
+        if (!path) {
+            add_finding(result, LAYOUT_CHECK_ERROR, "prop-value", id, "%s", error->message);
+            g_error_free(error);
+        }
+        poly_path_free(path);
+        return;
+    }
+    }
+
+    if (!ok) {
+        add_finding(result, LAYOUT_CHECK_ERROR,
+                    spec->kind == PROP_KIND_COLOR || spec->kind == PROP_KIND_HEX_COLOR
+                        ? "color" : "prop-type",
+                    id, "Prop '%s' must be %s", spec->name, kind_name(spec->kind));
+    }
+}
+
+/* ── Widgets ─────────────────────────────────────────────── */
+
+static const PropSpec* find_spec(const PropSpec *specs, const char *name) {
+    for (const PropSpec *spec = specs; spec && spec->name; spec++) {
+        if (strcmp(spec->name, name) == 0) return spec;
+    }
+    return NULL;
+}
+
+static gboolean get_number(JsonObject *props, const char *name, double *value) {
+    JsonNode *node = json_object_get_member(props, name);
+    if (!node || !holds_number(node)) return FALSE;
+    *value = json_node_get_double(node);
+    return TRUE;
+}
+
+static void check_props(LayoutCheckResult *result, const WidgetConfig *config) {
+    const char *id = config->id;
+    gboolean shape = is_shape_type(config->type);
+    const PropSpec *specs = shape ? shape_renderer_get_props(config->type)
+                                  : widget_factory_get_props(config->type);
+    const PropSpec *common = shape ? shape_renderer_get_common_props() : NULL;
+
+    if (!config->props) return;
+
+    GList *members = json_object_get_members(config->props);
+    for (GList *l = members; l != NULL; l = l->next) {
+        const char *name = (const char *)l->data;
+        JsonNode *node = json_object_get_member(config->props, name);
+
+        /* Bound to an expression, checked when the layout was loaded */
+        if (JSON_NODE_HOLDS_OBJECT(node) &&
+            json_object_has_member(json_node_get_object(node), "expr")) {
+            continue;
+        }
+
+        const PropSpec *spec = find_spec(specs, name);
+        if (!spec) spec = find_spec(common, name);
+        if (!spec) {
+            add_finding(result, LAYOUT_CHECK_WARNING, "unknown-prop", id,
+                        "%s has no prop '%s'", config->type, name);
+            continue;
+        }
+        check_value(result, id, spec, node, shape);
+    }
+    g_list_free(members);
+
+    /* Slider, Spin, Chart, Gauge */
+    double min, max, value;
+    if (get_number(config->props, "min", &min) && get_number(config->props, "max", &max)) {
+        if (min >= max) {
+            add_finding(result, LAYOUT_CHECK_ERROR, "prop-range", id,
+                        "\"min\" (%g) must be less than \"max\" (%g)", min, max);
+        } else if (!shape && get_number(config->props, "value", &value) &&
+                   (value < min || value > max)) {
+            add_finding(result, LAYOUT_CHECK_ERROR, "prop-range", id,
+                        "\"value\" (%g) is outside \"min\" and \"max\" (%g to %g)",
+                        value, min, max);
+        }
+    }
+}
+
+static void check_style(LayoutCheckResult *result, const WidgetConfig *config) {
+    if (!config->style) return;
+
+    GList *members = json_object_get_members(config->style);
+    for (GList *l = members; l != NULL; l = l->next) {
+        const char *name = (const char *)l->data;
+        if (g_str_has_suffix(name, "color") &&
+            !is_color(json_object_get_member(config->style, name), FALSE)) {
+            add_finding(result, LAYOUT_CHECK_ERROR, "color", config->id,
+                        "Style \"%s\" is not a CSS color", name);
+        }
+    }
+    g_list_free(members);
+}
+
+static void check_geometry(LayoutCheckResult *result, const WidgetConfig *config,
+                           int window_width, int window_height) {
+    if (config->width < 0 || config->height < 0) {
+        add_finding(result, LAYOUT_CHECK_ERROR, "geometry", config->id,
+                    "%s has a negative size (%dx%d)", widget_label(config),
+                    config->width, config->height);
+        return;
+    }
+    /* 0 = natural size, unknown without building the widget */
+    if (config->width == 0 || config->height == 0) return;
+
+    int right = config->x + config->width;
+    int bottom = config->y + config->height;
+    if (config->x >= window_width || config->y >= window_height || right <= 0 || bottom <= 0) {
+        add_finding(result, LAYOUT_CHECK_ERROR, "off-window", config->id,
+                    "%s at %d,%d %dx%d is outside the %dx%d window", widget_label(config),
+                    config->x, config->y, config->width, config->height,
+                    window_width, window_height);
+    } else if (config->x < 0 || config->y < 0 || right > window_width || bottom > window_height) {
+        add_finding(result, LAYOUT_CHECK_WARNING, "off-window", config->id,
+                    "%s at %d,%d %dx%d extends past the %dx%d window", widget_label(config),
+                    config->x, config->y, config->width, config->height,
+                    window_width, window_height);
+    }
+}
+
+static gint compare_left(gconstpointer a, gconstpointer b) {
+    const WidgetConfig *wa = *(const WidgetConfig * const *)a;
+    const WidgetConfig *wb = *(const WidgetConfig * const *)b;
+    return (wa->x > wb->x) - (wa->x < wb->x);
+}
+
+/* Sort and sweep along x: only widgets whose x spans meet are compared.
+ * Shapes are decoration and may sit under or over anything. */
+static void check_overlaps(LayoutCheckResult *result, GList *widgets) {
+    GPtrArray *sorted = g_ptr_array_new();
+    for (GList *l = widgets; l != NULL; l = l->next) {
+        WidgetConfig *config = (WidgetConfig *)l->data;
+        if (config->width > 0 && config->height > 0 && !is_shape_type(config->type)) {
+            g_ptr_array_add(sorted, config);
+        }
+    }
+    g_ptr_array_sort(sorted, compare_left);
+
+    GPtrArray *active = g_ptr_array_new();
+    guint overlaps = 0;
+    for (guint i = 0; i < sorted->len; i++) {
+        WidgetConfig *config = g_ptr_array_index(sorted, i);
+
+        for (guint j = 0; j < active->len;) {
+            WidgetConfig *other = g_ptr_array_index(active, j);
+            if (other->x + other->width <= config->x) {
+                g_ptr_array_remove_index_fast(active, j);
+                continue;
+            }
+            if (other->y < config->y + config->height && config->y < other->y + other->height &&
+                ++overlaps <= MAX_OVERLAP_FINDINGS) {
+                add_finding(result, LAYOUT_CHECK_WARNING, "overlap", config->id,
+                            "%s overlaps %s", widget_label(config), widget_label(other));
+            }
+            j++;
+        }
+        g_ptr_array_add(active, config);
+    }
+
+    if (overlaps > MAX_OVERLAP_FINDINGS) {
+        add_finding(result, LAYOUT_CHECK_WARNING, "overlap", NULL,
+                    "%u more overlapping pairs", overlaps - MAX_OVERLAP_FINDINGS);
+    }
+    g_ptr_array_free(active, TRUE);
+    g_ptr_array_free(sorted, TRUE);
+}
+
+/* Checks of one widget list: the layout's own or an inline scene's */
+static void check_widgets(LayoutCheckResult *result, GList *widgets,
+                          int window_width, int window_height) {
+    GHashTable *ids = g_hash_table_new(g_str_hash, g_str_equal);
+
+    for (GList *l = widgets; l != NULL; l = l->next) {
+        WidgetConfig *config = (WidgetConfig *)l->data;
+
+        if (config->id && !g_hash_table_add(ids, config->id)) {
+            add_finding(result, LAYOUT_CHECK_ERROR, "duplicate-id", config->id,
+                        "Id '%s' is used by more than one widget", config->id);
+        }
+
+        if (!config->type) {
+            add_finding(result, LAYOUT_CHECK_ERROR, "unknown-type", config->id,
+                        "Widget has no \"type\"");
+            continue;
+        }
+        if (!is_shape_type(config->type) && !widget_factory_get_props(config->type)) {
+            add_finding(result, LAYOUT_CHECK_ERROR, "unknown-type", config->id,
+                        "Unknown widget type: %s", config->type);
+            continue;
+        }
+
+        check_props(result, config);
+        check_style(result, config);
+        check_geometry(result, config, window_width, window_height);
+    }
+
+    check_overlaps(result, widgets);
+    g_hash_table_destroy(ids);
+}
+
+/* ── Layouts ─────────────────────────────────────────────── */
+
+static void check_background(LayoutCheckResult *result, const char *id, const char *color) {
+    GdkRGBA rgba;
+    if (color && !gdk_rgba_parse(&rgba, color)) {
+        add_finding(result, LAYOUT_CHECK_ERROR, "color", id,
+                    "\"background_color\" '%s' is not a CSS color", color);
+    }
+}
+
+static void check_file_exists(LayoutCheckResult *result, const char *id, const char *file) {
+    if (file && !g_file_test(file, G_FILE_TEST_IS_REGULAR)) {
+        add_finding(result, LAYOUT_CHECK_ERROR, "missing-file", id,
+                    "Layout file %s does not exist", file);
+    }
+}
+
+static void check_layout(LayoutCheckResult *result, LayoutConfig *layout) {
+    int width = layout->window.width > 0 ? layout->window.width : 1920;
+    int height = layout->window.height > 0 ? layout->window.height : 1080;
+
+    check_background(result, NULL, layout->window.background_color);
+    check_widgets(result, layout->widgets, width, height);
+
+    for (GList *l = layout->scenes; l != NULL; l = l->next) {
+        SceneConfig *scene = (SceneConfig *)l->data;
+        check_file_exists(result, scene->id, scene->file);
+        check_background(result, scene->id, scene->background_color);
+        check_widgets(result, scene->widgets, width, height);
+    }
+
+    for (GList *l = layout->outputs; l != NULL; l = l->next) {
+        check_file_exists(result, NULL, ((OutputConfig *)l->data)->file);
+    }
+}
+
+LayoutCheckResult* layout_check_file(const char *path) {
+    LayoutCheckResult *result = g_new0(LayoutCheckResult, 1);
+    gint64 start = g_get_monotonic_time();
+    GError *error = NULL;
+
+    result->path = g_strdup(path);
+    result->findings = g_ptr_array_new_with_free_func(finding_free);
+
+    g_private_set(&current_result, result);
+    LayoutConfig *layout = layout_config_load_from_file(path, &error);
+    g_private_set(&current_result, NULL);
+
+    if (layout) {
+        check_layout(result, layout);
+        layout_config_free(layout);
+    } else {
+        add_finding(result, LAYOUT_CHECK_ERROR, "load", NULL, "%s", error->message);
+        g_error_free(error);
+    }
+
+    result->duration_us = g_get_monotonic_time() - start;
+    return result;
+}
+
+void layout_check_result_free(LayoutCheckResult *result) {
+    if (!result) return;
+    g_free(result->path);
+    g_ptr_array_free(result->findings, TRUE);
+    g_free(result);
+}
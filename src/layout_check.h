@@ -0,0 +1,47 @@
+#ifndef LAYOUT_CHECK_H
+#define LAYOUT_CHECK_H
+
+#include <glib.h>
+
+/*
+ * Layout validation (gtk-dashboard-check).
+ *
+ * A file is loaded with the dashboard's own parser and then checked
+ * without building anything: widget and shape types and their props
+ * against the factory and renderer registries (kind, range, choices,
+ * colour syntax), duplicate ids, geometry against the window and
+ * overlapping widgets, and the scene and window files it refers to.
+ * Warnings and criticals the parser logs while loading the file are
+ * reported as errors of that file.
+ *
+ * Checking is thread-safe: files may be checked from any number of
+ * threads at once.
+ */
+
+typedef enum {
+    LAYOUT_CHECK_ERROR,      /* The layout would fail or misrender */
+    LAYOUT_CHECK_WARNING     /* Likely a mistake */
+} LayoutCheckSeverity;
+
+typedef struct {
+    LayoutCheckSeverity severity;
+    const char *code;        /* Short stable name: "prop-range", "overlap", ... */
+    char *id;                /* Widget or scene id, or NULL */
+    char *message;
+} LayoutCheckFinding;
+
+typedef struct {
+    char *path;
+    GPtrArray *findings;     /* LayoutCheckFinding*, in the order found */
+    guint errors;
+    guint warnings;
+    gint64 duration_us;
+} LayoutCheckResult;
+
+/* Once, before the first check: routes the parser's log messages */
+void layout_check_init(void);
+
+LayoutCheckResult* layout_check_file(const char *path);
+void layout_check_result_free(LayoutCheckResult *result);
+
+#endif /* LAYOUT_CHECK_H */
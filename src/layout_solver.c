@@ -0,0 +1,322 @@
+#include "layout_solver.h"
+#include "dep_graph.h"
+#include <math.h>
+#include <string.h>
+
+#define WINDOW_TARGET "window"
+
+typedef struct _LayoutNode LayoutNode;
+
+struct _LayoutNode {
+    WidgetConfig *config;
+    LayoutNode *sources[GEOMETRY_N_EDGES];  /* Widget read by each term, NULL = window or constant */
+    DepNode *dep;
+    guint window_axes;       /* Bit per axis of the window this one reads */
+    gboolean pinned;         /* Moved explicitly: constraints ignored */
+    double pos[2];           /* Solved left/top and width/height */
+    double size[2];
+    gpointer item;
+};
+
+struct _LayoutSolver {
+    DepGraph *graph;         /* Of LayoutNode* */
+    GHashTable *by_config;   /* WidgetConfig* -> LayoutNode* */
+    GPtrArray *window_dependents[2];  /* LayoutNode* reading the window width / height */
+    double window_size[2];
+    LayoutMovedFunc moved;
+    gpointer moved_data;
+};
+
+/* ── Graph ───────────────────────────────────────────────── */
+
+static LayoutNode* get_node(LayoutSolver *solver, WidgetConfig *config) {
+    LayoutNode *node = g_hash_table_lookup(solver->by_config, config);
+    if (node) return node;
+
+    node = g_new0(LayoutNode, 1);
+    node->config = config;
+    node->pos[0] = config->x;
+    node->pos[1] = config->y;
+    node->size[0] = config->width;
+    node->size[1] = config->height;
+
+    node->dep = dep_graph_add_node(solver->graph, node);
+    g_hash_table_insert(solver->by_config, config, node);
+    return node;
+}
+
+static gboolean add_edges(LayoutSolver *solver, LayoutNode *node, GHashTable *configs,
+                          GError **error) {
+    GeometryConstraints *constraints = node->config->constraints;
+
+    for (int edge = 0; edge < GEOMETRY_N_EDGES; edge++) {
+        const GeometryTerm *term = &constraints->terms[edge];
+        if (!(constraints->set & (1u << edge)) || !term->target) continue;
+
+        if (strcmp(term->target, WINDOW_TARGET) == 0) {
+            guint axis = term->target_edge / 4;
+            if (!(node->window_axes & (1u << axis))) {
+                node->window_axes |= 1u << axis;
+                g_ptr_array_add(solver->window_dependents[axis], node);
+            }
+            continue;
+        }
+
+        WidgetConfig *target = g_hash_table_lookup(configs, term->target);
+        if (!target) {
+            g_set_error(error, G_IO_ERROR, G_IO_ERROR_INVALID_DATA,
+                        "Geometry of '%s' refers to unknown widget '%s'",
+                        node->config->id ? node->config->id : node->config->type, term->target);
+            return FALSE;
+        }
+
+        LayoutNode *source = get_node(solver, target);
+        node->sources[edge] = source;
+        dep_graph_add_edge(solver->graph, source->dep, node->dep);
+    }
+    return TRUE;
+}
+
+static gboolean sort_nodes(LayoutSolver *solver, GError **error) {
+    gpointer cycle = NULL;
+    if (dep_graph_sort(solver->graph, &cycle)) return TRUE;
+
+    LayoutNode *node = (LayoutNode *)cycle;
+    g_set_error(error, G_IO_ERROR, G_IO_ERROR_INVALID_DATA,
+                "Geometry constraints form a cycle through '%s'",
+                node->config->id ? node->config->id : node->config->type);
+    return FALSE;
+}
+
+/* ── Solving ─────────────────────────────────────────────── */
+
+/* Edges come in the same order on both axes: start, end, centre, size */
+static double edge_value(int kind, double pos, double size) {
+    switch (kind) {
+    case 0:  return pos;
+    case 1:  return pos + size;
+    case 2:  return pos + size / 2.0;
+    default: return size;
+    }
+}
+
+static double term_value(LayoutSolver *solver, LayoutNode *node, int edge) {
+    const GeometryTerm *term = &node->config->constraints->terms[edge];
+    if (!term->target) return term->offset;
+
+    int axis = term->target_edge / 4;
+    LayoutNode *source = node->sources[edge];
+    double pos = source ? source->pos[axis] : 0.0;
+    double size = source ? source->size[axis] : solver->window_size[axis];
+    return term->multiplier * edge_value(term->target_edge % 4, pos, size) + term->offset;
+}
+
+static void solve_axis(LayoutSolver *solver, LayoutNode *node, int axis,
+                       double *pos, double *size) {
+    guint set = (node->config->constraints->set >> (axis * 4)) & 0xF;
+    double value[4] = { 0 };
+
+    for (int kind = 0; kind < 4; kind++) {
+        if (set & (1u << kind)) value[kind] = term_value(solver, node, axis * 4 + kind);
+    }
+
+    if (set & 8) {
+        *size = value[3];
+        *pos = (set & 1) ? value[0] : (set & 2) ? value[1] - *size : value[2] - *size / 2.0;
+    } else if ((set & 3) == 3) {
+        *pos = value[0];
+        *size = value[1] - value[0];
+    } else if (set & 1) {
+        *pos = value[0];
+        *size = 2.0 * (value[2] - value[0]);
+    } else {
+        *size = 2.0 * (value[1] - value[2]);
+        *pos = value[1] - *size;
+    }
+    /* A size <= 0 would mean "natural size" to the canvas */
+    *size = MAX(*size, 1.0);
+}
+
+static gboolean solve_node(LayoutSolver *solver, LayoutNode *node) {
+    if (node->pinned || !node->config->constraints) return FALSE;
+
+    double pos[2], size[2];
+    solve_axis(solver, node, 0, &pos[0], &size[0]);
+    solve_axis(solver, node, 1, &pos[1], &size[1]);
+    if (memcmp(pos, node->pos, sizeof(pos)) == 0 && memcmp(size, node->size, sizeof(size)) == 0) {
+        return FALSE;
+    }
+
+    memcpy(node->pos, pos, sizeof(pos));
+    memcpy(node->size, size, sizeof(size));
+    return TRUE;
+}
+
+/* Rounded so that adjacent edges stay adjacent */
+static void node_rect(LayoutNode *node, int *x, int *y, int *width, int *height) {
+    *x = (int)floor(node->pos[0] + 0.5);
+    *y = (int)floor(node->pos[1] + 0.5);
+    *width = (int)floor(node->pos[0] + node->size[0] + 0.5) - *x;
+    *height = (int)floor(node->pos[1] + node->size[1] + 0.5) - *y;
+}
+
+static void notify_moved(LayoutSolver *solver, LayoutNode *node) {
+    if (!solver->moved || !node->item) return;
+
+    int x, y, width, height;
+    node_rect(node, &x, &y, &width, &height);
+    solver->moved(node->item, x, y, width, height, solver->moved_data);
+}
+
+static gboolean update_node(gpointer data, gpointer user_data) {
+    LayoutSolver *solver = (LayoutSolver *)user_data;
+    LayoutNode *node = (LayoutNode *)data;
+
+    if (!solve_node(solver, node)) return FALSE;
+    notify_moved(solver, node);
+    return TRUE;
+}
+
+static void solve_pending(LayoutSolver *solver) {
+    dep_graph_update(solver->graph, update_node, solver);
+}
+
+/* ── Public API ──────────────────────────────────────────── */
+
+gboolean layout_solver_is_geometry_prop(const char *property) {
+    return strcmp(property, "x") == 0 || strcmp(property, "y") == 0 ||
+           strcmp(property, "width") == 0 || strcmp(property, "height") == 0;
+}
+
+gboolean layout_solver_has_geometry_bindings(const WidgetConfig *config) {
+    for (GList *l = config->bindings; l != NULL; l = l->next) {
+        if (layout_solver_is_geometry_prop(((PropBinding *)l->data)->property)) return TRUE;
+    }
+    return FALSE;
+}
+
+LayoutSolver* layout_solver_new(GList *widgets, GError **error) {
+    LayoutSolver *solver = g_new0(LayoutSolver, 1);
+    solver->graph = dep_graph_new(g_free);
+    solver->by_config = g_hash_table_new(g_direct_hash, g_direct_equal);
+    solver->window_dependents[0] = g_ptr_array_new();
+    solver->window_dependents[1] = g_ptr_array_new();
+
+    GHashTable *configs = widget_configs_by_id(widgets);
+    gboolean ok = TRUE;
+    for (GList *l = widgets; l != NULL && ok; l = l->next) {
+        WidgetConfig *config = (WidgetConfig *)l->data;
+        if (config->constraints) {
+            ok = add_edges(solver, get_node(solver, config), configs, error);
+        } else if (layout_solver_has_geometry_bindings(config)) {
+            get_node(solver, config);
+        }
+    }
+    g_hash_table_destroy(configs);
+
+    if (!ok || !sort_nodes(solver, error)) {
+        layout_solver_free(solver);
+        return NULL;
+    }
+    return solver;
+}
+
+void layout_solver_free(LayoutSolver *solver) {
+    if (!solver) return;
+
+    dep_graph_free(solver->graph);
+    g_hash_table_destroy(solver->by_config);
+    g_ptr_array_free(solver->window_dependents[0], TRUE);
+    g_ptr_array_free(solver->window_dependents[1], TRUE);
+    g_free(solver);
+}
+
+gboolean layout_solver_resolve(GList *widgets, int window_width, int window_height,
+                               GError **error) {
+    LayoutSolver *solver = layout_solver_new(widgets, error);
+    if (!solver) return FALSE;
+
+    solver->window_size[0] = window_width;
+    solver->window_size[1] = window_height;
+    guint n_nodes = dep_graph_get_n_nodes(solver->graph);
+    for (guint i = 0; i < n_nodes; i++) {
+        LayoutNode *node = dep_graph_get_data(solver->graph, i);
+        if (node->config->constraints) dep_graph_mark(solver->graph, node->dep);
+    }
+    solve_pending(solver);
+
+    for (guint i = 0; i < n_nodes; i++) {
+        LayoutNode *node = dep_graph_get_data(solver->graph, i);
+        WidgetConfig *config = node->config;
+        if (config->constraints) {
+            node_rect(node, &config->x, &config->y, &config->width, &config->height);
+        }
+    }
+
+    layout_solver_free(solver);
+    return TRUE;
+}
+
+gboolean layout_solver_bind(LayoutSolver *solver, const WidgetConfig *config, gpointer item) {
+    g_return_val_if_fail(solver != NULL, FALSE);
+
+    LayoutNode *node = g_hash_table_lookup(solver->by_config, config);
+    if (!node) return FALSE;
+
+    node->item = item;
+    return TRUE;
+}
+
+void layout_solver_set_moved_func(LayoutSolver *solver, LayoutMovedFunc moved,
+                                  gpointer user_data) {
+    g_return_if_fail(solver != NULL);
+
+    solver->moved = moved;
+    solver->moved_data = user_data;
+}
+
+void layout_solver_set_window_size(LayoutSolver *solver, int width, int height) {
+    g_return_if_fail(solver != NULL);
+
+    double size[2] = { width, height };
+    for (int axis = 0; axis < 2; axis++) {
+        if (size[axis] == solver->window_size[axis]) continue;
+
+        solver->window_size[axis] = size[axis];
+        GPtrArray *dependents = solver->window_dependents[axis];
+        for (guint i = 0; i < dependents->len; i++) {
+            dep_graph_mark(solver->graph, ((LayoutNode *)g_ptr_array_index(dependents, i))->dep);
+        }
+    }
+    solve_pending(solver);
+}
+
+gboolean layout_solver_get_rect(LayoutSolver *solver, const WidgetConfig *config,
+                                int *x, int *y, int *width, int *height) {
+    g_return_val_if_fail(solver != NULL, FALSE);
+
+    LayoutNode *node = g_hash_table_lookup(solver->by_config, config);
+    if (!node) return FALSE;
+
+    node_rect(node, x, y, width, height);
+    return TRUE;
+}
+
+gboolean layout_solver_move(LayoutSolver *solver, const WidgetConfig *config,
+                            int x, int y, int width, int height) {
+    g_return_val_if_fail(solver != NULL, FALSE);
+
+    LayoutNode *node = g_hash_table_lookup(solver->by_config, config);
+    if (!node) return FALSE;
+
+    node->pinned = TRUE;
+    node->pos[0] = x;
+    node->pos[1] = y;
+    node->size[0] = width;
+    node->size[1] = height;
+    notify_moved(solver, node);
+
+    dep_graph_mark_dependents(solver->graph, node->dep);
+    solve_pending(solver);
+    return TRUE;
+}
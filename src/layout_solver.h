@@ -0,0 +1,52 @@
+#ifndef LAYOUT_SOLVER_H
+#define LAYOUT_SOLVER_H
+
+#include "json_parser.h"
+
+/*
+ * Incremental solver for relative geometry (GeometryConstraints).
+ *
+ * Every constraint is one-way: an edge or size of a widget is a linear
+ * function of one edge of the window or of another widget. The widgets
+ * form a dependency graph that is sorted once, when the solver is built
+ * (a cycle is an error). Afterwards a window resize or a widget move only
+ * re-solves the widgets downstream of what changed, in dependency order,
+ * and stops wherever a solved rectangle comes out unchanged.
+ *
+ * Widgets without constraints take part only when another widget refers
+ * to them or a prop binding moves them, with their absolute geometry.
+ */
+
+typedef struct _LayoutSolver LayoutSolver;
+
+/* A solved rectangle changed; item is what layout_solver_bind() gave */
+typedef void (*LayoutMovedFunc)(gpointer item, int x, int y, int width, int height,
+                                gpointer user_data);
+
+/* Graph of a WidgetConfig list, starting from their current x/y/width/height */
+LayoutSolver* layout_solver_new(GList *widgets, GError **error);
+void layout_solver_free(LayoutSolver *solver);
+
+/* Solve a freshly parsed WidgetConfig list for a window size, in place */
+gboolean layout_solver_resolve(GList *widgets, int window_width, int window_height,
+                               GError **error);
+
+/* FALSE when the widget is not part of the graph (it never moves) */
+gboolean layout_solver_bind(LayoutSolver *solver, const WidgetConfig *config, gpointer item);
+void layout_solver_set_moved_func(LayoutSolver *solver, LayoutMovedFunc moved,
+                                  gpointer user_data);
+
+void layout_solver_set_window_size(LayoutSolver *solver, int width, int height);
+/* Current rectangle of a widget; FALSE when it is not part of the graph */
+gboolean layout_solver_get_rect(LayoutSolver *solver, const WidgetConfig *config,
+                                int *x, int *y, int *width, int *height);
+/* Pin a widget to a rectangle, ignoring its constraints, and re-solve its
+ * dependents. FALSE when the widget is not part of the graph. */
+gboolean layout_solver_move(LayoutSolver *solver, const WidgetConfig *config,
+                            int x, int y, int width, int height);
+
+/* "x", "y", "width" and "height" given as prop bindings move the widget */
+gboolean layout_solver_is_geometry_prop(const char *property);
+gboolean layout_solver_has_geometry_bindings(const WidgetConfig *config);
+
+#endif /* LAYOUT_SOLVER_H */
@@ -0,0 +1,668 @@
+#include "log_view.h"
+#include "tracer.h"
+#include "power_policy.h"
+#include <glib-unix.h>
+#include <glib/gstdio.h>
+#include <gio/gunixinputstream.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <math.h>
+
+#define LOG_DEFAULT_LINES 10000
+#define LOG_MAX_LINES (1024 * 1024)
+/* Longer lines are cut. Input is read in chunks of this size and split
+ * here, so a writer that never sends a newline can't grow memory. */
+#define LOG_MAX_LINE_BYTES 4096
+/* Following a file starts this far before its end */
+#define LOG_TAIL_BYTES (64 * 1024)
+/* Batches read by the worker are handed to the main loop at this interval */
+#define LOG_DRAIN_INTERVAL_MS 16
+/* A followed file is checked for new data this often, unless paused */
+#define LOG_POLL_INTERVAL_MS 100
+#define LOG_RECONNECT_INTERVAL_MS 1000
+#define LOG_SCROLL_LINES 3
+
+typedef enum {
+    LOG_LEVEL_INFO,
+    LOG_LEVEL_WARN,
+    LOG_LEVEL_ERROR
+} LogLevel;
+
+typedef struct {
+    char *text;
+    PangoLayout *layout;     /* Only while visible */
+    LogLevel level;
+    guint frame;             /* Last frame the line was drawn in */
+} LogLine;
+
+/* Shared between the widget and its reader thread */
+typedef struct {
+    gint ref_count;
+    GMutex lock;
+    GCond wake;              /* Signalled on resume and cancellation */
+    GPtrArray *pending;      /* char*, oldest first */
+    guint max_pending;
+    gboolean drain_scheduled;
+    gboolean paused;         /* Dashboard not shown: no drains, no file polling */
+    GCancellable *cancellable;
+
+    /* Read-only for the thread */
+    char *path;
+    gboolean is_socket;
+    gboolean from_start;
+
+    LogView *view;           /* Main thread only; NULL once the widget is gone */
+} LogSource;
+
+struct _LogView {
+    GtkWidget parent_instance;
+
+    /* Ring buffer: line seq lives at lines[seq % capacity] */
+    LogLine *lines;
+    guint capacity;
+    guint64 first_seq;
+    guint n_lines;
+
+    char *filter;
+    GArray *matches;         /* guint64 seqs of matching lines, oldest first */
+    guint match_start;       /* Entries before this were evicted */
+
+    guint scroll_offset;     /* Entries between the newest and the bottom line */
+    guint frame;
+    GArray *laid_out;        /* Seqs that got a layout in the last frame */
+
+    PangoFontDescription *font;
+    int line_height;
+    GdkRGBA colors[3];       /* Indexed by LogLevel */
+
+    LogSource *source;
+    guint power_watch;
+};
+
+G_DEFINE_TYPE(LogView, log_view, GTK_TYPE_WIDGET)
+
+/* ── Reader thread ───────────────────────────────────────── */
+
+static LogSource* log_source_ref(LogSource *source) {
+    g_atomic_int_inc(&source->ref_count);
+    return source;
+}
+
+static void log_source_unref(gpointer data) {
+    LogSource *source = (LogSource *)data;
+    if (!g_atomic_int_dec_and_test(&source->ref_count)) return;
+
+    g_mutex_clear(&source->lock);
+    g_cond_clear(&source->wake);
+    g_ptr_array_unref(source->pending);
+    g_object_unref(source->cancellable);
+    g_free(source->path);
+    g_free(source);
+}
+
+static void append_lines(LogView *view, GPtrArray *lines);
+
+/* Main thread: moves everything read so far into the widget */
+static gboolean drain_pending(gpointer user_data) {
+    LogSource *source = (LogSource *)user_data;
+
+    g_mutex_lock(&source->lock);
+    GPtrArray *batch = source->pending;
+    source->pending = g_ptr_array_new_with_free_func(g_free);
+    source->drain_scheduled = FALSE;
+    g_mutex_unlock(&source->lock);
+
+    if (source->view) {
+        tracer_begin("log_append", NULL);
+        append_lines(source->view, batch);
+        tracer_end("log_append");
+    }
+    g_ptr_array_unref(batch);
+    return G_SOURCE_REMOVE;
+}
+
+/* Called with the lock held */
+static void schedule_drain(LogSource *source) {
+    if (source->drain_scheduled || source->paused || source->pending->len == 0) return;
+
+    source->drain_scheduled = TRUE;
+    g_timeout_add_full(G_PRIORITY_DEFAULT, LOG_DRAIN_INTERVAL_MS, drain_pending,
+                       log_source_ref(source), log_source_unref);
+}
+
+/* Takes ownership of line. A reader faster than the main loop only
+ * drops lines the ring would evict anyway; while paused, lines collect
+ * here the same way and are drained on resume. */
+static void log_source_push(LogSource *source, char *line) {
+    g_mutex_lock(&source->lock);
+    if (source->pending->len >= source->max_pending * 2) {
+        g_ptr_array_remove_range(source->pending, 0, source->max_pending);
+    }
+    g_ptr_array_add(source->pending, line);
+    schedule_drain(source);
+    g_mutex_unlock(&source->lock);
+}
+
+/* Main thread */
+static void log_source_set_paused(LogSource *source, gboolean paused) {
+    g_mutex_lock(&source->lock);
+    source->paused = paused;
+    schedule_drain(source);
+    g_cond_signal(&source->wake);
+    g_mutex_unlock(&source->lock);
+}
+
+static void log_source_cancel(LogSource *source) {
+    g_cancellable_cancel(source->cancellable);
+    g_mutex_lock(&source->lock);
+    g_cond_signal(&source->wake);
+    g_mutex_unlock(&source->lock);
+}
+
+/* Blocks for interval_ms, and for as long as the source is paused.
+ * Returns early (FALSE) when the source is cancelled. */
+static gboolean wait_interval(LogSource *source, int interval_ms) {
+    gint64 end_time = g_get_monotonic_time() + interval_ms * G_TIME_SPAN_MILLISECOND;
+
+    g_mutex_lock(&source->lock);
+    while (!g_cancellable_is_cancelled(source->cancellable)) {
+        if (source->paused) {
+            g_cond_wait(&source->wake, &source->lock);
+        } else if (!g_cond_wait_until(&source->wake, &source->lock, end_time)) {
+            break;
+        }
+    }
+    g_mutex_unlock(&source->lock);
+    return !g_cancellable_is_cancelled(source->cancellable);
+}
+
+/* A FIFO opened for reading blocks in open(2) until a writer appears, out
+ * of reach of the cancellable. O_NONBLOCK returns at once; reads then
+ * block again, and the stream polls them together with the cancellable. */
+static GInputStream* open_pipe(LogSource *source, GError **error) {
+    int fd = g_open(source->path, O_RDONLY | O_NONBLOCK | O_CLOEXEC, 0);
+    if (fd < 0) {
+        int saved_errno = errno;
+        g_set_error(error, G_IO_ERROR, g_io_error_from_errno(saved_errno),
+                    "%s", g_strerror(saved_errno));
+        return NULL;
+    }
+    if (!g_unix_set_fd_nonblocking(fd, FALSE, error)) {
+        g_close(fd, NULL);
+        return NULL;
+    }
+    return g_unix_input_stream_new(fd, TRUE);
+}
+
+static GInputStream* open_file(LogSource *source, gboolean *skip_partial, GError **error) {
+    *skip_partial = FALSE;
+    if (g_file_test(source->path, G_FILE_TEST_EXISTS) &&
+        !g_file_test(source->path, G_FILE_TEST_IS_REGULAR)) {
+        return open_pipe(source, error);
+    }
+
+    GFile *file = g_file_new_for_path(source->path);
+    GFileInputStream *input = g_file_read(file, source->cancellable, error);
+    g_object_unref(file);
+    if (!input) return NULL;
+
+    /* Follow a regular file from near its end, like tail */
+    if (!source->from_start && g_file_test(source->path, G_FILE_TEST_IS_REGULAR)) {
+        GFileInfo *info = g_file_input_stream_query_info(input, G_FILE_ATTRIBUTE_STANDARD_SIZE,
+                                                         source->cancellable, NULL);
+        goffset size = info ? g_file_info_get_size(info) : 0;
+        if (info) g_object_unref(info);
+
+        if (size > LOG_TAIL_BYTES &&
+            g_seekable_seek(G_SEEKABLE(input), size - LOG_TAIL_BYTES, G_SEEK_SET,
+                            source->cancellable, NULL)) {
+            *skip_partial = TRUE;
+        }
+    }
+    return G_INPUT_STREAM(input);
+}
+
+static GIOStream* open_socket(LogSource *source, GError **error) {
+    GSocketClient *client = g_socket_client_new();
+    GSocketAddress *address = g_unix_socket_address_new(source->path);
+    GSocketConnection *connection = g_socket_client_connect(client,
+        G_SOCKET_CONNECTABLE(address), source->cancellable, error);
+    g_object_unref(address);
+    g_object_unref(client);
+    return connection ? G_IO_STREAM(connection) : NULL;
+}
+
+/* Hands over a complete line, unless it is the partial first one */
+static void emit_line(LogSource *source, GString *line, gboolean *skip_partial) {
+    if (*skip_partial) {
+        *skip_partial = FALSE;
+    } else {
+        gsize length = line->len;
+        if (length > 0 && line->str[length - 1] == '\r') length--;
+        log_source_push(source, g_utf8_make_valid(line->str, length));
+    }
+    g_string_truncate(line, 0);
+}
+
+/* Reads lines until end of stream, an error or cancellation. Returns
+ * FALSE when a followed file was truncated and must be reopened. */
+static gboolean read_lines(LogSource *source, GInputStream *input, gboolean skip_partial) {
+    gboolean regular = !source->is_socket && g_file_test(source->path, G_FILE_TEST_IS_REGULAR);
+    goffset position = regular ? g_seekable_tell(G_SEEKABLE(input)) : 0;
+    gboolean intact = TRUE;
+    char buffer[LOG_MAX_LINE_BYTES];
+    GString *line = g_string_sized_new(LOG_MAX_LINE_BYTES);
+
+    while (!g_cancellable_is_cancelled(source->cancellable)) {
+        GError *error = NULL;
+        gssize n = g_input_stream_read(input, buffer, sizeof(buffer), source->cancellable, &error);
+
+        if (n > 0) {
+            position += n;
+            const char *p = buffer, *end = buffer + n;
+            while (p < end) {
+                const char *newline = memchr(p, '\n', end - p);
+                const char *stop = newline ? newline : end;
+                /* Past the cap the rest of the line is dropped */
+                gsize room = LOG_MAX_LINE_BYTES - line->len;
+                g_string_append_len(line, p, MIN((gsize)(stop - p), room));
+                if (!newline) break;
+                emit_line(source, line, &skip_partial);
+                p = newline + 1;
+            }
+            continue;
+        }
+
+        if (n < 0) {
+            if (!g_error_matches(error, G_IO_ERROR, G_IO_ERROR_CANCELLED)) {
+                g_warning("LogView: reading '%s' failed: %s", source->path, error->message);
+            }
+            g_error_free(error);
+            break;
+        }
+
+        /* End of stream: pipes and sockets reopen, files are followed and
+         * keep a partial last line until its newline arrives */
+        if (!regular) {
+            if (line->len > 0) emit_line(source, line, &skip_partial);
+            break;
+        }
+
+        GStatBuf st;
+        if (g_stat(source->path, &st) == 0 && st.st_size < position) {
+            intact = FALSE;
+            break;
+        }
+        if (!wait_interval(source, LOG_POLL_INTERVAL_MS)) break;
+    }
+
+    g_string_free(line, TRUE);
+    return intact;
+}
+
+static gpointer reader_thread(gpointer user_data) {
+    LogSource *source = (LogSource *)user_data;
+    gboolean warned = FALSE;
+
+    while (!g_cancellable_is_cancelled(source->cancellable)) {
+        GError *error = NULL;
+        GIOStream *connection = NULL;
+        GInputStream *input = NULL;
+        gboolean skip_partial = FALSE;
+
+        if (source->is_socket) {
+            connection = open_socket(source, &error);
+            if (connection) input = g_object_ref(g_io_stream_get_input_stream(connection));
+        } else {
+            /* A FIFO without a writer reads as end of stream and is reopened */
+            input = open_file(source, &skip_partial, &error);
+        }
+
+        if (!input) {
+            if (!warned && !g_error_matches(error, G_IO_ERROR, G_IO_ERROR_CANCELLED)) {
+                g_warning("LogView: cannot open '%s': %s", source->path, error->message);
+                warned = TRUE;
+            }
+            g_clear_error(&error);
+            wait_interval(source, LOG_RECONNECT_INTERVAL_MS);
+            continue;
+        }
+        warned = FALSE;
+
+        gboolean truncated = !read_lines(source, input, skip_partial);
+        g_object_unref(input);
+        if (connection) g_object_unref(connection);
+
+        /* A truncated (rotated) file is read again from its start */
+        if (truncated) {
+            source->from_start = TRUE;
+        } else {
+            wait_interval(source, source->is_socket ? LOG_RECONNECT_INTERVAL_MS
+                                                    : LOG_POLL_INTERVAL_MS);
+        }
+    }
+
+    log_source_unref(source);
+    return NULL;
+}
+
+/* ── Ring buffer and filter ──────────────────────────────── */
+
+static LogLine* line_at(LogView *view, guint64 seq) {
+    return &view->lines[seq % view->capacity];
+}
+
+static guint entry_count(LogView *view) {
+    return view->filter ? view->matches->len - view->match_start : view->n_lines;
+}
+
+static guint64 entry_seq(LogView *view, guint index) {
+    return view->filter ? g_array_index(view->matches, guint64, view->match_start + index)
+                        : view->first_seq + index;
+}
+
+static void evict_oldest(LogView *view) {
+    LogLine *line = line_at(view, view->first_seq);
+    g_clear_pointer(&line->text, g_free);
+    g_clear_object(&line->layout);
+    view->first_seq++;
+    view->n_lines--;
+}
+
+/* Takes ownership of text; TRUE when the line is shown (matches the filter) */
+static gboolean push_line(LogView *view, char *text) {
+    if (view->n_lines == view->capacity) evict_oldest(view);
+
+    guint64 seq = view->first_seq + view->n_lines;
+    LogLine *line = line_at(view, seq);
+    line->text = text;
+    line->layout = NULL;
+    line->frame = 0;
+    view->n_lines++;
+
+    if (!view->filter) return TRUE;
+    if (!strstr(text, view->filter)) return FALSE;
+    g_array_append_val(view->matches, seq);
+    return TRUE;
+}
+
+/* Drops matches of evicted lines */
+static void trim_matches(LogView *view) {
+    while (view->match_start < view->matches->len &&
+           g_array_index(view->matches, guint64, view->match_start) < view->first_seq) {
+        view->match_start++;
+    }
+    if (view->match_start > 0 && view->match_start * 2 >= view->matches->len) {
+        g_array_remove_range(view->matches, 0, view->match_start);
+        view->match_start = 0;
+    }
+}
+
+/* Keeps a scrolled-back view on the same lines while new ones arrive */
+static void after_append(LogView *view, guint added) {
+    trim_matches(view);
+
+    if (view->scroll_offset > 0) {
+        view->scroll_offset = MIN(view->scroll_offset + added, entry_count(view));
+    }
+    power_policy_queue_draw(GTK_WIDGET(view));
+}
+
+static void append_lines(LogView *view, GPtrArray *lines) {
+    char **texts = (char **)lines->pdata;
+    guint added = 0;
+    if (lines->len == 0) return;
+
+    /* Lines the ring would evict within this batch are never stored */
+    guint first = lines->len > view->capacity ? lines->len - view->capacity : 0;
+    for (guint i = first; i < lines->len; i++) {
+        added += push_line(view, texts[i]);
+        texts[i] = NULL;
+    }
+    after_append(view, added);
+}
+
+static void rebuild_matches(LogView *view) {
+    g_array_set_size(view->matches, 0);
+    view->match_start = 0;
+    if (!view->filter) return;
+
+    for (guint i = 0; i < view->n_lines; i++) {
+        guint64 seq = view->first_seq + i;
+        if (strstr(line_at(view, seq)->text, view->filter)) {
+            g_array_append_val(view->matches, seq);
+        }
+    }
+}
+
+/* ── Rendering ───────────────────────────────────────────── */
+
+static LogLevel line_level(const char *text) {
+    if (strstr(text, "ERROR") || strstr(text, "ALARM")) return LOG_LEVEL_ERROR;
+    if (strstr(text, "WARN")) return LOG_LEVEL_WARN;
+    return LOG_LEVEL_INFO;
+}
+
+static void ensure_line_height(LogView *view) {
+    if (view->line_height > 0) return;
+
+    PangoLayout *layout = gtk_widget_create_pango_layout(GTK_WIDGET(view), "Ag");
+    pango_layout_set_font_description(layout, view->font);
+    pango_layout_get_pixel_size(layout, NULL, &view->line_height);
+    view->line_height = MAX(view->line_height, 1);
+    g_object_unref(layout);
+}
+
+static void log_view_snapshot(GtkWidget *widget, GtkSnapshot *snapshot) {
+    LogView *view = LOG_VIEW(widget);
+    int height = gtk_widget_get_height(widget);
+    if (height <= 0) return;
+
+    ensure_line_height(view);
+    view->frame++;
+
+    guint entries = entry_count(view);
+    guint visible = (guint)ceil((double)height / view->line_height);
+    guint end = entries - MIN(view->scroll_offset, entries);
+    guint begin = end > visible ? end - visible : 0;
+
+    /* Newest line at the bottom once the view is full */
+    float y = end - begin < visible ? 0.0f : (float)(height - (int)(end - begin) * view->line_height);
+
+    GArray *laid_out = g_array_sized_new(FALSE, FALSE, sizeof(guint64), end - begin);
+    for (guint i = begin; i < end; i++) {
+        guint64 seq = entry_seq(view, i);
+        LogLine *line = line_at(view, seq);
+
+        if (!line->layout) {
+            line->layout = gtk_widget_create_pango_layout(widget, line->text);
+            pango_layout_set_font_description(line->layout, view->font);
+            line->level = line_level(line->text);
+        }
+        line->frame = view->frame;
+        g_array_append_val(laid_out, seq);
+
+        gtk_snapshot_save(snapshot);
+        gtk_snapshot_translate(snapshot, &GRAPHENE_POINT_INIT(0, y));
+        gtk_snapshot_append_layout(snapshot, line->layout, &view->colors[line->level]);
+        gtk_snapshot_restore(snapshot);
+        y += view->line_height;
+    }
+
+    /* Lines that scrolled away give their layouts back */
+    for (guint i = 0; i < view->laid_out->len; i++) {
+        guint64 seq = g_array_index(view->laid_out, guint64, i);
+        if (seq < view->first_seq) continue;
+        LogLine *line = line_at(view, seq);
+        if (line->frame != view->frame) g_clear_object(&line->layout);
+    }
+    g_array_unref(view->laid_out);
+    view->laid_out = laid_out;
+}
+
+static gboolean on_scroll(GtkEventControllerScroll *controller, double dx, double dy,
+                          gpointer user_data) {
+    LogView *view = LOG_VIEW(user_data);
+    int height = gtk_widget_get_height(GTK_WIDGET(view));
+    guint visible = view->line_height > 0 ? (guint)(height / view->line_height) : 0;
+    guint entries = entry_count(view);
+    guint max_offset = entries > visible ? entries - visible : 0;
+
+    int offset = (int)view->scroll_offset - (int)lround(dy * LOG_SCROLL_LINES);
+    view->scroll_offset = (guint)CLAMP(offset, 0, (int)max_offset);
+    gtk_widget_queue_draw(GTK_WIDGET(view));
+    return TRUE;
+}
+
+/* ── Widget ──────────────────────────────────────────────── */
+
+static void log_view_dispose(GObject *object) {
+    LogView *view = LOG_VIEW(object);
+
+    if (view->power_watch) {
+        power_policy_unwatch(view->power_watch);
+        view->power_watch = 0;
+    }
+    if (view->source) {
+        view->source->view = NULL;
+        log_source_cancel(view->source);
+        log_source_unref(view->source);
+        view->source = NULL;
+    }
+
+    G_OBJECT_CLASS(log_view_parent_class)->dispose(object);
+}
+
+static void log_view_finalize(GObject *object) {
+    LogView *view = LOG_VIEW(object);
+
+    while (view->n_lines > 0) evict_oldest(view);
+    g_free(view->lines);
+    g_free(view->filter);
+    g_array_unref(view->matches);
+    g_array_unref(view->laid_out);
+    pango_font_description_free(view->font);
+
+    G_OBJECT_CLASS(log_view_parent_class)->finalize(object);
+}
+
+static void log_view_class_init(LogViewClass *klass) {
+    GObjectClass *object_class = G_OBJECT_CLASS(klass);
+    GtkWidgetClass *widget_class = GTK_WIDGET_CLASS(klass);
+
+    object_class->dispose = log_view_dispose;
+    object_class->finalize = log_view_finalize;
+    widget_class->snapshot = log_view_snapshot;
+    gtk_widget_class_set_css_name(widget_class, "logview");
+}
+
+static void log_view_init(LogView *view) {
+    view->matches = g_array_new(FALSE, FALSE, sizeof(guint64));
+    view->laid_out = g_array_new(FALSE, FALSE, sizeof(guint64));
+    gtk_widget_set_overflow(GTK_WIDGET(view), GTK_OVERFLOW_HIDDEN);
+
+    GtkEventController *scroll = gtk_event_controller_scroll_new(
+        GTK_EVENT_CONTROLLER_SCROLL_VERTICAL | GTK_EVENT_CONTROLLER_SCROLL_DISCRETE);
+    g_signal_connect(scroll, "scroll", G_CALLBACK(on_scroll), view);
+    gtk_widget_add_controller(GTK_WIDGET(view), scroll);
+}
+
+/* ── Public API ──────────────────────────────────────────── */
+
+static double get_double_prop(JsonObject *props, const char *key, double default_val) {
+    if (!props || !json_object_has_member(props, key)) return default_val;
+    JsonNode *node = json_object_get_member(props, key);
+    if (!JSON_NODE_HOLDS_VALUE(node)) return default_val;
+    return json_node_get_double(node);
+}
+
+static const char* get_string_prop(JsonObject *props, const char *key, const char *default_val) {
+    if (!props || !json_object_has_member(props, key)) return default_val;
+    JsonNode *node = json_object_get_member(props, key);
+    if (!JSON_NODE_HOLDS_VALUE(node)) return default_val;
+    const char *val = json_node_get_string(node);
+    return val ? val : default_val;
+}
+
+static void get_color_prop(JsonObject *props, const char *key, const char *default_val,
+                           GdkRGBA *color) {
+    if (!gdk_rgba_parse(color, get_string_prop(props, key, default_val))) {
+        gdk_rgba_parse(color, default_val);
+    }
+}
+
+static void on_power_changed(gpointer user_data) {
+    LogView *view = LOG_VIEW(user_data);
+    log_source_set_paused(view->source, power_policy_get_state() == POWER_STATE_PAUSED);
+}
+
+static void start_source(LogView *view, const char *path, gboolean is_socket,
+                         gboolean from_start) {
+    LogSource *source = g_new0(LogSource, 1);
+    source->ref_count = 1;
+    g_mutex_init(&source->lock);
+    g_cond_init(&source->wake);
+    source->pending = g_ptr_array_new_with_free_func(g_free);
+    source->max_pending = view->capacity;
+    source->cancellable = g_cancellable_new();
+    source->path = g_strdup(path);
+    source->is_socket = is_socket;
+    source->from_start = from_start;
+    source->paused = power_policy_get_state() == POWER_STATE_PAUSED;
+    source->view = view;
+    view->source = source;
+    view->power_watch = power_policy_watch(on_power_changed, view);
+
+    /* Detached: a thread blocked opening a FIFO exits once it wakes up */
+    g_thread_unref(g_thread_new("logview-reader", reader_thread, log_source_ref(source)));
+}
+
+GtkWidget* log_view_new(const WidgetConfig *config) {
+    LogView *view = g_object_new(LOG_TYPE_VIEW, NULL);
+    JsonObject *props = config->props;
+
+    view->capacity = (guint)CLAMP(get_double_prop(props, "max_lines", LOG_DEFAULT_LINES),
+                                  1, LOG_MAX_LINES);
+    view->lines = g_new0(LogLine, view->capacity);
+    view->font = pango_font_description_from_string(get_string_prop(props, "font", "Monospace 10"));
+    get_color_prop(props, "color", "#D8DEE9", &view->colors[LOG_LEVEL_INFO]);
+    get_color_prop(props, "warn_color", "#EBCB8B", &view->colors[LOG_LEVEL_WARN]);
+    get_color_prop(props, "error_color", "#BF616A", &view->colors[LOG_LEVEL_ERROR]);
+    log_view_set_filter(view, get_string_prop(props, "filter", NULL));
+
+    gboolean from_start = props && json_object_get_boolean_member_with_default(props,
+                                                                               "from_start", FALSE);
+    const char *socket_path = get_string_prop(props, "socket", NULL);
+    const char *path = get_string_prop(props, "path", NULL);
+    if (socket_path) {
+        start_source(view, socket_path, TRUE, from_start);
+    } else if (path) {
+        start_source(view, path, FALSE, from_start);
+    }
+
+    return GTK_WIDGET(view);
+}
+
+void log_view_append(LogView *view, const char *line) {
+    g_return_if_fail(LOG_IS_VIEW(view));
+    g_return_if_fail(line != NULL);
+
+    gboolean added = push_line(view, g_utf8_make_valid(line, MIN(strlen(line), LOG_MAX_LINE_BYTES)));
+    after_append(view, added);
+}
+
+void log_view_set_filter(LogView *view, const char *filter) {
+    g_return_if_fail(LOG_IS_VIEW(view));
+
+    g_free(view->filter);
+    view->filter = filter && *filter ? g_strdup(filter) : NULL;
+    rebuild_matches(view);
+    view->scroll_offset = 0;
+    gtk_widget_queue_draw(GTK_WIDGET(view));
+}
+
+const char* log_view_get_filter(LogView *view) {
+    g_return_val_if_fail(LOG_IS_VIEW(view), NULL);
+    return view->filter;
+}
@@ -0,0 +1,32 @@
+#ifndef LOG_VIEW_H
+#define LOG_VIEW_H
+
+#include <gtk/gtk.h>
+#include "json_parser.h"
+
+/*
+ * "LogView" widget: an event/alarm log panel.
+ *
+ * Lines come from a followed file, a FIFO or a Unix socket, read by a
+ * worker thread and handed to the main loop in batches a few times per
+ * frame. They are kept in a bounded ring buffer; only the visible lines
+ * get a PangoLayout, which is cached until the line scrolls away, so an
+ * append never lays out existing content. A substring filter is matched
+ * once per line and kept up to date incrementally.
+ */
+
+#define LOG_TYPE_VIEW (log_view_get_type())
+G_DECLARE_FINAL_TYPE(LogView, log_view, LOG, VIEW, GtkWidget)
+
+/* props: path, socket, max_lines, from_start, filter, font, color,
+ * warn_color, error_color */
+GtkWidget* log_view_new(const WidgetConfig *config);
+
+/* Takes a copy of line */
+void log_view_append(LogView *view, const char *line);
+
+/* Only lines containing filter are shown; NULL or "" shows every line */
+void log_view_set_filter(LogView *view, const char *filter);
+const char* log_view_get_filter(LogView *view);
+
+#endif /* LOG_VIEW_H */
@@ -0,0 +1,383 @@
+#include "mem_report.h"
+#include "shape_renderer.h"
+#include "style_manager.h"
+#include "resource_cache.h"
+#include "profiler.h"
+#include <json-glib/json-glib.h>
+#include <string.h>
+
+/* Approximate json-glib allocations on a 64-bit system */
+#define JSON_NODE_BYTES 48
+#define JSON_VALUE_BYTES 40
+#define JSON_OBJECT_BYTES 96     /* Struct + member hash table + order list */
+#define JSON_MEMBER_BYTES 56     /* Hash entry + list link */
+#define JSON_ARRAY_BYTES 48
+#define MAX_DUPLICATES 10
+
+typedef struct {
+    guint count;             /* Configs */
+    guint built;             /* GTK widgets currently built */
+    gsize config_bytes;
+    gsize shape_data_bytes;
+    gsize widget_bytes;
+    gsize css_bytes;
+    gsize texture_bytes;
+} TypeUsage;
+
+typedef struct {
+    const char *kind;        /* "props" / "style" */
+    const char *type;
+    const char *example_id;
+    guint count;
+    gsize bytes;
+} DuplicateGroup;
+
+typedef struct {
+    GHashTable *types;       /* type name -> TypeUsage* */
+    GHashTable *contents;    /* serialized object -> DuplicateGroup* */
+    GHashTable *seen;        /* JsonObject* already counted (shared refs) */
+    GHashTable *textures;    /* GdkTexture* already attributed */
+    StyleManager *scratch;   /* Renders single CSS rules for sizing */
+} MemReport;
+
+/* ── Estimates ───────────────────────────────────────────── */
+
+static gsize string_bytes(const char *str) {
+    return str ? strlen(str) + 1 : 0;
+}
+
+static gsize json_node_bytes(JsonNode *node);
+
+static gsize json_object_bytes(JsonObject *object) {
+    gsize bytes = JSON_OBJECT_BYTES;
+
+    GList *members = json_object_get_members(object);
+    for (GList *l = members; l != NULL; l = l->next) {
+        const char *key = (const char *)l->data;
+        bytes += JSON_MEMBER_BYTES + string_bytes(key);
+        bytes += json_node_bytes(json_object_get_member(object, key));
+    }
+    g_list_free(members);
+    return bytes;
+}
+
+static gsize json_node_bytes(JsonNode *node) {
+    gsize bytes = JSON_NODE_BYTES;
+
+    switch (json_node_get_node_type(node)) {
+    case JSON_NODE_OBJECT:
+        bytes += json_object_bytes(json_node_get_object(node));
+        break;
+    case JSON_NODE_ARRAY: {
+        JsonArray *array = json_node_get_array(node);
+        bytes += JSON_ARRAY_BYTES;
+        for (guint i = 0; i < json_array_get_length(array); i++) {
+            bytes += sizeof(gpointer) + json_node_bytes(json_array_get_element(array, i));
+        }
+        break;
+    }
+    case JSON_NODE_VALUE:
+        bytes += JSON_VALUE_BYTES;
+        if (json_node_get_value_type(node) == G_TYPE_STRING) {
+            bytes += string_bytes(json_node_get_string(node));
+        }
+        break;
+    default:
+        break;
+    }
+    return bytes;
+}
+
+/* Public instance structs of a widget and its internal children */
+static gsize widget_tree_bytes(GtkWidget *widget) {
+    GTypeQuery query;
+    g_type_query(G_OBJECT_TYPE(widget), &query);
+
+    gsize bytes = query.instance_size;
+    for (GtkWidget *child = gtk_widget_get_first_child(widget); child;
+         child = gtk_widget_get_next_sibling(child)) {
+        bytes += widget_tree_bytes(child);
+    }
+    return bytes;
+}
+
+static TypeUsage* type_usage(MemReport *report, const char *type) {
+    const char *key = type ? type : "(none)";
+    TypeUsage *usage = g_hash_table_lookup(report->types, key);
+    if (!usage) {
+        usage = g_new0(TypeUsage, 1);
+        g_hash_table_insert(report->types, g_strdup(key), usage);
+    }
+    return usage;
+}
+
+/* ── Configs ─────────────────────────────────────────────── */
+
+/* Bytes of a retained JSON object; shared references count once, and
+ * separate objects with identical content are recorded as duplicates */
+static gsize account_object(MemReport *report, JsonObject *object, const char *kind,
+                            const WidgetConfig *config) {
+    if (!object || !g_hash_table_add(report->seen, object)) return 0;
+
+    gsize bytes = json_object_bytes(object);
+
+    JsonNode *node = json_node_new(JSON_NODE_OBJECT);
+    json_node_set_object(node, object);
+    char *json = json_to_string(node, FALSE);
+    char *content = g_strconcat(kind, ":", config->type ? config->type : "", ":", json, NULL);
+    g_free(json);
+    json_node_unref(node);
+
+    DuplicateGroup *group = g_hash_table_lookup(report->contents, content);
+    if (group) {
+        group->count++;
+        g_free(content);
+    } else {
+        group = g_new0(DuplicateGroup, 1);
+        group->kind = kind;
+        group->type = config->type;
+        group->example_id = config->id;
+        group->count = 1;
+        group->bytes = bytes;
+        g_hash_table_insert(report->contents, content, group);
+    }
+    return bytes;
+}
+
+static void account_config(MemReport *report, const WidgetConfig *config) {
+    TypeUsage *usage = type_usage(report, config->type);
+    usage->count++;
+    gboolean new_style = config->style && !g_hash_table_contains(report->seen, config->style);
+
+    usage->config_bytes += sizeof(WidgetConfig) + sizeof(GList)
+        + string_bytes(config->id) + string_bytes(config->type)
+        + string_bytes(config->style_class)
+        + account_object(report, config->style, "style", config)
+        + account_object(report, config->props, "props", config)
+        + account_object(report, config->events, "events", config)
+        + g_list_length(config->animations) * (sizeof(AnimationConfig) + sizeof(GList));
+
+    /* CSS rule collected for widgets (shapes draw with Cairo); a shared
+     * class rule is counted once */
+    if (!is_shape_type(config->type) && config->style && config->style_class) {
+        if (new_style) {
+            g_string_truncate(report->scratch->css_buffer, 0);
+            style_manager_add_class_style(report->scratch, config->style_class, config->style);
+            usage->css_bytes += report->scratch->css_buffer->len;
+        }
+    } else if (!is_shape_type(config->type) && config->style && config->id) {
+        g_string_truncate(report->scratch->css_buffer, 0);
+        style_manager_add_widget_style(report->scratch, config->id, config->style);
+        usage->css_bytes += report->scratch->css_buffer->len;
+    }
+
+    /* Decoded image, attributed to the first Image that shows it */
+    if (config->type && strcmp(config->type, "Image") == 0 && config->props &&
+        json_object_has_member(config->props, "file_path")) {
+        GdkTexture *texture = resource_cache_peek_texture(
+            json_object_get_string_member(config->props, "file_path"));
+        if (texture && g_hash_table_add(report->textures, texture)) {
+            usage->texture_bytes += (gsize)gdk_texture_get_width(texture)
+                                  * gdk_texture_get_height(texture) * 4;
+        }
+    }
+}
+
+static void account_widgets(MemReport *report, GList *widgets) {
+    for (GList *l = widgets; l != NULL; l = l->next) {
+        account_config(report, (WidgetConfig *)l->data);
+    }
+}
+
+static void account_layout(MemReport *report, LayoutConfig *layout) {
+    if (!layout) return;
+
+    account_widgets(report, layout->widgets);
+    for (GList *l = layout->scenes; l != NULL; l = l->next) {
+        account_widgets(report, ((SceneConfig *)l->data)->widgets);
+    }
+}
+
+static void account_cached_layout(gpointer key, gpointer value, gpointer user_data) {
+    account_layout((MemReport *)user_data, (LayoutConfig *)value);
+}
+
+/* ── Built widgets ───────────────────────────────────────── */
+
+static void account_widget_tree(MemReport *report, GtkWidget *widget) {
+    const WidgetConfig *config = g_object_get_data(G_OBJECT(widget), "widget-config");
+    if (config) {
+        TypeUsage *usage = type_usage(report, config->type);
+        usage->built++;
+        usage->widget_bytes += widget_tree_bytes(widget);
+        usage->shape_data_bytes += shape_renderer_data_size(config);
+        return;
+    }
+
+    for (GtkWidget *child = gtk_widget_get_first_child(widget); child;
+         child = gtk_widget_get_next_sibling(child)) {
+        account_widget_tree(report, child);
+    }
+}
+
+/* Hidden GtkStack pages stay in the widget tree, so this also covers
+ * every built scene */
+static void account_windows(MemReport *report, DashboardApp *app) {
+    for (guint i = 0; i < app->windows->len; i++) {
+        DashboardWindow *win = g_ptr_array_index(app->windows, i);
+        if (win->container) account_widget_tree(report, win->container);
+    }
+}
+
+/* ── Output ──────────────────────────────────────────────── */
+
+static gsize usage_total(const TypeUsage *usage) {
+    return usage->config_bytes + usage->shape_data_bytes + usage->widget_bytes
+         + usage->css_bytes + usage->texture_bytes;
+}
+
+static int compare_type_names(gconstpointer a, gconstpointer b) {
+    return g_strcmp0(*(const char * const *)a, *(const char * const *)b);
+}
+
+static int compare_wasted(gconstpointer a, gconstpointer b) {
+    const DuplicateGroup *x = *(DuplicateGroup * const *)a;
+    const DuplicateGroup *y = *(DuplicateGroup * const *)b;
+    gsize wx = (x->count - 1) * x->bytes;
+    gsize wy = (y->count - 1) * y->bytes;
+    return (wy > wx) - (wy < wx);
+}
+
+static void add_types(JsonBuilder *b, MemReport *report, gsize *total) {
+    GPtrArray *names = g_hash_table_get_keys_as_ptr_array(report->types);
+    g_ptr_array_sort(names, compare_type_names);
+
+    json_builder_set_member_name(b, "types");
+    json_builder_begin_object(b);
+    for (guint i = 0; i < names->len; i++) {
+        const char *name = g_ptr_array_index(names, i);
+        TypeUsage *usage = g_hash_table_lookup(report->types, name);
+        gsize type_total = usage_total(usage);
+        *total += type_total;
+
+        json_builder_set_member_name(b, name);
+        json_builder_begin_object(b);
+        json_builder_set_member_name(b, "count");
+        json_builder_add_int_value(b, usage->count);
+        json_builder_set_member_name(b, "built");
+        json_builder_add_int_value(b, usage->built);
+        json_builder_set_member_name(b, "config_bytes");
+        json_builder_add_int_value(b, usage->config_bytes);
+        json_builder_set_member_name(b, "shape_data_bytes");
+        json_builder_add_int_value(b, usage->shape_data_bytes);
+        json_builder_set_member_name(b, "widget_bytes");
+        json_builder_add_int_value(b, usage->widget_bytes);
+        json_builder_set_member_name(b, "css_bytes");
+        json_builder_add_int_value(b, usage->css_bytes);
+        json_builder_set_member_name(b, "texture_bytes");
+        json_builder_add_int_value(b, usage->texture_bytes);
+        json_builder_set_member_name(b, "total_bytes");
+        json_builder_add_int_value(b, type_total);
+        json_builder_end_object(b);
+    }
+    json_builder_end_object(b);
+    g_ptr_array_free(names, TRUE);
+}
+
+static void add_duplicates(JsonBuilder *b, MemReport *report) {
+    GPtrArray *groups = g_ptr_array_new();
+    GHashTableIter iter;
+    gpointer value;
+
+    g_hash_table_iter_init(&iter, report->contents);
+    while (g_hash_table_iter_next(&iter, NULL, &value)) {
+        DuplicateGroup *group = (DuplicateGroup *)value;
+        if (group->count > 1) g_ptr_array_add(groups, group);
+    }
+    g_ptr_array_sort(groups, compare_wasted);
+
+    json_builder_set_member_name(b, "duplicates");
+    json_builder_begin_array(b);
+    for (guint i = 0; i < MIN(groups->len, MAX_DUPLICATES); i++) {
+        DuplicateGroup *group = g_ptr_array_index(groups, i);
+        json_builder_begin_object(b);
+        json_builder_set_member_name(b, "kind");
+        json_builder_add_string_value(b, group->kind);
+        json_builder_set_member_name(b, "type");
+        json_builder_add_string_value(b, group->type);
+        json_builder_set_member_name(b, "example_id");
+        json_builder_add_string_value(b, group->example_id);
+        json_builder_set_member_name(b, "copies");
+        json_builder_add_int_value(b, group->count);
+        json_builder_set_member_name(b, "bytes_each");
+        json_builder_add_int_value(b, group->bytes);
+        json_builder_set_member_name(b, "wasted_bytes");
+        json_builder_add_int_value(b, (group->count - 1) * group->bytes);
+        json_builder_end_object(b);
+    }
+    json_builder_end_array(b);
+    g_ptr_array_free(groups, TRUE);
+}
+
+static void add_caches(JsonBuilder *b) {
+    ResourceCacheStats stats;
+    resource_cache_get_stats(&stats);
+
+    json_builder_set_member_name(b, "caches");
+    json_builder_begin_object(b);
+    json_builder_set_member_name(b, "layouts");
+    json_builder_add_int_value(b, stats.layouts);
+    json_builder_set_member_name(b, "textures");
+    json_builder_add_int_value(b, stats.textures);
+    json_builder_set_member_name(b, "texture_bytes");
+    json_builder_add_int_value(b, stats.texture_bytes);
+    json_builder_set_member_name(b, "style_sets");
+    json_builder_add_int_value(b, stats.style_sets);
+    json_builder_set_member_name(b, "css_bytes");
+    json_builder_add_int_value(b, stats.css_bytes);
+    json_builder_end_object(b);
+}
+
+char* mem_report_build(DashboardApp *app) {
+    MemReport report = {
+        .types = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, g_free),
+        .contents = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, g_free),
+        .seen = g_hash_table_new(g_direct_hash, g_direct_equal),
+        .textures = g_hash_table_new(g_direct_hash, g_direct_equal),
+        .scratch = style_manager_new(),
+    };
+
+    account_layout(&report, app->layout);
+    resource_cache_foreach_layout(account_cached_layout, &report);
+    account_windows(&report, app);
+
+    JsonBuilder *b = json_builder_new();
+    json_builder_begin_object(b);
+
+    gsize total = 0;
+    add_types(b, &report, &total);
+    json_builder_set_member_name(b, "attributed_bytes");
+    json_builder_add_int_value(b, total);
+    json_builder_set_member_name(b, "heap_bytes");
+    json_builder_add_int_value(b, profiler_heap_in_use());
+    add_caches(b);
+    add_duplicates(b, &report);
+
+    json_builder_end_object(b);
+
+    JsonGenerator *gen = json_generator_new();
+    json_generator_set_pretty(gen, TRUE);
+    JsonNode *root = json_builder_get_root(b);
+    json_generator_set_root(gen, root);
+    char *data = json_generator_to_data(gen, NULL);
+
+    json_node_unref(root);
+    g_object_unref(gen);
+    g_object_unref(b);
+    style_manager_free(report.scratch);
+    g_hash_table_destroy(report.textures);
+    g_hash_table_destroy(report.seen);
+    g_hash_table_destroy(report.contents);
+    g_hash_table_destroy(report.types);
+    return data;
+}
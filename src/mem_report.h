@@ -0,0 +1,22 @@
+#ifndef MEM_REPORT_H
+#define MEM_REPORT_H
+
+#include "app.h"
+
+/*
+ * Memory accounting report (--mem-report and the F12 dialog).
+ *
+ * Attributes estimated memory to every widget and shape, grouped by type:
+ * the parsed WidgetConfig with its retained JSON objects, the shape draw
+ * data, the GTK widget instances, CSS rules and decoded textures, plus
+ * the shared resource caches. JSON objects with identical content retained
+ * as separate copies are listed as duplicates.
+ *
+ * Sizes are estimates: JSON and CSS sizes model json-glib's and our own
+ * allocations, GTK widgets count their public instance structs only.
+ */
+
+/* JSON report; free with g_free() */
+char* mem_report_build(DashboardApp *app);
+
+#endif /* MEM_REPORT_H */
@@ -0,0 +1,511 @@
+#include "metrics.h"
+#include "data_feed.h"
+#include "frame_stats.h"
+#include "json_parser.h"
+#include "profiler.h"
+#include <glib/gstdio.h>
+#include <string.h>
+
+#define REQUEST_MAX_BYTES 8192             /* Longer requests are dropped */
+#define CLIENT_TIMEOUT_S 5
+
+/* Upper bounds of the frame histogram buckets in µs; +Inf follows */
+static const gint64 frame_bounds[] = {
+    4000, 8000, 16667, 25000, 33333, 50000, 100000, 250000, 500000, 1000000
+};
+#define N_FRAME_BUCKETS (G_N_ELEMENTS(frame_bounds) + 1)
+
+/* Counters are gsize so pointer atomics apply: 64 bits on 64-bit targets */
+typedef struct {
+    gsize buckets[N_FRAME_BUCKETS];  /* Per bucket; cumulated when exposed */
+    gsize sum_us;
+} Histogram;
+
+/* One connection, from its request to the end of the response */
+typedef struct {
+    GSocketConnection *connection;
+    GString *request;
+    char buffer[1024];
+    char *response;
+    gsize response_len;
+} Client;
+
+static const struct {
+    const char *name;
+    const char *help;
+} counter_info[METRICS_N_COUNTERS] = {
+    { "gtk_dashboard_shape_draws_total", "Shape draw callbacks run." },
+    { "gtk_dashboard_redraw_requests_total", "Redraws requested by data." },
+    { "gtk_dashboard_redraws_total", "Redraws queued for data after rate limiting." },
+};
+
+static const char * const cache_names[METRICS_N_CACHES] = {
+    "layout", "texture", "styles", "shadow", "gauge"
+};
+
+static gsize counters[METRICS_N_COUNTERS];
+static gsize cache_hits[METRICS_N_CACHES];
+static gsize cache_misses[METRICS_N_CACHES];
+static Histogram frame_intervals;
+static Histogram frame_paints;
+
+static char *socket_path = NULL;
+static GSocketService *service = NULL;
+static GPtrArray *windows = NULL;         /* GtkWidget*, dashboard windows */
+
+/* ── Counters ────────────────────────────────────────────── */
+
+static inline void counter_add(gsize *counter, gsize value) {
+    g_atomic_pointer_add(counter, value);
+}
+
+static inline gsize counter_get(gsize *counter) {
+    return (gsize)g_atomic_pointer_get(counter);
+}
+
+void metrics_count(MetricsCounter counter) {
+    counter_add(&counters[counter], 1);
+}
+
+void metrics_cache_lookup(MetricsCache cache, gboolean hit) {
+    counter_add(hit ? &cache_hits[cache] : &cache_misses[cache], 1);
+}
+
+static void histogram_observe(Histogram *histogram, gint64 value_us) {
+    guint i = 0;
+    while (i < G_N_ELEMENTS(frame_bounds) && value_us > frame_bounds[i]) i++;
+    counter_add(&histogram->buckets[i], 1);
+    counter_add(&histogram->sum_us, (gsize)value_us);
+}
+
+/* ── Exposition ──────────────────────────────────────────── */
+
+static void append_header(GString *out, const char *name, const char *type, const char *help) {
+    g_string_append_printf(out, "# HELP %s %s\n# TYPE %s %s\n", name, help, name, type);
+}
+
+static void append_double(GString *out, double value) {
+    char buffer[G_ASCII_DTOSTR_BUF_SIZE];
+    g_string_append(out, g_ascii_dtostr(buffer, sizeof(buffer), value));
+}
+
+/* name{label="value"} with the value escaped as the format requires */
+static void append_labeled(GString *out, const char *name, const char *label, const char *value) {
+    g_string_append_printf(out, "%s{%s=\"", name, label);
+    for (const char *c = value; *c; c++) {
+        if (*c == '\\' || *c == '"') {
+            g_string_append_c(out, '\\');
+            g_string_append_c(out, *c);
+        } else if (*c == '\n') {
+            g_string_append(out, "\\n");
+        } else {
+            g_string_append_c(out, *c);
+        }
+    }
+    g_string_append(out, "\"} ");
+}
+
+static void append_histogram(GString *out, const char *name, const char *help,
+                             Histogram *histogram) {
+    append_header(out, name, "histogram", help);
+
+    /* _count is the +Inf bucket so a concurrent observation cannot make
+     * them disagree */
+    gsize total = 0;
+    for (guint i = 0; i < N_FRAME_BUCKETS; i++) {
+        total += counter_get(&histogram->buckets[i]);
+        g_string_append_printf(out, "%s_bucket{le=\"", name);
+        if (i < G_N_ELEMENTS(frame_bounds)) {
+            append_double(out, frame_bounds[i] / (double)G_USEC_PER_SEC);
+        } else {
+            g_string_append(out, "+Inf");
+        }
+        g_string_append_printf(out, "\"} %" G_GSIZE_FORMAT "\n", total);
+    }
+    g_string_append_printf(out, "%s_sum ", name);
+    append_double(out, counter_get(&histogram->sum_us) / (double)G_USEC_PER_SEC);
+    g_string_append_printf(out, "\n%s_count %" G_GSIZE_FORMAT "\n", name, total);
+}
+
+static void append_caches(GString *out) {
+    static const struct {
+        const char *name;
+        const char *help;
+        gsize *values;
+    } series[] = {
+        { "gtk_dashboard_cache_hits_total", "Lookups answered by a cache.", cache_hits },
+        { "gtk_dashboard_cache_misses_total", "Lookups that had to load or render.", cache_misses },
+    };
+
+    for (guint s = 0; s < G_N_ELEMENTS(series); s++) {
+        append_header(out, series[s].name, "counter", series[s].help);
+        for (guint i = 0; i < METRICS_N_CACHES; i++) {
+            append_labeled(out, series[s].name, "cache", cache_names[i]);
+            g_string_append_printf(out, "%" G_GSIZE_FORMAT "\n", counter_get(&series[s].values[i]));
+        }
+    }
+}
+
+typedef struct {
+    GString *out;
+    gint64 now;
+    gboolean ages;           /* Second pass: sample ages */
+} FeedPass;
+
+static void append_channel(const char *channel, guint64 samples, gint64 last_sample_us,
+                           gpointer user_data) {
+    FeedPass *pass = (FeedPass *)user_data;
+    if (!pass->ages) {
+        append_labeled(pass->out, "gtk_dashboard_feed_channel_samples_total", "channel", channel);
+        g_string_append_printf(pass->out, "%" G_GUINT64_FORMAT "\n", samples);
+    } else if (last_sample_us > 0) {
+        append_labeled(pass->out, "gtk_dashboard_feed_sample_age_seconds", "channel", channel);
+        append_double(pass->out, (pass->now - last_sample_us) / (double)G_USEC_PER_SEC);
+        g_string_append_c(pass->out, '\n');
+    }
+}
+
+static void append_feeds(GString *out) {
+    append_header(out, "gtk_dashboard_feed_samples_total", "counter",
+                  "Feed samples published, subscribed channel or not.");
+    g_string_append_printf(out, "gtk_dashboard_feed_samples_total %" G_GUINT64_FORMAT "\n",
+                           data_feed_get_sample_count());
+
+    FeedPass pass = { out, g_get_monotonic_time(), FALSE };
+    append_header(out, "gtk_dashboard_feed_channel_samples_total", "counter",
+                  "Samples of a subscribed channel.");
+    data_feed_foreach_channel(append_channel, &pass);
+
+    pass.ages = TRUE;
+    append_header(out, "gtk_dashboard_feed_sample_age_seconds", "gauge",
+                  "Time since the last sample of a subscribed channel.");
+    data_feed_foreach_channel(append_channel, &pass);
+}
+
+static void count_widgets(GtkWidget *widget, GHashTable *types, guint *total) {
+    (*total)++;
+
+    const WidgetConfig *config = g_object_get_data(G_OBJECT(widget), "widget-config");
+    if (config && config->type) {
+        guint n = GPOINTER_TO_UINT(g_hash_table_lookup(types, config->type));
+        g_hash_table_insert(types, (gpointer)config->type, GUINT_TO_POINTER(n + 1));
+    }
+
+    for (GtkWidget *child = gtk_widget_get_first_child(widget); child != NULL;
+         child = gtk_widget_get_next_sibling(child)) {
+        count_widgets(child, types, total);
+    }
+}
+
+static void append_widgets(GString *out) {
+    GHashTable *types = g_hash_table_new(g_str_hash, g_str_equal);
+    guint total = 0;
+    for (guint i = 0; windows && i < windows->len; i++) {
+        count_widgets(g_ptr_array_index(windows, i), types, &total);
+    }
+
+    append_header(out, "gtk_dashboard_widgets", "gauge",
+                  "Layout widgets and shapes shown, by type.");
+    GHashTableIter iter;
+    gpointer key, value;
+    g_hash_table_iter_init(&iter, types);
+    while (g_hash_table_iter_next(&iter, &key, &value)) {
+        append_labeled(out, "gtk_dashboard_widgets", "type", (const char *)key);
+        g_string_append_printf(out, "%u\n", GPOINTER_TO_UINT(value));
+    }
+
+    append_header(out, "gtk_dashboard_gtk_widgets", "gauge",
+                  "GTK widgets in the dashboard windows.");
+    g_string_append_printf(out, "gtk_dashboard_gtk_widgets %u\n", total);
+    g_hash_table_destroy(types);
+}
+
+/* VmRSS of /proc/self/status, 0 if unknown */
+static gint64 resident_bytes(void) {
+    char *status = NULL;
+    gint64 bytes = 0;
+
+    if (g_file_get_contents("/proc/self/status", &status, NULL, NULL)) {
+        const char *rss = strstr(status, "\nVmRSS:");
+        if (rss) bytes = g_ascii_strtoll(rss + strlen("\nVmRSS:"), NULL, 10) * 1024;
+        g_free(status);
+    }
+    return bytes;
+}
+
+static void append_memory(GString *out) {
+    append_header(out, "process_resident_memory_bytes", "gauge", "Resident memory size in bytes.");
+    g_string_append_printf(out, "process_resident_memory_bytes %" G_GINT64_FORMAT "\n",
+                           resident_bytes());
+
+    gint64 heap = profiler_heap_in_use();
+    if (heap > 0) {
+        append_header(out, "gtk_dashboard_heap_bytes", "gauge", "Bytes allocated from the malloc heap.");
+        g_string_append_printf(out, "gtk_dashboard_heap_bytes %" G_GINT64_FORMAT "\n", heap);
+    }
+}
+
+typedef struct {
+    GString *out;
+    GHashTable *seen;
+} PhasePass;
+
+/* Phases repeat on layout swaps; the first run is the startup one */
+static void append_phase(const char *name, gint64 start_us, gint64 duration_us, gpointer user_data) {
+    PhasePass *pass = (PhasePass *)user_data;
+    if (!g_hash_table_add(pass->seen, (gpointer)name)) return;
+
+    append_labeled(pass->out, "gtk_dashboard_startup_phase_seconds", "phase", name);
+    append_double(pass->out, duration_us / (double)G_USEC_PER_SEC);
+    g_string_append_c(pass->out, '\n');
+}
+
+static char* build_exposition(gsize *length) {
+    GString *out = g_string_sized_new(4096);
+
+    append_histogram(out, "gtk_dashboard_frame_interval_seconds",
+                     "Time between painted frames of a window, idle gaps excluded.",
+                     &frame_intervals);
+    append_histogram(out, "gtk_dashboard_frame_paint_seconds",
+                     "Time from frame start to painted.", &frame_paints);
+
+    for (guint i = 0; i < METRICS_N_COUNTERS; i++) {
+        append_header(out, counter_info[i].name, "counter", counter_info[i].help);
+        g_string_append_printf(out, "%s %" G_GSIZE_FORMAT "\n", counter_info[i].name,
+                               counter_get(&counters[i]));
+    }
+
+    append_caches(out);
+    append_feeds(out);
+    append_widgets(out);
+    append_memory(out);
+
+    PhasePass pass = { out, g_hash_table_new(g_str_hash, g_str_equal) };
+    append_header(out, "gtk_dashboard_startup_phase_seconds", "gauge",
+                  "Duration of the first run of a startup phase.");
+    profiler_foreach_phase(append_phase, &pass);
+    g_hash_table_destroy(pass.seen);
+
+    *length = out->len;
+    return g_string_free(out, FALSE);
+}
+
+/* ── Socket ──────────────────────────────────────────────── */
+
+static void client_free(Client *client) {
+    g_object_unref(client->connection);
+    g_string_free(client->request, TRUE);
+    g_free(client->response);
+    g_free(client);
+}
+
+static void on_client_closed(GObject *object, GAsyncResult *result, gpointer user_data) {
+    g_io_stream_close_finish(G_IO_STREAM(object), result, NULL);
+    client_free((Client *)user_data);
+}
+
+static void client_close(Client *client) {
+    g_io_stream_close_async(G_IO_STREAM(client->connection), G_PRIORITY_DEFAULT, NULL,
+                            on_client_closed, client);
+}
+
+static void on_response_written(GObject *object, GAsyncResult *result, gpointer user_data) {
+    /* A client gone before the end of the response is not an error here */
+    g_output_stream_write_all_finish(G_OUTPUT_STREAM(object), result, NULL, NULL);
+    client_close((Client *)user_data);
+}
+
+static gboolean is_http(const GString *request) {
+    return g_str_has_prefix(request->str, "GET ") || g_str_has_prefix(request->str, "HEAD ");
+}
+
+/* HTTP requests end with an empty line, anything else with its first line */
+static gboolean request_complete(const GString *request) {
+    if (!is_http(request)) return strchr(request->str, '\n') != NULL;
+    return strstr(request->str, "\r\n\r\n") || strstr(request->str, "\n\n");
+}
+
+static void respond(Client *client) {
+    gsize length;
+    char *body = build_exposition(&length);
+
+    if (is_http(client->request)) {
+        GString *response = g_string_sized_new(length + 256);
+        g_string_append_printf(response,
+                               "HTTP/1.0 200 OK\r\n"
+                               "Content-Type: text/plain; version=0.0.4; charset=utf-8\r\n"
+                               "Content-Length: %" G_GSIZE_FORMAT "\r\n"
+                               "Connection: close\r\n\r\n", length);
+        if (!g_str_has_prefix(client->request->str, "HEAD ")) {
+            g_string_append_len(response, body, length);
+        }
+        g_free(body);
+        client->response_len = response->len;
+        client->response = g_string_free(response, FALSE);
+    } else {
+        client->response_len = length;
+        client->response = body;
+    }
+
+    GOutputStream *output = g_io_stream_get_output_stream(G_IO_STREAM(client->connection));
+    g_output_stream_write_all_async(output, client->response, client->response_len,
+                                    G_PRIORITY_DEFAULT, NULL, on_response_written, client);
+}
+
+static void read_request(Client *client);
+
+static void on_request_read(GObject *object, GAsyncResult *result, gpointer user_data) {
+    Client *client = (Client *)user_data;
+    gssize n = g_input_stream_read_finish(G_INPUT_STREAM(object), result, NULL);
+
+    /* Errors include the client's timeout */
+    if (n < 0) {
+        client_close(client);
+        return;
+    }
+
+    g_string_append_len(client->request, client->buffer, n);
+    if (n == 0 || request_complete(client->request)) {
+        respond(client);
+    } else if (client->request->len > REQUEST_MAX_BYTES) {
+        client_close(client);
+    } else {
+        read_request(client);
+    }
+}
+
+static void read_request(Client *client) {
+    GInputStream *input = g_io_stream_get_input_stream(G_IO_STREAM(client->connection));
+    g_input_stream_read_async(input, client->buffer, sizeof(client->buffer), G_PRIORITY_DEFAULT,
+                              NULL, on_request_read, client);
+}
+
+static gboolean on_incoming(GSocketService *socket_service, GSocketConnection *connection,
+                            GObject *source_object, gpointer user_data) {
+    Client *client = g_new0(Client, 1);
+    client->connection = g_object_ref(connection);
+    client->request = g_string_new(NULL);
+
+    /* A client that never sends its request is dropped */
+    g_socket_set_timeout(g_socket_connection_get_socket(connection), CLIENT_TIMEOUT_S);
+    read_request(client);
+    return TRUE;
+}
+
+/* Whether something accepts connections at address. Connecting doesn't
+ * block: a listener with a full backlog counts as in use. */
+static gboolean socket_in_use(GSocketAddress *address, GError **error) {
+    GSocket *socket = g_socket_new(G_SOCKET_FAMILY_UNIX, G_SOCKET_TYPE_STREAM,
+                                   G_SOCKET_PROTOCOL_DEFAULT, error);
+    if (!socket) return TRUE;
+    g_socket_set_blocking(socket, FALSE);
+
+    GError *connect_error = NULL;
+    gboolean in_use = g_socket_connect(socket, address, NULL, &connect_error) ||
+                      g_error_matches(connect_error, G_IO_ERROR, G_IO_ERROR_WOULD_BLOCK) ||
+                      g_error_matches(connect_error, G_IO_ERROR, G_IO_ERROR_PENDING);
+    if (!in_use && !g_error_matches(connect_error, G_IO_ERROR, G_IO_ERROR_CONNECTION_REFUSED) &&
+        !g_error_matches(connect_error, G_IO_ERROR, G_IO_ERROR_NOT_FOUND)) {
+        /* Anything else: leave the socket alone */
+        g_propagate_error(error, connect_error);
+        connect_error = NULL;
+        in_use = TRUE;
+    }
+    g_clear_error(&connect_error);
+    g_object_unref(socket);
+    return in_use;
+}
+
+static gboolean listen_on(const char *path, GError **error) {
+    GFile *file = g_file_new_for_path(path);
+    GFileType type = g_file_query_file_type(file, G_FILE_QUERY_INFO_NOFOLLOW_SYMLINKS, NULL);
+    g_object_unref(file);
+
+    GSocketAddress *address = g_unix_socket_address_new(path);
+    if (type == G_FILE_TYPE_SPECIAL) {
+        /* A socket nothing listens on was left by an instance that is gone;
+         * one that accepts connections belongs to another dashboard process */
+        GError *probe_error = NULL;
+        if (socket_in_use(address, &probe_error)) {
+            if (probe_error) {
+                g_propagate_prefixed_error(error, probe_error, "%s: ", path);
+            } else {
+                g_set_error(error, G_IO_ERROR, G_IO_ERROR_ADDRESS_IN_USE, "%s: socket in use", path);
+            }
+            g_object_unref(address);
+            return FALSE;
+        }
+        g_unlink(path);
+    } else if (type != G_FILE_TYPE_UNKNOWN) {
+        g_set_error(error, G_IO_ERROR, G_IO_ERROR_EXISTS, "%s exists and is not a socket", path);
+        g_object_unref(address);
+        return FALSE;
+    }
+
+    service = g_socket_service_new();
+    gboolean listening = g_socket_listener_add_address(G_SOCKET_LISTENER(service), address,
+                                                       G_SOCKET_TYPE_STREAM,
+                                                       G_SOCKET_PROTOCOL_DEFAULT,
+                                                       NULL, NULL, error);
+    g_object_unref(address);
+    if (!listening) {
+        g_clear_object(&service);
+        return FALSE;
+    }
+
+    g_signal_connect(service, "incoming", G_CALLBACK(on_incoming), NULL);
+    g_socket_service_start(service);
+    return TRUE;
+}
+
+/* ── Windows ─────────────────────────────────────────────── */
+
+static void on_frame(GdkFrameClock *frame_clock, gint64 interval_us, gint64 paint_us,
+                     gpointer user_data) {
+    if (interval_us > 0) histogram_observe(&frame_intervals, interval_us);
+    histogram_observe(&frame_paints, paint_us);
+}
+
+static void on_window_destroy(GtkWidget *window, gpointer user_data) {
+    if (windows) g_ptr_array_remove(windows, window);
+}
+
+void metrics_add_window(GtkWidget *window) {
+    g_return_if_fail(GTK_IS_WINDOW(window));
+    if (!socket_path) return;
+
+    if (!windows) windows = g_ptr_array_new();
+    g_ptr_array_add(windows, window);
+    g_signal_connect(window, "destroy", G_CALLBACK(on_window_destroy), NULL);
+
+    frame_stats_watch(window, on_frame, NULL);
+}
+
+/* ── Lifecycle ───────────────────────────────────────────── */
+
+void metrics_init(const char *path) {
+    g_free(socket_path);
+    socket_path = path && *path ? g_strdup(path) : NULL;
+}
+
+void metrics_start(void) {
+    if (!socket_path || service) return;
+
+    GError *error = NULL;
+    if (!listen_on(socket_path, &error)) {
+        g_warning("Metrics disabled: %s", error->message);
+        g_error_free(error);
+        g_clear_pointer(&socket_path, g_free);
+    }
+}
+
+void metrics_shutdown(void) {
+    if (service) {
+        g_socket_service_stop(service);
+        g_socket_listener_close(G_SOCKET_LISTENER(service));
+        g_clear_object(&service);
+        g_unlink(socket_path);
+    }
+    g_clear_pointer(&socket_path, g_free);
+    g_clear_pointer(&windows, g_ptr_array_unref);
+}
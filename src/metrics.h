@@ -0,0 +1,50 @@
+#ifndef METRICS_H
+#define METRICS_H
+
+#include <gtk/gtk.h>
+
+/*
+ * Runtime metrics (--metrics).
+ *
+ * The counters below are plain pointer-sized atomics, always updated on
+ * the hot paths (shape draws, data redraws, cache lookups) from whatever
+ * thread runs them; an increment costs one atomic add and takes no lock.
+ *
+ * With a socket path set, the primary instance listens on that Unix
+ * socket and answers every connection with a snapshot in the Prometheus
+ * text exposition format: frame interval and paint time histograms of
+ * the dashboard windows, redraw and cache counters, feed sample counts
+ * and ages, widget counts by type, resident memory and startup phase
+ * durations. A client sending an HTTP request ("curl --unix-socket")
+ * gets an HTTP response; anything else gets the bare text.
+ */
+
+typedef enum {
+    METRICS_CACHE_LAYOUT,    /* Parsed layout files */
+    METRICS_CACHE_TEXTURE,   /* Decoded image files */
+    METRICS_CACHE_STYLES,    /* Shared CSS providers */
+    METRICS_CACHE_SHADOW,    /* Shape drop shadows */
+    METRICS_CACHE_GAUGE,     /* Gauge dial layers */
+    METRICS_N_CACHES
+} MetricsCache;
+
+typedef enum {
+    METRICS_SHAPE_DRAWS,     /* Shape draw callbacks run */
+    METRICS_REDRAW_REQUESTS, /* power_policy_queue_draw() calls */
+    METRICS_REDRAWS,         /* Draws it queued after coalescing */
+    METRICS_N_COUNTERS
+} MetricsCounter;
+
+void metrics_count(MetricsCounter counter);
+void metrics_cache_lookup(MetricsCache cache, gboolean hit);
+
+/* Once, before the application runs; NULL = no socket */
+void metrics_init(const char *socket_path);
+/* The primary instance is up: start listening */
+void metrics_start(void);
+/* Time the frames of a dashboard window until it is destroyed */
+void metrics_add_window(GtkWidget *window);
+/* Stop listening and remove the socket */
+void metrics_shutdown(void);
+
+#endif /* METRICS_H */
@@ -0,0 +1,273 @@
+#include "poly_path.h"
+#include <gio/gio.h>
+#include <math.h>
+#include <string.h>
+
+struct _PolyPath {
+    float *points;           /* x, y pairs in view box coordinates */
+    gsize n_points;
+    double view_x, view_y;
+    double view_width;       /* 0 = points are widget coordinates */
+    double view_height;
+
+    /* Points of the last get_points() */
+    float *cache;
+    gsize cache_points;
+    gboolean cache_valid;
+    double cache_width, cache_height, cache_scale, cache_tolerance;
+};
+
+/* ── Kernels ─────────────────────────────────────────────── */
+
+void poly_path_transform(const float *src, float *dst, gsize n_points,
+                         float sx, float sy, float tx, float ty) {
+    /* Pairs are interleaved: even lanes take the x factors, odd lanes the
+     * y ones, so the loop is a plain packed multiply-add */
+    enum { LANES = 8 };
+    float scale[LANES], offset[LANES];
+    gsize n = n_points * 2;
+    gsize i = 0;
+
+    for (int l = 0; l < LANES; l++) {
+        scale[l] = l % 2 ? sy : sx;
+        offset[l] = l % 2 ? ty : tx;
+    }
+
+    /* Loading a block before storing it keeps the lanes independent even
+     * when dst is src */
+    for (; i + LANES <= n; i += LANES) {
+        float v[LANES];
+        for (int l = 0; l < LANES; l++) v[l] = src[i + l];
+        for (int l = 0; l < LANES; l++) dst[i + l] = v[l] * scale[l] + offset[l];
+    }
+    for (; i < n; i++) dst[i] = src[i] * scale[i % 2] + offset[i % 2];
+}
+
+/* Drop points on the same device pixel as the previous point kept; the
+ * last point takes the place of the one kept on its pixel */
+static gsize dedup_pixels(float *p, gsize n, double scale) {
+    double last_x = floor(p[0] * scale);
+    double last_y = floor(p[1] * scale);
+    gsize kept = 1;
+
+    for (gsize i = 1; i < n; i++) {
+        double x = floor(p[2 * i] * scale);
+        double y = floor(p[2 * i + 1] * scale);
+        if (x == last_x && y == last_y) {
+            if (i == n - 1) {
+                gsize slot = kept > 1 ? kept - 1 : kept++;
+                p[2 * slot] = p[2 * i];
+                p[2 * slot + 1] = p[2 * i + 1];
+            }
+            continue;
+        }
+        p[2 * kept] = p[2 * i];
+        p[2 * kept + 1] = p[2 * i + 1];
+        kept++;
+        last_x = x;
+        last_y = y;
+    }
+    return kept;
+}
+
+/* Squared distance of point i from the segment a-b */
+static double segment_distance2(const float *p, gsize i, double ax, double ay,
+                                double dx, double dy, double inv_len2) {
+    double px = p[2 * i] - ax;
+    double py = p[2 * i + 1] - ay;
+    double t = CLAMP((px * dx + py * dy) * inv_len2, 0.0, 1.0);
+    double ex = px - t * dx;
+    double ey = py - t * dy;
+    return ex * ex + ey * ey;
+}
+
+/* Iterative Douglas–Peucker: a range is split at its farthest point
+ * while that point is farther than tolerance from the range's chord */
+static gsize douglas_peucker(float *p, gsize n, double tolerance) {
+    guint8 *keep = g_malloc0(n);
+    GArray *stack = g_array_new(FALSE, FALSE, sizeof(gsize));
+    double tolerance2 = tolerance * tolerance;
+    gsize range[2] = { 0, n - 1 };
+
+    keep[0] = keep[n - 1] = 1;
+    g_array_append_vals(stack, range, 2);
+
+    while (stack->len > 0) {
+        gsize first = g_array_index(stack, gsize, stack->len - 2);
+        gsize last = g_array_index(stack, gsize, stack->len - 1);
+        g_array_set_size(stack, stack->len - 2);
+        if (last - first < 2) continue;
+
+        double ax = p[2 * first], ay = p[2 * first + 1];
+        double dx = p[2 * last] - ax, dy = p[2 * last + 1] - ay;
+        double len2 = dx * dx + dy * dy;
+        double inv_len2 = len2 > 0 ? 1.0 / len2 : 0.0;
+
+        double farthest = 0;
+        gsize index = first;
+        for (gsize i = first + 1; i < last; i++) {
+            double d = segment_distance2(p, i, ax, ay, dx, dy, inv_len2);
+            if (d > farthest) {
+                farthest = d;
+                index = i;
+            }
+        }
+
+        if (farthest > tolerance2) {
+            keep[index] = 1;
+            gsize halves[4] = { first, index, index, last };
+            g_array_append_vals(stack, halves, 4);
+        }
+    }
+
+    gsize kept = 0;
+    for (gsize i = 0; i < n; i++) {
+        if (!keep[i]) continue;
+        p[2 * kept] = p[2 * i];
+        p[2 * kept + 1] = p[2 * i + 1];
+        kept++;
+    }
+
+    g_array_free(stack, TRUE);
+    g_free(keep);
+    return kept;
+}
+
+gsize poly_path_simplify(float *points, gsize n_points, double scale, double tolerance) {
+    if (n_points < 3 || scale <= 0 || tolerance <= 0) return n_points;
+
+    n_points = dedup_pixels(points, n_points, scale);
+    if (n_points < 3) return n_points;
+    return douglas_peucker(points, n_points, tolerance / scale);
+}
+
+/* ── Paths ───────────────────────────────────────────────── */
+
+PolyPath* poly_path_new(const float *points, gsize n_points) {
+    PolyPath *path = g_new0(PolyPath, 1);
+    path->points = g_new(float, n_points * 2);
+    memcpy(path->points, points, n_points * 2 * sizeof(float));
+    path->n_points = n_points;
+    return path;
+}
+
+static gboolean get_coordinate(JsonNode *node, float *value) {
+    if (!JSON_NODE_HOLDS_VALUE(node)) return FALSE;
+
+    GType type = json_node_get_value_type(node);
+    if (type != G_TYPE_DOUBLE && type != G_TYPE_INT64) return FALSE;
+    *value = (float)json_node_get_double(node);
+    return isfinite(*value);
+}
+
+PolyPath* poly_path_new_from_json(JsonNode *node, GError **error) {
+    if (!node || !JSON_NODE_HOLDS_ARRAY(node)) {
+        g_set_error(error, G_IO_ERROR, G_IO_ERROR_INVALID_DATA, "\"points\" must be an array");
+        return NULL;
+    }
+
+    JsonArray *array = json_node_get_array(node);
+    guint length = json_array_get_length(array);
+    gboolean pairs = length > 0 && JSON_NODE_HOLDS_ARRAY(json_array_get_element(array, 0));
+    gsize n_points = pairs ? length : length / 2;
+
+    if (n_points < 2 || (!pairs && length % 2 != 0)) {
+        g_set_error(error, G_IO_ERROR, G_IO_ERROR_INVALID_DATA,
+                    "\"points\" needs at least 2 x, y pairs");
+        return NULL;
+    }
+
+    float *points = g_new(float, n_points * 2);
+    for (gsize i = 0; i < n_points; i++) {
+        gboolean ok;
+        if (pairs) {
+            JsonNode *pair = json_array_get_element(array, i);
+            JsonArray *xy = JSON_NODE_HOLDS_ARRAY(pair) ? json_node_get_array(pair) : NULL;
+            ok = xy && json_array_get_length(xy) == 2 &&
+                 get_coordinate(json_array_get_element(xy, 0), &points[2 * i]) &&
+                 get_coordinate(json_array_get_element(xy, 1), &points[2 * i + 1]);
+        } else {
+            ok = get_coordinate(json_array_get_element(array, 2 * i), &points[2 * i]) &&
+                 get_coordinate(json_array_get_element(array, 2 * i + 1), &points[2 * i + 1]);
+        }
+        if (!ok) {
+            g_set_error(error, G_IO_ERROR, G_IO_ERROR_INVALID_DATA,
+                        "Point %" G_GSIZE_FORMAT " of \"points\" is not a pair of numbers", i);
+            g_free(points);
+            return NULL;
+        }
+    }
+
+    PolyPath *path = g_new0(PolyPath, 1);
+    path->points = points;
+    path->n_points = n_points;
+    return path;
+}
+
+void poly_path_free(PolyPath *path) {
+    if (!path) return;
+    g_free(path->points);
+    g_free(path->cache);
+    g_free(path);
+}
+
+gsize poly_path_get_n_points(PolyPath *path) {
+    return path->n_points;
+}
+
+gsize poly_path_get_size(PolyPath *path) {
+    return sizeof(PolyPath) + path->n_points * 2 * sizeof(float) * (path->cache ? 2 : 1);
+}
+
+void poly_path_set_view_box(PolyPath *path, double x, double y, double width, double height) {
+    path->view_x = x;
+    path->view_y = y;
+    path->view_width = width > 0 && height > 0 ? width : 0;
+    path->view_height = width > 0 && height > 0 ? height : 0;
+    path->cache_valid = FALSE;
+}
+
+const float* poly_path_get_points(PolyPath *path, double width, double height, double scale,
+                                  double tolerance, gsize *n_points) {
+    if (path->cache_valid && path->cache_width == width && path->cache_height == height &&
+        path->cache_scale == scale && path->cache_tolerance == tolerance) {
+        *n_points = path->cache_points;
+        return path->cache;
+    }
+
+    if (!path->cache) path->cache = g_new(float, path->n_points * 2);
+
+    double sx = 1.0, sy = 1.0;
+    if (path->view_width > 0) {
+        sx = width / path->view_width;
+        sy = height / path->view_height;
+    }
+    poly_path_transform(path->points, path->cache, path->n_points, (float)sx, (float)sy,
+                        (float)(-path->view_x * sx), (float)(-path->view_y * sy));
+    path->cache_points = poly_path_simplify(path->cache, path->n_points, scale, tolerance);
+
+    path->cache_valid = TRUE;
+    path->cache_width = width;
+    path->cache_height = height;
+    path->cache_scale = scale;
+    path->cache_tolerance = tolerance;
+
+    *n_points = path->cache_points;
+    return path->cache;
+}
+
+void poly_path_append(PolyPath *path, cairo_t *cr, double width, double height,
+                      double tolerance, gboolean closed) {
+    /* Device pixels per unit along the more magnified axis */
+    double ux = 1.0, uy = 0.0, vx = 0.0, vy = 1.0;
+    cairo_user_to_device_distance(cr, &ux, &uy);
+    cairo_user_to_device_distance(cr, &vx, &vy);
+    double scale = MAX(hypot(ux, uy), hypot(vx, vy));
+
+    gsize n;
+    const float *points = poly_path_get_points(path, width, height, scale, tolerance, &n);
+
+    cairo_move_to(cr, points[0], points[1]);
+    for (gsize i = 1; i < n; i++) cairo_line_to(cr, points[2 * i], points[2 * i + 1]);
+    if (closed) cairo_close_path(cr);
+}
@@ -0,0 +1,55 @@
+#ifndef POLY_PATH_H
+#define POLY_PATH_H
+
+#include <glib.h>
+#include <cairo.h>
+#include <json-glib/json-glib.h>
+
+/*
+ * Point paths of the "Polyline" and "Polygon" shapes.
+ *
+ * Points are stored packed, as x, y float pairs in the coordinates of a
+ * view box. Drawing maps them to widget space with a single scale and
+ * offset pass over the array, then simplifies the result for the device
+ * resolution before Cairo sees it: points on the same device pixel as
+ * the previous one are dropped, then Douglas–Peucker removes points
+ * closer than a tolerance to the line through their neighbours. The
+ * simplified points are kept for the last size and device scale, so a
+ * steady redraw only replays them.
+ */
+
+typedef struct _PolyPath PolyPath;
+
+/* Copies n_points x, y pairs */
+PolyPath* poly_path_new(const float *points, gsize n_points);
+/* A flat [x0, y0, x1, y1, ...] array or an array of [x, y] pairs */
+PolyPath* poly_path_new_from_json(JsonNode *node, GError **error);
+void poly_path_free(PolyPath *path);
+
+gsize poly_path_get_n_points(PolyPath *path);
+/* Bytes held, cache included (memory report) */
+gsize poly_path_get_size(PolyPath *path);
+
+/* Area of the point coordinates shown in the widget; by default the
+ * points' coordinates are widget coordinates */
+void poly_path_set_view_box(PolyPath *path, double x, double y, double width, double height);
+
+/* Points mapped to a width x height widget and simplified for scale
+ * device pixels per unit; tolerance in device pixels, 0 = no
+ * simplification. Valid until the next call. */
+const float* poly_path_get_points(PolyPath *path, double width, double height, double scale,
+                                  double tolerance, gsize *n_points);
+
+/* Add the path to cr's current path, simplified for cr's device scale */
+void poly_path_append(PolyPath *path, cairo_t *cr, double width, double height,
+                      double tolerance, gboolean closed);
+
+/* dst = src * (sx, sy) + (tx, ty) for n x, y pairs, written to be
+ * auto-vectorized; dst may be src */
+void poly_path_transform(const float *src, float *dst, gsize n_points,
+                         float sx, float sy, float tx, float ty);
+/* Simplify n x, y pairs in place; returns the number of points kept.
+ * The first and last points are always kept. */
+gsize poly_path_simplify(float *points, gsize n_points, double scale, double tolerance);
+
+#endif /* POLY_PATH_H */
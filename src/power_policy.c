@@ -0,0 +1,372 @@
+#include "power_policy.h"
+#include "data_feed.h"
+#include "metrics.h"
+
+#define WAKEUP_REPORT_INTERVAL_S 10
+
+typedef struct {
+    GtkWidget *window;
+    GdkSurface *surface;     /* While realized */
+    gulong state_handler;
+} WatchedWindow;
+
+typedef struct {
+    guint id;
+    PowerPolicyFunc func;
+    gpointer user_data;
+} Watch;
+
+static PowerConfig config = { 0, 0, 1 };
+static GtkApplication *application = NULL;
+static GPtrArray *windows = NULL;     /* WatchedWindow* */
+static GArray *watches = NULL;        /* Watch */
+static guint next_watch = 1;
+
+static PowerState state = POWER_STATE_ACTIVE;
+static gboolean idle = FALSE;
+static gint64 last_activity_us = 0;
+static guint idle_source = 0;
+
+/* Data-driven redraws waiting for the next allowed frame */
+static GHashTable *pending_draws = NULL;  /* GtkWidget* (ref) set */
+static guint flush_source = 0;
+static gint64 last_flush_us = 0;
+
+/* Wakeups */
+static GPollFunc default_poll = NULL;
+static guint wakeups = 0;
+static guint sample_wakeups = 0;
+static gint64 sample_time_us = 0;
+static double wakeup_rate = 0.0;
+
+/* ── Wakeups ─────────────────────────────────────────────── */
+
+/* A poll that could sleep and returned is one wakeup of the main thread */
+static gint counting_poll(GPollFD *fds, guint nfds, gint timeout) {
+    gint result = default_poll(fds, nfds, timeout);
+    if (timeout != 0) g_atomic_int_inc(&wakeups);
+    return result;
+}
+
+double power_policy_get_wakeups_per_second(void) {
+    gint64 now = g_get_monotonic_time();
+    guint count = (guint)g_atomic_int_get(&wakeups);
+
+    if (sample_time_us == 0) {
+        sample_time_us = now;
+        sample_wakeups = count;
+    } else if (now - sample_time_us >= G_USEC_PER_SEC) {
+        wakeup_rate = (double)(count - sample_wakeups) * G_USEC_PER_SEC / (now - sample_time_us);
+        sample_time_us = now;
+        sample_wakeups = count;
+    }
+    return wakeup_rate;
+}
+
+static gboolean on_report(gpointer user_data) {
+    g_print("wakeups/s %.1f (%s)\n", power_policy_get_wakeups_per_second(),
+            power_policy_get_state_name());
+    return G_SOURCE_CONTINUE;
+}
+
+/* ── Rate ────────────────────────────────────────────────── */
+
+static int current_fps(void) {
+    if (idle && config.idle_fps > 0) return config.idle_fps;
+    return config.max_fps;
+}
+
+gint64 power_policy_get_frame_interval(void) {
+    int fps = current_fps();
+    return fps > 0 ? G_USEC_PER_SEC / fps : 0;
+}
+
+static gboolean flush_draws(gpointer user_data) {
+    flush_source = 0;
+    last_flush_us = g_get_monotonic_time();
+
+    GHashTableIter iter;
+    gpointer widget;
+    g_hash_table_iter_init(&iter, pending_draws);
+    while (g_hash_table_iter_next(&iter, &widget, NULL)) {
+        gtk_widget_queue_draw(GTK_WIDGET(widget));
+        metrics_count(METRICS_REDRAWS);
+    }
+    g_hash_table_remove_all(pending_draws);
+    return G_SOURCE_REMOVE;
+}
+
+static void schedule_flush(void) {
+    if (flush_source || state == POWER_STATE_PAUSED) return;
+    if (!pending_draws || g_hash_table_size(pending_draws) == 0) return;
+
+    gint64 wait_us = last_flush_us + power_policy_get_frame_interval() - g_get_monotonic_time();
+    flush_source = g_timeout_add((guint)(MAX(wait_us, 0) / 1000), flush_draws, NULL);
+}
+
+static void reschedule_flush(void) {
+    if (flush_source) {
+        g_source_remove(flush_source);
+        flush_source = 0;
+    }
+    schedule_flush();
+}
+
+void power_policy_queue_draw(GtkWidget *widget) {
+    g_return_if_fail(GTK_IS_WIDGET(widget));
+    metrics_count(METRICS_REDRAW_REQUESTS);
+
+    if (state != POWER_STATE_PAUSED && power_policy_get_frame_interval() == 0) {
+        gtk_widget_queue_draw(widget);
+        metrics_count(METRICS_REDRAWS);
+        return;
+    }
+
+    if (!pending_draws) {
+        pending_draws = g_hash_table_new_full(g_direct_hash, g_direct_equal, g_object_unref, NULL);
+    }
+    if (!g_hash_table_contains(pending_draws, widget)) {
+        g_hash_table_add(pending_draws, g_object_ref(widget));
+    }
+    schedule_flush();
+}
+
+/* ── State ───────────────────────────────────────────────── */
+
+static void notify_watches(void) {
+    for (guint i = 0; watches && i < watches->len; i++) {
+        Watch *watch = &g_array_index(watches, Watch, i);
+        watch->func(watch->user_data);
+    }
+}
+
+static gboolean window_hidden(WatchedWindow *watched) {
+    if (!watched->surface || !gtk_widget_get_mapped(watched->window)) return TRUE;
+
+    GdkToplevelState toplevel = gdk_toplevel_get_state(GDK_TOPLEVEL(watched->surface));
+    if (toplevel & GDK_TOPLEVEL_STATE_MINIMIZED) return TRUE;
+#if GTK_CHECK_VERSION(4, 12, 0)
+    /* Occluded, on another workspace, or otherwise not shown */
+    if (toplevel & GDK_TOPLEVEL_STATE_SUSPENDED) return TRUE;
+#endif
+    return FALSE;
+}
+
+static gboolean screensaver_active(void) {
+    gboolean active = FALSE;
+    if (application) g_object_get(application, "screensaver-active", &active, NULL);
+    return active;
+}
+
+static gboolean all_hidden(void) {
+    if (!windows || windows->len == 0) return FALSE;
+
+    for (guint i = 0; i < windows->len; i++) {
+        if (!window_hidden(g_ptr_array_index(windows, i))) return FALSE;
+    }
+    return TRUE;
+}
+
+static void update_state(void) {
+    PowerState new_state = screensaver_active() || all_hidden() ? POWER_STATE_PAUSED
+                         : idle ? POWER_STATE_IDLE : POWER_STATE_ACTIVE;
+    if (new_state == state) return;
+
+    gboolean was_paused = state == POWER_STATE_PAUSED;
+    state = new_state;
+
+    if (state == POWER_STATE_PAUSED) {
+        data_feed_set_paused(TRUE);
+        if (flush_source) {
+            g_source_remove(flush_source);
+            flush_source = 0;
+        }
+    } else {
+        if (was_paused) data_feed_set_paused(FALSE);
+        reschedule_flush();
+    }
+    notify_watches();
+}
+
+static void schedule_idle_check(void);
+
+static gboolean on_idle_check(gpointer user_data) {
+    idle_source = 0;
+    if (g_get_monotonic_time() - last_activity_us >= (gint64)config.idle_after_s * G_USEC_PER_SEC) {
+        idle = TRUE;
+        update_state();
+    } else {
+        schedule_idle_check();
+    }
+    return G_SOURCE_REMOVE;
+}
+
+/* One timer per idle period, not one per activity */
+static void schedule_idle_check(void) {
+    if (idle_source || idle || config.idle_after_s <= 0) return;
+
+    gint64 due_us = last_activity_us + (gint64)config.idle_after_s * G_USEC_PER_SEC;
+    gint64 wait_us = MAX(due_us - g_get_monotonic_time(), 0);
+    idle_source = g_timeout_add((guint)(wait_us / 1000) + 1, on_idle_check, NULL);
+}
+
+void power_policy_activity(void) {
+    last_activity_us = g_get_monotonic_time();
+    if (idle) {
+        idle = FALSE;
+        update_state();
+    }
+    schedule_idle_check();
+}
+
+static void on_feed_changed(gpointer user_data) {
+    power_policy_activity();
+}
+
+PowerState power_policy_get_state(void) {
+    return state;
+}
+
+const char* power_policy_get_state_name(void) {
+    switch (state) {
+    case POWER_STATE_IDLE:   return "idle";
+    case POWER_STATE_PAUSED: return "paused";
+    default:                 return "active";
+    }
+}
+
+/* ── Windows ─────────────────────────────────────────────── */
+
+static void on_surface_state(GObject *surface, GParamSpec *pspec, gpointer user_data) {
+    update_state();
+}
+
+static void on_window_realize(GtkWidget *window, gpointer user_data) {
+    WatchedWindow *watched = (WatchedWindow *)user_data;
+
+    GdkSurface *surface = gtk_native_get_surface(GTK_NATIVE(window));
+    if (!surface || !GDK_IS_TOPLEVEL(surface)) return;
+
+    watched->surface = g_object_ref(surface);
+    watched->state_handler = g_signal_connect(surface, "notify::state",
+                                              G_CALLBACK(on_surface_state), NULL);
+}
+
+static void unwatch_surface(WatchedWindow *watched) {
+    if (!watched->surface) return;
+    g_signal_handler_disconnect(watched->surface, watched->state_handler);
+    g_clear_object(&watched->surface);
+    watched->state_handler = 0;
+}
+
+static void on_window_unrealize(GtkWidget *window, gpointer user_data) {
+    unwatch_surface((WatchedWindow *)user_data);
+    update_state();
+}
+
+static void on_window_mapping(GtkWidget *window, gpointer user_data) {
+    update_state();
+}
+
+static void on_window_destroy(GtkWidget *window, gpointer user_data) {
+    WatchedWindow *watched = (WatchedWindow *)user_data;
+    unwatch_surface(watched);
+    g_signal_handlers_disconnect_by_data(window, watched);
+    g_ptr_array_remove(windows, watched);  /* Frees watched */
+    update_state();
+}
+
+/* Every event reaching the window, before its widgets see it */
+static gboolean on_window_event(GtkEventControllerLegacy *controller, GdkEvent *event,
+                                gpointer user_data) {
+    power_policy_activity();
+    return FALSE;
+}
+
+void power_policy_add_window(GtkWidget *window) {
+    g_return_if_fail(GTK_IS_WINDOW(window));
+
+    if (!windows) windows = g_ptr_array_new_with_free_func(g_free);
+
+    WatchedWindow *watched = g_new0(WatchedWindow, 1);
+    watched->window = window;
+    g_ptr_array_add(windows, watched);
+
+    g_signal_connect(window, "realize", G_CALLBACK(on_window_realize), watched);
+    g_signal_connect(window, "unrealize", G_CALLBACK(on_window_unrealize), watched);
+    g_signal_connect(window, "map", G_CALLBACK(on_window_mapping), NULL);
+    g_signal_connect(window, "unmap", G_CALLBACK(on_window_mapping), NULL);
+    g_signal_connect(window, "destroy", G_CALLBACK(on_window_destroy), watched);
+    if (gtk_widget_get_realized(window)) on_window_realize(window, watched);
+
+    GtkEventController *input = gtk_event_controller_legacy_new();
+    gtk_event_controller_set_propagation_phase(input, GTK_PHASE_CAPTURE);
+    g_signal_connect(input, "event", G_CALLBACK(on_window_event), NULL);
+    gtk_widget_add_controller(window, input);
+
+    update_state();
+}
+
+/* ── Lifecycle ───────────────────────────────────────────── */
+
+static void on_screensaver_active(GObject *object, GParamSpec *pspec, gpointer user_data) {
+    update_state();
+}
+
+void power_policy_init(GtkApplication *app) {
+    application = app;
+
+    /* screensaver-active is only tracked for registered sessions */
+    g_object_set(app, "register-session", TRUE, NULL);
+    g_signal_connect(app, "notify::screensaver-active", G_CALLBACK(on_screensaver_active), NULL);
+
+    if (!default_poll) {
+        default_poll = g_main_context_get_poll_func(NULL);
+        g_main_context_set_poll_func(NULL, counting_poll);
+    }
+
+    data_feed_set_change_func(on_feed_changed, NULL);
+    last_activity_us = g_get_monotonic_time();
+}
+
+void power_policy_report_wakeups(void) {
+    g_timeout_add_seconds(WAKEUP_REPORT_INTERVAL_S, on_report, NULL);
+}
+
+void power_policy_configure(const PowerConfig *new_config) {
+    static const PowerConfig defaults = { 0, 0, 1 };
+    config = new_config ? *new_config : defaults;
+
+    if (idle_source) {
+        g_source_remove(idle_source);
+        idle_source = 0;
+    }
+    idle = FALSE;
+    last_activity_us = g_get_monotonic_time();
+    schedule_idle_check();
+
+    if (state == POWER_STATE_IDLE) {
+        update_state();
+    } else {
+        reschedule_flush();
+        notify_watches();
+    }
+}
+
+guint power_policy_watch(PowerPolicyFunc func, gpointer user_data) {
+    g_return_val_if_fail(func != NULL, 0);
+
+    if (!watches) watches = g_array_new(FALSE, FALSE, sizeof(Watch));
+    Watch watch = { next_watch++, func, user_data };
+    g_array_append_val(watches, watch);
+    return watch.id;
+}
+
+void power_policy_unwatch(guint id) {
+    for (guint i = 0; watches && i < watches->len; i++) {
+        if (g_array_index(watches, Watch, i).id == id) {
+            g_array_remove_index(watches, i);
+            return;
+        }
+    }
+}
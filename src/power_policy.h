@@ -0,0 +1,59 @@
+#ifndef POWER_POLICY_H
+#define POWER_POLICY_H
+
+#include <gtk/gtk.h>
+#include "json_parser.h"
+
+/*
+ * Power policy for panels that run unattended.
+ *
+ * Redraws caused by data (feed samples, log lines, animated values) go
+ * through power_policy_queue_draw(), which coalesces them to at most
+ * "max_fps" per second, and to "idle_fps" once "idle_after_s" seconds
+ * passed without input on a dashboard window or a feed value different
+ * from the previous one. Animations step at the same limited rate on a
+ * timer instead of every display frame.
+ *
+ * While every dashboard window is minimized or hidden from view
+ * (suspended), or the screensaver is active, feeds, animations and
+ * data-driven redraws stop entirely; samples already received are drawn
+ * on resume. LogView readers block instead of following files and keep
+ * the lines they read until then. Main-thread wakeups are counted at the
+ * main loop's poll so an idle dashboard can be checked to really sleep.
+ */
+
+typedef enum {
+    POWER_STATE_ACTIVE,
+    POWER_STATE_IDLE,        /* Limited to idle_fps */
+    POWER_STATE_PAUSED       /* Nothing visible */
+} PowerState;
+
+typedef void (*PowerPolicyFunc)(gpointer user_data);
+
+/* Once, before the application is registered */
+void power_policy_init(GtkApplication *app);
+/* Print the wakeup rate every few seconds (--wakeups) */
+void power_policy_report_wakeups(void);
+/* Limits of the current layout, NULL = none */
+void power_policy_configure(const PowerConfig *config);
+/* Watch a dashboard window for visibility and input until it is destroyed */
+void power_policy_add_window(GtkWidget *window);
+
+/* Input or a changed value: leaves the idle state */
+void power_policy_activity(void);
+/* gtk_widget_queue_draw() for redraws driven by data */
+void power_policy_queue_draw(GtkWidget *widget);
+
+PowerState power_policy_get_state(void);
+const char* power_policy_get_state_name(void);
+/* Minimum time between animation steps, 0 = every frame */
+gint64 power_policy_get_frame_interval(void);
+
+/* Called after every state or rate change */
+guint power_policy_watch(PowerPolicyFunc func, gpointer user_data);
+void power_policy_unwatch(guint id);
+
+/* Main-thread wakeups per second, measured over the last second or more */
+double power_policy_get_wakeups_per_second(void);
+
+#endif /* POWER_POLICY_H */
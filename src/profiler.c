@@ -0,0 +1,189 @@
+#include "profiler.h"
+#include <json-glib/json-glib.h>
+#include <string.h>
+#include <malloc.h>
+
+#ifdef HAVE_SYSPROF
+#include <sysprof-capture.h>
+#endif
+
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 33))
+#define HAVE_MALLINFO2 1
+#endif
+
+typedef struct {
+    char *name;
+    gint64 start_us;
+    gint64 end_us;
+    gint64 heap_start;
+    gint64 heap_end;
+} ProfilePhase;
+
+typedef struct {
+    guint count;
+    gint64 total_us;
+} WidgetTypeStats;
+
+static gboolean profiler_enabled = FALSE;
+static gint64 profiler_t0 = 0;
+static GPtrArray *phases = NULL;         /* ProfilePhase*, in begin order */
+static GHashTable *widget_types = NULL;  /* type name -> WidgetTypeStats* */
+static guint widgets_total = 0;
+
+static void profile_phase_free(gpointer data) {
+    ProfilePhase *phase = (ProfilePhase *)data;
+    g_free(phase->name);
+    g_free(phase);
+}
+
+gint64 profiler_heap_in_use(void) {
+#ifdef HAVE_MALLINFO2
+    struct mallinfo2 mi = mallinfo2();
+    return (gint64)(mi.uordblks + mi.hblkhd);
+#else
+    return 0;
+#endif
+}
+
+#ifdef HAVE_SYSPROF
+static void emit_mark(const char *group, const char *name, const char *message,
+                      gint64 start_us, gint64 end_us) {
+    sysprof_collector_mark(start_us * 1000, (end_us - start_us) * 1000,
+                           group, name, message);
+}
+#else
+#define emit_mark(group, name, message, start_us, end_us) ((void)0)
+#endif
+
+void profiler_init(gboolean enabled) {
+    profiler_enabled = enabled;
+    profiler_t0 = g_get_monotonic_time();
+
+    if (!phases) {
+        phases = g_ptr_array_new_with_free_func(profile_phase_free);
+        widget_types = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, g_free);
+    }
+}
+
+void profiler_set_enabled(gboolean enabled) {
+    profiler_enabled = enabled;
+}
+
+gboolean profiler_is_enabled(void) {
+    return profiler_enabled;
+}
+
+void profiler_phase_begin(const char *name) {
+    if (!phases) return;
+
+    ProfilePhase *phase = g_new0(ProfilePhase, 1);
+    phase->name = g_strdup(name);
+    phase->start_us = g_get_monotonic_time();
+    phase->heap_start = profiler_heap_in_use();
+    g_ptr_array_add(phases, phase);
+}
+
+void profiler_phase_end(const char *name) {
+    if (!phases) return;
+
+    /* Close the most recently opened phase with this name */
+    for (guint i = phases->len; i > 0; i--) {
+        ProfilePhase *phase = g_ptr_array_index(phases, i - 1);
+        if (phase->end_us == 0 && strcmp(phase->name, name) == 0) {
+            phase->end_us = g_get_monotonic_time();
+            phase->heap_end = profiler_heap_in_use();
+            emit_mark("gtk-dashboard", phase->name, "", phase->start_us, phase->end_us);
+            return;
+        }
+    }
+}
+
+void profiler_record_widget(const char *type, const char *id, gint64 start_us, gint64 end_us) {
+    if (!widget_types) return;
+
+    const char *key = type ? type : "(null)";
+    WidgetTypeStats *stats = g_hash_table_lookup(widget_types, key);
+    if (!stats) {
+        stats = g_new0(WidgetTypeStats, 1);
+        g_hash_table_insert(widget_types, g_strdup(key), stats);
+    }
+    stats->count++;
+    stats->total_us += end_us - start_us;
+    widgets_total++;
+
+    emit_mark("gtk-dashboard", key, id ? id : "", start_us, end_us);
+}
+
+void profiler_foreach_phase(ProfilerPhaseFunc func, gpointer user_data) {
+    for (guint i = 0; phases && i < phases->len; i++) {
+        ProfilePhase *phase = g_ptr_array_index(phases, i);
+        if (phase->end_us == 0) continue;
+        func(phase->name, phase->start_us - profiler_t0, phase->end_us - phase->start_us, user_data);
+    }
+}
+
+void profiler_report(void) {
+    if (!profiler_enabled || !phases) return;
+
+    JsonBuilder *builder = json_builder_new();
+    json_builder_begin_object(builder);
+
+    json_builder_set_member_name(builder, "total_ms");
+    json_builder_add_double_value(builder, (g_get_monotonic_time() - profiler_t0) / 1000.0);
+
+    json_builder_set_member_name(builder, "phases");
+    json_builder_begin_array(builder);
+    for (guint i = 0; i < phases->len; i++) {
+        ProfilePhase *phase = g_ptr_array_index(phases, i);
+        if (phase->end_us == 0) continue;
+
+        json_builder_begin_object(builder);
+        json_builder_set_member_name(builder, "name");
+        json_builder_add_string_value(builder, phase->name);
+        json_builder_set_member_name(builder, "start_ms");
+        json_builder_add_double_value(builder, (phase->start_us - profiler_t0) / 1000.0);
+        json_builder_set_member_name(builder, "duration_ms");
+        json_builder_add_double_value(builder, (phase->end_us - phase->start_us) / 1000.0);
+        json_builder_set_member_name(builder, "heap_delta_bytes");
+        json_builder_add_int_value(builder, phase->heap_end - phase->heap_start);
+        json_builder_end_object(builder);
+    }
+    json_builder_end_array(builder);
+
+    json_builder_set_member_name(builder, "heap_bytes");
+    json_builder_add_int_value(builder, profiler_heap_in_use());
+
+    json_builder_set_member_name(builder, "widgets_total");
+    json_builder_add_int_value(builder, widgets_total);
+
+    json_builder_set_member_name(builder, "widget_types");
+    json_builder_begin_object(builder);
+    GHashTableIter iter;
+    gpointer key, value;
+    g_hash_table_iter_init(&iter, widget_types);
+    while (g_hash_table_iter_next(&iter, &key, &value)) {
+        WidgetTypeStats *stats = (WidgetTypeStats *)value;
+        json_builder_set_member_name(builder, (const char *)key);
+        json_builder_begin_object(builder);
+        json_builder_set_member_name(builder, "count");
+        json_builder_add_int_value(builder, stats->count);
+        json_builder_set_member_name(builder, "build_ms");
+        json_builder_add_double_value(builder, stats->total_us / 1000.0);
+        json_builder_end_object(builder);
+    }
+    json_builder_end_object(builder);
+
+    json_builder_end_object(builder);
+
+    JsonGenerator *gen = json_generator_new();
+    json_generator_set_pretty(gen, TRUE);
+    JsonNode *root = json_builder_get_root(builder);
+    json_generator_set_root(gen, root);
+    char *json = json_generator_to_data(gen, NULL);
+    g_print("%s\n", json);
+
+    g_free(json);
+    json_node_unref(root);
+    g_object_unref(gen);
+    g_object_unref(builder);
+}
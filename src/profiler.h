@@ -0,0 +1,36 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <glib.h>
+
+/*
+ * Startup profiler.
+ *
+ * Phases are timed with the monotonic clock and always emitted as sysprof
+ * marks when sysprof-capture is available. The JSON report is only printed
+ * when profiling was enabled with --profile.
+ */
+
+void profiler_init(gboolean enabled);
+/* Turn the report on after init (once the options are known) */
+void profiler_set_enabled(gboolean enabled);
+gboolean profiler_is_enabled(void);
+
+void profiler_phase_begin(const char *name);
+void profiler_phase_end(const char *name);
+
+/* Record one widget/shape built by build_dashboard() */
+void profiler_record_widget(const char *type, const char *id, gint64 start_us, gint64 end_us);
+
+/* Bytes currently allocated from the malloc heap (0 if unknown) */
+gint64 profiler_heap_in_use(void);
+
+/* Finished phases in begin order; start_us counts from profiler_init() */
+typedef void (*ProfilerPhaseFunc)(const char *name, gint64 start_us, gint64 duration_us,
+                                  gpointer user_data);
+void profiler_foreach_phase(ProfilerPhaseFunc func, gpointer user_data);
+
+/* Print the JSON breakdown to stdout (no-op unless enabled) */
+void profiler_report(void);
+
+#endif /* PROFILER_H */
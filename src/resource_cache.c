@@ -0,0 +1,208 @@
+#include "resource_cache.h"
+#include "metrics.h"
+#include <string.h>
+
+typedef struct {
+    StyleManager *styles;
+    guint refs;
+} SharedStyles;
+
+static GMutex layouts_lock;
+static GHashTable *layouts = NULL;    /* canonical path -> LayoutConfig* */
+static GPtrArray *retired = NULL;     /* Earlier layouts tables, still in use */
+static GHashTable *textures = NULL;   /* canonical path -> GdkTexture*, NULL on failure */
+static GHashTable *styles = NULL;     /* key -> SharedStyles* */
+static guint styles_serial = 0;
+
+static void shared_styles_free(gpointer data) {
+    SharedStyles *shared = (SharedStyles *)data;
+    style_manager_unapply(shared->styles);
+    style_manager_free(shared->styles);
+    g_free(shared);
+}
+
+static void texture_unref(gpointer data) {
+    if (data) g_object_unref(data);
+}
+
+/* ── Layouts ─────────────────────────────────────────────── */
+
+LayoutConfig* resource_cache_load_layout(const char *filename, GError **error) {
+    char *path = g_canonicalize_filename(filename, NULL);
+
+    g_mutex_lock(&layouts_lock);
+    if (!layouts) {
+        layouts = g_hash_table_new_full(g_str_hash, g_str_equal, g_free,
+                                        (GDestroyNotify)layout_config_free);
+    }
+    LayoutConfig *config = g_hash_table_lookup(layouts, path);
+    g_mutex_unlock(&layouts_lock);
+    metrics_cache_lookup(METRICS_CACHE_LAYOUT, config != NULL);
+
+    if (config) {
+        g_free(path);
+        return config;
+    }
+
+    /* Parse unlocked; if another thread won the race keep its copy */
+    LayoutConfig *parsed = layout_config_load_from_file(path, error);
+    if (!parsed) {
+        g_free(path);
+        return NULL;
+    }
+
+    g_mutex_lock(&layouts_lock);
+    config = g_hash_table_lookup(layouts, path);
+    if (config) {
+        layout_config_free(parsed);
+        g_free(path);
+    } else {
+        config = parsed;
+        g_hash_table_insert(layouts, path, config);
+    }
+    g_mutex_unlock(&layouts_lock);
+
+    return config;
+}
+
+void resource_cache_retire_layouts(void) {
+    g_mutex_lock(&layouts_lock);
+    if (layouts) {
+        if (!retired) retired = g_ptr_array_new_with_free_func((GDestroyNotify)g_hash_table_destroy);
+        g_ptr_array_add(retired, layouts);
+        layouts = NULL;
+    }
+    g_mutex_unlock(&layouts_lock);
+}
+
+void resource_cache_free_retired_layouts(void) {
+    g_mutex_lock(&layouts_lock);
+    GPtrArray *tables = g_steal_pointer(&retired);
+    g_mutex_unlock(&layouts_lock);
+
+    if (tables) g_ptr_array_free(tables, TRUE);
+}
+
+/* ── Textures ────────────────────────────────────────────── */
+
+GdkTexture* resource_cache_get_texture(const char *filename) {
+    if (!filename || !*filename) return NULL;
+
+    if (!textures) {
+        textures = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, texture_unref);
+    }
+
+    char *path = g_canonicalize_filename(filename, NULL);
+    GdkTexture *texture = NULL;
+    gboolean cached = g_hash_table_lookup_extended(textures, path, NULL, (gpointer *)&texture);
+    metrics_cache_lookup(METRICS_CACHE_TEXTURE, cached);
+    if (cached) {
+        g_free(path);
+        return texture;
+    }
+
+    GError *error = NULL;
+    texture = gdk_texture_new_from_filename(path, &error);
+    if (!texture) {
+        g_warning("Failed to load image '%s': %s", path, error->message);
+        g_clear_error(&error);
+    }
+
+    /* Failures are cached too, so every window warns only once */
+    g_hash_table_insert(textures, path, texture);
+    return texture;
+}
+
+/* ── Styles ──────────────────────────────────────────────── */
+
+StyleManager* resource_cache_acquire_styles(gconstpointer key, gboolean *created) {
+    if (!styles) {
+        styles = g_hash_table_new_full(g_direct_hash, g_direct_equal, NULL, shared_styles_free);
+    }
+
+    SharedStyles *shared = g_hash_table_lookup(styles, key);
+    *created = shared == NULL;
+    metrics_cache_lookup(METRICS_CACHE_STYLES, !*created);
+
+    if (!shared) {
+        shared = g_new0(SharedStyles, 1);
+        shared->styles = style_manager_new();
+
+        char *scope = g_strdup_printf("styles-%u", ++styles_serial);
+        style_manager_set_scope(shared->styles, scope);
+        g_free(scope);
+
+        g_hash_table_insert(styles, (gpointer)key, shared);
+    }
+
+    shared->refs++;
+    return shared->styles;
+}
+
+void resource_cache_release_styles(gconstpointer key) {
+    if (!styles) return;
+
+    SharedStyles *shared = g_hash_table_lookup(styles, key);
+    if (shared && --shared->refs == 0) {
+        g_hash_table_remove(styles, key);
+    }
+}
+
+/* ── Statistics ──────────────────────────────────────────── */
+
+static gsize texture_bytes(GdkTexture *texture) {
+    return texture ? (gsize)gdk_texture_get_width(texture) * gdk_texture_get_height(texture) * 4 : 0;
+}
+
+void resource_cache_get_stats(ResourceCacheStats *stats) {
+    memset(stats, 0, sizeof(*stats));
+    GHashTableIter iter;
+    gpointer value;
+
+    g_mutex_lock(&layouts_lock);
+    stats->layouts = layouts ? g_hash_table_size(layouts) : 0;
+    g_mutex_unlock(&layouts_lock);
+
+    if (textures) {
+        g_hash_table_iter_init(&iter, textures);
+        while (g_hash_table_iter_next(&iter, NULL, &value)) {
+            if (!value) continue;
+            stats->textures++;
+            stats->texture_bytes += texture_bytes(value);
+        }
+    }
+
+    if (styles) {
+        g_hash_table_iter_init(&iter, styles);
+        while (g_hash_table_iter_next(&iter, NULL, &value)) {
+            SharedStyles *shared = (SharedStyles *)value;
+            stats->style_sets++;
+            stats->css_bytes += shared->styles->css_buffer->len;
+        }
+    }
+}
+
+void resource_cache_foreach_layout(GHFunc func, gpointer user_data) {
+    g_mutex_lock(&layouts_lock);
+    if (layouts) g_hash_table_foreach(layouts, func, user_data);
+    g_mutex_unlock(&layouts_lock);
+}
+
+GdkTexture* resource_cache_peek_texture(const char *filename) {
+    if (!textures || !filename || !*filename) return NULL;
+
+    char *path = g_canonicalize_filename(filename, NULL);
+    GdkTexture *texture = g_hash_table_lookup(textures, path);
+    g_free(path);
+    return texture;
+}
+
+void resource_cache_clear(void) {
+    g_clear_pointer(&styles, g_hash_table_destroy);
+    g_clear_pointer(&textures, g_hash_table_destroy);
+
+    resource_cache_free_retired_layouts();
+    g_mutex_lock(&layouts_lock);
+    g_clear_pointer(&layouts, g_hash_table_destroy);
+    g_mutex_unlock(&layouts_lock);
+}
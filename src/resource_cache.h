@@ -0,0 +1,50 @@
+#ifndef RESOURCE_CACHE_H
+#define RESOURCE_CACHE_H
+
+#include <gtk/gtk.h>
+#include "json_parser.h"
+#include "style_manager.h"
+
+/*
+ * Process-wide resources shared by every dashboard window.
+ *
+ * Layout files are parsed once per path (again after an in-process layout
+ * swap, which retires them), image files are decoded into one
+ * GdkTexture per path, and each distinct layout or scene gets one CSS
+ * provider no matter how many windows show it. Everything except the
+ * layout cache must be used from the main thread.
+ */
+
+/* Thread-safe. The returned config is owned by the cache. */
+LayoutConfig* resource_cache_load_layout(const char *filename, GError **error);
+/* Later loads parse their files again, so edits on disk are picked up;
+ * configs loaded so far stay valid until free_retired_layouts() */
+void resource_cache_retire_layouts(void);
+void resource_cache_free_retired_layouts(void);
+
+/* Borrowed texture for an image file, NULL if it cannot be loaded */
+GdkTexture* resource_cache_get_texture(const char *filename);
+
+/* Reference-counted, display-wide styles for key. When *created is TRUE
+ * the caller fills and applies them. Selectors are scoped: name the
+ * container the styles are meant for after manager->scope. */
+StyleManager* resource_cache_acquire_styles(gconstpointer key, gboolean *created);
+void resource_cache_release_styles(gconstpointer key);
+
+typedef struct {
+    guint layouts;
+    guint textures;
+    gsize texture_bytes;     /* Decoded pixels, 4 bytes each */
+    guint style_sets;
+    gsize css_bytes;
+} ResourceCacheStats;
+
+void resource_cache_get_stats(ResourceCacheStats *stats);
+/* func receives (const char *path, LayoutConfig *config, user_data) */
+void resource_cache_foreach_layout(GHFunc func, gpointer user_data);
+/* Cached texture for an image file without loading it, or NULL */
+GdkTexture* resource_cache_peek_texture(const char *filename);
+
+void resource_cache_clear(void);
+
+#endif /* RESOURCE_CACHE_H */
@@ -0,0 +1,206 @@
+#include "scale_bin.h"
+
+/* A resize is considered settled after this long without size changes */
+#define SETTLE_TIMEOUT_MS 150
+
+struct _ScaleBin {
+    GtkWidget parent_instance;
+
+    GtkWidget *child;
+    int design_width;
+    int design_height;
+
+    /* Current fit */
+    double scale;
+    double offset_x;
+    double offset_y;
+
+    /* Fit the child was last rendered at */
+    double settled_scale;
+    double settled_x;
+    double settled_y;
+    GskRenderNode *last_node;     /* Child's last live frame */
+    GdkTexture *resize_texture;   /* last_node rasterized, shown while resizing */
+    graphene_rect_t texture_rect; /* Texture area in design coordinates */
+    gboolean resizing;
+    guint settle_source;
+};
+
+G_DEFINE_TYPE(ScaleBin, scale_bin, GTK_TYPE_WIDGET)
+
+/* ── Resize settling ─────────────────────────────────────── */
+
+/* Cached child nodes would keep images rasterized for the old fit */
+static void queue_draw_all(GtkWidget *widget) {
+    gtk_widget_queue_draw(widget);
+    for (GtkWidget *child = gtk_widget_get_first_child(widget); child != NULL;
+         child = gtk_widget_get_next_sibling(child)) {
+        queue_draw_all(child);
+    }
+}
+
+static gboolean on_settled(gpointer user_data) {
+    ScaleBin *bin = SCALE_BIN(user_data);
+    gboolean rescaled = bin->settled_scale != bin->scale;
+
+    bin->settle_source = 0;
+    bin->resizing = FALSE;
+    bin->settled_scale = bin->scale;
+    bin->settled_x = bin->offset_x;
+    bin->settled_y = bin->offset_y;
+    g_clear_object(&bin->resize_texture);
+
+    /* Render the child again at its final scale */
+    if (rescaled) {
+        queue_draw_all(GTK_WIDGET(bin));
+    } else {
+        gtk_widget_queue_draw(GTK_WIDGET(bin));
+    }
+    return G_SOURCE_REMOVE;
+}
+
+/* Rasterize the child's last frame once, at the scale it was drawn at */
+static void capture_resize_texture(ScaleBin *bin) {
+    if (bin->resize_texture || !bin->last_node) return;
+
+    GtkNative *native = gtk_widget_get_native(GTK_WIDGET(bin));
+    GskRenderer *renderer = native ? gtk_native_get_renderer(native) : NULL;
+    if (!renderer) return;
+
+    graphene_rect_t bounds;
+    gsk_render_node_get_bounds(bin->last_node, &bounds);
+    bin->resize_texture = gsk_renderer_render_texture(renderer, bin->last_node, &bounds);
+
+    /* Remember the area in design coordinates, independent of the fit */
+    bin->texture_rect = GRAPHENE_RECT_INIT(
+        (bounds.origin.x - bin->settled_x) / bin->settled_scale,
+        (bounds.origin.y - bin->settled_y) / bin->settled_scale,
+        bounds.size.width / bin->settled_scale,
+        bounds.size.height / bin->settled_scale);
+}
+
+/* ── GtkWidget ───────────────────────────────────────────── */
+
+static void scale_bin_measure(GtkWidget *widget, GtkOrientation orientation, int for_size,
+                              int *minimum, int *natural,
+                              int *minimum_baseline, int *natural_baseline) {
+    ScaleBin *bin = SCALE_BIN(widget);
+
+    /* Any size works: the child is scaled, never squeezed */
+    *minimum = 1;
+    *natural = orientation == GTK_ORIENTATION_HORIZONTAL ? bin->design_width
+                                                         : bin->design_height;
+}
+
+static void scale_bin_size_allocate(GtkWidget *widget, int width, int height, int baseline) {
+    ScaleBin *bin = SCALE_BIN(widget);
+    if (!bin->child) return;
+
+    double scale = MIN((double)width / bin->design_width, (double)height / bin->design_height);
+    bin->offset_x = (width - bin->design_width * scale) / 2.0;
+    bin->offset_y = (height - bin->design_height * scale) / 2.0;
+
+    if (bin->settled_scale == 0) {
+        bin->settled_scale = scale;
+        bin->settled_x = bin->offset_x;
+        bin->settled_y = bin->offset_y;
+    } else if (scale != bin->scale) {
+        /* Size is changing: freeze the content until it settles */
+        bin->resizing = TRUE;
+        if (bin->settle_source) g_source_remove(bin->settle_source);
+        bin->settle_source = g_timeout_add(SETTLE_TIMEOUT_MS, on_settled, bin);
+    }
+    bin->scale = scale;
+
+    /* The child keeps its design size, so only this transform changes
+     * and none of its children are allocated again */
+    GskTransform *transform = gsk_transform_translate(NULL,
+        &GRAPHENE_POINT_INIT(bin->offset_x, bin->offset_y));
+    transform = gsk_transform_scale(transform, scale, scale);
+    gtk_widget_allocate(bin->child, bin->design_width, bin->design_height, -1, transform);
+}
+
+static void scale_bin_snapshot(GtkWidget *widget, GtkSnapshot *snapshot) {
+    ScaleBin *bin = SCALE_BIN(widget);
+    if (!bin->child) return;
+
+    if (bin->resizing) {
+        capture_resize_texture(bin);
+    }
+
+    if (bin->resizing && bin->resize_texture) {
+        /* Stretch the frozen frame over the new fit */
+        const graphene_rect_t *r = &bin->texture_rect;
+        gtk_snapshot_append_texture(snapshot, bin->resize_texture,
+            &GRAPHENE_RECT_INIT(bin->offset_x + r->origin.x * bin->scale,
+                                bin->offset_y + r->origin.y * bin->scale,
+                                r->size.width * bin->scale,
+                                r->size.height * bin->scale));
+        return;
+    }
+
+    /* Live frame: keep the child's node so a resize can freeze it */
+    GtkSnapshot *child_snapshot = gtk_snapshot_new();
+    gtk_widget_snapshot_child(widget, bin->child, child_snapshot);
+    g_clear_pointer(&bin->last_node, gsk_render_node_unref);
+    bin->last_node = gtk_snapshot_free_to_node(child_snapshot);
+
+    if (bin->last_node) {
+        gtk_snapshot_append_node(snapshot, bin->last_node);
+    }
+}
+
+/* ── GObject ─────────────────────────────────────────────── */
+
+static void scale_bin_dispose(GObject *object) {
+    ScaleBin *bin = SCALE_BIN(object);
+
+    if (bin->settle_source) {
+        g_source_remove(bin->settle_source);
+        bin->settle_source = 0;
+    }
+    g_clear_pointer(&bin->last_node, gsk_render_node_unref);
+    g_clear_object(&bin->resize_texture);
+    g_clear_pointer(&bin->child, gtk_widget_unparent);
+
+    G_OBJECT_CLASS(scale_bin_parent_class)->dispose(object);
+}
+
+static void scale_bin_class_init(ScaleBinClass *klass) {
+    GObjectClass *object_class = G_OBJECT_CLASS(klass);
+    GtkWidgetClass *widget_class = GTK_WIDGET_CLASS(klass);
+
+    object_class->dispose = scale_bin_dispose;
+    widget_class->measure = scale_bin_measure;
+    widget_class->size_allocate = scale_bin_size_allocate;
+    widget_class->snapshot = scale_bin_snapshot;
+}
+
+static void scale_bin_init(ScaleBin *bin) {
+    gtk_widget_set_overflow(GTK_WIDGET(bin), GTK_OVERFLOW_HIDDEN);
+}
+
+GtkWidget* scale_bin_new(GtkWidget *child, int design_width, int design_height) {
+    ScaleBin *bin = g_object_new(SCALE_TYPE_BIN, NULL);
+
+    bin->design_width = MAX(1, design_width);
+    bin->design_height = MAX(1, design_height);
+    bin->child = child;
+    gtk_widget_set_parent(child, GTK_WIDGET(bin));
+
+    return GTK_WIDGET(bin);
+}
+
+double scale_bin_get_scale(ScaleBin *bin) {
+    return bin->scale;
+}
+
+double scale_bin_get_raster_scale(GtkWidget *widget) {
+    double scale = gtk_widget_get_scale_factor(widget);
+    GtkWidget *ancestor = gtk_widget_get_ancestor(widget, SCALE_TYPE_BIN);
+
+    if (ancestor && SCALE_BIN(ancestor)->settled_scale > 0) {
+        scale *= SCALE_BIN(ancestor)->settled_scale;
+    }
+    return scale;
+}
@@ -0,0 +1,29 @@
+#ifndef SCALE_BIN_H
+#define SCALE_BIN_H
+
+#include <gtk/gtk.h>
+
+/*
+ * Scale-to-fit container for layouts authored in absolute pixels.
+ *
+ * The child is always allocated at the design size and drawn through a
+ * single scale transform that fits it into the available space, keeping
+ * the aspect ratio (letterboxed). A live resize therefore never re-lays
+ * out the children: while the size keeps changing the last frame is shown
+ * as a stretched texture, and once it settles the child is rendered again
+ * at the new scale so text and shapes are rasterized crisply.
+ */
+
+#define SCALE_TYPE_BIN (scale_bin_get_type())
+G_DECLARE_FINAL_TYPE(ScaleBin, scale_bin, SCALE, BIN, GtkWidget)
+
+GtkWidget* scale_bin_new(GtkWidget *child, int design_width, int design_height);
+double scale_bin_get_scale(ScaleBin *bin);
+
+/* Device pixels per unit of widget's own coordinates: the GTK scale
+ * factor times the settled fit of the ScaleBin it is in, if any. Widgets
+ * caching rasterized images size them with this; a settled resize
+ * redraws every descendant so they pick up the new fit. */
+double scale_bin_get_raster_scale(GtkWidget *widget);
+
+#endif /* SCALE_BIN_H */
@@ -0,0 +1,353 @@
+#include "scene_manager.h"
+#include "app.h"
+#include "profiler.h"
+#include "style_manager.h"
+#include "resource_cache.h"
+#include <string.h>
+
+/* Used for scenes whose build did not move the heap counter */
+#define SCENE_COST_PER_WIDGET (16 * 1024)
+
+typedef enum {
+    SCENE_UNLOADED,   /* External file not parsed yet */
+    SCENE_LOADING,    /* Parsing on a worker thread */
+    SCENE_PARSED,     /* Config available, no widgets */
+    SCENE_BUILT,      /* Page is in the stack */
+    SCENE_FAILED      /* External file could not be loaded */
+} SceneState;
+
+typedef struct {
+    SceneManager *manager;
+    SceneConfig *config;     /* Borrowed from the layout */
+    LayoutConfig *loaded;    /* Parsed external file, owned by the resource cache */
+    SceneState state;
+    guint index;
+    GtkWidget *page;
+    StyleManager *styles;    /* Shared with other windows showing this scene */
+    gint64 cost_bytes;       /* Heap cost of the last build */
+    gint64 last_used;
+} Scene;
+
+struct _SceneManager {
+    LayoutConfig *layout;
+    GtkWidget *stack;
+    GPtrArray *scenes;       /* Scene*, in layout order */
+    Scene *current;
+    Scene *pending;          /* Requested while still loading */
+    GCancellable *cancellable;
+    gint64 budget_bytes;     /* 0 = unlimited */
+    guint rotate_source;
+    guint preload_source;
+};
+
+static void scene_manager_set_current(SceneManager *manager, Scene *scene);
+static void schedule_preload(SceneManager *manager);
+
+static void scene_free(gpointer data) {
+    Scene *scene = (Scene *)data;
+    if (scene->styles) resource_cache_release_styles(scene->config);
+    g_free(scene);
+}
+
+static GList* scene_widgets(Scene *scene) {
+    return scene->loaded ? scene->loaded->widgets : scene->config->widgets;
+}
+
+static const char* scene_background(Scene *scene) {
+    return scene->loaded ? scene->loaded->window.background_color
+                         : scene->config->background_color;
+}
+
+static gint64 built_bytes(SceneManager *manager) {
+    gint64 total = 0;
+    for (guint i = 0; i < manager->scenes->len; i++) {
+        Scene *scene = g_ptr_array_index(manager->scenes, i);
+        if (scene->state == SCENE_BUILT) total += scene->cost_bytes;
+    }
+    return total;
+}
+
+/* ── Background parsing ──────────────────────────────────── */
+
+static void load_scene_thread(GTask *task, gpointer source_object,
+                              gpointer task_data, GCancellable *cancellable) {
+    const char *file = (const char *)task_data;
+    GError *error = NULL;
+
+    LayoutConfig *config = resource_cache_load_layout(file, &error);
+    if (config) {
+        g_task_return_pointer(task, config, NULL);
+    } else {
+        g_task_return_error(task, error);
+    }
+}
+
+static void on_scene_loaded(GObject *source_object, GAsyncResult *result, gpointer user_data) {
+    GError *error = NULL;
+    LayoutConfig *config = g_task_propagate_pointer(G_TASK(result), &error);
+
+    /* Manager is gone: user_data must not be touched */
+    if (g_error_matches(error, G_IO_ERROR, G_IO_ERROR_CANCELLED)) {
+        g_error_free(error);
+        return;
+    }
+
+    Scene *scene = (Scene *)user_data;
+    SceneManager *manager = scene->manager;
+
+    if (!config) {
+        g_warning("Failed to load scene '%s' from '%s': %s",
+                  scene->config->id, scene->config->file, error->message);
+        g_error_free(error);
+        scene->state = SCENE_FAILED;
+        if (manager->pending == scene) manager->pending = NULL;
+        return;
+    }
+
+    scene->loaded = config;
+    scene->state = SCENE_PARSED;
+
+    if (manager->pending == scene) {
+        manager->pending = NULL;
+        scene_manager_set_current(manager, scene);
+    } else {
+        schedule_preload(manager);
+    }
+}
+
+static void start_loading(SceneManager *manager, Scene *scene) {
+    if (scene->state != SCENE_UNLOADED) return;
+
+    scene->state = SCENE_LOADING;
+    GTask *task = g_task_new(NULL, manager->cancellable, on_scene_loaded, scene);
+    g_task_set_task_data(task, g_strdup(scene->config->file), g_free);
+    g_task_run_in_thread(task, load_scene_thread);
+    g_object_unref(task);
+}
+
+/* ── Build / evict ───────────────────────────────────────── */
+
+static void build_scene(SceneManager *manager, Scene *scene) {
+    if (scene->state != SCENE_PARSED) return;
+
+    gint64 heap_before = profiler_heap_in_use();
+    gboolean created;
+
+    scene->styles = resource_cache_acquire_styles(scene->config, &created);
+    if (created) {
+        if (scene_background(scene)) {
+            style_manager_add_window_style(scene->styles, scene_background(scene));
+        }
+        dashboard_collect_styles(scene_widgets(scene), scene->styles);
+        style_manager_apply(scene->styles);
+    }
+
+    scene->page = dashboard_build_widgets(scene_widgets(scene), NULL);
+    gtk_widget_set_name(scene->page, scene->styles->scope);
+    gtk_stack_add_named(GTK_STACK(manager->stack), scene->page, scene->config->id);
+
+    scene->cost_bytes = profiler_heap_in_use() - heap_before;
+    if (scene->cost_bytes <= 0) {
+        scene->cost_bytes = (gint64)g_list_length(scene_widgets(scene)) * SCENE_COST_PER_WIDGET;
+    }
+    scene->state = SCENE_BUILT;
+}
+
+static void evict_scene(SceneManager *manager, Scene *scene) {
+    if (scene->state != SCENE_BUILT) return;
+
+    gtk_stack_remove(GTK_STACK(manager->stack), scene->page);
+    scene->page = NULL;
+
+    resource_cache_release_styles(scene->config);
+    scene->styles = NULL;
+
+    scene->state = SCENE_PARSED;
+}
+
+/* Evict least recently used scenes until the budget is met */
+static void enforce_budget(SceneManager *manager) {
+    if (manager->budget_bytes <= 0) return;
+
+    while (built_bytes(manager) > manager->budget_bytes) {
+        Scene *victim = NULL;
+        for (guint i = 0; i < manager->scenes->len; i++) {
+            Scene *scene = g_ptr_array_index(manager->scenes, i);
+            if (scene->state != SCENE_BUILT || scene == manager->current) continue;
+            if (!victim || scene->last_used < victim->last_used) victim = scene;
+        }
+        if (!victim) break;
+        evict_scene(manager, victim);
+    }
+}
+
+/* ── Preloading ──────────────────────────────────────────── */
+
+/* Next unbuilt scene in rotation order after the current one */
+static Scene* next_to_preload(SceneManager *manager) {
+    guint n = manager->scenes->len;
+    guint start = manager->current ? manager->current->index : 0;
+
+    for (guint step = 1; step <= n; step++) {
+        Scene *scene = g_ptr_array_index(manager->scenes, (start + step) % n);
+        if (scene->state == SCENE_PARSED) return scene;
+    }
+    return NULL;
+}
+
+/* Builds one scene per idle callback while the budget allows it */
+static gboolean preload_idle(gpointer user_data) {
+    SceneManager *manager = (SceneManager *)user_data;
+
+    Scene *scene = next_to_preload(manager);
+    if (!scene) {
+        manager->preload_source = 0;
+        return G_SOURCE_REMOVE;
+    }
+
+    if (manager->budget_bytes > 0) {
+        gint64 estimate = scene->cost_bytes > 0 ? scene->cost_bytes
+            : (gint64)g_list_length(scene_widgets(scene)) * SCENE_COST_PER_WIDGET;
+        if (built_bytes(manager) + estimate > manager->budget_bytes) {
+            manager->preload_source = 0;
+            return G_SOURCE_REMOVE;
+        }
+    }
+
+    build_scene(manager, scene);
+    return G_SOURCE_CONTINUE;
+}
+
+static void schedule_preload(SceneManager *manager) {
+    if (manager->preload_source) return;
+    manager->preload_source = g_idle_add_full(G_PRIORITY_LOW, preload_idle, manager, NULL);
+}
+
+/* ── Switching ───────────────────────────────────────────── */
+
+static void scene_manager_set_current(SceneManager *manager, Scene *scene) {
+    if (scene->state == SCENE_UNLOADED || scene->state == SCENE_LOADING) {
+        /* Keep showing the current scene until the file is parsed */
+        manager->pending = scene;
+        start_loading(manager, scene);
+        return;
+    }
+    if (scene->state == SCENE_FAILED) return;
+
+    build_scene(manager, scene);
+    gtk_stack_set_visible_child(GTK_STACK(manager->stack), scene->page);
+
+    manager->current = scene;
+    manager->pending = NULL;
+    scene->last_used = g_get_monotonic_time();
+
+    enforce_budget(manager);
+    schedule_preload(manager);
+}
+
+static Scene* find_scene(SceneManager *manager, const char *scene_id) {
+    for (guint i = 0; i < manager->scenes->len; i++) {
+        Scene *scene = g_ptr_array_index(manager->scenes, i);
+        if (strcmp(scene->config->id, scene_id) == 0) return scene;
+    }
+    return NULL;
+}
+
+gboolean scene_manager_show(SceneManager *manager, const char *scene_id) {
+    if (!manager || !scene_id) return FALSE;
+
+    Scene *scene = find_scene(manager, scene_id);
+    if (!scene) {
+        g_warning("Unknown scene '%s'", scene_id);
+        return FALSE;
+    }
+    scene_manager_set_current(manager, scene);
+    return TRUE;
+}
+
+static void step_scene(SceneManager *manager, int direction) {
+    guint n = manager->scenes->len;
+    if (n == 0) return;
+
+    /* Step from the scene being waited for, so repeated presses advance */
+    Scene *from = manager->pending ? manager->pending : manager->current;
+    guint index = from ? from->index : 0;
+
+    /* Skip scenes whose file failed to load */
+    for (guint step = 1; step <= n; step++) {
+        Scene *scene = g_ptr_array_index(manager->scenes, (index + n + direction * (int)step) % n);
+        if (scene->state != SCENE_FAILED) {
+            scene_manager_set_current(manager, scene);
+            return;
+        }
+    }
+}
+
+void scene_manager_next(SceneManager *manager) {
+    if (manager) step_scene(manager, 1);
+}
+
+void scene_manager_previous(SceneManager *manager) {
+    if (manager) step_scene(manager, -1);
+}
+
+static gboolean on_rotate(gpointer user_data) {
+    scene_manager_next((SceneManager *)user_data);
+    return G_SOURCE_CONTINUE;
+}
+
+/* ── Lifecycle ───────────────────────────────────────────── */
+
+SceneManager* scene_manager_new(LayoutConfig *layout) {
+    SceneManager *manager = g_new0(SceneManager, 1);
+    manager->layout = layout;
+    manager->cancellable = g_cancellable_new();
+    manager->scenes = g_ptr_array_new_with_free_func(scene_free);
+    manager->budget_bytes = (gint64)layout->scene_budget_mb * 1024 * 1024;
+
+    manager->stack = g_object_ref_sink(gtk_stack_new());
+    gtk_stack_set_transition_type(GTK_STACK(manager->stack), GTK_STACK_TRANSITION_TYPE_NONE);
+
+    guint index = 0;
+    for (GList *l = layout->scenes; l != NULL; l = l->next, index++) {
+        Scene *scene = g_new0(Scene, 1);
+        scene->manager = manager;
+        scene->config = (SceneConfig *)l->data;
+        scene->index = index;
+        scene->state = scene->config->file ? SCENE_UNLOADED : SCENE_PARSED;
+        g_ptr_array_add(manager->scenes, scene);
+    }
+
+    /* Parse every external scene in the background right away */
+    for (guint i = 0; i < manager->scenes->len; i++) {
+        start_loading(manager, g_ptr_array_index(manager->scenes, i));
+    }
+
+    if (manager->scenes->len > 0) {
+        scene_manager_set_current(manager, g_ptr_array_index(manager->scenes, 0));
+    }
+
+    if (layout->scene_interval > 0) {
+        manager->rotate_source = g_timeout_add_seconds(layout->scene_interval, on_rotate, manager);
+    }
+
+    return manager;
+}
+
+GtkWidget* scene_manager_get_widget(SceneManager *manager) {
+    return manager->stack;
+}
+
+void scene_manager_free(SceneManager *manager) {
+    if (!manager) return;
+
+    g_cancellable_cancel(manager->cancellable);
+    g_object_unref(manager->cancellable);
+
+    if (manager->rotate_source) g_source_remove(manager->rotate_source);
+    if (manager->preload_source) g_source_remove(manager->preload_source);
+
+    g_ptr_array_free(manager->scenes, TRUE);
+    g_object_unref(manager->stack);
+    g_free(manager);
+}
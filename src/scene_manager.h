@@ -0,0 +1,29 @@
+#ifndef SCENE_MANAGER_H
+#define SCENE_MANAGER_H
+
+#include <gtk/gtk.h>
+#include "json_parser.h"
+
+/*
+ * Multi-scene dashboards.
+ *
+ * Every scene of a layout becomes a page of a GtkStack. External scene
+ * files are parsed on worker threads, scenes are built ahead of time in
+ * idle callbacks and stay built (unmapped) so switching is instant. Built
+ * scenes beyond the layout's memory budget are evicted least recently
+ * used first and rebuilt from their parsed config on demand.
+ */
+
+typedef struct _SceneManager SceneManager;
+
+/* layout must outlive the manager */
+SceneManager* scene_manager_new(LayoutConfig *layout);
+void scene_manager_free(SceneManager *manager);
+
+GtkWidget* scene_manager_get_widget(SceneManager *manager);
+
+gboolean scene_manager_show(SceneManager *manager, const char *scene_id);
+void scene_manager_next(SceneManager *manager);
+void scene_manager_previous(SceneManager *manager);
+
+#endif /* SCENE_MANAGER_H */
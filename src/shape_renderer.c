@@ -1,4 +1,8 @@
 #include "shape_renderer.h"
+#include "frame_hud.h"
+#include "metrics.h"
+#include "poly_path.h"
+#include "tracer.h"
 #include <string.h>
 #include <math.h>
 
@@ -8,17 +12,27 @@
 
 /* Shape data stored as user_data on each GtkDrawingArea */
 typedef struct {
+    char *id;
     char *type;
     int width;
     int height;
     JsonObject *props;
+    gboolean own_props;        /* Copied from the WidgetConfig on the first set_prop */
+    GtkDrawingAreaDrawFunc draw;
+    const char *trace_detail;  /* Interned id (or type) for trace events */
+    GdkTexture *shadow;        /* Shared shadow for shadow_scale */
+    double shadow_scale;       /* 0 once a prop change may have changed it */
+    PolyPath *poly;            /* Polyline, Polygon: parsed "points" */
 } ShapeData;
 
 static void shape_data_free(gpointer data) {
     ShapeData *sd = (ShapeData *)data;
     if (!sd) return;
+    g_free(sd->id);
     g_free(sd->type);
     if (sd->props) json_object_unref(sd->props);
+    g_clear_object(&sd->shadow);
+    poly_path_free(sd->poly);
     g_free(sd);
 }
 
@@ -56,6 +70,58 @@ static int get_int_prop_s(JsonObject *props, const char *key, int def) {
     return (int)json_node_get_int(node);
 }
 
+/* ── Gradients ───────────────────────────────────────────── */
+
+/* "fill_gradient": { "type": "linear" | "radial", "angle": degrees (linear,
+ * CSS convention: 180 = top to bottom), "stops": [ { "offset", "color" } ] } */
+static gboolean has_gradient(JsonObject *props) {
+    return props && json_object_has_member(props, "fill_gradient") &&
+           JSON_NODE_HOLDS_OBJECT(json_object_get_member(props, "fill_gradient"));
+}
+
+static cairo_pattern_t* create_gradient(JsonObject *props, int w, int h) {
+    JsonObject *gradient = json_object_get_object_member(props, "fill_gradient");
+    const char *type = get_str_prop(gradient, "type", "linear");
+    double cx = w / 2.0, cy = h / 2.0;
+    cairo_pattern_t *pattern;
+
+    if (strcmp(type, "radial") == 0) {
+        pattern = cairo_pattern_create_radial(cx, cy, 0, cx, cy, fmax(w, h) / 2.0);
+    } else {
+        /* Gradient line through the centre, long enough to reach the corners */
+        double angle = get_dbl_prop(gradient, "angle", 180.0) * M_PI / 180.0;
+        double dx = sin(angle), dy = -cos(angle);
+        double half = (fabs(w * dx) + fabs(h * dy)) / 2.0;
+        pattern = cairo_pattern_create_linear(cx - dx * half, cy - dy * half,
+                                              cx + dx * half, cy + dy * half);
+    }
+
+    if (json_object_has_member(gradient, "stops")) {
+        JsonArray *stops = json_object_get_array_member(gradient, "stops");
+        guint n = json_array_get_length(stops);
+        for (guint i = 0; i < n; i++) {
+            JsonObject *stop = json_array_get_object_element(stops, i);
+            double offset = get_dbl_prop(stop, "offset", n > 1 ? (double)i / (n - 1) : 0.0);
+            double r = 0, g = 0, b = 0;
+            int opaque = parse_color(get_str_prop(stop, "color", "transparent"), &r, &g, &b);
+            cairo_pattern_add_color_stop_rgba(pattern, offset, r, g, b, opaque ? 1.0 : 0.0);
+        }
+    }
+    return pattern;
+}
+
+/* Fill source: the gradient if there is one, else the fill colour */
+static void set_fill_source(cairo_t *cr, JsonObject *props, int w, int h,
+                            double r, double g, double b) {
+    if (!has_gradient(props)) {
+        cairo_set_source_rgb(cr, r, g, b);
+        return;
+    }
+    cairo_pattern_t *pattern = create_gradient(props, w, h);
+    cairo_set_source(cr, pattern);
+    cairo_pattern_destroy(pattern);
+}
+
 /* ── Line ────────────────────────────────────────────────── */
 static void draw_line(GtkDrawingArea *area, cairo_t *cr, int w, int h, gpointer user_data) {
     ShapeData *sd = (ShapeData *)user_data;
@@ -95,8 +161,8 @@ static void draw_rect(GtkDrawingArea *area, cairo_t *cr, int w, int h, gpointer
     double stroke_width = get_dbl_prop(sd->props, "stroke_width", 2.0);
     double border_radius = get_dbl_prop(sd->props, "border_radius", 0.0);
 
-    double fr, fg, fb, sr, sg, sb;
-    int has_fill = parse_color(fill_color, &fr, &fg, &fb);
+    double fr = 0, fg = 0, fb = 0, sr, sg, sb;
+    int has_fill = parse_color(fill_color, &fr, &fg, &fb) || has_gradient(sd->props);
     int has_stroke = parse_color(stroke_color, &sr, &sg, &sb);
 
     double offset = stroke_width / 2.0;
@@ -116,7 +182,7 @@ static void draw_rect(GtkDrawingArea *area, cairo_t *cr, int w, int h, gpointer
     }
 
     if (has_fill) {
-        cairo_set_source_rgb(cr, fr, fg, fb);
+        set_fill_source(cr, sd->props, w, h, fr, fg, fb);
         if (has_stroke) {
             cairo_fill_preserve(cr);
         } else {
@@ -138,8 +204,8 @@ static void draw_ellipse(GtkDrawingArea *area, cairo_t *cr, int w, int h, gpoint
     const char *stroke_color = get_str_prop(sd->props, "stroke_color", "#ECEFF4");
     double stroke_width = get_dbl_prop(sd->props, "stroke_width", 2.0);
 
-    double fr, fg, fb, sr, sg, sb;
-    int has_fill = parse_color(fill_color, &fr, &fg, &fb);
+    double fr = 0, fg = 0, fb = 0, sr, sg, sb;
+    int has_fill = parse_color(fill_color, &fr, &fg, &fb) || has_gradient(sd->props);
     int has_stroke = parse_color(stroke_color, &sr, &sg, &sb);
 
     double cx = w / 2.0;
@@ -154,7 +220,7 @@ static void draw_ellipse(GtkDrawingArea *area, cairo_t *cr, int w, int h, gpoint
     cairo_restore(cr);
 
     if (has_fill) {
-        cairo_set_source_rgb(cr, fr, fg, fb);
+        set_fill_source(cr, sd->props, w, h, fr, fg, fb);
         if (has_stroke) {
             cairo_fill_preserve(cr);
         } else {
@@ -177,8 +243,8 @@ static void draw_triangle(GtkDrawingArea *area, cairo_t *cr, int w, int h, gpoin
     double stroke_width = get_dbl_prop(sd->props, "stroke_width", 2.0);
     const char *direction = get_str_prop(sd->props, "direction", "up");
 
-    double fr, fg, fb, sr, sg, sb;
-    int has_fill = parse_color(fill_color, &fr, &fg, &fb);
+    double fr = 0, fg = 0, fb = 0, sr, sg, sb;
+    int has_fill = parse_color(fill_color, &fr, &fg, &fb) || has_gradient(sd->props);
     int has_stroke = parse_color(stroke_color, &sr, &sg, &sb);
 
     double px[3], py[3];
@@ -210,7 +276,7 @@ static void draw_triangle(GtkDrawingArea *area, cairo_t *cr, int w, int h, gpoin
     cairo_close_path(cr);
 
     if (has_fill) {
-        cairo_set_source_rgb(cr, fr, fg, fb);
+        set_fill_source(cr, sd->props, w, h, fr, fg, fb);
         if (has_stroke) cairo_fill_preserve(cr); else cairo_fill(cr);
     }
     if (has_stroke && stroke_width > 0) {
@@ -227,8 +293,8 @@ static void draw_diamond(GtkDrawingArea *area, cairo_t *cr, int w, int h, gpoint
     const char *stroke_color = get_str_prop(sd->props, "stroke_color", "#ECEFF4");
     double stroke_width = get_dbl_prop(sd->props, "stroke_width", 2.0);
 
-    double fr, fg, fb, sr, sg, sb;
-    int has_fill = parse_color(fill_color, &fr, &fg, &fb);
+    double fr = 0, fg = 0, fb = 0, sr, sg, sb;
+    int has_fill = parse_color(fill_color, &fr, &fg, &fb) || has_gradient(sd->props);
     int has_stroke = parse_color(stroke_color, &sr, &sg, &sb);
 
     cairo_move_to(cr, w / 2.0, 0);
@@ -238,7 +304,7 @@ static void draw_diamond(GtkDrawingArea *area, cairo_t *cr, int w, int h, gpoint
     cairo_close_path(cr);
 
     if (has_fill) {
-        cairo_set_source_rgb(cr, fr, fg, fb);
+        set_fill_source(cr, sd->props, w, h, fr, fg, fb);
         if (has_stroke) cairo_fill_preserve(cr); else cairo_fill(cr);
     }
     if (has_stroke && stroke_width > 0) {
@@ -306,8 +372,8 @@ static void draw_star(GtkDrawingArea *area, cairo_t *cr, int w, int h, gpointer
     if (points < 3) points = 3;
     if (points > 20) points = 20;
 
-    double fr, fg, fb, sr, sg, sb;
-    int has_fill = parse_color(fill_color, &fr, &fg, &fb);
+    double fr = 0, fg = 0, fb = 0, sr, sg, sb;
+    int has_fill = parse_color(fill_color, &fr, &fg, &fb) || has_gradient(sd->props);
     int has_stroke = parse_color(stroke_color, &sr, &sg, &sb);
 
     double cx = w / 2.0;
@@ -331,7 +397,7 @@ static void draw_star(GtkDrawingArea *area, cairo_t *cr, int w, int h, gpointer
     cairo_close_path(cr);
 
     if (has_fill) {
-        cairo_set_source_rgb(cr, fr, fg, fb);
+        set_fill_source(cr, sd->props, w, h, fr, fg, fb);
         if (has_stroke) cairo_fill_preserve(cr); else cairo_fill(cr);
     }
     if (has_stroke && stroke_width > 0) {
@@ -341,17 +407,531 @@ static void draw_star(GtkDrawingArea *area, cairo_t *cr, int w, int h, gpointer
     }
 }
 
+/* ── Polyline / Polygon ──────────────────────────────────── */
+
+static gboolean is_poly_type(const char *type) {
+    return type && (strcmp(type, "Polyline") == 0 || strcmp(type, "Polygon") == 0);
+}
+
+/* "points" mapped from "viewbox" [x, y, w, h], by default the shape's own
+ * width x height, to the drawn size */
+static PolyPath* create_poly_path(JsonObject *props, int width, int height, GError **error) {
+    JsonNode *points = props ? json_object_get_member(props, "points") : NULL;
+    PolyPath *path = poly_path_new_from_json(points, error);
+    if (!path) return NULL;
+
+    double box[4] = { 0, 0, width, height };
+    JsonNode *node = props ? json_object_get_member(props, "viewbox") : NULL;
+    if (node && JSON_NODE_HOLDS_ARRAY(node) &&
+        json_array_get_length(json_node_get_array(node)) == 4) {
+        for (guint i = 0; i < 4; i++) {
+            box[i] = json_array_get_double_element(json_node_get_array(node), i);
+        }
+    }
+    poly_path_set_view_box(path, box[0], box[1], box[2], box[3]);
+    return path;
+}
+
+/* Packed points plus the simplified copy, for the memory report */
+static gsize poly_data_size(JsonObject *props) {
+    JsonNode *node = props ? json_object_get_member(props, "points") : NULL;
+    if (!node || !JSON_NODE_HOLDS_ARRAY(node)) return 0;
+
+    JsonArray *array = json_node_get_array(node);
+    guint length = json_array_get_length(array);
+    gboolean pairs = length > 0 && JSON_NODE_HOLDS_ARRAY(json_array_get_element(array, 0));
+    return (pairs ? length : length / 2) * 2 * sizeof(float) * 2;
+}
+
+static cairo_line_join_t get_line_join(JsonObject *props) {
+    const char *join = get_str_prop(props, "line_join", "round");
+    if (strcmp(join, "miter") == 0) return CAIRO_LINE_JOIN_MITER;
+    if (strcmp(join, "bevel") == 0) return CAIRO_LINE_JOIN_BEVEL;
+    return CAIRO_LINE_JOIN_ROUND;
+}
+
+static void draw_poly(ShapeData *sd, cairo_t *cr, int w, int h, gboolean closed) {
+    if (!sd->poly) return;
+
+    const char *fill_color = closed ? get_str_prop(sd->props, "fill_color", "transparent")
+                                    : "transparent";
+    const char *stroke_color = get_str_prop(sd->props, "stroke_color", "#ECEFF4");
+    double stroke_width = get_dbl_prop(sd->props, "stroke_width", 2.0);
+    /* Device pixels a simplified path may deviate from the points */
+    double tolerance = fmax(get_dbl_prop(sd->props, "simplify", 0.5), 0.0);
+
+    double fr = 0, fg = 0, fb = 0, sr, sg, sb;
+    int has_fill = closed && (parse_color(fill_color, &fr, &fg, &fb) || has_gradient(sd->props));
+    int has_stroke = parse_color(stroke_color, &sr, &sg, &sb);
+
+    poly_path_append(sd->poly, cr, w, h, tolerance, closed);
+
+    if (has_fill) {
+        set_fill_source(cr, sd->props, w, h, fr, fg, fb);
+        if (has_stroke) cairo_fill_preserve(cr); else cairo_fill(cr);
+    }
+    if (has_stroke && stroke_width > 0) {
+        cairo_set_source_rgb(cr, sr, sg, sb);
+        cairo_set_line_width(cr, stroke_width);
+        cairo_set_line_join(cr, get_line_join(sd->props));
+        cairo_set_line_cap(cr, closed ? CAIRO_LINE_CAP_BUTT : CAIRO_LINE_CAP_ROUND);
+        cairo_stroke(cr);
+    }
+    cairo_new_path(cr);
+}
+
+static void draw_polyline(GtkDrawingArea *area, cairo_t *cr, int w, int h, gpointer user_data) {
+    draw_poly((ShapeData *)user_data, cr, w, h, FALSE);
+}
+
+static void draw_polygon(GtkDrawingArea *area, cairo_t *cr, int w, int h, gpointer user_data) {
+    draw_poly((ShapeData *)user_data, cr, w, h, TRUE);
+}
+
+/* ── Type table ──────────────────────────────────────────── */
+
+/* Read by every shape: gradient fill and drop shadow */
+static const PropSpec common_props[] = {
+    PROP_SPEC("fill_gradient", OBJECT),
+    PROP_SPEC("shadow_color", HEX_COLOR),
+    PROP_SPEC_RANGE("shadow_opacity", NUMBER, 0.0, 1.0),
+    PROP_SPEC_RANGE("shadow_blur", NUMBER, 0.0, G_MAXDOUBLE),
+    PROP_SPEC("shadow_dx", NUMBER),
+    PROP_SPEC("shadow_dy", NUMBER),
+    PROP_SPEC_END
+};
+
+#define STROKE_PROPS \
+    PROP_SPEC("stroke_color", HEX_COLOR), \
+    PROP_SPEC_RANGE("stroke_width", NUMBER, 0.0, G_MAXDOUBLE)
+
+static const PropSpec line_props[] = {
+    STROKE_PROPS,
+    PROP_SPEC_CHOICE("direction", "horizontal|vertical|diagonal-se|diagonal-ne"),
+    PROP_SPEC_END
+};
+
+static const PropSpec rect_props[] = {
+    PROP_SPEC("fill_color", HEX_COLOR),
+    STROKE_PROPS,
+    PROP_SPEC_RANGE("border_radius", NUMBER, 0.0, G_MAXDOUBLE),
+    PROP_SPEC_END
+};
+
+/* Ellipse and Diamond */
+static const PropSpec filled_props[] = {
+    PROP_SPEC("fill_color", HEX_COLOR),
+    STROKE_PROPS,
+    PROP_SPEC_END
+};
+
+static const PropSpec triangle_props[] = {
+    PROP_SPEC("fill_color", HEX_COLOR),
+    STROKE_PROPS,
+    PROP_SPEC_CHOICE("direction", "up|down|left|right"),
+    PROP_SPEC_END
+};
+
+static const PropSpec arrow_props[] = {
+    STROKE_PROPS,
+    PROP_SPEC_CHOICE("direction", "right|left|up|down"),
+    PROP_SPEC_END
+};
+
+static const PropSpec star_props[] = {
+    PROP_SPEC("fill_color", HEX_COLOR),
+    STROKE_PROPS,
+    PROP_SPEC_RANGE("points", INTEGER, 3, 20),
+    PROP_SPEC_END
+};
+
+#define POLY_PROPS \
+    PROP_SPEC("points", POINTS), \
+    PROP_SPEC("viewbox", ARRAY), \
+    STROKE_PROPS, \
+    PROP_SPEC_CHOICE("line_join", "round|miter|bevel"), \
+    PROP_SPEC_RANGE("simplify", NUMBER, 0.0, G_MAXDOUBLE)
+
+static const PropSpec polyline_props[] = {
+    POLY_PROPS,
+    PROP_SPEC_END
+};
+
+static const PropSpec polygon_props[] = {
+    POLY_PROPS,
+    PROP_SPEC("fill_color", HEX_COLOR),
+    PROP_SPEC_END
+};
+
+typedef struct {
+    const char *name;
+    GtkDrawingAreaDrawFunc draw;
+    const PropSpec *props;
+} ShapeType;
+
+static const ShapeType shape_types[] = {
+    { "Line",     draw_line,     line_props },
+    { "Rect",     draw_rect,     rect_props },
+    { "Ellipse",  draw_ellipse,  filled_props },
+    { "Triangle", draw_triangle, triangle_props },
+    { "Diamond",  draw_diamond,  filled_props },
+    { "Arrow",    draw_arrow,    arrow_props },
+    { "Star",     draw_star,     star_props },
+    { "Polyline", draw_polyline, polyline_props },
+    { "Polygon",  draw_polygon,  polygon_props },
+};
+
+static const ShapeType* lookup_shape_type(const char *type) {
+    if (!type) return NULL;
+    for (guint i = 0; i < G_N_ELEMENTS(shape_types); i++) {
+        if (strcmp(type, shape_types[i].name) == 0) return &shape_types[i];
+    }
+    return NULL;
+}
+
+static GtkDrawingAreaDrawFunc lookup_draw_func(const char *type) {
+    const ShapeType *shape_type = lookup_shape_type(type);
+    return shape_type ? shape_type->draw : NULL;
+}
+
+/* ── Draw dispatch ───────────────────────────────────────── */
+
+/* Common draw callback: traced, and timed while the HUD is shown */
+static void draw_shape(GtkDrawingArea *area, cairo_t *cr, int w, int h, gpointer user_data) {
+    ShapeData *sd = (ShapeData *)user_data;
+
+    tracer_begin("shape_draw", sd->trace_detail);
+    metrics_count(METRICS_SHAPE_DRAWS);
+    if (!frame_hud_is_collecting()) {
+        sd->draw(area, cr, w, h, sd);
+        tracer_end("shape_draw");
+        return;
+    }
+
+    gint64 start = g_get_monotonic_time();
+    sd->draw(area, cr, w, h, sd);
+    frame_hud_record_shape_draw(sd->id ? sd->id : sd->type, g_get_monotonic_time() - start);
+    tracer_end("shape_draw");
+}
+
+/* ── Drop shadows ────────────────────────────────────────── */
+
+/* Three box blurs approximate a Gaussian */
+#define SHADOW_BOX_PASSES 3
+
+/* key -> GdkTexture*, shared by shapes casting the same shadow. The table
+ * holds no reference: an entry goes away with the texture when the last
+ * shape using it drops it. */
+static GHashTable *shadow_cache = NULL;
+
+static gboolean has_shadow(JsonObject *props) {
+    return props && json_object_has_member(props, "shadow_color");
+}
+
+/* Box blur of n samples step apart, zero outside; tmp holds n bytes */
+static void blur_line(guint8 *line, int n, int step, int radius, guint8 *tmp) {
+    int window = 2 * radius + 1;
+    int sum = 0;
+
+    for (int i = 0; i < n; i++) tmp[i] = line[i * step];
+    for (int i = 0; i <= radius && i < n; i++) sum += tmp[i];
+
+    for (int x = 0; x < n; x++) {
+        line[x * step] = (guint8)(sum / window);
+        if (x + radius + 1 < n) sum += tmp[x + radius + 1];
+        if (x - radius >= 0) sum -= tmp[x - radius];
+    }
+}
+
+static void blur_alpha(guint8 *data, int width, int height, int stride, int radius) {
+    guint8 *tmp = g_malloc(MAX(width, height));
+    for (int pass = 0; pass < SHADOW_BOX_PASSES; pass++) {
+        for (int y = 0; y < height; y++) blur_line(data + y * stride, width, 1, radius, tmp);
+        for (int x = 0; x < width; x++) blur_line(data + x, height, stride, radius, tmp);
+    }
+    g_free(tmp);
+}
+
+/* Logical pixels the blur can spread past the shape */
+static int shadow_padding(JsonObject *props) {
+    return (int)ceil(fmax(get_dbl_prop(props, "shadow_blur", 8.0), 0.0)) + 1;
+}
+
+static void append_gradient_alpha(GString *key, JsonObject *gradient) {
+    g_string_append_printf(key, "|gradient=%s,%g", get_str_prop(gradient, "type", "linear"),
+                           get_dbl_prop(gradient, "angle", 180.0));
+    if (!json_object_has_member(gradient, "stops")) return;
+
+    double r, g, b;
+    JsonArray *stops = json_object_get_array_member(gradient, "stops");
+    guint n = json_array_get_length(stops);
+    for (guint i = 0; i < n; i++) {
+        JsonObject *stop = json_array_get_object_element(stops, i);
+        g_string_append_printf(key, ",%g:%d",
+                               get_dbl_prop(stop, "offset", n > 1 ? (double)i / (n - 1) : 0.0),
+                               parse_color(get_str_prop(stop, "color", "transparent"), &r, &g, &b));
+    }
+}
+
+static void append_shadow_props(GString *key, JsonObject *props, const PropSpec *specs) {
+    double r, g, b;
+    for (const PropSpec *spec = specs; spec && spec->name; spec++) {
+        JsonNode *node = json_object_get_member(props, spec->name);
+        if (!node) continue;
+        /* The offset only moves the image */
+        if (strcmp(spec->name, "shadow_dx") == 0 || strcmp(spec->name, "shadow_dy") == 0) continue;
+
+        if (spec->kind == PROP_KIND_HEX_COLOR && strcmp(spec->name, "shadow_color") != 0) {
+            /* Only the shape's alpha is drawn: a colour counts as opaque or not */
+            g_string_append_printf(key, "|%s=%d", spec->name,
+                                   parse_color(get_str_prop(props, spec->name, NULL), &r, &g, &b));
+        } else if (strcmp(spec->name, "fill_gradient") == 0) {
+            if (JSON_NODE_HOLDS_OBJECT(node)) append_gradient_alpha(key, json_node_get_object(node));
+        } else {
+            char *value = json_to_string(node, FALSE);
+            g_string_append_printf(key, "|%s=%s", spec->name, value);
+            g_free(value);
+        }
+    }
+}
+
+/* Everything the shadow image depends on: the shape's geometry and alpha,
+ * the blur and the shadow colour. Fill and stroke colours don't change it. */
+static char* shadow_key(ShapeData *sd, double scale) {
+    GString *key = g_string_new(NULL);
+    g_string_append_printf(key, "%s|%dx%d@%g", sd->type, sd->width, sd->height, scale);
+
+    const ShapeType *shape_type = lookup_shape_type(sd->type);
+    append_shadow_props(key, sd->props, shape_type ? shape_type->props : NULL);
+    append_shadow_props(key, sd->props, common_props);
+    return g_string_free(key, FALSE);
+}
+
+static void on_shadow_finalized(gpointer key, GObject *where_the_object_was) {
+    if (shadow_cache) g_hash_table_remove(shadow_cache, key);
+}
+
+/* Alpha of the shape drawn once, blurred and tinted */
+static GdkTexture* render_shadow(ShapeData *sd, double scale) {
+    int pad = shadow_padding(sd->props);
+    int width = (int)ceil((sd->width + 2 * pad) * scale);
+    int height = (int)ceil((sd->height + 2 * pad) * scale);
+
+    cairo_surface_t *mask = cairo_image_surface_create(CAIRO_FORMAT_A8, width, height);
+    cairo_t *cr = cairo_create(mask);
+    cairo_scale(cr, scale, scale);
+    cairo_translate(cr, pad, pad);
+    sd->draw(NULL, cr, sd->width, sd->height, sd);
+    cairo_destroy(cr);
+    cairo_surface_flush(mask);
+
+    guint8 *alpha = cairo_image_surface_get_data(mask);
+    int stride = cairo_image_surface_get_stride(mask);
+    double blur = fmax(get_dbl_prop(sd->props, "shadow_blur", 8.0), 0.0);
+    int radius = (int)round(blur * scale / SHADOW_BOX_PASSES);
+    if (radius > 0) blur_alpha(alpha, width, height, stride, radius);
+
+    double r = 0, g = 0, b = 0;
+    parse_color(get_str_prop(sd->props, "shadow_color", "#000000"), &r, &g, &b);
+    double opacity = CLAMP(get_dbl_prop(sd->props, "shadow_opacity", 0.5), 0.0, 1.0);
+
+    /* Premultiplied ARGB, the layout of GDK_MEMORY_DEFAULT */
+    guint32 *pixels = g_new(guint32, (gsize)width * height);
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            guint a = (guint)(alpha[y * stride + x] * opacity + 0.5);
+            pixels[y * width + x] = (a << 24) | ((guint)(r * a + 0.5) << 16) |
+                                    ((guint)(g * a + 0.5) << 8) | (guint)(b * a + 0.5);
+        }
+    }
+    cairo_surface_destroy(mask);
+
+    GBytes *bytes = g_bytes_new_take(pixels, (gsize)width * height * 4);
+    GdkTexture *texture = gdk_memory_texture_new(width, height, GDK_MEMORY_DEFAULT,
+                                                 bytes, (gsize)width * 4);
+    g_bytes_unref(bytes);
+    return texture;
+}
+
 /* ── Public API ──────────────────────────────────────────── */
 
 gboolean is_shape_type(const char *type) {
-    if (!type) return FALSE;
-    return (strcmp(type, "Line") == 0 ||
-            strcmp(type, "Rect") == 0 ||
-            strcmp(type, "Ellipse") == 0 ||
-            strcmp(type, "Triangle") == 0 ||
-            strcmp(type, "Diamond") == 0 ||
-            strcmp(type, "Arrow") == 0 ||
-            strcmp(type, "Star") == 0);
+    return lookup_draw_func(type) != NULL;
+}
+
+const char* const* shape_renderer_type_names(void) {
+    static const char *names[G_N_ELEMENTS(shape_types) + 1];
+    if (!names[0]) {
+        for (guint i = 0; i < G_N_ELEMENTS(shape_types); i++) {
+            names[i] = shape_types[i].name;
+        }
+    }
+    return names;
+}
+
+const PropSpec* shape_renderer_get_props(const char *type) {
+    const ShapeType *shape_type = lookup_shape_type(type);
+    return shape_type ? shape_type->props : NULL;
+}
+
+const PropSpec* shape_renderer_get_common_props(void) {
+    return common_props;
+}
+
+gboolean shape_renderer_draw(const WidgetConfig *config, cairo_t *cr, int width, int height) {
+    if (!config) return FALSE;
+
+    GtkDrawingAreaDrawFunc draw_func = lookup_draw_func(config->type);
+    if (!draw_func) return FALSE;
+
+    ShapeData sd = {
+        .id = config->id,
+        .type = config->type,
+        .width = width,
+        .height = height,
+        .props = config->props,
+        .draw = draw_func
+    };
+    if (is_poly_type(config->type)) {
+        sd.poly = create_poly_path(config->props, config->width, config->height, NULL);
+    }
+    draw_func(NULL, cr, width, height, &sd);
+    poly_path_free(sd.poly);
+    return TRUE;
+}
+
+gsize shape_renderer_data_size(const WidgetConfig *config) {
+    if (!config || !is_shape_type(config->type)) return 0;
+
+    /* props are shared with the config by reference, not copied */
+    return sizeof(ShapeData)
+        + (config->id ? strlen(config->id) + 1 : 0)
+        + strlen(config->type) + 1
+        + (is_poly_type(config->type) ? poly_data_size(config->props) : 0);
+}
+
+gboolean shape_renderer_has_shadow(const WidgetConfig *config) {
+    return config && is_shape_type(config->type) && has_shadow(config->props);
+}
+
+GdkTexture* shape_renderer_get_shadow(GtkWidget *shape, double scale, graphene_rect_t *bounds) {
+    ShapeData *sd = g_object_get_data(G_OBJECT(shape), "shape-data");
+    if (!sd || !has_shadow(sd->props)) return NULL;
+
+    if (!sd->shadow || sd->shadow_scale != scale) {
+        if (!shadow_cache) {
+            shadow_cache = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, NULL);
+        }
+
+        char *key = shadow_key(sd, scale);
+        GdkTexture *texture = g_hash_table_lookup(shadow_cache, key);
+        metrics_cache_lookup(METRICS_CACHE_SHADOW, texture != NULL);
+        if (texture) {
+            g_free(key);
+            g_object_ref(texture);
+        } else {
+            texture = render_shadow(sd, scale);
+            g_hash_table_insert(shadow_cache, key, texture);
+            g_object_weak_ref(G_OBJECT(texture), on_shadow_finalized, key);
+        }
+
+        /* Released after the lookup so an unchanged shadow is found again */
+        if (sd->shadow) g_object_unref(sd->shadow);
+        sd->shadow = texture;
+        sd->shadow_scale = scale;
+    }
+
+    int pad = shadow_padding(sd->props);
+    *bounds = GRAPHENE_RECT_INIT(get_dbl_prop(sd->props, "shadow_dx", 0.0) - pad,
+                                 get_dbl_prop(sd->props, "shadow_dy", 4.0) - pad,
+                                 sd->width + 2 * pad, sd->height + 2 * pad);
+    return sd->shadow;
+}
+
+void shape_renderer_clear_shadows(void) {
+    if (!shadow_cache) return;
+
+    /* Textures still held elsewhere must not reach the freed table */
+    GHashTableIter iter;
+    gpointer key, value;
+    g_hash_table_iter_init(&iter, shadow_cache);
+    while (g_hash_table_iter_next(&iter, &key, &value)) {
+        g_object_weak_unref(G_OBJECT(value), on_shadow_finalized, key);
+    }
+    g_clear_pointer(&shadow_cache, g_hash_table_destroy);
+}
+
+gboolean shape_renderer_get_opaque_rect(const WidgetConfig *config, GdkRectangle *rect) {
+    if (!config || !config->type || strcmp(config->type, "Rect") != 0) return FALSE;
+    /* Bound props can change the fill at any time */
+    if (has_gradient(config->props) || config->bindings) return FALSE;
+
+    /* Only square-cornered rects with an opaque fill cover their box */
+    double r, g, b;
+    const char *fill_color = get_str_prop(config->props, "fill_color", "transparent");
+    if (!parse_color(fill_color, &r, &g, &b)) return FALSE;
+    if (get_dbl_prop(config->props, "border_radius", 0.0) > 0) return FALSE;
+
+    /* The fill is inset by half the stroke; an opaque stroke covers the rest */
+    double stroke_width = get_dbl_prop(config->props, "stroke_width", 2.0);
+    const char *stroke_color = get_str_prop(config->props, "stroke_color", "#ECEFF4");
+    int inset = (stroke_width > 0 && parse_color(stroke_color, &r, &g, &b))
+        ? 0 : (int)ceil(stroke_width / 2.0);
+
+    *rect = (GdkRectangle){ inset, inset, config->width - 2 * inset, config->height - 2 * inset };
+    return rect->width > 0 && rect->height > 0;
+}
+
+void shape_renderer_set_prop(GtkWidget *shape, const char *key, JsonNode *value) {
+    ShapeData *sd = g_object_get_data(G_OBJECT(shape), "shape-data");
+    if (!sd) {
+        json_node_unref(value);
+        return;
+    }
+
+    /* Other windows share the config's props: copy them before the first change */
+    if (!sd->own_props) {
+        JsonObject *props = json_object_new();
+        GList *members = sd->props ? json_object_get_members(sd->props) : NULL;
+        for (GList *l = members; l != NULL; l = l->next) {
+            const char *member = (const char *)l->data;
+            json_object_set_member(props, member,
+                                   json_node_copy(json_object_get_member(sd->props, member)));
+        }
+        g_list_free(members);
+
+        if (sd->props) json_object_unref(sd->props);
+        sd->props = props;
+        sd->own_props = TRUE;
+    }
+
+    json_object_set_member(sd->props, key, value);
+    if (is_poly_type(sd->type) && (strcmp(key, "points") == 0 || strcmp(key, "viewbox") == 0)) {
+        poly_path_free(sd->poly);
+        sd->poly = create_poly_path(sd->props, sd->width, sd->height, NULL);
+    }
+    /* The next get_shadow() looks up the shadow of the new appearance */
+    sd->shadow_scale = 0;
+    gtk_widget_queue_draw(shape);
+}
+
+void shape_renderer_set_size(GtkWidget *shape, int width, int height) {
+    gtk_drawing_area_set_content_width(GTK_DRAWING_AREA(shape), width);
+    gtk_drawing_area_set_content_height(GTK_DRAWING_AREA(shape), height);
+    gtk_widget_set_size_request(shape, width, height);
+
+    ShapeData *sd = g_object_get_data(G_OBJECT(shape), "shape-data");
+    if (!sd || (sd->width == width && sd->height == height)) return;
+
+    sd->width = width;
+    sd->height = height;
+    /* Without a viewbox the points are in widget coordinates */
+    if (is_poly_type(sd->type)) {
+        poly_path_free(sd->poly);
+        sd->poly = create_poly_path(sd->props, width, height, NULL);
+    }
+    sd->shadow_scale = 0;
+    gtk_widget_queue_draw(shape);
 }
 
 GtkWidget* shape_renderer_create(const WidgetConfig *config) {
@@ -364,6 +944,7 @@ GtkWidget* shape_renderer_create(const WidgetConfig *config) {
 
     /* Store shape data */
     ShapeData *sd = g_new0(ShapeData, 1);
+    sd->id = g_strdup(config->id);
     sd->type = g_strdup(config->type);
     sd->width = config->width;
     sd->height = config->height;
@@ -372,26 +953,23 @@ GtkWidget* shape_renderer_create(const WidgetConfig *config) {
     }
 
     /* Select draw function based on type */
-    GtkDrawingAreaDrawFunc draw_func = NULL;
-    if (strcmp(config->type, "Line") == 0) {
-        draw_func = draw_line;
-    } else if (strcmp(config->type, "Rect") == 0) {
-        draw_func = draw_rect;
-    } else if (strcmp(config->type, "Ellipse") == 0) {
-        draw_func = draw_ellipse;
-    } else if (strcmp(config->type, "Triangle") == 0) {
-        draw_func = draw_triangle;
-    } else if (strcmp(config->type, "Diamond") == 0) {
-        draw_func = draw_diamond;
-    } else if (strcmp(config->type, "Arrow") == 0) {
-        draw_func = draw_arrow;
-    } else if (strcmp(config->type, "Star") == 0) {
-        draw_func = draw_star;
+    GtkDrawingAreaDrawFunc draw_func = lookup_draw_func(config->type);
+
+    if (draw_func && is_poly_type(config->type)) {
+        GError *error = NULL;
+        sd->poly = create_poly_path(config->props, config->width, config->height, &error);
+        if (!sd->poly) {
+            g_warning("Shape '%s': %s", config->id ? config->id : config->type, error->message);
+            g_clear_error(&error);
+        }
     }
 
     if (draw_func) {
+        sd->draw = draw_func;
+        sd->trace_detail = g_intern_string(config->id ? config->id : config->type);
+        g_object_set_data(G_OBJECT(drawing_area), "shape-data", sd);
         gtk_drawing_area_set_draw_func(GTK_DRAWING_AREA(drawing_area),
-                                       draw_func, sd, shape_data_free);
+                                       draw_shape, sd, shape_data_free);
     } else {
         shape_data_free(sd);
     }
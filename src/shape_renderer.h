@@ -7,4 +7,40 @@
 gboolean is_shape_type(const char *type);
 GtkWidget* shape_renderer_create(const WidgetConfig *config);
 
+/* NULL-terminated list of supported shape type names */
+const char* const* shape_renderer_type_names(void);
+/* Props a shape type reads besides the common ones, NULL if it is not a
+ * shape type */
+const PropSpec* shape_renderer_get_props(const char *type);
+/* Props every shape reads (gradient fill, drop shadow) */
+const PropSpec* shape_renderer_get_common_props(void);
+
+/* Draw a shape straight into a cairo context (offscreen rendering).
+ * Returns FALSE if the type is not a shape. */
+gboolean shape_renderer_draw(const WidgetConfig *config, cairo_t *cr, int width, int height);
+
+/* Bytes of per-widget draw data a shape widget keeps (memory report) */
+gsize shape_renderer_data_size(const WidgetConfig *config);
+
+/* Area of the shape (in its own coordinates) painted fully opaque.
+ * Returns FALSE if the shape has no such area. */
+gboolean shape_renderer_get_opaque_rect(const WidgetConfig *config, GdkRectangle *rect);
+
+/* Change one prop of a shape made by shape_renderer_create() and redraw
+ * it; value is consumed */
+void shape_renderer_set_prop(GtkWidget *shape, const char *key, JsonNode *value);
+
+/* Resize a shape made by shape_renderer_create(): its size request, its
+ * path and its shadow follow */
+void shape_renderer_set_size(GtkWidget *shape, int width, int height);
+
+/* Drop shadow ("shadow_color" prop). The blurred image is computed once
+ * per shape geometry, blur radius, shadow colour and raster scale (scale
+ * factor times the ScaleBin fit) and shared by every shape casting the same shadow while any of them uses it.
+ * get_shadow() is a DashboardShadowFunc for shapes made by
+ * shape_renderer_create(). clear_shadows() frees the cache at shutdown. */
+gboolean shape_renderer_has_shadow(const WidgetConfig *config);
+GdkTexture* shape_renderer_get_shadow(GtkWidget *shape, double scale, graphene_rect_t *bounds);
+void shape_renderer_clear_shadows(void);
+
 #endif /* SHAPE_RENDERER_H */
@@ -0,0 +1,167 @@
+#include "splash_cache.h"
+#include <glib/gstdio.h>
+#include <string.h>
+
+/* Oldest images beyond this many are deleted after each save */
+#define SPLASH_CACHE_MAX_FILES 32
+
+typedef struct {
+    char *path;
+    GdkTexture *texture;     /* Memory texture, safe to use off the main thread */
+} SaveJob;
+
+typedef struct {
+    char *path;
+    gint64 mtime;
+} CacheEntry;
+
+static void save_job_free(gpointer data) {
+    SaveJob *job = (SaveJob *)data;
+    g_free(job->path);
+    g_object_unref(job->texture);
+    g_free(job);
+}
+
+static gboolean checksum_file(GChecksum *checksum, const char *filename) {
+    char *contents;
+    gsize length;
+
+    if (!g_file_get_contents(filename, &contents, &length, NULL)) return FALSE;
+    g_checksum_update(checksum, (const guchar *)contents, length);
+    g_free(contents);
+    return TRUE;
+}
+
+char* splash_cache_path(const char *layout_file, const char *window_file,
+                        int window_index, int width, int height) {
+    if (!layout_file || width <= 0 || height <= 0) return NULL;
+
+    GChecksum *checksum = g_checksum_new(G_CHECKSUM_SHA256);
+    gboolean ok = checksum_file(checksum, layout_file);
+    if (ok && window_file) ok = checksum_file(checksum, window_file);
+
+    char *path = NULL;
+    if (ok) {
+        char *name = g_strdup_printf("%.16s-%d-%dx%d.png", g_checksum_get_string(checksum),
+                                     window_index, width, height);
+        path = g_build_filename(g_get_user_cache_dir(), "gtk-dashboard", "splash", name, NULL);
+        g_free(name);
+    }
+
+    g_checksum_free(checksum);
+    return path;
+}
+
+GdkTexture* splash_cache_load(const char *path) {
+    if (!path || !g_file_test(path, G_FILE_TEST_IS_REGULAR)) return NULL;
+
+    GError *error = NULL;
+    GdkTexture *texture = gdk_texture_new_from_filename(path, &error);
+    if (!texture) {
+        g_warning("Ignoring splash image '%s': %s", path, error->message);
+        g_error_free(error);
+        g_unlink(path);
+    }
+    return texture;
+}
+
+/* ── Saving ──────────────────────────────────────────────── */
+
+static int compare_entries(gconstpointer a, gconstpointer b) {
+    const CacheEntry *ea = (const CacheEntry *)a;
+    const CacheEntry *eb = (const CacheEntry *)b;
+    return (ea->mtime > eb->mtime) - (ea->mtime < eb->mtime);
+}
+
+/* Keep the most recently written images only */
+static void prune_cache(const char *dir_path) {
+    GDir *dir = g_dir_open(dir_path, 0, NULL);
+    if (!dir) return;
+
+    GArray *entries = g_array_new(FALSE, FALSE, sizeof(CacheEntry));
+    const char *name;
+    while ((name = g_dir_read_name(dir)) != NULL) {
+        if (!g_str_has_suffix(name, ".png")) continue;
+
+        CacheEntry entry = { g_build_filename(dir_path, name, NULL), 0 };
+        GStatBuf st;
+        if (g_stat(entry.path, &st) == 0) entry.mtime = (gint64)st.st_mtime;
+        g_array_append_val(entries, entry);
+    }
+    g_dir_close(dir);
+
+    if (entries->len > SPLASH_CACHE_MAX_FILES) {
+        g_array_sort(entries, compare_entries);
+        for (guint i = 0; i < entries->len - SPLASH_CACHE_MAX_FILES; i++) {
+            g_unlink(g_array_index(entries, CacheEntry, i).path);
+        }
+    }
+
+    for (guint i = 0; i < entries->len; i++) {
+        g_free(g_array_index(entries, CacheEntry, i).path);
+    }
+    g_array_free(entries, TRUE);
+}
+
+static void save_thread(GTask *task, gpointer source_object,
+                        gpointer task_data, GCancellable *cancellable) {
+    SaveJob *job = (SaveJob *)task_data;
+    char *dir = g_path_get_dirname(job->path);
+    GError *error = NULL;
+
+    GBytes *png = gdk_texture_save_to_png_bytes(job->texture);
+    gsize size;
+    const char *data = g_bytes_get_data(png, &size);
+
+    /* g_file_set_contents() replaces the file atomically */
+    if (g_mkdir_with_parents(dir, 0700) != 0) {
+        g_warning("Failed to create splash cache directory '%s'", dir);
+    } else if (!g_file_set_contents(job->path, data, (gssize)size, &error)) {
+        g_warning("Failed to save splash image: %s", error->message);
+        g_error_free(error);
+    } else {
+        prune_cache(dir);
+    }
+
+    g_bytes_unref(png);
+    g_free(dir);
+}
+
+gboolean splash_cache_save(GtkWidget *widget, const char *path) {
+    if (!path || !gtk_widget_get_mapped(widget)) return FALSE;
+
+    int width = gtk_widget_get_width(widget);
+    int height = gtk_widget_get_height(widget);
+    GtkNative *native = gtk_widget_get_native(widget);
+    GskRenderer *renderer = native ? gtk_native_get_renderer(native) : NULL;
+    if (!renderer || width <= 0 || height <= 0) return FALSE;
+
+    GdkPaintable *paintable = gtk_widget_paintable_new(widget);
+    GtkSnapshot *snapshot = gtk_snapshot_new();
+    gdk_paintable_snapshot(paintable, snapshot, width, height);
+    GskRenderNode *node = gtk_snapshot_free_to_node(snapshot);
+    g_object_unref(paintable);
+    if (!node) return FALSE;
+
+    GdkTexture *rendered = gsk_renderer_render_texture(renderer, node,
+                                                       &GRAPHENE_RECT_INIT(0, 0, width, height));
+    gsk_render_node_unref(node);
+
+    /* GL textures are tied to the renderer's context: hand the worker a copy */
+    gsize stride = (gsize)width * 4;
+    guchar *pixels = g_malloc(stride * height);
+    gdk_texture_download(rendered, pixels, stride);
+    g_object_unref(rendered);
+
+    GBytes *bytes = g_bytes_new_take(pixels, stride * height);
+    SaveJob *job = g_new0(SaveJob, 1);
+    job->path = g_strdup(path);
+    job->texture = gdk_memory_texture_new(width, height, GDK_MEMORY_DEFAULT, bytes, stride);
+    g_bytes_unref(bytes);
+
+    GTask *task = g_task_new(NULL, NULL, NULL, NULL);
+    g_task_set_task_data(task, job, save_job_free);
+    g_task_run_in_thread(task, save_thread);
+    g_object_unref(task);
+    return TRUE;
+}
@@ -0,0 +1,27 @@
+#ifndef SPLASH_CACHE_H
+#define SPLASH_CACHE_H
+
+#include <gtk/gtk.h>
+
+/*
+ * Warm-start splash images.
+ *
+ * Once a window's dashboard has been up for a moment it is rendered to a
+ * PNG in the user cache directory, keyed by a hash of the layout file
+ * contents and the window size. The next launch with the same layout and
+ * size shows that image at once while the real widgets are built behind
+ * it. PNG encoding and disk writes run on a worker thread.
+ */
+
+/* Cache file for a window, or NULL when the layout file cannot be read.
+ * window_file is the window's own layout file, if any. */
+char* splash_cache_path(const char *layout_file, const char *window_file,
+                        int window_index, int width, int height);
+
+/* Cached image at path, or NULL if there is none */
+GdkTexture* splash_cache_load(const char *path);
+
+/* Render a mapped widget at its current size and store it at path */
+gboolean splash_cache_save(GtkWidget *widget, const char *path);
+
+#endif /* SPLASH_CACHE_H */
@@ -1,4 +1,5 @@
 #include "style_manager.h"
+#include "tracer.h"
 #include <string.h>
 
 StyleManager* style_manager_new(void) {
@@ -17,14 +18,26 @@ void style_manager_free(StyleManager *manager) {
     if (manager->css_buffer) {
         g_string_free(manager->css_buffer, TRUE);
     }
+    g_free(manager->scope);
     g_free(manager);
 }
 
+void style_manager_set_scope(StyleManager *manager, const char *scope) {
+    if (!manager) return;
+
+    g_free(manager->scope);
+    manager->scope = g_strdup(scope);
+}
+
 void style_manager_add_window_style(StyleManager *manager, const char *background_color) {
     if (!manager || !background_color) return;
 
+    if (manager->scope) {
+        g_string_append_printf(manager->css_buffer, "#%s {\n", manager->scope);
+    } else {
+        g_string_append(manager->css_buffer, "window {\n");
+    }
     g_string_append_printf(manager->css_buffer,
-        "window {\n"
         "  background-color: %s;\n"
         "}\n\n",
         background_color);
@@ -59,11 +72,7 @@ static void append_style_property(GString *css, const char *json_key, const char
     }
 }
 
-void style_manager_add_widget_style(StyleManager *manager, const char *widget_id, JsonObject *style) {
-    if (!manager || !widget_id || !style) return;
-
-    g_string_append_printf(manager->css_buffer, "#%s {\n", widget_id);
-
+static void append_rule_body(GString *css, JsonObject *style) {
     GList *members = json_object_get_members(style);
     for (GList *l = members; l != NULL; l = l->next) {
         const char *key = (const char *)l->data;
@@ -72,18 +81,41 @@ void style_manager_add_widget_style(StyleManager *manager, const char *widget_id
         if (JSON_NODE_HOLDS_VALUE(node)) {
             const char *value = json_node_get_string(node);
             if (value) {
-                append_style_property(manager->css_buffer, key, value);
+                append_style_property(css, key, value);
             }
         }
     }
     g_list_free(members);
 
-    g_string_append(manager->css_buffer, "}\n\n");
+    g_string_append(css, "}\n\n");
+}
+
+void style_manager_add_widget_style(StyleManager *manager, const char *widget_id, JsonObject *style) {
+    if (!manager || !widget_id || !style) return;
+
+    if (manager->scope) {
+        g_string_append_printf(manager->css_buffer, "#%s #%s {\n", manager->scope, widget_id);
+    } else {
+        g_string_append_printf(manager->css_buffer, "#%s {\n", widget_id);
+    }
+    append_rule_body(manager->css_buffer, style);
+}
+
+void style_manager_add_class_style(StyleManager *manager, const char *css_class, JsonObject *style) {
+    if (!manager || !css_class || !style) return;
+
+    if (manager->scope) {
+        g_string_append_printf(manager->css_buffer, "#%s .%s {\n", manager->scope, css_class);
+    } else {
+        g_string_append_printf(manager->css_buffer, ".%s {\n", css_class);
+    }
+    append_rule_body(manager->css_buffer, style);
 }
 
 void style_manager_apply(StyleManager *manager) {
     if (!manager) return;
 
+    tracer_begin("style_apply", NULL);
     gtk_css_provider_load_from_string(manager->provider, manager->css_buffer->str);
 
     gtk_style_context_add_provider_for_display(
@@ -91,4 +123,14 @@ void style_manager_apply(StyleManager *manager) {
         GTK_STYLE_PROVIDER(manager->provider),
         GTK_STYLE_PROVIDER_PRIORITY_APPLICATION
     );
+    tracer_end("style_apply");
+}
+
+void style_manager_unapply(StyleManager *manager) {
+    if (!manager) return;
+
+    gtk_style_context_remove_provider_for_display(
+        gdk_display_get_default(),
+        GTK_STYLE_PROVIDER(manager->provider)
+    );
 }
@@ -7,12 +7,20 @@
 typedef struct {
     GtkCssProvider *provider;
     GString *css_buffer;
+    char *scope;    /* Widget name prefixing every selector, or NULL */
 } StyleManager;
 
 StyleManager* style_manager_new(void);
 void style_manager_free(StyleManager *manager);
 void style_manager_add_widget_style(StyleManager *manager, const char *widget_id, JsonObject *style);
+/* One rule for every widget carrying css_class (shared template styles) */
+void style_manager_add_class_style(StyleManager *manager, const char *css_class, JsonObject *style);
 void style_manager_add_window_style(StyleManager *manager, const char *background_color);
 void style_manager_apply(StyleManager *manager);
+void style_manager_unapply(StyleManager *manager);
+
+/* Restrict rules to descendants of the widget named scope; the window
+ * style then targets that widget instead of the toplevel window. */
+void style_manager_set_scope(StyleManager *manager, const char *scope);
 
 #endif /* STYLE_MANAGER_H */
@@ -0,0 +1,231 @@
+#include "tracer.h"
+#include <glib-unix.h>
+#include <glib/gstdio.h>
+#include <signal.h>
+#include <string.h>
+#include <unistd.h>
+
+#ifdef __linux__
+#include <sys/prctl.h>
+#include <sys/syscall.h>
+#endif
+
+/* Per thread; a power of two */
+#define TRACE_BUFFER_EVENTS 8192
+/* Threads beyond this many live ones are not recorded */
+#define TRACE_MAX_BUFFERS 64
+
+typedef struct {
+    gint64 ts;               /* Monotonic microseconds */
+    const char *name;
+    const char *detail;
+    double value;
+    char phase;              /* 'B', 'E' or 'C' */
+} TraceEvent;
+
+typedef struct {
+    TraceEvent events[TRACE_BUFFER_EVENTS];
+    gint head;               /* Events written (wraps), published atomically */
+    gboolean wrapped;
+    gboolean in_use;         /* Owned by a running thread */
+    int tid;
+    char thread_name[17];
+} TraceBuffer;
+
+static void release_buffer(gpointer data);
+
+static GMutex buffers_lock;
+static TraceBuffer *buffers[TRACE_MAX_BUFFERS];
+static guint n_buffers = 0;
+static GPrivate local_buffer = G_PRIVATE_INIT(release_buffer);
+static char *exit_path = NULL;
+static guint signal_dumps = 0;
+
+/* ── Recording ───────────────────────────────────────────── */
+
+static void release_buffer(gpointer data) {
+    TraceBuffer *buffer = (TraceBuffer *)data;
+
+    /* Kept for dumps until another thread reuses it */
+    g_mutex_lock(&buffers_lock);
+    buffer->in_use = FALSE;
+    g_mutex_unlock(&buffers_lock);
+}
+
+static void identify_thread(TraceBuffer *buffer) {
+#ifdef __linux__
+    buffer->tid = (int)syscall(SYS_gettid);
+    char name[17] = { 0 };
+    if (prctl(PR_GET_NAME, name, 0, 0, 0) == 0) {
+        g_strlcpy(buffer->thread_name, name, sizeof(buffer->thread_name));
+        return;
+    }
+#else
+    static int next_tid = 1;
+    buffer->tid = next_tid++;
+#endif
+    g_snprintf(buffer->thread_name, sizeof(buffer->thread_name), "thread-%d", buffer->tid);
+}
+
+static TraceBuffer* acquire_buffer(void) {
+    TraceBuffer *buffer = NULL;
+
+    g_mutex_lock(&buffers_lock);
+    for (guint i = 0; i < n_buffers && !buffer; i++) {
+        if (!buffers[i]->in_use) buffer = buffers[i];
+    }
+    if (!buffer && n_buffers < TRACE_MAX_BUFFERS) {
+        buffer = g_new0(TraceBuffer, 1);
+        buffers[n_buffers++] = buffer;
+    }
+    if (buffer) {
+        g_atomic_int_set(&buffer->head, 0);
+        buffer->wrapped = FALSE;
+        buffer->in_use = TRUE;
+        identify_thread(buffer);
+    }
+    g_mutex_unlock(&buffers_lock);
+
+    if (buffer) g_private_set(&local_buffer, buffer);
+    return buffer;
+}
+
+static void record(char phase, const char *name, const char *detail, double value) {
+    TraceBuffer *buffer = g_private_get(&local_buffer);
+    if (G_UNLIKELY(!buffer) && !(buffer = acquire_buffer())) return;
+
+    /* Only this thread writes; the dump reads up to the published head */
+    guint head = (guint)buffer->head;
+    TraceEvent *event = &buffer->events[head & (TRACE_BUFFER_EVENTS - 1)];
+    event->ts = g_get_monotonic_time();
+    event->name = name;
+    event->detail = detail;
+    event->value = value;
+    event->phase = phase;
+
+    if (head + 1 == TRACE_BUFFER_EVENTS) buffer->wrapped = TRUE;
+    g_atomic_int_set(&buffer->head, (gint)(head + 1));
+}
+
+void tracer_begin(const char *name, const char *detail) {
+    record('B', name, detail, 0.0);
+}
+
+void tracer_end(const char *name) {
+    record('E', name, NULL, 0.0);
+}
+
+void tracer_counter(const char *name, double value) {
+    record('C', name, NULL, value);
+}
+
+/* ── Export ──────────────────────────────────────────────── */
+
+static void append_json_string(GString *json, const char *str) {
+    g_string_append_c(json, '"');
+    for (const char *p = str; *p; p++) {
+        if (*p == '"' || *p == '\\') {
+            g_string_append_c(json, '\\');
+            g_string_append_c(json, *p);
+        } else if ((guchar)*p < 0x20) {
+            g_string_append_printf(json, "\\u%04x", (guchar)*p);
+        } else {
+            g_string_append_c(json, *p);
+        }
+    }
+    g_string_append_c(json, '"');
+}
+
+static void append_event(GString *json, const TraceEvent *event, int pid, int tid) {
+    char value[G_ASCII_DTOSTR_BUF_SIZE];
+
+    g_string_append(json, ",\n{\"name\":");
+    append_json_string(json, event->name ? event->name : "");
+    g_string_append_printf(json, ",\"cat\":\"dashboard\",\"ph\":\"%c\",\"ts\":%" G_GINT64_FORMAT
+                           ",\"pid\":%d,\"tid\":%d", event->phase, event->ts, pid, tid);
+    if (event->phase == 'C') {
+        g_string_append_printf(json, ",\"args\":{\"value\":%s}",
+                               g_ascii_dtostr(value, sizeof(value), event->value));
+    } else if (event->detail) {
+        g_string_append(json, ",\"args\":{\"detail\":");
+        append_json_string(json, event->detail);
+        g_string_append_c(json, '}');
+    }
+    g_string_append_c(json, '}');
+}
+
+gboolean tracer_dump(const char *path, GError **error) {
+    int pid = (int)getpid();
+    GString *json = g_string_new("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+    g_string_append_printf(json, "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":%d,"
+                           "\"args\":{\"name\":\"gtk-dashboard\"}}", pid);
+
+    /* Buffers are not reused while locked; their owners keep recording,
+     * so the oldest events of a busy thread may be overwritten mid-copy */
+    g_mutex_lock(&buffers_lock);
+    for (guint i = 0; i < n_buffers; i++) {
+        TraceBuffer *buffer = buffers[i];
+        guint head = (guint)g_atomic_int_get(&buffer->head);
+        guint count = buffer->wrapped ? TRACE_BUFFER_EVENTS : head;
+        if (count == 0) continue;
+
+        g_string_append_printf(json, ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":%d,"
+                               "\"tid\":%d,\"args\":{\"name\":", pid, buffer->tid);
+        append_json_string(json, buffer->thread_name);
+        g_string_append(json, "}}");
+
+        for (guint k = head - count; k != head; k++) {
+            append_event(json, &buffer->events[k & (TRACE_BUFFER_EVENTS - 1)], pid, buffer->tid);
+        }
+    }
+    g_mutex_unlock(&buffers_lock);
+
+    g_string_append(json, "\n]}\n");
+    gboolean ok = g_file_set_contents(path, json->str, (gssize)json->len, error);
+    g_string_free(json, TRUE);
+    return ok;
+}
+
+/* SIGUSR1: dump to the --trace path, or a new file in the cache directory */
+static gboolean on_dump_signal(gpointer user_data) {
+    char *path;
+    if (exit_path) {
+        path = g_strdup(exit_path);
+    } else {
+        char *dir = g_build_filename(g_get_user_cache_dir(), "gtk-dashboard", NULL);
+        g_mkdir_with_parents(dir, 0700);
+        char *name = g_strdup_printf("trace-%d-%u.json", (int)getpid(), ++signal_dumps);
+        path = g_build_filename(dir, name, NULL);
+        g_free(name);
+        g_free(dir);
+    }
+
+    GError *error = NULL;
+    if (tracer_dump(path, &error)) {
+        g_printerr("Trace written to %s\n", path);
+    } else {
+        g_warning("Failed to write trace: %s", error->message);
+        g_error_free(error);
+    }
+    g_free(path);
+    return G_SOURCE_CONTINUE;
+}
+
+/* ── Lifecycle ───────────────────────────────────────────── */
+
+void tracer_init(const char *path) {
+    g_free(exit_path);
+    exit_path = g_strdup(path);
+    g_unix_signal_add(SIGUSR1, on_dump_signal, NULL);
+}
+
+void tracer_shutdown(void) {
+    if (!exit_path) return;
+
+    GError *error = NULL;
+    if (!tracer_dump(exit_path, &error)) {
+        g_warning("Failed to write trace: %s", error->message);
+        g_error_free(error);
+    }
+    g_clear_pointer(&exit_path, g_free);
+}
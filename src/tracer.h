@@ -0,0 +1,30 @@
+#ifndef TRACER_H
+#define TRACER_H
+
+#include <glib.h>
+
+/*
+ * Always-on trace recorder.
+ *
+ * Every thread records begin/end/counter events into its own fixed-size
+ * ring buffer, with a monotonic timestamp and without locking, so the
+ * most recent few thousand events per thread are always available. The
+ * buffers are written as Chrome trace-event JSON (chrome://tracing,
+ * Perfetto) on SIGUSR1, and at exit when a path was given with --trace.
+ *
+ * Names and details are stored by pointer: pass string literals or
+ * g_intern_string() results.
+ */
+
+/* exit_path: file written by tracer_shutdown(), or NULL */
+void tracer_init(const char *exit_path);
+void tracer_shutdown(void);
+
+void tracer_begin(const char *name, const char *detail);
+void tracer_end(const char *name);
+void tracer_counter(const char *name, double value);
+
+/* Write every thread's buffer to path */
+gboolean tracer_dump(const char *path, GError **error);
+
+#endif /* TRACER_H */
@@ -0,0 +1,236 @@
+#include "widget_bindings.h"
+#include "binding_graph.h"
+#include "gauge_widget.h"
+#include "shape_renderer.h"
+#include "widget_factory.h"
+#include <math.h>
+#include <string.h>
+
+struct _WidgetBindings {
+    BindingGraph *graph;
+    GtkWidget *canvas;       /* Owner, once attached */
+    LayoutSolver *solver;    /* Moves widgets with bound geometry, or NULL */
+    guint tick_id;           /* Update due on the next frame */
+};
+
+/* One live property a binding reads */
+typedef struct {
+    WidgetBindings *bindings;
+    const WidgetConfig *config;
+    const char *property;
+} Watch;
+
+/* Widget props a binding can set; shapes take any prop */
+static const struct {
+    const char *type;
+    const char *property;
+} writable_properties[] = {
+    { "Button",   "label" },
+    { "Label",    "label" },
+    { "Checkbox", "label" },
+    { "Checkbox", "checked" },
+    { "Switch",   "label" },
+    { "Switch",   "active" },
+    { "Combo",    "active_index" },
+    { "Entry",    "text" },
+    { "Entry",    "placeholder" },
+    { "Slider",   "value" },
+    { "Spin",     "value" },
+    { "Progress", "value" },
+    { "Gauge",    "value" },
+};
+
+static gboolean is_writable(const WidgetConfig *config, const char *property) {
+    if (is_shape_type(config->type) || layout_solver_is_geometry_prop(property)) return TRUE;
+
+    for (guint i = 0; i < G_N_ELEMENTS(writable_properties); i++) {
+        if (strcmp(writable_properties[i].type, config->type) == 0 &&
+            strcmp(writable_properties[i].property, property) == 0) {
+            return TRUE;
+        }
+    }
+    return FALSE;
+}
+
+/* ── Reading and writing ─────────────────────────────────── */
+
+static void read_property(gpointer item, const char *property, ExpressionValue *value,
+                          gpointer user_data) {
+    widget_factory_read_prop(GTK_WIDGET(item), property, value);
+}
+
+/* Shapes store the value as a prop: numbers stay numbers unless formatted */
+static JsonNode* value_to_node(const PropBinding *binding, const ExpressionValue *value) {
+    JsonNode *node = json_node_new(JSON_NODE_VALUE);
+    if (value->type == EXPRESSION_NUMBER && !binding->format) {
+        json_node_set_double(node, value->number);
+    } else {
+        char *text = expression_value_to_string(value, binding->format);
+        json_node_set_string(node, text);
+        g_free(text);
+    }
+    return node;
+}
+
+/* One edge of the widget's rectangle; its dependents follow */
+static void move_widget(WidgetBindings *bindings, const WidgetConfig *config,
+                        const char *property, double value) {
+    static const char * const edges[] = { "x", "y", "width", "height" };
+    int rect[4];
+
+    if (!bindings->solver ||
+        !layout_solver_get_rect(bindings->solver, config, &rect[0], &rect[1], &rect[2], &rect[3])) {
+        return;
+    }
+    for (int i = 0; i < 4; i++) {
+        if (strcmp(property, edges[i]) != 0) continue;
+        /* A size <= 0 would mean "natural size" to the canvas */
+        rect[i] = i < 2 ? (int)round(value) : MAX((int)round(value), 1);
+    }
+    layout_solver_move(bindings->solver, config, rect[0], rect[1], rect[2], rect[3]);
+}
+
+static void write_property(gpointer item, const WidgetConfig *config, const PropBinding *binding,
+                           const ExpressionValue *value, gpointer user_data) {
+    GtkWidget *widget = GTK_WIDGET(item);
+    const char *property = binding->property;
+
+    if (layout_solver_is_geometry_prop(property)) {
+        move_widget((WidgetBindings *)user_data, config, property,
+                    expression_value_to_number(value));
+    } else if (is_shape_type(config->type)) {
+        shape_renderer_set_prop(widget, property, value_to_node(binding, value));
+    } else {
+        widget_factory_write_prop(widget, property, value, binding->format);
+    }
+}
+
+/* ── Change tracking ─────────────────────────────────────── */
+
+static gboolean on_tick(GtkWidget *canvas, GdkFrameClock *frame_clock, gpointer user_data) {
+    WidgetBindings *bindings = (WidgetBindings *)user_data;
+    bindings->tick_id = 0;
+    binding_graph_update(bindings->graph);
+    return G_SOURCE_REMOVE;
+}
+
+static void source_changed(Watch *watch) {
+    WidgetBindings *bindings = watch->bindings;
+    if (!binding_graph_changed(bindings->graph, watch->config, watch->property)) return;
+
+    /* However often sources change, readers are recomputed once per frame */
+    if (bindings->canvas && !bindings->tick_id) {
+        bindings->tick_id = gtk_widget_add_tick_callback(bindings->canvas, on_tick, bindings, NULL);
+    }
+}
+
+static void free_watch(gpointer data, GClosure *closure) {
+    g_free(data);
+}
+
+static void on_source_changed(GObject *object, gpointer user_data) {
+    source_changed((Watch *)user_data);
+}
+
+static void on_source_notify(GObject *object, GParamSpec *pspec, gpointer user_data) {
+    source_changed((Watch *)user_data);
+}
+
+static void watch_property(WidgetBindings *bindings, const WidgetConfig *config,
+                           GtkWidget *widget, const char *property) {
+    if (!binding_graph_reads(bindings->graph, config, property)) return;
+
+    Watch *watch = g_new0(Watch, 1);
+    watch->bindings = bindings;
+    watch->config = config;
+    watch->property = property;
+
+    GtkWidget *sw;
+    if (GTK_IS_RANGE(widget) || GTK_IS_SPIN_BUTTON(widget)) {
+        g_signal_connect_data(widget, "value-changed", G_CALLBACK(on_source_changed), watch,
+                              free_watch, 0);
+    } else if (GTK_IS_PROGRESS_BAR(widget)) {
+        g_signal_connect_data(widget, "notify::fraction", G_CALLBACK(on_source_notify), watch,
+                              free_watch, 0);
+    } else if (GAUGE_IS_WIDGET(widget)) {
+        g_signal_connect_data(widget, "notify::value", G_CALLBACK(on_source_notify), watch,
+                              free_watch, 0);
+    } else if (GTK_IS_CHECK_BUTTON(widget)) {
+        g_signal_connect_data(widget, "toggled", G_CALLBACK(on_source_changed), watch,
+                              free_watch, 0);
+    } else if (GTK_IS_COMBO_BOX(widget) || GTK_IS_EDITABLE(widget)) {
+        g_signal_connect_data(widget, "changed", G_CALLBACK(on_source_changed), watch,
+                              free_watch, 0);
+    } else if ((sw = widget_factory_get_switch(widget))) {
+        g_signal_connect_data(sw, "notify::active", G_CALLBACK(on_source_notify), watch,
+                              free_watch, 0);
+    } else {
+        g_free(watch);
+    }
+}
+
+/* ── Public API ──────────────────────────────────────────── */
+
+static void widget_bindings_free(gpointer data) {
+    WidgetBindings *bindings = (WidgetBindings *)data;
+    binding_graph_free(bindings->graph);
+    g_free(bindings);
+}
+
+WidgetBindings* widget_bindings_new(GList *widgets) {
+    gboolean bound = FALSE;
+    for (GList *l = widgets; l != NULL && !bound; l = l->next) {
+        bound = ((WidgetConfig *)l->data)->bindings != NULL;
+    }
+    if (!bound) return NULL;
+
+    GError *error = NULL;
+    BindingGraph *graph = binding_graph_new(widgets, &error);
+    if (!graph) {
+        g_warning("Prop bindings disabled: %s", error->message);
+        g_error_free(error);
+        return NULL;
+    }
+
+    WidgetBindings *bindings = g_new0(WidgetBindings, 1);
+    bindings->graph = graph;
+    binding_graph_set_funcs(graph, read_property, write_property, bindings);
+    return bindings;
+}
+
+void widget_bindings_add(WidgetBindings *bindings, const WidgetConfig *config, GtkWidget *widget) {
+    g_return_if_fail(bindings != NULL);
+
+    if (!binding_graph_bind(bindings->graph, config, widget)) return;
+
+    for (GList *l = config->bindings; l != NULL; l = l->next) {
+        PropBinding *binding = (PropBinding *)l->data;
+        if (!is_writable(config, binding->property)) {
+            g_warning("Prop '%s' of '%s' (%s) cannot be bound", binding->property,
+                      config->id ? config->id : "(no id)", config->type);
+        }
+    }
+
+    /* Every property a binding can read, for the widget's type */
+    static const char * const live[] = { "value", "checked", "active", "active_index", "text" };
+    for (guint i = 0; i < G_N_ELEMENTS(live); i++) {
+        if (binding_graph_is_live(config->type, live[i])) {
+            watch_property(bindings, config, widget, live[i]);
+        }
+    }
+}
+
+void widget_bindings_set_solver(WidgetBindings *bindings, LayoutSolver *solver) {
+    g_return_if_fail(bindings != NULL);
+    bindings->solver = solver;
+}
+
+void widget_bindings_attach(WidgetBindings *bindings, GtkWidget *canvas) {
+    g_return_if_fail(bindings != NULL);
+
+    bindings->canvas = canvas;
+    g_object_set_data_full(G_OBJECT(canvas), "widget-bindings", bindings, widget_bindings_free);
+
+    /* Initial values, before the first frame */
+    binding_graph_update(bindings->graph);
+}
@@ -0,0 +1,35 @@
+#ifndef WIDGET_BINDINGS_H
+#define WIDGET_BINDINGS_H
+
+#include <gtk/gtk.h>
+#include "json_parser.h"
+#include "layout_solver.h"
+
+/*
+ * Prop bindings of one canvas.
+ *
+ * A BindingGraph over the canvas' WidgetConfig list, connected to the
+ * widgets: the signals of the properties expressions read mark their
+ * readers, and marked bindings are recomputed once per frame on the
+ * canvas' frame clock, then pushed to the bound widgets and shapes.
+ * Nothing is recomputed while the canvas is not shown.
+ */
+
+typedef struct _WidgetBindings WidgetBindings;
+
+/* NULL when no widget of the list has a bound prop */
+WidgetBindings* widget_bindings_new(GList *widgets);
+
+/* Connect the widget made for config */
+void widget_bindings_add(WidgetBindings *bindings, const WidgetConfig *config, GtkWidget *widget);
+
+/* Relative geometry of the canvas, borrowed: bound "x", "y", "width" and
+ * "height" move widgets through it and their dependents follow. Without
+ * a solver they are ignored. */
+void widget_bindings_set_solver(WidgetBindings *bindings, LayoutSolver *solver);
+
+/* Once every widget is added: apply the initial values and keep the
+ * bindings up to date on canvas frames; canvas then owns bindings */
+void widget_bindings_attach(WidgetBindings *bindings, GtkWidget *canvas);
+
+#endif /* WIDGET_BINDINGS_H */
@@ -1,4 +1,8 @@
 #include "widget_factory.h"
+#include "resource_cache.h"
+#include "chart_widget.h"
+#include "gauge_widget.h"
+#include "log_view.h"
 #include <string.h>
 #include <pango/pango.h>
 
@@ -186,6 +190,11 @@ static GtkWidget* create_image(const WidgetConfig *config) {
     const char *alt_text = get_string_prop(config->props, "alt_text", "Image");
 
     if (file_path && strlen(file_path) > 0) {
+        /* Decoded once per file and shared by every window */
+        GdkTexture *texture = resource_cache_get_texture(file_path);
+        if (texture) {
+            return gtk_image_new_from_paintable(GDK_PAINTABLE(texture));
+        }
         GtkWidget *image = gtk_image_new_from_file(file_path);
         return image;
     }
@@ -222,6 +231,287 @@ static GtkWidget* create_separator(const WidgetConfig *config) {
     return gtk_separator_new(orientation);
 }
 
+/* Props every type reads, checked by gtk-dashboard-check */
+static const PropSpec button_props[] = {
+    PROP_SPEC("label", STRING),
+    PROP_SPEC("icon_name", STRING),
+    PROP_SPEC_END
+};
+
+static const PropSpec label_props[] = {
+    PROP_SPEC("label", STRING),
+    PROP_SPEC_RANGE("font_size", INTEGER, 0, G_MAXINT),
+    PROP_SPEC_END
+};
+
+static const PropSpec entry_props[] = {
+    PROP_SPEC("placeholder", STRING),
+    PROP_SPEC("text", STRING),
+    PROP_SPEC_END
+};
+
+static const PropSpec checkbox_props[] = {
+    PROP_SPEC("label", STRING),
+    PROP_SPEC("checked", BOOLEAN),
+    PROP_SPEC_END
+};
+
+static const PropSpec switch_props[] = {
+    PROP_SPEC("label", STRING),
+    PROP_SPEC("active", BOOLEAN),
+    PROP_SPEC_END
+};
+
+static const PropSpec combo_props[] = {
+    PROP_SPEC("items", STRING_LIST),
+    PROP_SPEC_RANGE("active_index", INTEGER, -1, G_MAXINT),
+    PROP_SPEC_END
+};
+
+/* Slider and Spin */
+static const PropSpec range_props[] = {
+    PROP_SPEC("min", NUMBER),
+    PROP_SPEC("max", NUMBER),
+    PROP_SPEC("value", NUMBER),
+    PROP_SPEC_RANGE("step", NUMBER, G_MINDOUBLE, G_MAXDOUBLE),
+    PROP_SPEC_END
+};
+
+static const PropSpec image_props[] = {
+    PROP_SPEC("file_path", STRING),
+    PROP_SPEC("alt_text", STRING),
+    PROP_SPEC_END
+};
+
+static const PropSpec progress_props[] = {
+    PROP_SPEC_RANGE("value", NUMBER, 0.0, 1.0),
+    PROP_SPEC("show_text", BOOLEAN),
+    PROP_SPEC_END
+};
+
+static const PropSpec separator_props[] = {
+    PROP_SPEC_CHOICE("orientation", "horizontal|vertical"),
+    PROP_SPEC_END
+};
+
+static const PropSpec chart_props[] = {
+    PROP_SPEC("feed", STRING),
+    PROP_SPEC_RANGE("capacity", INTEGER, 1, 64 * 1024 * 1024),
+    PROP_SPEC("min", NUMBER),
+    PROP_SPEC("max", NUMBER),
+    PROP_SPEC("color", COLOR),
+    PROP_SPEC("data", ARRAY),
+    PROP_SPEC_END
+};
+
+static const PropSpec gauge_props[] = {
+    PROP_SPEC("value", NUMBER),
+    PROP_SPEC("min", NUMBER),
+    PROP_SPEC("max", NUMBER),
+    PROP_SPEC("feed", STRING),
+    PROP_SPEC("bands", ARRAY),
+    PROP_SPEC_RANGE("ticks", INTEGER, 1, G_MAXINT),
+    PROP_SPEC_RANGE("minor_ticks", INTEGER, 0, G_MAXINT),
+    PROP_SPEC("start_angle", NUMBER),
+    PROP_SPEC("sweep", NUMBER),
+    PROP_SPEC_RANGE("decimals", INTEGER, 0, 6),
+    PROP_SPEC("units", STRING),
+    PROP_SPEC("face_color", COLOR),
+    PROP_SPEC("tick_color", COLOR),
+    PROP_SPEC("needle_color", COLOR),
+    PROP_SPEC_END
+};
+
+static const PropSpec log_view_props[] = {
+    PROP_SPEC("path", STRING),
+    PROP_SPEC("socket", STRING),
+    PROP_SPEC_RANGE("max_lines", INTEGER, 1, 1024 * 1024),
+    PROP_SPEC("from_start", BOOLEAN),
+    PROP_SPEC("filter", STRING),
+    PROP_SPEC("font", STRING),
+    PROP_SPEC("color", COLOR),
+    PROP_SPEC("warn_color", COLOR),
+    PROP_SPEC("error_color", COLOR),
+    PROP_SPEC_END
+};
+
+typedef struct {
+    const char *name;
+    GtkWidget* (*create)(const WidgetConfig *config);
+    const PropSpec *props;
+} WidgetType;
+
+static const WidgetType widget_types[] = {
+    { "Button",    create_button,         button_props },
+    { "Label",     create_label,          label_props },
+    { "Entry",     create_entry,          entry_props },
+    { "Checkbox",  create_check_button,   checkbox_props },
+    { "Switch",    create_switch,         switch_props },
+    { "Combo",     create_combo_box_text, combo_props },
+    { "Slider",    create_scale,          range_props },
+    { "Spin",      create_spin_button,    range_props },
+    { "Image",     create_image,          image_props },
+    { "Progress",  create_progress_bar,   progress_props },
+    { "Separator", create_separator,      separator_props },
+    { "Chart",     chart_widget_new,      chart_props },
+    { "Sparkline", chart_widget_new,      chart_props },
+    { "Gauge",     gauge_widget_new,      gauge_props },
+    { "LogView",   log_view_new,          log_view_props },
+};
+
+static const WidgetType* lookup_widget_type(const char *type) {
+    if (!type) return NULL;
+    for (guint i = 0; i < G_N_ELEMENTS(widget_types); i++) {
+        if (strcmp(type, widget_types[i].name) == 0) return &widget_types[i];
+    }
+    return NULL;
+}
+
+const char* const* widget_factory_type_names(void) {
+    static const char *names[G_N_ELEMENTS(widget_types) + 1];
+    if (!names[0]) {
+        for (guint i = 0; i < G_N_ELEMENTS(widget_types); i++) {
+            names[i] = widget_types[i].name;
+        }
+    }
+    return names;
+}
+
+const PropSpec* widget_factory_get_props(const char *type) {
+    const WidgetType *widget_type = lookup_widget_type(type);
+    return widget_type ? widget_type->props : NULL;
+}
+
+static gboolean is_opaque_hex_color(const char *color) {
+    if (!color || color[0] != '#' || strlen(color) != 7) return FALSE;
+    for (int i = 1; i < 7; i++) {
+        if (!g_ascii_isxdigit(color[i])) return FALSE;
+    }
+    return TRUE;
+}
+
+gboolean widget_factory_get_opaque_rect(const WidgetConfig *config, GdkRectangle *rect) {
+    if (!config || !config->style) return FALSE;
+
+    /* Themes round corners by default, so zero radius must be explicit */
+    const char *radius = get_string_prop(config->style, "border_radius", NULL);
+    if (!radius || g_ascii_strtod(radius, NULL) != 0) return FALSE;
+    if (json_object_has_member(config->style, "margin")) return FALSE;
+    if (!is_opaque_hex_color(get_string_prop(config->style, "background_color", NULL))) return FALSE;
+
+    *rect = (GdkRectangle){ 0, 0, config->width, config->height };
+    return rect->width > 0 && rect->height > 0;
+}
+
+/* A Switch with a label is a box holding the label, then the switch */
+GtkWidget* widget_factory_get_switch(GtkWidget *widget) {
+    if (GTK_IS_SWITCH(widget)) return widget;
+    GtkWidget *last = gtk_widget_get_last_child(widget);
+    return last && GTK_IS_SWITCH(last) ? last : NULL;
+}
+
+gboolean widget_factory_read_prop(GtkWidget *widget, const char *property,
+                                  ExpressionValue *value) {
+    GtkWidget *sw;
+
+    if (strcmp(property, "value") == 0) {
+        if (GTK_IS_RANGE(widget)) {
+            value->number = gtk_range_get_value(GTK_RANGE(widget));
+        } else if (GTK_IS_SPIN_BUTTON(widget)) {
+            value->number = gtk_spin_button_get_value(GTK_SPIN_BUTTON(widget));
+        } else if (GTK_IS_PROGRESS_BAR(widget)) {
+            value->number = gtk_progress_bar_get_fraction(GTK_PROGRESS_BAR(widget));
+        } else if (GAUGE_IS_WIDGET(widget)) {
+            value->number = gauge_widget_get_value(GAUGE_WIDGET(widget));
+        } else {
+            return FALSE;
+        }
+    } else if (strcmp(property, "checked") == 0 && GTK_IS_CHECK_BUTTON(widget)) {
+        value->number = gtk_check_button_get_active(GTK_CHECK_BUTTON(widget));
+    } else if (strcmp(property, "active") == 0 && (sw = widget_factory_get_switch(widget))) {
+        value->number = gtk_switch_get_active(GTK_SWITCH(sw));
+    } else if (strcmp(property, "active_index") == 0 && GTK_IS_COMBO_BOX(widget)) {
+        value->number = gtk_combo_box_get_active(GTK_COMBO_BOX(widget));
+    } else if (strcmp(property, "text") == 0 && GTK_IS_COMBO_BOX_TEXT(widget)) {
+        char *text = gtk_combo_box_text_get_active_text(GTK_COMBO_BOX_TEXT(widget));
+        value->type = EXPRESSION_STRING;
+        value->string = text ? text : g_strdup("");
+    } else if (strcmp(property, "text") == 0 && GTK_IS_EDITABLE(widget)) {
+        value->type = EXPRESSION_STRING;
+        value->string = g_strdup(gtk_editable_get_text(GTK_EDITABLE(widget)));
+    } else {
+        return FALSE;
+    }
+    return TRUE;
+}
+
+static gboolean set_value(GtkWidget *widget, double value) {
+    if (GTK_IS_RANGE(widget)) {
+        gtk_range_set_value(GTK_RANGE(widget), value);
+    } else if (GTK_IS_SPIN_BUTTON(widget)) {
+        gtk_spin_button_set_value(GTK_SPIN_BUTTON(widget), value);
+    } else if (GAUGE_IS_WIDGET(widget)) {
+        gauge_widget_set_value(GAUGE_WIDGET(widget), value);
+    } else if (GTK_IS_PROGRESS_BAR(widget)) {
+        GtkProgressBar *bar = GTK_PROGRESS_BAR(widget);
+        double fraction = CLAMP(value, 0.0, 1.0);
+        gtk_progress_bar_set_fraction(bar, fraction);
+        if (gtk_progress_bar_get_show_text(bar)) {
+            char *text = g_strdup_printf("%.0f%%", fraction * 100.0);
+            gtk_progress_bar_set_text(bar, text);
+            g_free(text);
+        }
+    } else {
+        return FALSE;
+    }
+    return TRUE;
+}
+
+static gboolean set_text(GtkWidget *widget, const char *property, const char *text) {
+    if (strcmp(property, "label") == 0) {
+        if (GTK_IS_LABEL(widget)) {
+            gtk_label_set_text(GTK_LABEL(widget), text);
+        } else if (GTK_IS_CHECK_BUTTON(widget)) {
+            gtk_check_button_set_label(GTK_CHECK_BUTTON(widget), text);
+        } else if (GTK_IS_BUTTON(widget)) {
+            gtk_button_set_label(GTK_BUTTON(widget), text);
+        } else {
+            /* Switch with a label */
+            GtkWidget *label = GTK_IS_SWITCH(widget) ? NULL : gtk_widget_get_first_child(widget);
+            if (!label || !GTK_IS_LABEL(label)) return FALSE;
+            gtk_label_set_text(GTK_LABEL(label), text);
+        }
+    } else if (strcmp(property, "text") == 0 && GTK_IS_EDITABLE(widget)) {
+        gtk_editable_set_text(GTK_EDITABLE(widget), text);
+    } else if (strcmp(property, "placeholder") == 0 && GTK_IS_ENTRY(widget)) {
+        gtk_entry_set_placeholder_text(GTK_ENTRY(widget), text);
+    } else {
+        return FALSE;
+    }
+    return TRUE;
+}
+
+gboolean widget_factory_write_prop(GtkWidget *widget, const char *property,
+                                   const ExpressionValue *value, const char *format) {
+    GtkWidget *sw;
+
+    if (strcmp(property, "value") == 0) {
+        return set_value(widget, expression_value_to_number(value));
+    } else if (strcmp(property, "checked") == 0 && GTK_IS_CHECK_BUTTON(widget)) {
+        gtk_check_button_set_active(GTK_CHECK_BUTTON(widget), expression_value_is_true(value));
+    } else if (strcmp(property, "active") == 0 && (sw = widget_factory_get_switch(widget))) {
+        gtk_switch_set_active(GTK_SWITCH(sw), expression_value_is_true(value));
+    } else if (strcmp(property, "active_index") == 0 && GTK_IS_COMBO_BOX(widget)) {
+        gtk_combo_box_set_active(GTK_COMBO_BOX(widget), (int)expression_value_to_number(value));
+    } else {
+        char *text = expression_value_to_string(value, format);
+        gboolean done = set_text(widget, property, text);
+        g_free(text);
+        return done;
+    }
+    return TRUE;
+}
+
 GtkWidget* widget_factory_create(const WidgetConfig *config, GError **error) {
     if (!config || !config->type) {
         g_set_error(error, G_IO_ERROR, G_IO_ERROR_INVALID_ARGUMENT,
@@ -229,40 +519,22 @@ GtkWidget* widget_factory_create(const WidgetConfig *config, GError **error) {
         return NULL;
     }
 
-    GtkWidget *widget = NULL;
-
-    if (strcmp(config->type, "Button") == 0) {
-        widget = create_button(config);
-    } else if (strcmp(config->type, "Label") == 0) {
-        widget = create_label(config);
-    } else if (strcmp(config->type, "Entry") == 0) {
-        widget = create_entry(config);
-    } else if (strcmp(config->type, "Checkbox") == 0) {
-        widget = create_check_button(config);
-    } else if (strcmp(config->type, "Switch") == 0) {
-        widget = create_switch(config);
-    } else if (strcmp(config->type, "Combo") == 0) {
-        widget = create_combo_box_text(config);
-    } else if (strcmp(config->type, "Slider") == 0) {
-        widget = create_scale(config);
-    } else if (strcmp(config->type, "Spin") == 0) {
-        widget = create_spin_button(config);
-    } else if (strcmp(config->type, "Image") == 0) {
-        widget = create_image(config);
-    } else if (strcmp(config->type, "Progress") == 0) {
-        widget = create_progress_bar(config);
-    } else if (strcmp(config->type, "Separator") == 0) {
-        widget = create_separator(config);
-    } else {
+    const WidgetType *widget_type = lookup_widget_type(config->type);
+    if (!widget_type) {
         g_set_error(error, G_IO_ERROR, G_IO_ERROR_NOT_SUPPORTED,
                     "Unknown widget type: %s", config->type);
         return NULL;
     }
 
+    GtkWidget *widget = widget_type->create(config);
+
     /* Set widget name for CSS styling */
     if (config->id) {
         gtk_widget_set_name(widget, config->id);
     }
+    if (config->style_class) {
+        gtk_widget_add_css_class(widget, config->style_class);
+    }
 
     /* Set size request */
     gtk_widget_set_size_request(widget, config->width, config->height);
@@ -6,4 +6,25 @@
 
 GtkWidget* widget_factory_create(const WidgetConfig *config, GError **error);
 
+/* NULL-terminated list of supported widget type names */
+const char* const* widget_factory_type_names(void);
+/* Props a widget type reads, NULL if it is not a widget type */
+const PropSpec* widget_factory_get_props(const char *type);
+
+/* Area of the widget (in its own coordinates) its CSS paints fully opaque:
+ * an opaque #RRGGBB background with border_radius explicitly 0 and no margin */
+gboolean widget_factory_get_opaque_rect(const WidgetConfig *config, GdkRectangle *rect);
+
+/* The GtkSwitch of a created Switch (with a label it is a box), or NULL */
+GtkWidget* widget_factory_get_switch(GtkWidget *widget);
+/* Current value of a prop of a created widget that changes at run time
+ * ("value", "checked", "active", "active_index", "text"), into a cleared
+ * value. FALSE when the widget has no such prop. */
+gboolean widget_factory_read_prop(GtkWidget *widget, const char *property,
+                                  ExpressionValue *value);
+/* Set a prop of a created widget; text props format numbers with format
+ * (may be NULL). FALSE when the widget has no such settable prop. */
+gboolean widget_factory_write_prop(GtkWidget *widget, const char *property,
+                                   const ExpressionValue *value, const char *format);
+
 #endif /* WIDGET_FACTORY_H */
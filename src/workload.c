@@ -0,0 +1,659 @@
+#include "workload.h"
+#include "data_feed.h"
+#include "frame_stats.h"
+#include "power_policy.h"
+#include "widget_factory.h"
+#include <glib-unix.h>
+#include <gio/gio.h>
+#include <json-glib/json-glib.h>
+#include <errno.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define RECORD_BUFFER_SIZE (64 * 1024)
+#define REPLAY_SETTLE_MS 500               /* Frames drawn after the last event */
+#define LONG_FRAME_FACTOR 2                /* Long frame: over twice the median */
+
+typedef enum {
+    EVENT_FEED,
+    EVENT_KEY,
+    EVENT_MOTION,
+    EVENT_PRESS,
+    EVENT_RELEASE,
+    EVENT_WIDGET
+} EventKind;
+
+/* One recorded event */
+typedef struct {
+    gint64 time;             /* µs from the start */
+    EventKind kind;
+    int window;              /* Index among the open dashboard windows */
+    const char *name;        /* Interned: feed channel or widget id */
+    const char *property;    /* Interned: changed widget property */
+    double value;            /* Feed sample or widget value */
+    char *text;              /* Entry text */
+    double x, y;             /* Pointer position in the window */
+    guint code;              /* Keyval or button */
+    GdkModifierType state;
+} WorkloadEvent;
+
+static GPtrArray *windows = NULL;          /* GtkWidget*, in opening order */
+static gint64 start_time = 0;
+static WorkloadKeyFunc key_func = NULL;
+static gpointer key_data = NULL;
+
+/* Recording */
+static FILE *record_file = NULL;
+static char *record_path = NULL;
+static guint recorded = 0;
+static gboolean in_input = FALSE;          /* An input event is being handled */
+static guint input_idle = 0;
+
+/* Replay */
+static GArray *events = NULL;              /* WorkloadEvent */
+static double replay_speed = 1.0;
+static guint next_event = 0;
+static guint replay_timer = 0;
+static gboolean reported = FALSE;
+static gint64 max_lag = 0;
+static GArray *intervals = NULL;           /* gint64 µs between frames */
+static GArray *paints = NULL;              /* gint64 µs from frame start to painted */
+static GtkWidget *hovered = NULL;
+static GtkWidget *pressed = NULL;
+
+static int window_index(GtkWidget *window) {
+    guint index;
+    if (windows && window && g_ptr_array_find(windows, window, &index)) return (int)index;
+    return -1;
+}
+
+static GtkWidget* get_window(int index) {
+    if (!windows || index < 0 || (guint)index >= windows->len) return NULL;
+    return g_ptr_array_index(windows, index);
+}
+
+/* ── Recording ───────────────────────────────────────────── */
+
+/* Timestamp and kind of a new line; FALSE when nothing is recorded yet */
+static gboolean record_begin(const char *kind) {
+    if (!record_file || start_time == 0) return FALSE;
+    fprintf(record_file, "%" G_GINT64_FORMAT "\t%s", g_get_monotonic_time() - start_time, kind);
+    recorded++;
+    return TRUE;
+}
+
+static void record_number(double value) {
+    char buffer[G_ASCII_DTOSTR_BUF_SIZE];
+    fprintf(record_file, "\t%s", g_ascii_dtostr(buffer, sizeof(buffer), value));
+}
+
+static void record_string(const char *text) {
+    char *escaped = g_strescape(text ? text : "", NULL);
+    fprintf(record_file, "\t%s", escaped);
+    g_free(escaped);
+}
+
+static void on_feed_sample(const char *channel, double value, gpointer user_data) {
+    if (!record_begin("feed")) return;
+    record_string(channel);
+    record_number(value);
+    fputc('\n', record_file);
+}
+
+static gboolean on_input_done(gpointer user_data) {
+    in_input = FALSE;
+    input_idle = 0;
+    return G_SOURCE_REMOVE;
+}
+
+/* Widget changes until the event is handled are the user's; the idle runs
+ * before the next frame, whose animations and bindings change widgets too */
+static void begin_input(void) {
+    in_input = TRUE;
+    if (!input_idle) input_idle = g_idle_add_full(G_PRIORITY_HIGH, on_input_done, NULL, NULL);
+}
+
+static gboolean on_window_event(GtkEventControllerLegacy *controller, GdkEvent *event,
+                                gpointer user_data) {
+    GtkWidget *window = gtk_event_controller_get_widget(GTK_EVENT_CONTROLLER(controller));
+    GdkEventType type = gdk_event_get_event_type(event);
+    double x, y, origin_x, origin_y;
+
+    begin_input();
+    if (type != GDK_MOTION_NOTIFY && type != GDK_BUTTON_PRESS && type != GDK_BUTTON_RELEASE) {
+        return FALSE;
+    }
+    if (!gdk_event_get_position(event, &x, &y)) return FALSE;
+
+    /* Surface to window coordinates, past client-side decorations */
+    gtk_native_get_surface_transform(GTK_NATIVE(window), &origin_x, &origin_y);
+
+    const char *kind = type == GDK_MOTION_NOTIFY ? "motion"
+                     : type == GDK_BUTTON_PRESS ? "press" : "release";
+    if (!record_begin(kind)) return FALSE;
+    fprintf(record_file, "\t%d", window_index(window));
+    if (type != GDK_MOTION_NOTIFY) fprintf(record_file, "\t%u", gdk_button_event_get_button(event));
+    record_number(x - origin_x);
+    record_number(y - origin_y);
+    fputc('\n', record_file);
+    return FALSE;
+}
+
+static void record_change(GtkWidget *widget, const WidgetConfig *config, const char *property) {
+    if (!in_input || !record_begin("widget")) return;
+
+    fprintf(record_file, "\t%d", window_index(GTK_WIDGET(gtk_widget_get_root(widget))));
+    record_string(config->id);
+    fprintf(record_file, "\t%s", property);
+
+    ExpressionValue value = { 0 };
+    if (widget_factory_read_prop(widget, property, &value)) {
+        if (value.type == EXPRESSION_STRING) {
+            record_string(value.string);
+        } else {
+            record_number(value.number);
+        }
+        expression_value_clear(&value);
+    }
+    fputc('\n', record_file);
+}
+
+static void on_value_changed(GtkWidget *widget, gpointer user_data) {
+    record_change(widget, user_data, "value");
+}
+
+static void on_toggled(GtkWidget *widget, gpointer user_data) {
+    record_change(widget, user_data, "checked");
+}
+
+static void on_switch_notify(GObject *object, GParamSpec *pspec, gpointer user_data) {
+    record_change(GTK_WIDGET(object), user_data, "active");
+}
+
+static void on_combo_changed(GtkWidget *widget, gpointer user_data) {
+    record_change(widget, user_data, "active_index");
+}
+
+static void on_text_changed(GtkWidget *widget, gpointer user_data) {
+    record_change(widget, user_data, "text");
+}
+
+static void on_clicked(GtkWidget *widget, gpointer user_data) {
+    record_change(widget, user_data, "clicked");
+}
+
+void workload_add_widget(const WidgetConfig *config, GtkWidget *widget) {
+    /* Replay finds widgets by id */
+    if (!record_file || !config->id) return;
+
+    gpointer data = (gpointer)config;
+    GtkWidget *sw;
+    if (GTK_IS_RANGE(widget) || GTK_IS_SPIN_BUTTON(widget)) {
+        g_signal_connect(widget, "value-changed", G_CALLBACK(on_value_changed), data);
+    } else if (GTK_IS_CHECK_BUTTON(widget)) {
+        g_signal_connect(widget, "toggled", G_CALLBACK(on_toggled), data);
+    } else if (GTK_IS_BUTTON(widget)) {
+        g_signal_connect(widget, "clicked", G_CALLBACK(on_clicked), data);
+    } else if (GTK_IS_COMBO_BOX(widget)) {
+        g_signal_connect(widget, "changed", G_CALLBACK(on_combo_changed), data);
+    } else if (GTK_IS_EDITABLE(widget)) {
+        g_signal_connect(widget, "changed", G_CALLBACK(on_text_changed), data);
+    } else if ((sw = widget_factory_get_switch(widget))) {
+        g_signal_connect(sw, "notify::active", G_CALLBACK(on_switch_notify), data);
+    }
+}
+
+void workload_record_key(GtkWidget *window, guint keyval, GdkModifierType state) {
+    const char *name = gdk_keyval_name(keyval);
+    if (!name || !record_begin("key")) return;
+    fprintf(record_file, "\t%d\t%s\t%u\n", window_index(window), name,
+            (guint)(state & GDK_MODIFIER_MASK));
+}
+
+static gboolean on_quit_signal(gpointer user_data) {
+    /* Quit normally so the recording is complete */
+    g_application_quit(g_application_get_default());
+    return G_SOURCE_CONTINUE;
+}
+
+gboolean workload_record(const char *path, GError **error) {
+    g_return_val_if_fail(!record_file && !events, FALSE);
+
+    record_file = fopen(path, "w");
+    if (!record_file) {
+        int saved_errno = errno;
+        g_set_error(error, G_IO_ERROR, g_io_error_from_errno(saved_errno),
+                    "Cannot write '%s': %s", path, g_strerror(saved_errno));
+        return FALSE;
+    }
+    setvbuf(record_file, NULL, _IOFBF, RECORD_BUFFER_SIZE);
+    record_path = g_strdup(path);
+    fprintf(record_file, "# gtk-dashboard workload 1\n");
+
+    data_feed_set_tap(on_feed_sample, NULL);
+    g_unix_signal_add(SIGINT, on_quit_signal, NULL);
+    g_unix_signal_add(SIGTERM, on_quit_signal, NULL);
+    return TRUE;
+}
+
+/* ── Loading ─────────────────────────────────────────────── */
+
+static void event_clear(gpointer data) {
+    g_free(((WorkloadEvent *)data)->text);
+}
+
+static gboolean parse_number(const char *text, double *value) {
+    char *end;
+    *value = g_ascii_strtod(text, &end);
+    return end != text && *end == '\0';
+}
+
+static gboolean parse_int(const char *text, gint64 *value) {
+    char *end;
+    *value = g_ascii_strtoll(text, &end, 10);
+    return end != text && *end == '\0';
+}
+
+/* fields: time, kind, then the kind's own */
+static gboolean parse_event(char **fields, guint n, WorkloadEvent *event) {
+    gint64 number;
+    char *name;
+
+    if (n < 3 || !parse_int(fields[0], &event->time) || event->time < 0) return FALSE;
+    const char *kind = fields[1];
+
+    if (strcmp(kind, "feed") == 0) {
+        event->kind = EVENT_FEED;
+        name = g_strcompress(fields[2]);
+        event->name = g_intern_string(name);
+        g_free(name);
+        return n == 4 && parse_number(fields[3], &event->value);
+    }
+
+    if (!parse_int(fields[2], &number)) return FALSE;
+    event->window = (int)number;
+
+    if (strcmp(kind, "key") == 0) {
+        event->kind = EVENT_KEY;
+        if (n != 5 || !parse_int(fields[4], &number)) return FALSE;
+        event->code = gdk_keyval_from_name(fields[3]);
+        if (event->code == GDK_KEY_VoidSymbol) return FALSE;
+        event->state = (GdkModifierType)number;
+        return TRUE;
+    }
+    if (strcmp(kind, "motion") == 0) {
+        event->kind = EVENT_MOTION;
+        return n == 5 && parse_number(fields[3], &event->x) && parse_number(fields[4], &event->y);
+    }
+    if (strcmp(kind, "press") == 0 || strcmp(kind, "release") == 0) {
+        event->kind = kind[0] == 'p' ? EVENT_PRESS : EVENT_RELEASE;
+        if (n != 6 || !parse_int(fields[3], &number)) return FALSE;
+        event->code = (guint)number;
+        return parse_number(fields[4], &event->x) && parse_number(fields[5], &event->y);
+    }
+    if (strcmp(kind, "widget") == 0 && n >= 5) {
+        event->kind = EVENT_WIDGET;
+        name = g_strcompress(fields[3]);
+        event->name = g_intern_string(name);
+        g_free(name);
+        event->property = g_intern_string(fields[4]);
+        if (strcmp(fields[4], "clicked") == 0) return n == 5;
+        if (n != 6) return FALSE;
+        if (strcmp(fields[4], "text") == 0) {
+            event->text = g_strcompress(fields[5]);
+            return TRUE;
+        }
+        return parse_number(fields[5], &event->value);
+    }
+    return FALSE;
+}
+
+gboolean workload_replay(const char *path, double speed, GError **error) {
+    g_return_val_if_fail(!record_file && !events, FALSE);
+
+    if (speed <= 0) {
+        g_set_error(error, G_IO_ERROR, G_IO_ERROR_INVALID_ARGUMENT,
+                    "Replay speed must be positive");
+        return FALSE;
+    }
+
+    char *contents;
+    if (!g_file_get_contents(path, &contents, NULL, error)) return FALSE;
+
+    GArray *loaded = g_array_new(FALSE, TRUE, sizeof(WorkloadEvent));
+    g_array_set_clear_func(loaded, event_clear);
+    char **lines = g_strsplit(contents, "\n", -1);
+    gboolean ok = TRUE;
+
+    for (guint i = 0; lines[i] != NULL && ok; i++) {
+        if (lines[i][0] == '\0' || lines[i][0] == '#') continue;
+
+        char **fields = g_strsplit(lines[i], "\t", -1);
+        WorkloadEvent event = { 0 };
+        ok = parse_event(fields, g_strv_length(fields), &event);
+        if (ok) {
+            g_array_append_val(loaded, event);
+        } else {
+            event_clear(&event);
+            g_set_error(error, G_IO_ERROR, G_IO_ERROR_INVALID_DATA,
+                        "%s:%u: invalid event", path, i + 1);
+        }
+        g_strfreev(fields);
+    }
+    g_strfreev(lines);
+    g_free(contents);
+
+    if (!ok) {
+        g_array_unref(loaded);
+        return FALSE;
+    }
+
+    events = loaded;
+    replay_speed = speed;
+    intervals = g_array_new(FALSE, FALSE, sizeof(gint64));
+    paints = g_array_new(FALSE, FALSE, sizeof(gint64));
+
+    /* The recorded samples are the only ones */
+    data_feed_set_sources_enabled(FALSE);
+    return TRUE;
+}
+
+/* ── Replay ──────────────────────────────────────────────── */
+
+void workload_set_key_func(WorkloadKeyFunc func, gpointer user_data) {
+    key_func = func;
+    key_data = user_data;
+}
+
+/* The hovered widget and its ancestors are prelit, as under a real pointer */
+static void set_hovered(GtkWidget *target) {
+    if (target == hovered) return;
+
+    for (GtkWidget *w = hovered; w != NULL; w = gtk_widget_get_parent(w)) {
+        if (!target || (w != target && !gtk_widget_is_ancestor(target, w))) {
+            gtk_widget_unset_state_flags(w, GTK_STATE_FLAG_PRELIGHT);
+        }
+    }
+    for (GtkWidget *w = target; w != NULL; w = gtk_widget_get_parent(w)) {
+        gtk_widget_set_state_flags(w, GTK_STATE_FLAG_PRELIGHT, FALSE);
+    }
+    g_set_object(&hovered, target);
+}
+
+static void set_pressed(GtkWidget *target) {
+    if (pressed) gtk_widget_unset_state_flags(pressed, GTK_STATE_FLAG_ACTIVE);
+    if (target) gtk_widget_set_state_flags(target, GTK_STATE_FLAG_ACTIVE, FALSE);
+    g_set_object(&pressed, target);
+}
+
+/* The mapped widget made for the WidgetConfig with this id */
+static GtkWidget* find_widget(GtkWidget *widget, const char *id) {
+    if (!gtk_widget_get_mapped(widget)) return NULL;
+
+    const WidgetConfig *config = g_object_get_data(G_OBJECT(widget), "widget-config");
+    if (config && g_strcmp0(config->id, id) == 0) return widget;
+
+    for (GtkWidget *child = gtk_widget_get_first_child(widget); child != NULL;
+         child = gtk_widget_get_next_sibling(child)) {
+        GtkWidget *found = find_widget(child, id);
+        if (found) return found;
+    }
+    return NULL;
+}
+
+static void apply_change(GtkWidget *widget, const WorkloadEvent *event) {
+    const char *property = event->property;
+
+    if (strcmp(property, "clicked") == 0 && GTK_IS_BUTTON(widget)) {
+        g_signal_emit_by_name(widget, "clicked");
+        return;
+    }
+
+    ExpressionValue value = { .number = event->value };
+    if (event->text) {
+        value.type = EXPRESSION_STRING;
+        value.string = event->text;
+    }
+    if (!widget_factory_write_prop(widget, property, &value, NULL)) {
+        g_warning("Replay: cannot set '%s' of '%s'", property, event->name);
+    }
+}
+
+static void replay_event(const WorkloadEvent *event) {
+    if (event->kind == EVENT_FEED) {
+        data_feed_publish(event->name, event->value);
+        return;
+    }
+
+    GtkWidget *window = get_window(event->window);
+    if (!window) return;
+    power_policy_activity();
+
+    switch (event->kind) {
+    case EVENT_KEY:
+        if (key_func) key_func(window, event->code, event->state, key_data);
+        break;
+    case EVENT_MOTION:
+        set_hovered(gtk_widget_pick(window, event->x, event->y, GTK_PICK_DEFAULT));
+        break;
+    case EVENT_PRESS:
+        set_hovered(gtk_widget_pick(window, event->x, event->y, GTK_PICK_DEFAULT));
+        set_pressed(hovered);
+        break;
+    case EVENT_RELEASE:
+        set_pressed(NULL);
+        break;
+    case EVENT_WIDGET: {
+        GtkWidget *widget = find_widget(window, event->name);
+        if (widget) {
+            apply_change(widget, event);
+        } else {
+            g_warning("Replay: no widget '%s' shown in window %d", event->name, event->window);
+        }
+        break;
+    }
+    case EVENT_FEED:
+        break;
+    }
+}
+
+static int compare_int64(const void *a, const void *b) {
+    gint64 x = *(const gint64 *)a;
+    gint64 y = *(const gint64 *)b;
+    return (x > y) - (x < y);
+}
+
+static gint64 percentile(GArray *sorted, guint percent) {
+    if (sorted->len == 0) return 0;
+    return g_array_index(sorted, gint64, MIN(sorted->len - 1, sorted->len * percent / 100));
+}
+
+/* Percentiles of a µs array, in ms; sorts it */
+static void add_distribution(JsonBuilder *builder, const char *name, GArray *samples) {
+    g_array_sort(samples, compare_int64);
+
+    gint64 total = 0;
+    for (guint i = 0; i < samples->len; i++) total += g_array_index(samples, gint64, i);
+
+    json_builder_set_member_name(builder, name);
+    json_builder_begin_object(builder);
+    json_builder_set_member_name(builder, "mean");
+    json_builder_add_double_value(builder, samples->len ? total / 1000.0 / samples->len : 0.0);
+    json_builder_set_member_name(builder, "p50");
+    json_builder_add_double_value(builder, percentile(samples, 50) / 1000.0);
+    json_builder_set_member_name(builder, "p95");
+    json_builder_add_double_value(builder, percentile(samples, 95) / 1000.0);
+    json_builder_set_member_name(builder, "p99");
+    json_builder_add_double_value(builder, percentile(samples, 99) / 1000.0);
+    json_builder_set_member_name(builder, "max");
+    json_builder_add_double_value(builder, percentile(samples, 100) / 1000.0);
+    json_builder_end_object(builder);
+}
+
+static void replay_report(void) {
+    reported = TRUE;
+    double duration_s = (g_get_monotonic_time() - start_time) / (double)G_USEC_PER_SEC;
+
+    JsonBuilder *builder = json_builder_new();
+    json_builder_begin_object(builder);
+
+    json_builder_set_member_name(builder, "complete");
+    json_builder_add_boolean_value(builder, next_event == events->len);
+    json_builder_set_member_name(builder, "events");
+    json_builder_add_int_value(builder, next_event);
+    json_builder_set_member_name(builder, "speed");
+    json_builder_add_double_value(builder, replay_speed);
+    json_builder_set_member_name(builder, "duration_ms");
+    json_builder_add_double_value(builder, duration_s * 1000.0);
+    /* How late the latest event was sent: the build could not keep up */
+    json_builder_set_member_name(builder, "max_lag_ms");
+    json_builder_add_double_value(builder, max_lag / 1000.0);
+    json_builder_set_member_name(builder, "frames");
+    json_builder_add_int_value(builder, paints->len);
+    json_builder_set_member_name(builder, "fps");
+    json_builder_add_double_value(builder, duration_s > 0 ? paints->len / duration_s : 0.0);
+
+    add_distribution(builder, "frame_interval_ms", intervals);
+    add_distribution(builder, "paint_ms", paints);
+
+    gint64 long_limit = percentile(intervals, 50) * LONG_FRAME_FACTOR;
+    guint long_frames = 0;
+    for (guint i = 0; i < intervals->len; i++) {
+        if (g_array_index(intervals, gint64, i) > long_limit) long_frames++;
+    }
+    json_builder_set_member_name(builder, "long_frames");
+    json_builder_add_int_value(builder, long_frames);
+
+    json_builder_end_object(builder);
+
+    JsonGenerator *gen = json_generator_new();
+    json_generator_set_pretty(gen, TRUE);
+    JsonNode *root = json_builder_get_root(builder);
+    json_generator_set_root(gen, root);
+    char *json = json_generator_to_data(gen, NULL);
+    g_print("%s\n", json);
+
+    g_free(json);
+    json_node_unref(root);
+    g_object_unref(gen);
+    g_object_unref(builder);
+}
+
+static gboolean on_replay_done(gpointer user_data) {
+    replay_timer = 0;
+    replay_report();
+    g_application_quit(g_application_get_default());
+    return G_SOURCE_REMOVE;
+}
+
+static gboolean on_replay_timer(gpointer user_data);
+
+static void schedule_next(void) {
+    if (next_event >= events->len) {
+        replay_timer = g_timeout_add(REPLAY_SETTLE_MS, on_replay_done, NULL);
+        return;
+    }
+
+    const WorkloadEvent *event = &g_array_index(events, WorkloadEvent, next_event);
+    gint64 delay = start_time + (gint64)(event->time / replay_speed) - g_get_monotonic_time();
+    replay_timer = g_timeout_add(delay > 0 ? (guint)((delay + 999) / 1000) : 0,
+                                 on_replay_timer, NULL);
+}
+
+/* Sends every event that is due, then waits for the next one */
+static gboolean on_replay_timer(gpointer user_data) {
+    replay_timer = 0;
+    gint64 now = g_get_monotonic_time();
+
+    while (next_event < events->len) {
+        const WorkloadEvent *event = &g_array_index(events, WorkloadEvent, next_event);
+        gint64 due = start_time + (gint64)(event->time / replay_speed);
+        if (due > now) break;
+
+        max_lag = MAX(max_lag, now - due);
+        replay_event(event);
+        next_event++;
+    }
+    schedule_next();
+    return G_SOURCE_REMOVE;
+}
+
+/* ── Windows ─────────────────────────────────────────────── */
+
+static void on_before_paint(GdkFrameClock *frame_clock, gpointer user_data) {
+    /* Changes from here on come from the frame: animations, bindings */
+    in_input = FALSE;
+}
+
+static void on_frame(GdkFrameClock *frame_clock, gint64 interval_us, gint64 paint_us,
+                     gpointer user_data) {
+    if (start_time == 0 || reported) return;
+
+    if (interval_us > 0) g_array_append_val(intervals, interval_us);
+    g_array_append_val(paints, paint_us);
+}
+
+static void on_window_realize(GtkWidget *window, gpointer user_data) {
+    GdkFrameClock *frame_clock = gtk_widget_get_frame_clock(window);
+    if (frame_clock) {
+        g_signal_connect_object(frame_clock, "before-paint", G_CALLBACK(on_before_paint), window, 0);
+    }
+}
+
+static void on_window_destroy(GtkWidget *window, gpointer user_data) {
+    if (windows) g_ptr_array_remove(windows, window);
+}
+
+void workload_add_window(GtkWidget *window) {
+    g_return_if_fail(GTK_IS_WINDOW(window));
+    if (!record_file && !events) return;
+
+    if (!windows) windows = g_ptr_array_new();
+    g_ptr_array_add(windows, window);
+    g_signal_connect(window, "destroy", G_CALLBACK(on_window_destroy), NULL);
+
+    if (record_file) {
+        GtkEventController *input = gtk_event_controller_legacy_new();
+        gtk_event_controller_set_propagation_phase(input, GTK_PHASE_CAPTURE);
+        g_signal_connect(input, "event", G_CALLBACK(on_window_event), NULL);
+        gtk_widget_add_controller(window, input);
+
+        g_signal_connect(window, "realize", G_CALLBACK(on_window_realize), NULL);
+        if (gtk_widget_get_realized(window)) on_window_realize(window, NULL);
+    } else {
+        frame_stats_watch(window, on_frame, NULL);
+    }
+}
+
+/* ── Lifecycle ───────────────────────────────────────────── */
+
+void workload_start(void) {
+    if ((!record_file && !events) || start_time != 0) return;
+
+    start_time = g_get_monotonic_time();
+    if (events) schedule_next();
+}
+
+void workload_shutdown(void) {
+    if (record_file) {
+        data_feed_set_tap(NULL, NULL);
+        fclose(record_file);
+        record_file = NULL;
+        g_print("Recorded %u events to %s\n", recorded, record_path);
+        g_clear_pointer(&record_path, g_free);
+    }
+
+    if (events) {
+        if (replay_timer) g_source_remove(replay_timer);
+        replay_timer = 0;
+        if (!reported && start_time != 0) replay_report();
+        g_clear_object(&hovered);
+        g_clear_object(&pressed);
+        g_clear_pointer(&events, g_array_unref);
+        g_clear_pointer(&intervals, g_array_unref);
+        g_clear_pointer(&paints, g_array_unref);
+    }
+    g_clear_pointer(&windows, g_ptr_array_unref);
+}
@@ -0,0 +1,49 @@
+#ifndef WORKLOAD_H
+#define WORKLOAD_H
+
+#include <gtk/gtk.h>
+#include "json_parser.h"
+
+/*
+ * Recorded workloads (--record, --replay).
+ *
+ * A recording holds, with microsecond timestamps from the start of the
+ * dashboard, every data-feed sample, the pointer motion and buttons and
+ * the shortcut keys of the dashboard windows, and every change the user
+ * makes to an interactive widget; one tab-separated event per line.
+ *
+ * A replay disables the layout's own feed sources and sends the recorded
+ * events again on the recorded schedule, optionally faster, so builds can
+ * be compared on the same load. Frame statistics of the dashboard windows
+ * are collected meanwhile, printed as JSON once the last event is sent,
+ * and the application quits.
+ *
+ * GTK cannot inject synthesized input events, so input replays by its
+ * effect: keys go to the dashboard's shortcut handler, the pointer sets
+ * the hover and pressed states of the widget under its recorded position,
+ * and widget changes are applied to the mapped widget with the recorded id.
+ */
+
+typedef void (*WorkloadKeyFunc)(GtkWidget *window, guint keyval, GdkModifierType state,
+                                gpointer user_data);
+
+/* Once, before the application runs; at most one of them */
+gboolean workload_record(const char *path, GError **error);
+gboolean workload_replay(const char *path, double speed, GError **error);
+
+/* Handler of replayed keys */
+void workload_set_key_func(WorkloadKeyFunc func, gpointer user_data);
+
+/* Follow a dashboard window until it is destroyed */
+void workload_add_window(GtkWidget *window);
+/* Record the user's changes to the widget made for config */
+void workload_add_widget(const WidgetConfig *config, GtkWidget *widget);
+/* A shortcut key the dashboard handled */
+void workload_record_key(GtkWidget *window, guint keyval, GdkModifierType state);
+
+/* The dashboard is up: timestamps count from here */
+void workload_start(void);
+/* Close the recording; an unfinished replay still reports its frames */
+void workload_shutdown(void);
+
+#endif /* WORKLOAD_H */